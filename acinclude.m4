@@ -6,6 +6,14 @@ dnl Function to detect if libvmdk dependencies are available
 AC_DEFUN([AX_LIBVMDK_CHECK_LOCAL],
   [dnl Check for internationalization functions in libvmdk/libvmdk_i18n.c
   AC_CHECK_FUNCS([bindtextdomain])
+
+  dnl Headers and functions included in libvmdk/libvmdk_trace.c
+  AS_IF(
+    [test "x$ac_cv_enable_winapi" = xno],
+    [AC_CHECK_HEADERS([sys/time.h])
+
+    AC_CHECK_FUNCS([clock_gettime gettimeofday time])
+  ])
 ])
 
 dnl Function to detect if vmdktools dependencies are available
@@ -20,6 +20,7 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <memory.h>
 #include <types.h>
 
@@ -185,6 +186,142 @@ int libvmdk_bit_stream_free(
 	return( 1 );
 }
 
+/* Reads bytes from the byte stream into the bit buffer
+ * The first byte is stored in the least significant bits of the bit buffer
+ * This function reads as many bytes as fit in the bit buffer
+ * Returns 1 on success or -1 on error
+ */
+int libvmdk_bit_stream_read_bytes_back_to_front(
+     libvmdk_bit_stream_t *bit_stream,
+     libcerror_error_t **error )
+{
+	static char *function   = "libvmdk_bit_stream_read_bytes_back_to_front";
+	uint64_t value_64bit    = 0;
+	uint8_t number_of_bytes = 0;
+
+	if( bit_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit stream.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_bytes = ( 64 - bit_stream->bit_buffer_size ) / 8;
+
+	if( number_of_bytes == 0 )
+	{
+		return( 1 );
+	}
+	if( ( bit_stream->byte_stream_offset < bit_stream->byte_stream_size )
+	 && ( ( bit_stream->byte_stream_size - bit_stream->byte_stream_offset ) >= 8 ) )
+	{
+		/* Fast path: read a 64-bit value and use the bytes that fit in the bit buffer
+		 */
+		byte_stream_copy_to_uint64_little_endian(
+		 &( bit_stream->byte_stream[ bit_stream->byte_stream_offset ] ),
+		 value_64bit );
+
+		if( number_of_bytes == 8 )
+		{
+			bit_stream->bit_buffer = value_64bit;
+		}
+		else
+		{
+			value_64bit &= ( (uint64_t) 1 << ( number_of_bytes * 8 ) ) - 1;
+
+			bit_stream->bit_buffer |= value_64bit << bit_stream->bit_buffer_size;
+		}
+		bit_stream->bit_buffer_size    += number_of_bytes * 8;
+		bit_stream->byte_stream_offset += number_of_bytes;
+	}
+	else
+	{
+		while( ( number_of_bytes > 0 )
+		    && ( bit_stream->byte_stream_offset < bit_stream->byte_stream_size ) )
+		{
+			bit_stream->bit_buffer |= (uint64_t) bit_stream->byte_stream[ bit_stream->byte_stream_offset ] << bit_stream->bit_buffer_size;
+
+			bit_stream->bit_buffer_size    += 8;
+			bit_stream->byte_stream_offset += 1;
+
+			number_of_bytes--;
+		}
+	}
+	return( 1 );
+}
+
+/* Reads bytes from the byte stream into the bit buffer
+ * The first byte is stored in the most significant bits of the bits in the bit buffer
+ * This function reads as many bytes as fit in the bit buffer
+ * Returns 1 on success or -1 on error
+ */
+int libvmdk_bit_stream_read_bytes_front_to_back(
+     libvmdk_bit_stream_t *bit_stream,
+     libcerror_error_t **error )
+{
+	static char *function   = "libvmdk_bit_stream_read_bytes_front_to_back";
+	uint64_t value_64bit    = 0;
+	uint8_t number_of_bytes = 0;
+
+	if( bit_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit stream.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_bytes = ( 64 - bit_stream->bit_buffer_size ) / 8;
+
+	if( number_of_bytes == 0 )
+	{
+		return( 1 );
+	}
+	if( ( bit_stream->byte_stream_offset < bit_stream->byte_stream_size )
+	 && ( ( bit_stream->byte_stream_size - bit_stream->byte_stream_offset ) >= 8 ) )
+	{
+		/* Fast path: read a 64-bit value and use the bytes that fit in the bit buffer
+		 */
+		byte_stream_copy_to_uint64_big_endian(
+		 &( bit_stream->byte_stream[ bit_stream->byte_stream_offset ] ),
+		 value_64bit );
+
+		if( number_of_bytes == 8 )
+		{
+			bit_stream->bit_buffer = value_64bit;
+		}
+		else
+		{
+			bit_stream->bit_buffer <<= number_of_bytes * 8;
+			bit_stream->bit_buffer  |= value_64bit >> ( 64 - ( number_of_bytes * 8 ) );
+		}
+		bit_stream->bit_buffer_size    += number_of_bytes * 8;
+		bit_stream->byte_stream_offset += number_of_bytes;
+	}
+	else
+	{
+		while( ( number_of_bytes > 0 )
+		    && ( bit_stream->byte_stream_offset < bit_stream->byte_stream_size ) )
+		{
+			bit_stream->bit_buffer <<= 8;
+			bit_stream->bit_buffer  |= bit_stream->byte_stream[ bit_stream->byte_stream_offset ];
+
+			bit_stream->bit_buffer_size    += 8;
+			bit_stream->byte_stream_offset += 1;
+
+			number_of_bytes--;
+		}
+	}
+	return( 1 );
+}
+
 /* Retrieves a value from the bit stream
  * Returns 1 on success or -1 on error
  */
@@ -194,11 +331,63 @@ int libvmdk_bit_stream_get_value(
      uint32_t *value_32bit,
      libcerror_error_t **error )
 {
-	static char *function            = "libvmdk_bit_stream_get_value";
-	uint32_t read_value_32bit        = 0;
-	uint32_t safe_value_32bit        = 0;
-	uint8_t read_number_of_bits      = 0;
-	uint8_t remaining_number_of_bits = 0;
+	static char *function = "libvmdk_bit_stream_get_value";
+
+	if( libvmdk_bit_stream_peek_value(
+	     bit_stream,
+	     number_of_bits,
+	     value_32bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_bits > bit_stream->bit_buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid byte stream offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_bit_stream_skip_bits(
+	     bit_stream,
+	     number_of_bits,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to skip bits.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a value from the bit stream without consuming the bits
+ * If fewer bits remain in the bit stream the missing bits are set to 0
+ * Returns 1 on success or -1 on error
+ */
+int libvmdk_bit_stream_peek_value(
+     libvmdk_bit_stream_t *bit_stream,
+     uint8_t number_of_bits,
+     uint32_t *value_32bit,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_bit_stream_peek_value";
+	uint64_t value_64bit  = 0;
 
 	if( bit_stream == NULL )
 	{
@@ -233,81 +422,119 @@ int libvmdk_bit_stream_get_value(
 
 		return( -1 );
 	}
-	remaining_number_of_bits = number_of_bits;
+	if( number_of_bits == 0 )
+	{
+		*value_32bit = 0;
 
-	while( remaining_number_of_bits > 0 )
+		return( 1 );
+	}
+	if( bit_stream->storage_type == LIBVMDK_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
 	{
-		while( ( remaining_number_of_bits > bit_stream->bit_buffer_size )
-		    && ( bit_stream->bit_buffer_size <= 24 ) )
+		if( number_of_bits > bit_stream->bit_buffer_size )
 		{
-			if( bit_stream->byte_stream_offset >= bit_stream->byte_stream_size )
+			if( libvmdk_bit_stream_read_bytes_back_to_front(
+			     bit_stream,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-				 "%s: invalid byte stream offset value out of bounds.",
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read bytes into bit buffer.",
 				 function );
 
 				return( -1 );
 			}
-			if( bit_stream->storage_type == LIBVMDK_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
-			{
-				bit_stream->bit_buffer |= (uint32_t) bit_stream->byte_stream[ bit_stream->byte_stream_offset ] << bit_stream->bit_buffer_size;
-			}
-			else if( bit_stream->storage_type == LIBVMDK_BIT_STREAM_STORAGE_TYPE_BYTE_FRONT_TO_BACK )
+		}
+		/* The bits above the bit buffer size are always 0
+		 */
+		value_64bit = bit_stream->bit_buffer;
+	}
+	else if( bit_stream->storage_type == LIBVMDK_BIT_STREAM_STORAGE_TYPE_BYTE_FRONT_TO_BACK )
+	{
+		if( number_of_bits > bit_stream->bit_buffer_size )
+		{
+			if( libvmdk_bit_stream_read_bytes_front_to_back(
+			     bit_stream,
+			     error ) != 1 )
 			{
-				bit_stream->bit_buffer <<= 8;
-				bit_stream->bit_buffer  |= bit_stream->byte_stream[ bit_stream->byte_stream_offset ];
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read bytes into bit buffer.",
+				 function );
+
+				return( -1 );
 			}
-			bit_stream->bit_buffer_size    += 8;
-			bit_stream->byte_stream_offset += 1;
 		}
-		if( remaining_number_of_bits < bit_stream->bit_buffer_size )
+		if( bit_stream->bit_buffer_size >= number_of_bits )
 		{
-			read_number_of_bits = remaining_number_of_bits;
+			value_64bit = bit_stream->bit_buffer >> ( bit_stream->bit_buffer_size - number_of_bits );
 		}
 		else
 		{
-			read_number_of_bits = bit_stream->bit_buffer_size;
+			value_64bit = bit_stream->bit_buffer << ( number_of_bits - bit_stream->bit_buffer_size );
 		}
-		read_value_32bit = bit_stream->bit_buffer;
+	}
+	*value_32bit = (uint32_t) ( value_64bit & ( ( (uint64_t) 1 << number_of_bits ) - 1 ) );
 
-		if( remaining_number_of_bits < number_of_bits )
-		{
-			safe_value_32bit <<= remaining_number_of_bits;
-		}
-		if( bit_stream->storage_type == LIBVMDK_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
-		{
-			if( read_number_of_bits < 32 )
-			{
-				/* On VS 2008 32-bit "~( 0xfffffffUL << 32 )" does not behave as expected
-				 */
-				read_value_32bit &= ~( 0xffffffffUL << read_number_of_bits );
+	return( 1 );
+}
 
-				bit_stream->bit_buffer >>= read_number_of_bits;
-			}
-			bit_stream->bit_buffer_size -= read_number_of_bits;
-		}
-		else if( bit_stream->storage_type == LIBVMDK_BIT_STREAM_STORAGE_TYPE_BYTE_FRONT_TO_BACK )
-		{
-			bit_stream->bit_buffer_size -= read_number_of_bits;
-			read_value_32bit           >>= bit_stream->bit_buffer_size;
+/* Skips bits in the bit stream
+ * The bits should have been made available in the bit buffer by peeking before
+ * Returns 1 on success or -1 on error
+ */
+int libvmdk_bit_stream_skip_bits(
+     libvmdk_bit_stream_t *bit_stream,
+     uint8_t number_of_bits,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_bit_stream_skip_bits";
 
-			if( bit_stream->bit_buffer_size > 0 )
-			{
-				bit_stream->bit_buffer &= 0xffffffffUL >> ( 32 - bit_stream->bit_buffer_size );
-			}
-		}
-		if( bit_stream->bit_buffer_size == 0 )
-		{
-			bit_stream->bit_buffer = 0;
-		}
-		safe_value_32bit         |= read_value_32bit;
-		remaining_number_of_bits -= read_number_of_bits;
+	if( bit_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_bits > bit_stream->bit_buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of bits value out of bounds.",
+		 function );
+
+		return( -1 );
 	}
-	*value_32bit = safe_value_32bit;
+	/* Note that skipping 0 bits of a full bit buffer would otherwise shift by 64
+	 */
+	if( number_of_bits == 0 )
+	{
+		return( 1 );
+	}
+	bit_stream->bit_buffer_size -= number_of_bits;
 
+	if( bit_stream->bit_buffer_size == 0 )
+	{
+		bit_stream->bit_buffer = 0;
+	}
+	else if( bit_stream->storage_type == LIBVMDK_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
+	{
+		bit_stream->bit_buffer >>= number_of_bits;
+	}
+	else if( bit_stream->storage_type == LIBVMDK_BIT_STREAM_STORAGE_TYPE_BYTE_FRONT_TO_BACK )
+	{
+		bit_stream->bit_buffer &= ( (uint64_t) 1 << bit_stream->bit_buffer_size ) - 1;
+	}
 	return( 1 );
 }
 
@@ -40,6 +40,23 @@ enum LIBVMDK_BIT_STREAM_STORAGE_TYPES
 	LIBVMDK_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT	= 0x02
 };
 
+/* Unchecked peek and skip of bits that are already in the bit buffer
+ * The number of bits must be in the range 1 - 32 and not exceed the bit buffer size
+ */
+#define LIBVMDK_BIT_STREAM_PEEK_VALUE_BACK_TO_FRONT( bit_stream, number_of_bits ) \
+	(uint32_t) ( ( bit_stream )->bit_buffer & ( ( (uint64_t) 1 << ( number_of_bits ) ) - 1 ) )
+
+#define LIBVMDK_BIT_STREAM_PEEK_VALUE_FRONT_TO_BACK( bit_stream, number_of_bits ) \
+	(uint32_t) ( ( ( bit_stream )->bit_buffer >> ( ( bit_stream )->bit_buffer_size - ( number_of_bits ) ) ) & ( ( (uint64_t) 1 << ( number_of_bits ) ) - 1 ) )
+
+#define LIBVMDK_BIT_STREAM_SKIP_BITS_BACK_TO_FRONT( bit_stream, number_of_bits ) \
+	( bit_stream )->bit_buffer     >>= ( number_of_bits ); \
+	( bit_stream )->bit_buffer_size -= ( number_of_bits )
+
+#define LIBVMDK_BIT_STREAM_SKIP_BITS_FRONT_TO_BACK( bit_stream, number_of_bits ) \
+	( bit_stream )->bit_buffer_size -= ( number_of_bits ); \
+	( bit_stream )->bit_buffer      &= ( (uint64_t) 1 << ( bit_stream )->bit_buffer_size ) - 1
+
 typedef struct libvmdk_bit_stream libvmdk_bit_stream_t;
 
 struct libvmdk_bit_stream
@@ -62,7 +79,7 @@ struct libvmdk_bit_stream
 
 	/* The bit buffer
 	 */
-	uint32_t bit_buffer;
+	uint64_t bit_buffer;
 
 	/* The number of bits remaining in the bit buffer
 	 */
@@ -81,12 +98,31 @@ int libvmdk_bit_stream_free(
      libvmdk_bit_stream_t **bit_stream,
      libcerror_error_t **error );
 
+int libvmdk_bit_stream_read_bytes_back_to_front(
+     libvmdk_bit_stream_t *bit_stream,
+     libcerror_error_t **error );
+
+int libvmdk_bit_stream_read_bytes_front_to_back(
+     libvmdk_bit_stream_t *bit_stream,
+     libcerror_error_t **error );
+
 int libvmdk_bit_stream_get_value(
      libvmdk_bit_stream_t *bit_stream,
      uint8_t number_of_bits,
      uint32_t *value_32bit,
      libcerror_error_t **error );
 
+int libvmdk_bit_stream_peek_value(
+     libvmdk_bit_stream_t *bit_stream,
+     uint8_t number_of_bits,
+     uint32_t *value_32bit,
+     libcerror_error_t **error );
+
+int libvmdk_bit_stream_skip_bits(
+     libvmdk_bit_stream_t *bit_stream,
+     uint8_t number_of_bits,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
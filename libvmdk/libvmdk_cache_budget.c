@@ -0,0 +1,488 @@
+/*
+ * Cache memory budget functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvmdk_cache_budget.h"
+#include "libvmdk_definitions.h"
+#include "libvmdk_libcerror.h"
+
+/* Creates a cache budget
+ * Make sure the value cache_budget is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_cache_budget_initialize(
+     libvmdk_cache_budget_t **cache_budget,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_cache_budget_initialize";
+
+	if( cache_budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache budget.",
+		 function );
+
+		return( -1 );
+	}
+	if( *cache_budget != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid cache budget value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*cache_budget = memory_allocate_structure(
+	                 libvmdk_cache_budget_t );
+
+	if( *cache_budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create cache budget.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *cache_budget,
+	     0,
+	     sizeof( libvmdk_cache_budget_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear cache budget.",
+		 function );
+
+		goto on_error;
+	}
+	( *cache_budget )->grains_share                         = LIBVMDK_CACHE_BUDGET_DEFAULT_GRAINS_SHARE;
+	( *cache_budget )->number_of_grains_cache_entries       = LIBVMDK_MAXIMUM_CACHE_ENTRIES_GRAINS;
+	( *cache_budget )->number_of_grain_groups_cache_entries = LIBVMDK_MAXIMUM_CACHE_ENTRIES_GRAIN_GROUPS;
+
+	return( 1 );
+
+on_error:
+	if( *cache_budget != NULL )
+	{
+		memory_free(
+		 *cache_budget );
+
+		*cache_budget = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a cache budget
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_cache_budget_free(
+     libvmdk_cache_budget_t **cache_budget,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_cache_budget_free";
+
+	if( cache_budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache budget.",
+		 function );
+
+		return( -1 );
+	}
+	if( *cache_budget != NULL )
+	{
+		memory_free(
+		 *cache_budget );
+
+		*cache_budget = NULL;
+	}
+	return( 1 );
+}
+
+/* Calculates the number of grain groups and grains cache entries from the shares of the budget
+ * The fixed default number of cache entries is used if no maximum size or entry sizes are set
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_cache_budget_calculate_number_of_cache_entries(
+     libvmdk_cache_budget_t *cache_budget,
+     libcerror_error_t **error )
+{
+	static char *function            = "libvmdk_cache_budget_calculate_number_of_cache_entries";
+	size64_t grain_groups_cache_size = 0;
+	size64_t grains_cache_size       = 0;
+	size64_t number_of_cache_entries = 0;
+
+	if( cache_budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache budget.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( cache_budget->maximum_size == 0 )
+	 || ( cache_budget->grain_entry_size == 0 )
+	 || ( cache_budget->grain_group_entry_size == 0 )
+	 || ( cache_budget->number_of_grain_groups_caches <= 0 ) )
+	{
+		cache_budget->number_of_grains_cache_entries       = LIBVMDK_MAXIMUM_CACHE_ENTRIES_GRAINS;
+		cache_budget->number_of_grain_groups_cache_entries = LIBVMDK_MAXIMUM_CACHE_ENTRIES_GRAIN_GROUPS;
+
+		return( 1 );
+	}
+	grains_cache_size       = ( cache_budget->maximum_size / LIBVMDK_CACHE_BUDGET_NUMBER_OF_SHARES ) * cache_budget->grains_share;
+	grain_groups_cache_size = cache_budget->maximum_size - grains_cache_size;
+
+	number_of_cache_entries = grains_cache_size / cache_budget->grain_entry_size;
+
+	if( number_of_cache_entries < 1 )
+	{
+		number_of_cache_entries = 1;
+	}
+	else if( number_of_cache_entries > LIBVMDK_CACHE_BUDGET_MAXIMUM_NUMBER_OF_CACHE_ENTRIES )
+	{
+		number_of_cache_entries = LIBVMDK_CACHE_BUDGET_MAXIMUM_NUMBER_OF_CACHE_ENTRIES;
+	}
+	cache_budget->number_of_grains_cache_entries = (int) number_of_cache_entries;
+
+	/* The grain groups share is divided between the grain groups caches of the cached extent files
+	 */
+	number_of_cache_entries = ( grain_groups_cache_size / cache_budget->number_of_grain_groups_caches ) / cache_budget->grain_group_entry_size;
+
+	if( number_of_cache_entries < 1 )
+	{
+		number_of_cache_entries = 1;
+	}
+	else if( number_of_cache_entries > LIBVMDK_CACHE_BUDGET_MAXIMUM_NUMBER_OF_CACHE_ENTRIES )
+	{
+		number_of_cache_entries = LIBVMDK_CACHE_BUDGET_MAXIMUM_NUMBER_OF_CACHE_ENTRIES;
+	}
+	cache_budget->number_of_grain_groups_cache_entries = (int) number_of_cache_entries;
+
+	return( 1 );
+}
+
+/* Sets the maximum (cache memory) size
+ * A maximum size of 0 restores the fixed default number of cache entries
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_cache_budget_set_maximum_size(
+     libvmdk_cache_budget_t *cache_budget,
+     size64_t maximum_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_cache_budget_set_maximum_size";
+
+	if( cache_budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache budget.",
+		 function );
+
+		return( -1 );
+	}
+	cache_budget->maximum_size = maximum_size;
+
+	if( libvmdk_cache_budget_calculate_number_of_cache_entries(
+	     cache_budget,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate number of cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the entry sizes of the grains and grain groups caches and the number of grain groups caches
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_cache_budget_set_entry_sizes(
+     libvmdk_cache_budget_t *cache_budget,
+     size64_t grain_entry_size,
+     size64_t grain_group_entry_size,
+     int number_of_grain_groups_caches,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_cache_budget_set_entry_sizes";
+
+	if( cache_budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache budget.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_grain_groups_caches < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of grain groups caches value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	cache_budget->grain_entry_size              = grain_entry_size;
+	cache_budget->grain_group_entry_size        = grain_group_entry_size;
+	cache_budget->number_of_grain_groups_caches = number_of_grain_groups_caches;
+
+	if( libvmdk_cache_budget_calculate_number_of_cache_entries(
+	     cache_budget,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate number of cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Balances the shares of the budget according to the cache statistics
+ * The counters are the totals since the handle was opened, the budget keeps the totals of the last balance
+ * Once the number of lookups since the last balance reaches the balance interval, the cache with
+ * at least twice the cost of misses (reads) of the other cache is favoured, where the cost of
+ * a miss is the size of the entry that is read. A share is moved to the favoured cache once
+ * it was favoured for a number of consecutive balance intervals (hysteresis)
+ * Returns 1 if the number of cache entries changed, 0 if not or -1 on error
+ */
+int libvmdk_cache_budget_balance(
+     libvmdk_cache_budget_t *cache_budget,
+     uint64_t number_of_grain_lookups,
+     uint64_t number_of_grain_reads,
+     uint64_t number_of_grain_group_lookups,
+     uint64_t number_of_grain_group_reads,
+     libcerror_error_t **error )
+{
+	static char *function                    = "libvmdk_cache_budget_balance";
+	uint64_t grain_group_misses_cost         = 0;
+	uint64_t grain_misses_cost               = 0;
+	uint64_t number_of_grain_group_misses    = 0;
+	uint64_t number_of_grain_misses          = 0;
+	uint64_t number_of_lookups               = 0;
+	int grains_share                         = 0;
+	int number_of_grain_groups_cache_entries = 0;
+	int number_of_grains_cache_entries       = 0;
+
+	if( cache_budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache budget.",
+		 function );
+
+		return( -1 );
+	}
+	/* The counters restart when the handle is reopened
+	 */
+	if( ( number_of_grain_lookups < cache_budget->last_number_of_grain_lookups )
+	 || ( number_of_grain_reads < cache_budget->last_number_of_grain_reads )
+	 || ( number_of_grain_group_lookups < cache_budget->last_number_of_grain_group_lookups )
+	 || ( number_of_grain_group_reads < cache_budget->last_number_of_grain_group_reads ) )
+	{
+		cache_budget->last_number_of_grain_lookups       = number_of_grain_lookups;
+		cache_budget->last_number_of_grain_reads         = number_of_grain_reads;
+		cache_budget->last_number_of_grain_group_lookups = number_of_grain_group_lookups;
+		cache_budget->last_number_of_grain_group_reads   = number_of_grain_group_reads;
+		cache_budget->pending_share_move                 = 0;
+
+		return( 0 );
+	}
+	number_of_lookups = ( number_of_grain_lookups - cache_budget->last_number_of_grain_lookups )
+	                  + ( number_of_grain_group_lookups - cache_budget->last_number_of_grain_group_lookups );
+
+	if( number_of_lookups < LIBVMDK_CACHE_BUDGET_BALANCE_INTERVAL )
+	{
+		return( 0 );
+	}
+	number_of_grain_misses       = number_of_grain_reads - cache_budget->last_number_of_grain_reads;
+	number_of_grain_group_misses = number_of_grain_group_reads - cache_budget->last_number_of_grain_group_reads;
+
+	cache_budget->last_number_of_grain_lookups       = number_of_grain_lookups;
+	cache_budget->last_number_of_grain_reads         = number_of_grain_reads;
+	cache_budget->last_number_of_grain_group_lookups = number_of_grain_group_lookups;
+	cache_budget->last_number_of_grain_group_reads   = number_of_grain_group_reads;
+
+	if( cache_budget->maximum_size == 0 )
+	{
+		return( 0 );
+	}
+	grain_misses_cost       = number_of_grain_misses * cache_budget->grain_entry_size;
+	grain_group_misses_cost = number_of_grain_group_misses * cache_budget->grain_group_entry_size;
+
+	grains_share = cache_budget->grains_share;
+
+	if( ( grain_misses_cost > ( 2 * grain_group_misses_cost ) )
+	 && ( grains_share < ( LIBVMDK_CACHE_BUDGET_NUMBER_OF_SHARES - 1 ) ) )
+	{
+		if( cache_budget->pending_share_move < 0 )
+		{
+			cache_budget->pending_share_move = 0;
+		}
+		cache_budget->pending_share_move += 1;
+	}
+	else if( ( grain_group_misses_cost > ( 2 * grain_misses_cost ) )
+	      && ( grains_share > 1 ) )
+	{
+		if( cache_budget->pending_share_move > 0 )
+		{
+			cache_budget->pending_share_move = 0;
+		}
+		cache_budget->pending_share_move -= 1;
+	}
+	else
+	{
+		cache_budget->pending_share_move = 0;
+	}
+	if( cache_budget->pending_share_move >= LIBVMDK_CACHE_BUDGET_BALANCE_HYSTERESIS )
+	{
+		grains_share += 1;
+	}
+	else if( cache_budget->pending_share_move <= -LIBVMDK_CACHE_BUDGET_BALANCE_HYSTERESIS )
+	{
+		grains_share -= 1;
+	}
+	else
+	{
+		return( 0 );
+	}
+	cache_budget->pending_share_move = 0;
+	number_of_grains_cache_entries       = cache_budget->number_of_grains_cache_entries;
+	number_of_grain_groups_cache_entries = cache_budget->number_of_grain_groups_cache_entries;
+
+	cache_budget->grains_share = grains_share;
+
+	if( libvmdk_cache_budget_calculate_number_of_cache_entries(
+	     cache_budget,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate number of cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_grains_cache_entries == cache_budget->number_of_grains_cache_entries )
+	 && ( number_of_grain_groups_cache_entries == cache_budget->number_of_grain_groups_cache_entries ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the (memory) sizes of the grain groups and grains caches
+ * The size of the grain groups caches is the total of the grain groups caches of the cached extent files
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_cache_budget_get_cache_sizes(
+     libvmdk_cache_budget_t *cache_budget,
+     size64_t *grain_groups_cache_size,
+     size64_t *grains_cache_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_cache_budget_get_cache_sizes";
+
+	if( cache_budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache budget.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_groups_cache_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain groups cache size.",
+		 function );
+
+		return( -1 );
+	}
+	if( grains_cache_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grains cache size.",
+		 function );
+
+		return( -1 );
+	}
+	*grain_groups_cache_size = (size64_t) cache_budget->number_of_grain_groups_cache_entries
+	                         * cache_budget->grain_group_entry_size
+	                         * (size64_t) cache_budget->number_of_grain_groups_caches;
+
+	*grains_cache_size = (size64_t) cache_budget->number_of_grains_cache_entries
+	                   * cache_budget->grain_entry_size;
+
+	return( 1 );
+}
+
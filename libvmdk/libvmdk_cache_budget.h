@@ -0,0 +1,132 @@
+/*
+ * Cache memory budget functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_CACHE_BUDGET_H )
+#define _LIBVMDK_CACHE_BUDGET_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvmdk_cache_budget libvmdk_cache_budget_t;
+
+struct libvmdk_cache_budget
+{
+	/* The maximum (cache memory) size or 0 if not set
+	 */
+	size64_t maximum_size;
+
+	/* The size of a grains cache entry
+	 */
+	size64_t grain_entry_size;
+
+	/* The size of a grain groups cache entry
+	 */
+	size64_t grain_group_entry_size;
+
+	/* The number of grain groups caches, one per cached extent file
+	 */
+	int number_of_grain_groups_caches;
+
+	/* The number of shares of the budget used by the grains cache
+	 * The grain groups caches use the remaining shares
+	 */
+	int grains_share;
+
+	/* The number of consecutive balance intervals that favoured moving a share
+	 * Positive towards the grains cache, negative towards the grain groups caches
+	 */
+	int pending_share_move;
+
+	/* The number of grain lookups at the last balance
+	 */
+	uint64_t last_number_of_grain_lookups;
+
+	/* The number of grain reads at the last balance
+	 */
+	uint64_t last_number_of_grain_reads;
+
+	/* The number of grain group lookups at the last balance
+	 */
+	uint64_t last_number_of_grain_group_lookups;
+
+	/* The number of grain group reads at the last balance
+	 */
+	uint64_t last_number_of_grain_group_reads;
+
+	/* The number of grains cache entries
+	 */
+	int number_of_grains_cache_entries;
+
+	/* The number of entries of each grain groups cache
+	 */
+	int number_of_grain_groups_cache_entries;
+};
+
+int libvmdk_cache_budget_initialize(
+     libvmdk_cache_budget_t **cache_budget,
+     libcerror_error_t **error );
+
+int libvmdk_cache_budget_free(
+     libvmdk_cache_budget_t **cache_budget,
+     libcerror_error_t **error );
+
+int libvmdk_cache_budget_calculate_number_of_cache_entries(
+     libvmdk_cache_budget_t *cache_budget,
+     libcerror_error_t **error );
+
+int libvmdk_cache_budget_set_maximum_size(
+     libvmdk_cache_budget_t *cache_budget,
+     size64_t maximum_size,
+     libcerror_error_t **error );
+
+int libvmdk_cache_budget_set_entry_sizes(
+     libvmdk_cache_budget_t *cache_budget,
+     size64_t grain_entry_size,
+     size64_t grain_group_entry_size,
+     int number_of_grain_groups_caches,
+     libcerror_error_t **error );
+
+int libvmdk_cache_budget_balance(
+     libvmdk_cache_budget_t *cache_budget,
+     uint64_t number_of_grain_lookups,
+     uint64_t number_of_grain_reads,
+     uint64_t number_of_grain_group_lookups,
+     uint64_t number_of_grain_group_reads,
+     libcerror_error_t **error );
+
+int libvmdk_cache_budget_get_cache_sizes(
+     libvmdk_cache_budget_t *cache_budget,
+     size64_t *grain_groups_cache_size,
+     size64_t *grains_cache_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_CACHE_BUDGET_H ) */
+
@@ -20,12 +20,15 @@
  */
 
 #include <common.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
 #include <stdlib.h>
 #endif
 
+#include <time.h>
+
 #if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
 #include <zlib.h>
 #endif
@@ -35,166 +38,641 @@
 #include "libvmdk_deflate.h"
 #include "libvmdk_libcerror.h"
 #include "libvmdk_libcnotify.h"
+#include "libvmdk_unused.h"
 
-/* Decompresses data using the compression method
- * Returns 1 on success, 0 on failure or -1 on error
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+#define LIBVMDK_DECOMPRESSION_BACKEND_DEFAULT	LIBVMDK_DECOMPRESSION_BACKEND_ZLIB
+#else
+#define LIBVMDK_DECOMPRESSION_BACKEND_DEFAULT	LIBVMDK_DECOMPRESSION_BACKEND_BUILTIN
+#endif
+
+/* The size of the data and the number of iterations used to compare the decompression backends
  */
-int libvmdk_decompress_data(
+#define LIBVMDK_DECOMPRESSION_SELECT_BACKEND_DATA_SIZE			65536
+#define LIBVMDK_DECOMPRESSION_SELECT_BACKEND_NUMBER_OF_ITERATIONS	16
+
+/* The decompression backend used to decompress deflate compressed data
+ * The backend is process-wide and only changed by the set functions
+ */
+int libvmdk_decompression_backend = LIBVMDK_DECOMPRESSION_BACKEND_DEFAULT;
+
+/* The user defined decompression function and its user data
+ */
+int (*libvmdk_decompression_function)(
      const uint8_t *compressed_data,
      size_t compressed_data_size,
-     uint16_t compression_method,
      uint8_t *uncompressed_data,
      size_t *uncompressed_data_size,
+     void *user_data ) = NULL;
+
+void *libvmdk_decompression_function_user_data = NULL;
+
+#if !defined( HAVE_LOCAL_LIBVMDK )
+
+/* Retrieves the decompression backend
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_get_decompression_backend(
+     int *backend,
      libcerror_error_t **error )
 {
-	static char *function              = "libvmdk_decompress_data";
-	int result                         = 0;
+	static char *function = "libvmdk_get_decompression_backend";
 
-#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
-	uLongf zlib_uncompressed_data_size = 0;
-#endif
-
-	if( compressed_data == NULL )
+	if( backend == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid compressed data buffer.",
+		 "%s: invalid backend.",
 		 function );
 
 		return( -1 );
 	}
-	if( uncompressed_data == NULL )
+	*backend = libvmdk_decompression_backend;
+
+	return( 1 );
+}
+
+/* Sets the decompression backend
+ * The default backend is zlib if available, otherwise the builtin backend
+ * LIBVMDK_DECOMPRESSION_BACKEND_AUTO_DETECT selects the fastest available backend,
+ * which is only done when explicitly requested by this function
+ * The backend is shared by all handles in the process, this function is not thread-safe
+ * and must be called before any handle is used from multiple threads
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_set_decompression_backend(
+     int backend,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_set_decompression_backend";
+
+	if( backend == LIBVMDK_DECOMPRESSION_BACKEND_AUTO_DETECT )
+	{
+		if( libvmdk_decompression_select_backend(
+		     &backend,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to select decompression backend.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+	else if( ( backend != LIBVMDK_DECOMPRESSION_BACKEND_BUILTIN )
+	      && ( backend != LIBVMDK_DECOMPRESSION_BACKEND_ZLIB ) )
+#else
+	else if( backend != LIBVMDK_DECOMPRESSION_BACKEND_BUILTIN )
+#endif
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid uncompressed data buffer.",
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported backend.",
 		 function );
 
 		return( -1 );
 	}
-	if( uncompressed_data == compressed_data )
+	libvmdk_decompression_backend             = backend;
+	libvmdk_decompression_function            = NULL;
+	libvmdk_decompression_function_user_data = NULL;
+
+	return( 1 );
+}
+
+/* Sets a user defined function to decompress deflate (zlib) compressed data
+ * The function should return 1 if successful or -1 on error
+ * On input uncompressed_data_size contains the size of the uncompressed data buffer
+ * and on output the size of the uncompressed data
+ * A decompression function of NULL restores the default backend
+ * The function is shared by all handles in the process, this function is not thread-safe
+ * and must be called before any handle is used from multiple threads
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_set_decompression_function(
+     int (*decompression_function)(
+            const uint8_t *compressed_data,
+            size_t compressed_data_size,
+            uint8_t *uncompressed_data,
+            size_t *uncompressed_data_size,
+            void *user_data ),
+     void *user_data,
+     libcerror_error_t **error )
+{
+	LIBVMDK_UNREFERENCED_PARAMETER( error )
+
+	if( decompression_function == NULL )
+	{
+		libvmdk_decompression_backend             = LIBVMDK_DECOMPRESSION_BACKEND_DEFAULT;
+		libvmdk_decompression_function_user_data = NULL;
+	}
+	else
+	{
+		libvmdk_decompression_backend             = LIBVMDK_DECOMPRESSION_BACKEND_USER_DEFINED;
+		libvmdk_decompression_function_user_data = user_data;
+	}
+	libvmdk_decompression_function = decompression_function;
+
+	return( 1 );
+}
+
+#endif /* !defined( HAVE_LOCAL_LIBVMDK ) */
+
+/* Selects the fastest available decompression backend
+ * The backends are compared by decompressing generated test data
+ * This is only done on request of libvmdk_set_decompression_backend
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_decompression_select_backend(
+     int *backend,
+     libcerror_error_t **error )
+{
+	static char *function            = "libvmdk_decompression_select_backend";
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+	uint8_t *compressed_data         = NULL;
+	uint8_t *data                    = NULL;
+	uint8_t *uncompressed_data       = NULL;
+	clock_t builtin_time             = 0;
+	clock_t start_time               = 0;
+	clock_t zlib_time                = 0;
+	uLongf zlib_compressed_data_size = 0;
+	uLongf zlib_data_size            = 0;
+	size_t data_offset               = 0;
+	size_t uncompressed_data_size    = 0;
+	uint32_t random_value            = 1;
+	int iteration                    = 0;
+	int result                       = 0;
+#endif
+
+	if( backend == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid compressed data buffer equals uncompressed data buffer.",
+		 "%s: invalid backend.",
 		 function );
 
 		return( -1 );
 	}
-	if( uncompressed_data_size == NULL )
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * LIBVMDK_DECOMPRESSION_SELECT_BACKEND_DATA_SIZE );
+
+	if( data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid uncompressed data size.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
 		 function );
 
-		return( -1 );
+		goto on_error;
+	}
+	uncompressed_data = (uint8_t *) memory_allocate(
+	                                 sizeof( uint8_t ) * LIBVMDK_DECOMPRESSION_SELECT_BACKEND_DATA_SIZE );
+
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create uncompressed data.",
+		 function );
+
+		goto on_error;
 	}
-	if( compression_method == LIBVMDK_COMPRESSION_METHOD_DEFLATE )
+	zlib_compressed_data_size = (uLongf) ( 2 * LIBVMDK_DECOMPRESSION_SELECT_BACKEND_DATA_SIZE );
+
+	compressed_data = (uint8_t *) memory_allocate(
+	                               sizeof( uint8_t ) * (size_t) zlib_compressed_data_size );
+
+	if( compressed_data == NULL )
 	{
-#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
-		if( compressed_data_size > (size_t) ULONG_MAX )
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compressed data.",
+		 function );
+
+		goto on_error;
+	}
+	/* Generate data that contains literals, short and long matches, similar to a grain of a file system
+	 */
+	while( data_offset < LIBVMDK_DECOMPRESSION_SELECT_BACKEND_DATA_SIZE )
+	{
+		random_value = ( random_value * 1103515245UL ) + 12345;
+
+		if( ( random_value & 0x00030000UL ) == 0 )
+		{
+			data[ data_offset++ ] = 0;
+		}
+		else if( ( data_offset >= 256 )
+		      && ( ( random_value & 0x00040000UL ) != 0 ) )
+		{
+			data[ data_offset ] = data[ data_offset - 1 - ( ( random_value >> 8 ) & 0xff ) ];
+
+			data_offset++;
+		}
+		else
+		{
+			data[ data_offset++ ] = (uint8_t) ( 'a' + ( ( random_value >> 19 ) % 26 ) );
+		}
+	}
+	result = compress2(
+	          (Bytef *) compressed_data,
+	          &zlib_compressed_data_size,
+	          (Bytef *) data,
+	          (uLong) LIBVMDK_DECOMPRESSION_SELECT_BACKEND_DATA_SIZE,
+	          Z_DEFAULT_COMPRESSION );
+
+	if( result != Z_OK )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: unable to compress data.",
+		 function );
+
+		goto on_error;
+	}
+	start_time = clock();
+
+	for( iteration = 0;
+	     iteration < LIBVMDK_DECOMPRESSION_SELECT_BACKEND_NUMBER_OF_ITERATIONS;
+	     iteration++ )
+	{
+		zlib_data_size = (uLongf) LIBVMDK_DECOMPRESSION_SELECT_BACKEND_DATA_SIZE;
+
+		if( uncompress(
+		     (Bytef *) uncompressed_data,
+		     &zlib_data_size,
+		     (Bytef *) compressed_data,
+		     (uLong) zlib_compressed_data_size ) != Z_OK )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-			 "%s: invalid compressed data size value exceeds maximum.",
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress data using zlib.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( *uncompressed_data_size > (size_t) ULONG_MAX )
+	}
+	zlib_time  = clock() - start_time;
+	start_time = clock();
+
+	for( iteration = 0;
+	     iteration < LIBVMDK_DECOMPRESSION_SELECT_BACKEND_NUMBER_OF_ITERATIONS;
+	     iteration++ )
+	{
+		uncompressed_data_size = LIBVMDK_DECOMPRESSION_SELECT_BACKEND_DATA_SIZE;
+
+		if( libvmdk_deflate_decompress_zlib(
+		     compressed_data,
+		     (size_t) zlib_compressed_data_size,
+		     uncompressed_data,
+		     &uncompressed_data_size,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-			 "%s: invalid uncompressed data size value exceeds maximum.",
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress data using built-in deflate.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		zlib_uncompressed_data_size = (uLongf) *uncompressed_data_size;
+	}
+	builtin_time = clock() - start_time;
 
-		result = uncompress(
-			  (Bytef *) uncompressed_data,
-			  &zlib_uncompressed_data_size,
-			  (Bytef *) compressed_data,
-			  (uLong) compressed_data_size );
+	memory_free(
+	 compressed_data );
 
-		if( result == Z_OK )
-		{
-			*uncompressed_data_size = (size_t) zlib_uncompressed_data_size;
+	memory_free(
+	 uncompressed_data );
+
+	memory_free(
+	 data );
 
-			result = 1;
-		}
-		else if( result == Z_DATA_ERROR )
-		{
 #if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: unable to read compressed data: data error.\n",
-				 function );
-			}
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: zlib time\t\t\t: %ld\n",
+		 function,
+		 (long) zlib_time );
+
+		libcnotify_printf(
+		 "%s: built-in time\t\t: %ld\n",
+		 function,
+		 (long) builtin_time );
+
+		libcnotify_printf(
+		 "\n" );
+	}
 #endif
-			*uncompressed_data_size = 0;
+	if( builtin_time < zlib_time )
+	{
+		*backend = LIBVMDK_DECOMPRESSION_BACKEND_BUILTIN;
+	}
+	else
+	{
+		*backend = LIBVMDK_DECOMPRESSION_BACKEND_ZLIB;
+	}
+	return( 1 );
 
-			result = -1;
-		}
-		else if( result == Z_BUF_ERROR )
-		{
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				"%s: unable to read compressed data: target buffer too small.\n",
-				 function );
-			}
+on_error:
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+#else
+	/* Without a zlib compress function there is no data to compare the backends
+	 */
+	*backend = LIBVMDK_DECOMPRESSION_BACKEND_DEFAULT;
+
+	return( 1 );
 #endif
-			/* Estimate that a factor 2 enlargement should suffice
-			 */
-			*uncompressed_data_size *= 2;
+}
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+
+/* Decompresses data using zlib
+ * Returns 1 on success, 0 on failure or -1 on error
+ */
+int libvmdk_decompress_data_using_zlib(
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function              = "libvmdk_decompress_data_using_zlib";
+	uLongf zlib_uncompressed_data_size = 0;
+	int result                         = 0;
+
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer.",
+		 function );
 
-			result = 0;
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size > (size_t) ULONG_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( *uncompressed_data_size > (size_t) ULONG_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid uncompressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	zlib_uncompressed_data_size = (uLongf) *uncompressed_data_size;
+
+	result = uncompress(
+		  (Bytef *) uncompressed_data,
+		  &zlib_uncompressed_data_size,
+		  (Bytef *) compressed_data,
+		  (uLong) compressed_data_size );
+
+	if( result == Z_OK )
+	{
+		*uncompressed_data_size = (size_t) zlib_uncompressed_data_size;
+
+		result = 1;
+	}
+	else if( result == Z_DATA_ERROR )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to read compressed data: data error.\n",
+			 function );
 		}
-		else if( result == Z_MEM_ERROR )
+#endif
+		*uncompressed_data_size = 0;
+
+		result = -1;
+	}
+	else if( result == Z_BUF_ERROR )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to read compressed data: insufficient memory.",
+			libcnotify_printf(
+			"%s: unable to read compressed data: target buffer too small.\n",
 			 function );
+		}
+#endif
+		/* Estimate that a factor 2 enlargement should suffice
+		 */
+		*uncompressed_data_size *= 2;
+
+		result = 0;
+	}
+	else if( result == Z_MEM_ERROR )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to read compressed data: insufficient memory.",
+		 function );
 
-			*uncompressed_data_size = 0;
+		*uncompressed_data_size = 0;
 
-			result = -1;
-		}
-		else
+		result = -1;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: zlib returned undefined error: %d.",
+		 function,
+		 result );
+
+		*uncompressed_data_size = 0;
+
+		result = -1;
+	}
+	return( result );
+}
+
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL ) */
+
+/* Decompresses data using the compression method
+ * Returns 1 on success, 0 on failure or -1 on error
+ */
+int libvmdk_decompress_data(
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint16_t compression_method,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_decompress_data";
+	int result            = 0;
+
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == compressed_data )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer equals uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_method != LIBVMDK_COMPRESSION_METHOD_DEFLATE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression method.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( libvmdk_decompression_backend == LIBVMDK_DECOMPRESSION_BACKEND_USER_DEFINED )
+	 && ( libvmdk_decompression_function != NULL ) )
+	{
+		result = libvmdk_decompression_function(
+		          compressed_data,
+		          compressed_data_size,
+		          uncompressed_data,
+		          uncompressed_data_size,
+		          libvmdk_decompression_function_user_data );
+
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
 			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
-			 "%s: zlib returned undefined error: %d.",
-			 function,
-			 result );
-
-			*uncompressed_data_size = 0;
+			 "%s: unable to decompress deflate compressed data using user defined function.",
+			 function );
 
-			result = -1;
+			return( -1 );
 		}
-#else
+	}
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+	else if( libvmdk_decompression_backend == LIBVMDK_DECOMPRESSION_BACKEND_ZLIB )
+	{
+		result = libvmdk_decompress_data_using_zlib(
+		          compressed_data,
+		          compressed_data_size,
+		          uncompressed_data,
+		          uncompressed_data_size,
+		          error );
+	}
+#endif
+	else
+	{
 		result = libvmdk_deflate_decompress_zlib(
 		          compressed_data,
 		          compressed_data_size,
@@ -213,19 +691,6 @@ int libvmdk_decompress_data(
 
 			return( -1 );
 		}
-#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL ) */
-	}
-	else
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported compression method.",
-		 function );
-
-		return( -1 );
 	}
 	return( result );
 }
-
@@ -25,12 +25,53 @@
 #include <common.h>
 #include <types.h>
 
+#include "libvmdk_extern.h"
 #include "libvmdk_libcerror.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+#if !defined( HAVE_LOCAL_LIBVMDK )
+
+LIBVMDK_EXTERN \
+int libvmdk_get_decompression_backend(
+     int *backend,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_set_decompression_backend(
+     int backend,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_set_decompression_function(
+     int (*decompression_function)(
+            const uint8_t *compressed_data,
+            size_t compressed_data_size,
+            uint8_t *uncompressed_data,
+            size_t *uncompressed_data_size,
+            void *user_data ),
+     void *user_data,
+     libcerror_error_t **error );
+
+#endif /* !defined( HAVE_LOCAL_LIBVMDK ) */
+
+int libvmdk_decompression_select_backend(
+     int *backend,
+     libcerror_error_t **error );
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+
+int libvmdk_decompress_data_using_zlib(
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error );
+
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL ) */
+
 int libvmdk_decompress_data(
      const uint8_t *compressed_data,
      size_t compressed_data_size,
@@ -30,6 +30,13 @@
 #include "libvmdk_libcerror.h"
 #include "libvmdk_libcnotify.h"
 
+#if defined( LIBVMDK_DEFLATE_HAVE_X86_SIMD )
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+#include <immintrin.h>
+#endif
+
 const uint8_t libvmdk_deflate_code_sizes_sequence[ 19 ]  = {
 	16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2,
         14, 1, 15 };
@@ -51,6 +58,115 @@ const uint16_t libvmdk_deflate_distance_codes_number_of_extra_bits[ 30 ] = {
 	0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
 	7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
 
+/* The lookup tables of the fixed Huffman trees, these are equivalent to
+ * the lookup tables built by libvmdk_deflate_build_fixed_huffman_trees
+ */
+const uint32_t libvmdk_deflate_fixed_huffman_literals_lookup_table[ 512 ] = {
+	0x00010007UL, 0x00005008UL, 0x00001008UL, 0x00011808UL, 0x00011007UL, 0x00007008UL,
+	0x00003008UL, 0x0000c009UL, 0x00010807UL, 0x00006008UL, 0x00002008UL, 0x0000a009UL,
+	0x00000008UL, 0x00008008UL, 0x00004008UL, 0x0000e009UL, 0x00010407UL, 0x00005808UL,
+	0x00001808UL, 0x00009009UL, 0x00011407UL, 0x00007808UL, 0x00003808UL, 0x0000d009UL,
+	0x00010c07UL, 0x00006808UL, 0x00002808UL, 0x0000b009UL, 0x00000808UL, 0x00008808UL,
+	0x00004808UL, 0x0000f009UL, 0x00010207UL, 0x00005408UL, 0x00001408UL, 0x00011c08UL,
+	0x00011207UL, 0x00007408UL, 0x00003408UL, 0x0000c809UL, 0x00010a07UL, 0x00006408UL,
+	0x00002408UL, 0x0000a809UL, 0x00000408UL, 0x00008408UL, 0x00004408UL, 0x0000e809UL,
+	0x00010607UL, 0x00005c08UL, 0x00001c08UL, 0x00009809UL, 0x00011607UL, 0x00007c08UL,
+	0x00003c08UL, 0x0000d809UL, 0x00010e07UL, 0x00006c08UL, 0x00002c08UL, 0x0000b809UL,
+	0x00000c08UL, 0x00008c08UL, 0x00004c08UL, 0x0000f809UL, 0x00010107UL, 0x00005208UL,
+	0x00001208UL, 0x00011a08UL, 0x00011107UL, 0x00007208UL, 0x00003208UL, 0x0000c409UL,
+	0x00010907UL, 0x00006208UL, 0x00002208UL, 0x0000a409UL, 0x00000208UL, 0x00008208UL,
+	0x00004208UL, 0x0000e409UL, 0x00010507UL, 0x00005a08UL, 0x00001a08UL, 0x00009409UL,
+	0x00011507UL, 0x00007a08UL, 0x00003a08UL, 0x0000d409UL, 0x00010d07UL, 0x00006a08UL,
+	0x00002a08UL, 0x0000b409UL, 0x00000a08UL, 0x00008a08UL, 0x00004a08UL, 0x0000f409UL,
+	0x00010307UL, 0x00005608UL, 0x00001608UL, 0x00011e08UL, 0x00011307UL, 0x00007608UL,
+	0x00003608UL, 0x0000cc09UL, 0x00010b07UL, 0x00006608UL, 0x00002608UL, 0x0000ac09UL,
+	0x00000608UL, 0x00008608UL, 0x00004608UL, 0x0000ec09UL, 0x00010707UL, 0x00005e08UL,
+	0x00001e08UL, 0x00009c09UL, 0x00011707UL, 0x00007e08UL, 0x00003e08UL, 0x0000dc09UL,
+	0x00010f07UL, 0x00006e08UL, 0x00002e08UL, 0x0000bc09UL, 0x00000e08UL, 0x00008e08UL,
+	0x00004e08UL, 0x0000fc09UL, 0x00010007UL, 0x00005108UL, 0x00001108UL, 0x00011908UL,
+	0x00011007UL, 0x00007108UL, 0x00003108UL, 0x0000c209UL, 0x00010807UL, 0x00006108UL,
+	0x00002108UL, 0x0000a209UL, 0x00000108UL, 0x00008108UL, 0x00004108UL, 0x0000e209UL,
+	0x00010407UL, 0x00005908UL, 0x00001908UL, 0x00009209UL, 0x00011407UL, 0x00007908UL,
+	0x00003908UL, 0x0000d209UL, 0x00010c07UL, 0x00006908UL, 0x00002908UL, 0x0000b209UL,
+	0x00000908UL, 0x00008908UL, 0x00004908UL, 0x0000f209UL, 0x00010207UL, 0x00005508UL,
+	0x00001508UL, 0x00011d08UL, 0x00011207UL, 0x00007508UL, 0x00003508UL, 0x0000ca09UL,
+	0x00010a07UL, 0x00006508UL, 0x00002508UL, 0x0000aa09UL, 0x00000508UL, 0x00008508UL,
+	0x00004508UL, 0x0000ea09UL, 0x00010607UL, 0x00005d08UL, 0x00001d08UL, 0x00009a09UL,
+	0x00011607UL, 0x00007d08UL, 0x00003d08UL, 0x0000da09UL, 0x00010e07UL, 0x00006d08UL,
+	0x00002d08UL, 0x0000ba09UL, 0x00000d08UL, 0x00008d08UL, 0x00004d08UL, 0x0000fa09UL,
+	0x00010107UL, 0x00005308UL, 0x00001308UL, 0x00011b08UL, 0x00011107UL, 0x00007308UL,
+	0x00003308UL, 0x0000c609UL, 0x00010907UL, 0x00006308UL, 0x00002308UL, 0x0000a609UL,
+	0x00000308UL, 0x00008308UL, 0x00004308UL, 0x0000e609UL, 0x00010507UL, 0x00005b08UL,
+	0x00001b08UL, 0x00009609UL, 0x00011507UL, 0x00007b08UL, 0x00003b08UL, 0x0000d609UL,
+	0x00010d07UL, 0x00006b08UL, 0x00002b08UL, 0x0000b609UL, 0x00000b08UL, 0x00008b08UL,
+	0x00004b08UL, 0x0000f609UL, 0x00010307UL, 0x00005708UL, 0x00001708UL, 0x00011f08UL,
+	0x00011307UL, 0x00007708UL, 0x00003708UL, 0x0000ce09UL, 0x00010b07UL, 0x00006708UL,
+	0x00002708UL, 0x0000ae09UL, 0x00000708UL, 0x00008708UL, 0x00004708UL, 0x0000ee09UL,
+	0x00010707UL, 0x00005f08UL, 0x00001f08UL, 0x00009e09UL, 0x00011707UL, 0x00007f08UL,
+	0x00003f08UL, 0x0000de09UL, 0x00010f07UL, 0x00006f08UL, 0x00002f08UL, 0x0000be09UL,
+	0x00000f08UL, 0x00008f08UL, 0x00004f08UL, 0x0000fe09UL, 0x00010007UL, 0x00005008UL,
+	0x00001008UL, 0x00011808UL, 0x00011007UL, 0x00007008UL, 0x00003008UL, 0x0000c109UL,
+	0x00010807UL, 0x00006008UL, 0x00002008UL, 0x0000a109UL, 0x00000008UL, 0x00008008UL,
+	0x00004008UL, 0x0000e109UL, 0x00010407UL, 0x00005808UL, 0x00001808UL, 0x00009109UL,
+	0x00011407UL, 0x00007808UL, 0x00003808UL, 0x0000d109UL, 0x00010c07UL, 0x00006808UL,
+	0x00002808UL, 0x0000b109UL, 0x00000808UL, 0x00008808UL, 0x00004808UL, 0x0000f109UL,
+	0x00010207UL, 0x00005408UL, 0x00001408UL, 0x00011c08UL, 0x00011207UL, 0x00007408UL,
+	0x00003408UL, 0x0000c909UL, 0x00010a07UL, 0x00006408UL, 0x00002408UL, 0x0000a909UL,
+	0x00000408UL, 0x00008408UL, 0x00004408UL, 0x0000e909UL, 0x00010607UL, 0x00005c08UL,
+	0x00001c08UL, 0x00009909UL, 0x00011607UL, 0x00007c08UL, 0x00003c08UL, 0x0000d909UL,
+	0x00010e07UL, 0x00006c08UL, 0x00002c08UL, 0x0000b909UL, 0x00000c08UL, 0x00008c08UL,
+	0x00004c08UL, 0x0000f909UL, 0x00010107UL, 0x00005208UL, 0x00001208UL, 0x00011a08UL,
+	0x00011107UL, 0x00007208UL, 0x00003208UL, 0x0000c509UL, 0x00010907UL, 0x00006208UL,
+	0x00002208UL, 0x0000a509UL, 0x00000208UL, 0x00008208UL, 0x00004208UL, 0x0000e509UL,
+	0x00010507UL, 0x00005a08UL, 0x00001a08UL, 0x00009509UL, 0x00011507UL, 0x00007a08UL,
+	0x00003a08UL, 0x0000d509UL, 0x00010d07UL, 0x00006a08UL, 0x00002a08UL, 0x0000b509UL,
+	0x00000a08UL, 0x00008a08UL, 0x00004a08UL, 0x0000f509UL, 0x00010307UL, 0x00005608UL,
+	0x00001608UL, 0x00011e08UL, 0x00011307UL, 0x00007608UL, 0x00003608UL, 0x0000cd09UL,
+	0x00010b07UL, 0x00006608UL, 0x00002608UL, 0x0000ad09UL, 0x00000608UL, 0x00008608UL,
+	0x00004608UL, 0x0000ed09UL, 0x00010707UL, 0x00005e08UL, 0x00001e08UL, 0x00009d09UL,
+	0x00011707UL, 0x00007e08UL, 0x00003e08UL, 0x0000dd09UL, 0x00010f07UL, 0x00006e08UL,
+	0x00002e08UL, 0x0000bd09UL, 0x00000e08UL, 0x00008e08UL, 0x00004e08UL, 0x0000fd09UL,
+	0x00010007UL, 0x00005108UL, 0x00001108UL, 0x00011908UL, 0x00011007UL, 0x00007108UL,
+	0x00003108UL, 0x0000c309UL, 0x00010807UL, 0x00006108UL, 0x00002108UL, 0x0000a309UL,
+	0x00000108UL, 0x00008108UL, 0x00004108UL, 0x0000e309UL, 0x00010407UL, 0x00005908UL,
+	0x00001908UL, 0x00009309UL, 0x00011407UL, 0x00007908UL, 0x00003908UL, 0x0000d309UL,
+	0x00010c07UL, 0x00006908UL, 0x00002908UL, 0x0000b309UL, 0x00000908UL, 0x00008908UL,
+	0x00004908UL, 0x0000f309UL, 0x00010207UL, 0x00005508UL, 0x00001508UL, 0x00011d08UL,
+	0x00011207UL, 0x00007508UL, 0x00003508UL, 0x0000cb09UL, 0x00010a07UL, 0x00006508UL,
+	0x00002508UL, 0x0000ab09UL, 0x00000508UL, 0x00008508UL, 0x00004508UL, 0x0000eb09UL,
+	0x00010607UL, 0x00005d08UL, 0x00001d08UL, 0x00009b09UL, 0x00011607UL, 0x00007d08UL,
+	0x00003d08UL, 0x0000db09UL, 0x00010e07UL, 0x00006d08UL, 0x00002d08UL, 0x0000bb09UL,
+	0x00000d08UL, 0x00008d08UL, 0x00004d08UL, 0x0000fb09UL, 0x00010107UL, 0x00005308UL,
+	0x00001308UL, 0x00011b08UL, 0x00011107UL, 0x00007308UL, 0x00003308UL, 0x0000c709UL,
+	0x00010907UL, 0x00006308UL, 0x00002308UL, 0x0000a709UL, 0x00000308UL, 0x00008308UL,
+	0x00004308UL, 0x0000e709UL, 0x00010507UL, 0x00005b08UL, 0x00001b08UL, 0x00009709UL,
+	0x00011507UL, 0x00007b08UL, 0x00003b08UL, 0x0000d709UL, 0x00010d07UL, 0x00006b08UL,
+	0x00002b08UL, 0x0000b709UL, 0x00000b08UL, 0x00008b08UL, 0x00004b08UL, 0x0000f709UL,
+	0x00010307UL, 0x00005708UL, 0x00001708UL, 0x00011f08UL, 0x00011307UL, 0x00007708UL,
+	0x00003708UL, 0x0000cf09UL, 0x00010b07UL, 0x00006708UL, 0x00002708UL, 0x0000af09UL,
+	0x00000708UL, 0x00008708UL, 0x00004708UL, 0x0000ef09UL, 0x00010707UL, 0x00005f08UL,
+	0x00001f08UL, 0x00009f09UL, 0x00011707UL, 0x00007f08UL, 0x00003f08UL, 0x0000df09UL,
+	0x00010f07UL, 0x00006f08UL, 0x00002f08UL, 0x0000bf09UL, 0x00000f08UL, 0x00008f08UL,
+	0x00004f08UL, 0x0000ff09UL
+};
+
+const uint32_t libvmdk_deflate_fixed_huffman_distances_lookup_table[ 32 ] = {
+	0x00000005UL, 0x00001005UL, 0x00000805UL, 0x00001805UL, 0x00000405UL, 0x00001405UL,
+	0x00000c05UL, 0x00001c05UL, 0x00000205UL, 0x00001205UL, 0x00000a05UL, 0x00001a05UL,
+	0x00000605UL, 0x00001605UL, 0x00000e05UL, 0x00000000UL, 0x00000105UL, 0x00001105UL,
+	0x00000905UL, 0x00001905UL, 0x00000505UL, 0x00001505UL, 0x00000d05UL, 0x00001d05UL,
+	0x00000305UL, 0x00001305UL, 0x00000b05UL, 0x00001b05UL, 0x00000705UL, 0x00001705UL,
+	0x00000f05UL, 0x00000000UL
+};
+
+/* The fixed Huffman trees are shared by all decompressions
+ */
+const libvmdk_huffman_tree_t libvmdk_deflate_fixed_huffman_literals_tree = {
+	9, NULL, NULL, 9, (uint32_t *) libvmdk_deflate_fixed_huffman_literals_lookup_table, 512 };
+
+const libvmdk_huffman_tree_t libvmdk_deflate_fixed_huffman_distances_tree = {
+	5, NULL, NULL, 5, (uint32_t *) libvmdk_deflate_fixed_huffman_distances_lookup_table, 32 };
+
 /* Initializes the dynamic Huffman trees
  * Returns 1 on success or -1 on error
  */
@@ -450,17 +566,19 @@ int libvmdk_deflate_build_fixed_huffman_trees(
  */
 int libvmdk_deflate_decode_huffman(
      libvmdk_bit_stream_t *bit_stream,
-     libvmdk_huffman_tree_t *literals_tree,
-     libvmdk_huffman_tree_t *distances_tree,
+     const libvmdk_huffman_tree_t *literals_tree,
+     const libvmdk_huffman_tree_t *distances_tree,
      uint8_t *uncompressed_data,
      size_t uncompressed_data_size,
      size_t *uncompressed_data_offset,
      libcerror_error_t **error )
 {
 	static char *function         = "libvmdk_deflate_decode_huffman";
+	const uint8_t *match_data     = NULL;
 	size_t data_offset            = 0;
 	uint32_t extra_bits           = 0;
 	uint16_t compression_offset   = 0;
+	uint16_t copy_size            = 0;
 	uint16_t compression_size     = 0;
 	uint16_t number_of_extra_bits = 0;
 	uint16_t symbol               = 0;
@@ -612,12 +730,90 @@ int libvmdk_deflate_decode_huffman(
 
 				return( -1 );
 			}
-			while( compression_size > 0 )
+			match_data = &( uncompressed_data[ data_offset - compression_offset ] );
+
+			if( compression_offset == 1 )
 			{
-				uncompressed_data[ data_offset ] = uncompressed_data[ data_offset - compression_offset ];
+				/* A distance of 1 repeats the last byte
+				 */
+				if( memory_set(
+				     &( uncompressed_data[ data_offset ] ),
+				     *match_data,
+				     (size_t) compression_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to set match data.",
+					 function );
 
-				data_offset++;
-				compression_size--;
+					return( -1 );
+				}
+				data_offset += compression_size;
+			}
+			else if( compression_offset >= 8 )
+			{
+				/* The source and destination of an 8-byte copy do not overlap
+				 */
+				while( compression_size >= 8 )
+				{
+					if( memory_copy(
+					     &( uncompressed_data[ data_offset ] ),
+					     match_data,
+					     8 ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+						 "%s: unable to copy match data.",
+						 function );
+
+						return( -1 );
+					}
+					match_data       += 8;
+					data_offset      += 8;
+					compression_size -= 8;
+				}
+				while( compression_size > 0 )
+				{
+					uncompressed_data[ data_offset++ ] = *match_data;
+
+					match_data++;
+					compression_size--;
+				}
+			}
+			else
+			{
+				/* The data from the start of the match up to the current offset
+				 * is a repeating pattern, hence every copy can double in size
+				 */
+				while( compression_size > 0 )
+				{
+					copy_size = (uint16_t) ( &( uncompressed_data[ data_offset ] ) - match_data );
+
+					if( copy_size > compression_size )
+					{
+						copy_size = compression_size;
+					}
+					if( memory_copy(
+					     &( uncompressed_data[ data_offset ] ),
+					     match_data,
+					     (size_t) copy_size ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+						 "%s: unable to copy match data.",
+						 function );
+
+						return( -1 );
+					}
+					data_offset      += copy_size;
+					compression_size -= copy_size;
+				}
 			}
 		}
 		else if( symbol != 256 )
@@ -644,14 +840,14 @@ int libvmdk_deflate_decode_huffman(
  * It uses the initial value to calculate a new Adler-32
  * Returns 1 if successful or -1 on error
  */
-int libvmdk_deflate_calculate_adler32(
+int libvmdk_deflate_calculate_adler32_scalar(
      uint32_t *checksum_value,
      const uint8_t *data,
      size_t data_size,
      uint32_t initial_value,
      libcerror_error_t **error )
 {
-	static char *function = "libvmdk_deflate_calculate_adler32";
+	static char *function = "libvmdk_deflate_calculate_adler32_scalar";
 	size_t data_offset    = 0;
 	uint32_t lower_word   = 0;
 	uint32_t upper_word   = 0;
@@ -888,6 +1084,582 @@ int libvmdk_deflate_calculate_adler32(
 	return( 1 );
 }
 
+#if defined( LIBVMDK_DEFLATE_HAVE_X86_SIMD )
+
+/* The CPU features that can be used to calculate an Adler-32 checksum or -1 if not determined yet
+ * The value is shared by all decompression threads, hence it is accessed atomically
+ */
+static long libvmdk_deflate_cpu_features = -1;
+
+#if defined( _MSC_VER )
+#define libvmdk_deflate_cpu_features_get() \
+	_InterlockedCompareExchange( &libvmdk_deflate_cpu_features, -1, -1 )
+
+#define libvmdk_deflate_cpu_features_set( value ) \
+	_InterlockedExchange( &libvmdk_deflate_cpu_features, value )
+
+#else
+#define libvmdk_deflate_cpu_features_get() \
+	__atomic_load_n( &libvmdk_deflate_cpu_features, __ATOMIC_RELAXED )
+
+#define libvmdk_deflate_cpu_features_set( value ) \
+	__atomic_store_n( &libvmdk_deflate_cpu_features, value, __ATOMIC_RELAXED )
+
+#endif /* defined( _MSC_VER ) */
+
+/* Determines the CPU features that can be used to calculate an Adler-32 checksum
+ * Returns the CPU feature flags
+ */
+int libvmdk_deflate_get_cpu_features(
+     void )
+{
+	int cpu_features = 0;
+
+#if defined( _MSC_VER )
+	int cpu_information[ 4 ];
+	int maximum_function = 0;
+
+	__cpuid(
+	 cpu_information,
+	 0 );
+
+	maximum_function = cpu_information[ 0 ];
+
+	if( maximum_function >= 1 )
+	{
+		__cpuid(
+		 cpu_information,
+		 1 );
+
+		if( ( cpu_information[ 3 ] & 0x04000000UL ) != 0 )
+		{
+			cpu_features |= LIBVMDK_DEFLATE_CPU_FEATURE_SSE2;
+		}
+		if( ( cpu_information[ 2 ] & 0x00000200UL ) != 0 )
+		{
+			cpu_features |= LIBVMDK_DEFLATE_CPU_FEATURE_SSSE3;
+		}
+		/* AVX2 requires the operating system to save the YMM registers
+		 */
+		if( ( ( cpu_information[ 2 ] & 0x18000000UL ) == 0x18000000UL )
+		 && ( ( _xgetbv( 0 ) & 0x06 ) == 0x06 )
+		 && ( maximum_function >= 7 ) )
+		{
+			__cpuidex(
+			 cpu_information,
+			 7,
+			 0 );
+
+			if( ( cpu_information[ 1 ] & 0x00000020UL ) != 0 )
+			{
+				cpu_features |= LIBVMDK_DEFLATE_CPU_FEATURE_AVX2;
+			}
+		}
+	}
+#else
+	__builtin_cpu_init();
+
+	if( __builtin_cpu_supports( "sse2" ) )
+	{
+		cpu_features |= LIBVMDK_DEFLATE_CPU_FEATURE_SSE2;
+	}
+	if( __builtin_cpu_supports( "ssse3" ) )
+	{
+		cpu_features |= LIBVMDK_DEFLATE_CPU_FEATURE_SSSE3;
+	}
+	if( __builtin_cpu_supports( "avx2" ) )
+	{
+		cpu_features |= LIBVMDK_DEFLATE_CPU_FEATURE_AVX2;
+	}
+#endif
+	return( cpu_features );
+}
+
+/* Calculates the Adler-32 of a buffer using SSE2 instructions
+ * The buffer is processed in blocks of 16 bytes, the remaining bytes are processed by
+ * libvmdk_deflate_calculate_adler32_scalar
+ * Returns 1 if successful or -1 on error
+ */
+#if defined( __GNUC__ )
+__attribute__((target("sse2")))
+#endif
+int libvmdk_deflate_calculate_adler32_sse2(
+     uint32_t *checksum_value,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t initial_value,
+     libcerror_error_t **error )
+{
+	__m128i block_data;
+	__m128i lower_sum;
+	__m128i previous_lower_sum;
+	__m128i upper_sum;
+
+	static char *function   = "libvmdk_deflate_calculate_adler32_sse2";
+	size_t number_of_blocks = 0;
+	size_t block_index      = 0;
+	uint32_t lower_word     = 0;
+	uint32_t upper_word     = 0;
+
+	const __m128i weights1  = _mm_setr_epi16( 16, 15, 14, 13, 12, 11, 10, 9 );
+	const __m128i weights2  = _mm_setr_epi16( 8, 7, 6, 5, 4, 3, 2, 1 );
+	const __m128i zero      = _mm_setzero_si128();
+
+	if( checksum_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum value.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	while( data_size >= 16 )
+	{
+		/* The modulo calculation is needed per 5552 (0x15b0) bytes
+		 * 5552 / 16 = 347
+		 */
+		number_of_blocks = data_size / 16;
+
+		if( number_of_blocks > 347 )
+		{
+			number_of_blocks = 347;
+		}
+		data_size -= number_of_blocks * 16;
+
+		/* The lower word is added to the upper word for every byte in the blocks
+		 */
+		previous_lower_sum = _mm_set_epi32( 0, 0, 0, (int) ( lower_word * number_of_blocks ) );
+		upper_sum          = _mm_set_epi32( 0, 0, 0, (int) upper_word );
+		lower_sum          = _mm_setzero_si128();
+
+		for( block_index = 0;
+		     block_index < number_of_blocks;
+		     block_index++ )
+		{
+			block_data = _mm_loadu_si128(
+			              (const __m128i *) data );
+
+			previous_lower_sum = _mm_add_epi32( previous_lower_sum, lower_sum );
+			lower_sum          = _mm_add_epi32( lower_sum, _mm_sad_epu8( block_data, zero ) );
+
+			upper_sum = _mm_add_epi32( upper_sum, _mm_madd_epi16( _mm_unpacklo_epi8( block_data, zero ), weights1 ) );
+			upper_sum = _mm_add_epi32( upper_sum, _mm_madd_epi16( _mm_unpackhi_epi8( block_data, zero ), weights2 ) );
+
+			data += 16;
+		}
+		upper_sum = _mm_add_epi32( upper_sum, _mm_slli_epi32( previous_lower_sum, 4 ) );
+
+		/* Calculate the horizontal sums
+		 */
+		lower_sum = _mm_add_epi32( lower_sum, _mm_shuffle_epi32( lower_sum, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+		lower_sum = _mm_add_epi32( lower_sum, _mm_shuffle_epi32( lower_sum, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		upper_sum = _mm_add_epi32( upper_sum, _mm_shuffle_epi32( upper_sum, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+		upper_sum = _mm_add_epi32( upper_sum, _mm_shuffle_epi32( upper_sum, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+
+		lower_word = ( lower_word + (uint32_t) _mm_cvtsi128_si32( lower_sum ) ) % 65521;
+		upper_word = (uint32_t) _mm_cvtsi128_si32( upper_sum ) % 65521;
+	}
+	if( libvmdk_deflate_calculate_adler32_scalar(
+	     checksum_value,
+	     data,
+	     data_size,
+	     ( upper_word << 16 ) | lower_word,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum of remaining data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Calculates the Adler-32 of a buffer using SSSE3 instructions
+ * The buffer is processed in blocks of 32 bytes, the remaining bytes are processed by
+ * libvmdk_deflate_calculate_adler32_scalar
+ * Returns 1 if successful or -1 on error
+ */
+#if defined( __GNUC__ )
+__attribute__((target("ssse3")))
+#endif
+int libvmdk_deflate_calculate_adler32_ssse3(
+     uint32_t *checksum_value,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t initial_value,
+     libcerror_error_t **error )
+{
+	__m128i block_data1;
+	__m128i block_data2;
+	__m128i lower_sum;
+	__m128i previous_lower_sum;
+	__m128i upper_sum;
+
+	static char *function   = "libvmdk_deflate_calculate_adler32_ssse3";
+	size_t number_of_blocks = 0;
+	size_t block_index      = 0;
+	uint32_t lower_word     = 0;
+	uint32_t upper_word     = 0;
+
+	const __m128i ones      = _mm_set1_epi16( 1 );
+	const __m128i weights1  = _mm_setr_epi8( 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17 );
+	const __m128i weights2  = _mm_setr_epi8( 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+	const __m128i zero      = _mm_setzero_si128();
+
+	if( checksum_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum value.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	while( data_size >= 32 )
+	{
+		/* The modulo calculation is needed per 5552 (0x15b0) bytes
+		 * 5552 / 32 = 173
+		 */
+		number_of_blocks = data_size / 32;
+
+		if( number_of_blocks > 173 )
+		{
+			number_of_blocks = 173;
+		}
+		data_size -= number_of_blocks * 32;
+
+		/* The lower word is added to the upper word for every byte in the blocks
+		 */
+		previous_lower_sum = _mm_set_epi32( 0, 0, 0, (int) ( lower_word * number_of_blocks ) );
+		upper_sum          = _mm_set_epi32( 0, 0, 0, (int) upper_word );
+		lower_sum          = _mm_setzero_si128();
+
+		for( block_index = 0;
+		     block_index < number_of_blocks;
+		     block_index++ )
+		{
+			block_data1 = _mm_loadu_si128(
+			               (const __m128i *) data );
+			block_data2 = _mm_loadu_si128(
+			               (const __m128i *) &( data[ 16 ] ) );
+
+			previous_lower_sum = _mm_add_epi32( previous_lower_sum, lower_sum );
+			lower_sum          = _mm_add_epi32( lower_sum, _mm_sad_epu8( block_data1, zero ) );
+			lower_sum          = _mm_add_epi32( lower_sum, _mm_sad_epu8( block_data2, zero ) );
+
+			upper_sum = _mm_add_epi32( upper_sum, _mm_madd_epi16( _mm_maddubs_epi16( block_data1, weights1 ), ones ) );
+			upper_sum = _mm_add_epi32( upper_sum, _mm_madd_epi16( _mm_maddubs_epi16( block_data2, weights2 ), ones ) );
+
+			data += 32;
+		}
+		upper_sum = _mm_add_epi32( upper_sum, _mm_slli_epi32( previous_lower_sum, 5 ) );
+
+		/* Calculate the horizontal sums
+		 */
+		lower_sum = _mm_add_epi32( lower_sum, _mm_shuffle_epi32( lower_sum, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+		lower_sum = _mm_add_epi32( lower_sum, _mm_shuffle_epi32( lower_sum, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		upper_sum = _mm_add_epi32( upper_sum, _mm_shuffle_epi32( upper_sum, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+		upper_sum = _mm_add_epi32( upper_sum, _mm_shuffle_epi32( upper_sum, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+
+		lower_word = ( lower_word + (uint32_t) _mm_cvtsi128_si32( lower_sum ) ) % 65521;
+		upper_word = (uint32_t) _mm_cvtsi128_si32( upper_sum ) % 65521;
+	}
+	if( libvmdk_deflate_calculate_adler32_scalar(
+	     checksum_value,
+	     data,
+	     data_size,
+	     ( upper_word << 16 ) | lower_word,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum of remaining data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Calculates the Adler-32 of a buffer using AVX2 instructions
+ * The buffer is processed in blocks of 32 bytes, the remaining bytes are processed by
+ * libvmdk_deflate_calculate_adler32_scalar
+ * Returns 1 if successful or -1 on error
+ */
+#if defined( __GNUC__ )
+__attribute__((target("avx2")))
+#endif
+int libvmdk_deflate_calculate_adler32_avx2(
+     uint32_t *checksum_value,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t initial_value,
+     libcerror_error_t **error )
+{
+	__m256i block_data;
+	__m256i lower_sum;
+	__m256i previous_lower_sum;
+	__m256i upper_sum;
+	__m128i sum;
+
+	static char *function   = "libvmdk_deflate_calculate_adler32_avx2";
+	size_t number_of_blocks = 0;
+	size_t block_index      = 0;
+	uint32_t lower_word     = 0;
+	uint32_t upper_word     = 0;
+
+	const __m256i ones      = _mm256_set1_epi16( 1 );
+	const __m256i weights   = _mm256_setr_epi8( 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+	const __m256i zero      = _mm256_setzero_si256();
+
+	if( checksum_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum value.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	while( data_size >= 32 )
+	{
+		/* The modulo calculation is needed per 5552 (0x15b0) bytes
+		 * 5552 / 32 = 173
+		 */
+		number_of_blocks = data_size / 32;
+
+		if( number_of_blocks > 173 )
+		{
+			number_of_blocks = 173;
+		}
+		data_size -= number_of_blocks * 32;
+
+		/* The lower word is added to the upper word for every byte in the blocks
+		 */
+		previous_lower_sum = _mm256_set_epi32( 0, 0, 0, 0, 0, 0, 0, (int) ( lower_word * number_of_blocks ) );
+		upper_sum          = _mm256_set_epi32( 0, 0, 0, 0, 0, 0, 0, (int) upper_word );
+		lower_sum          = _mm256_setzero_si256();
+
+		for( block_index = 0;
+		     block_index < number_of_blocks;
+		     block_index++ )
+		{
+			block_data = _mm256_loadu_si256(
+			              (const __m256i *) data );
+
+			previous_lower_sum = _mm256_add_epi32( previous_lower_sum, lower_sum );
+			lower_sum          = _mm256_add_epi32( lower_sum, _mm256_sad_epu8( block_data, zero ) );
+
+			upper_sum = _mm256_add_epi32( upper_sum, _mm256_madd_epi16( _mm256_maddubs_epi16( block_data, weights ), ones ) );
+
+			data += 32;
+		}
+		upper_sum = _mm256_add_epi32( upper_sum, _mm256_slli_epi32( previous_lower_sum, 5 ) );
+
+		/* Calculate the horizontal sums
+		 */
+		sum = _mm_add_epi32( _mm256_castsi256_si128( lower_sum ), _mm256_extracti128_si256( lower_sum, 1 ) );
+		sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+		sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+
+		lower_word = ( lower_word + (uint32_t) _mm_cvtsi128_si32( sum ) ) % 65521;
+
+		sum = _mm_add_epi32( _mm256_castsi256_si128( upper_sum ), _mm256_extracti128_si256( upper_sum, 1 ) );
+		sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+		sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+
+		upper_word = (uint32_t) _mm_cvtsi128_si32( sum ) % 65521;
+	}
+	if( libvmdk_deflate_calculate_adler32_scalar(
+	     checksum_value,
+	     data,
+	     data_size,
+	     ( upper_word << 16 ) | lower_word,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum of remaining data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( LIBVMDK_DEFLATE_HAVE_X86_SIMD ) */
+
+/* Calculates the Adler-32 of a buffer
+ * Uses the SIMD instructions supported by the CPU if available
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_deflate_calculate_adler32(
+     uint32_t *checksum_value,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t initial_value,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_deflate_calculate_adler32";
+	int result            = 0;
+
+#if defined( LIBVMDK_DEFLATE_HAVE_X86_SIMD )
+	int cpu_features      = 0;
+
+	cpu_features = (int) libvmdk_deflate_cpu_features_get();
+
+	if( cpu_features == -1 )
+	{
+		/* The CPU features are only determined once, since they are the same for every caller
+		 * concurrent callers store the same value
+		 */
+		cpu_features = libvmdk_deflate_get_cpu_features();
+
+		libvmdk_deflate_cpu_features_set(
+		 (long) cpu_features );
+	}
+
+	if( ( cpu_features & LIBVMDK_DEFLATE_CPU_FEATURE_AVX2 ) != 0 )
+	{
+		result = libvmdk_deflate_calculate_adler32_avx2(
+		          checksum_value,
+		          data,
+		          data_size,
+		          initial_value,
+		          error );
+	}
+	else if( ( cpu_features & LIBVMDK_DEFLATE_CPU_FEATURE_SSSE3 ) != 0 )
+	{
+		result = libvmdk_deflate_calculate_adler32_ssse3(
+		          checksum_value,
+		          data,
+		          data_size,
+		          initial_value,
+		          error );
+	}
+	else if( ( cpu_features & LIBVMDK_DEFLATE_CPU_FEATURE_SSE2 ) != 0 )
+	{
+		result = libvmdk_deflate_calculate_adler32_sse2(
+		          checksum_value,
+		          data,
+		          data_size,
+		          initial_value,
+		          error );
+	}
+	else
+#endif
+	{
+		result = libvmdk_deflate_calculate_adler32_scalar(
+		          checksum_value,
+		          data,
+		          data_size,
+		          initial_value,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Reads the compressed data header
  * Returns 1 on success or -1 on error
  */
@@ -1119,8 +1891,8 @@ int libvmdk_deflate_read_block_header(
 int libvmdk_deflate_read_block(
      libvmdk_bit_stream_t *bit_stream,
      uint8_t block_type,
-     libvmdk_huffman_tree_t *fixed_huffman_literals_tree,
-     libvmdk_huffman_tree_t *fixed_huffman_distances_tree,
+     const libvmdk_huffman_tree_t *fixed_huffman_literals_tree,
+     const libvmdk_huffman_tree_t *fixed_huffman_distances_tree,
      uint8_t *uncompressed_data,
      size_t uncompressed_data_size,
      size_t *uncompressed_data_offset,
@@ -1237,6 +2009,16 @@ int libvmdk_deflate_read_block(
 
 				goto on_error;
 			}
+			/* Return the bytes that were read ahead into the bit buffer to the byte stream
+			 */
+			while( bit_stream->bit_buffer_size >= 8 )
+			{
+				bit_stream->byte_stream_offset -= 1;
+				bit_stream->bit_buffer_size    -= 8;
+			}
+			bit_stream->bit_buffer      = 0;
+			bit_stream->bit_buffer_size = 0;
+
 			if( block_size == 0 )
 			{
 				break;
@@ -1442,8 +2224,6 @@ int libvmdk_deflate_decompress(
      libcerror_error_t **error )
 {
 	libvmdk_bit_stream_t *bit_stream                     = NULL;
-	libvmdk_huffman_tree_t *fixed_huffman_distances_tree = NULL;
-	libvmdk_huffman_tree_t *fixed_huffman_literals_tree  = NULL;
 	static char *function                                = "libvmdk_deflate_decompress";
 	size_t compressed_data_offset                        = 0;
 	size_t safe_uncompressed_data_size                   = 0;
@@ -1536,7 +2316,10 @@ int libvmdk_deflate_decompress(
 
 		goto on_error;
 	}
-	while( bit_stream->byte_stream_offset < bit_stream->byte_stream_size )
+	/* The bit buffer can contain bytes that were read ahead from the byte stream
+	 */
+	while( ( bit_stream->byte_stream_offset < bit_stream->byte_stream_size )
+	    || ( bit_stream->bit_buffer_size >= 8 ) )
 	{
 		if( libvmdk_deflate_read_block_header(
 		     bit_stream,
@@ -1553,62 +2336,11 @@ int libvmdk_deflate_decompress(
 
 			goto on_error;
 		}
-		if( block_type == LIBVMDK_DEFLATE_BLOCK_TYPE_HUFFMAN_FIXED )
-		{
-			if( ( fixed_huffman_literals_tree == NULL )
-			 && ( fixed_huffman_distances_tree == NULL ) )
-			{
-				if( libvmdk_huffman_tree_initialize(
-				     &fixed_huffman_literals_tree,
-				     288,
-				     15,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to build fixed literals Huffman tree.",
-					 function );
-
-					goto on_error;
-				}
-				if( libvmdk_huffman_tree_initialize(
-				     &fixed_huffman_distances_tree,
-				     30,
-				     15,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to build fixed distances Huffman tree.",
-					 function );
-
-					goto on_error;
-				}
-				if( libvmdk_deflate_build_fixed_huffman_trees(
-				     fixed_huffman_literals_tree,
-				     fixed_huffman_distances_tree,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to build fixed Huffman trees.",
-					 function );
-
-					goto on_error;
-				}
-			}
-		}
 		if( libvmdk_deflate_read_block(
 		     bit_stream,
 		     block_type,
-		     fixed_huffman_literals_tree,
-		     fixed_huffman_distances_tree,
+		     &libvmdk_deflate_fixed_huffman_literals_tree,
+		     &libvmdk_deflate_fixed_huffman_distances_tree,
 		     uncompressed_data,
 		     safe_uncompressed_data_size,
 		     &uncompressed_data_offset,
@@ -1628,38 +2360,6 @@ int libvmdk_deflate_decompress(
 			break;
 		}
 	}
-	if( fixed_huffman_distances_tree != NULL )
-	{
-		if( libvmdk_huffman_tree_free(
-		     &fixed_huffman_distances_tree,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free fixed distances Huffman tree.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	if( fixed_huffman_literals_tree != NULL )
-	{
-		if( libvmdk_huffman_tree_free(
-		     &fixed_huffman_literals_tree,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free fixed literals Huffman tree.",
-			 function );
-
-			goto on_error;
-		}
-	}
 	if( libvmdk_bit_stream_free(
 	     &bit_stream,
 	     error ) != 1 )
@@ -1678,18 +2378,6 @@ int libvmdk_deflate_decompress(
 	return( 1 );
 
 on_error:
-	if( fixed_huffman_distances_tree != NULL )
-	{
-		libvmdk_huffman_tree_free(
-		 &fixed_huffman_distances_tree,
-		 NULL );
-	}
-	if( fixed_huffman_literals_tree != NULL )
-	{
-		libvmdk_huffman_tree_free(
-		 &fixed_huffman_literals_tree,
-		 NULL );
-	}
 	if( bit_stream != NULL )
 	{
 		libvmdk_bit_stream_free(
@@ -1710,8 +2398,6 @@ int libvmdk_deflate_decompress_zlib(
      libcerror_error_t **error )
 {
 	libvmdk_bit_stream_t *bit_stream                     = NULL;
-	libvmdk_huffman_tree_t *fixed_huffman_distances_tree = NULL;
-	libvmdk_huffman_tree_t *fixed_huffman_literals_tree  = NULL;
 	static char *function                                = "libvmdk_deflate_decompress_zlib";
 	size_t compressed_data_offset                        = 0;
 	size_t safe_uncompressed_data_size                   = 0;
@@ -1821,7 +2507,10 @@ int libvmdk_deflate_decompress_zlib(
 
 		goto on_error;
 	}
-	while( bit_stream->byte_stream_offset < bit_stream->byte_stream_size )
+	/* The bit buffer can contain bytes that were read ahead from the byte stream
+	 */
+	while( ( bit_stream->byte_stream_offset < bit_stream->byte_stream_size )
+	    || ( bit_stream->bit_buffer_size >= 8 ) )
 	{
 		if( libvmdk_deflate_read_block_header(
 		     bit_stream,
@@ -1838,62 +2527,11 @@ int libvmdk_deflate_decompress_zlib(
 
 			goto on_error;
 		}
-		if( block_type == LIBVMDK_DEFLATE_BLOCK_TYPE_HUFFMAN_FIXED )
-		{
-			if( ( fixed_huffman_literals_tree == NULL )
-			 && ( fixed_huffman_distances_tree == NULL ) )
-			{
-				if( libvmdk_huffman_tree_initialize(
-				     &fixed_huffman_literals_tree,
-				     288,
-				     15,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to build fixed literals Huffman tree.",
-					 function );
-
-					goto on_error;
-				}
-				if( libvmdk_huffman_tree_initialize(
-				     &fixed_huffman_distances_tree,
-				     30,
-				     15,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to build fixed distances Huffman tree.",
-					 function );
-
-					goto on_error;
-				}
-				if( libvmdk_deflate_build_fixed_huffman_trees(
-				     fixed_huffman_literals_tree,
-				     fixed_huffman_distances_tree,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to build fixed Huffman trees.",
-					 function );
-
-					goto on_error;
-				}
-			}
-		}
 		if( libvmdk_deflate_read_block(
 		     bit_stream,
 		     block_type,
-		     fixed_huffman_literals_tree,
-		     fixed_huffman_distances_tree,
+		     &libvmdk_deflate_fixed_huffman_literals_tree,
+		     &libvmdk_deflate_fixed_huffman_distances_tree,
 		     uncompressed_data,
 		     safe_uncompressed_data_size,
 		     &uncompressed_data_offset,
@@ -1913,13 +2551,15 @@ int libvmdk_deflate_decompress_zlib(
 			break;
 		}
 	}
+	/* Return the bytes that were read ahead into the bit buffer to the byte stream
+	 */
+	while( bit_stream->bit_buffer_size >= 8 )
+	{
+		bit_stream->byte_stream_offset -= 1;
+		bit_stream->bit_buffer_size    -= 8;
+	}
 	if( ( bit_stream->byte_stream_size - bit_stream->byte_stream_offset ) >= 4 )
 	{
-		while( bit_stream->bit_buffer_size >= 8 )
-		{
-			bit_stream->byte_stream_offset -= 1;
-			bit_stream->bit_buffer_size    -= 8;
-		}
 		byte_stream_copy_to_uint32_big_endian(
 		 &( bit_stream->byte_stream[ bit_stream->byte_stream_offset ] ),
 		 stored_checksum );
@@ -1954,38 +2594,6 @@ int libvmdk_deflate_decompress_zlib(
 			goto on_error;
 		}
 	}
-	if( fixed_huffman_distances_tree != NULL )
-	{
-		if( libvmdk_huffman_tree_free(
-		     &fixed_huffman_distances_tree,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free fixed distances Huffman tree.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	if( fixed_huffman_literals_tree != NULL )
-	{
-		if( libvmdk_huffman_tree_free(
-		     &fixed_huffman_literals_tree,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free fixed literals Huffman tree.",
-			 function );
-
-			goto on_error;
-		}
-	}
 	if( libvmdk_bit_stream_free(
 	     &bit_stream,
 	     error ) != 1 )
@@ -2004,18 +2612,6 @@ int libvmdk_deflate_decompress_zlib(
 	return( 1 );
 
 on_error:
-	if( fixed_huffman_distances_tree != NULL )
-	{
-		libvmdk_huffman_tree_free(
-		 &fixed_huffman_distances_tree,
-		 NULL );
-	}
-	if( fixed_huffman_literals_tree != NULL )
-	{
-		libvmdk_huffman_tree_free(
-		 &fixed_huffman_literals_tree,
-		 NULL );
-	}
 	if( bit_stream != NULL )
 	{
 		libvmdk_bit_stream_free(
@@ -33,6 +33,23 @@
 extern "C" {
 #endif
 
+/* Adler-32 can be calculated using x86 SIMD instructions if the compiler
+ * supports selecting the instruction set per function
+ */
+#if ( ( defined( __clang__ ) || ( defined( __GNUC__ ) && ( ( __GNUC__ > 4 ) || ( ( __GNUC__ == 4 ) && ( __GNUC_MINOR__ >= 9 ) ) ) ) ) && ( defined( __x86_64__ ) || defined( __i386__ ) ) ) \
+ || ( defined( _MSC_VER ) && ( _MSC_VER >= 1800 ) && ( defined( _M_X64 ) || defined( _M_IX86 ) ) )
+#define LIBVMDK_DEFLATE_HAVE_X86_SIMD
+#endif
+
+/* The CPU features
+ */
+enum LIBVMDK_DEFLATE_CPU_FEATURES
+{
+	LIBVMDK_DEFLATE_CPU_FEATURE_SSE2		= 0x01,
+	LIBVMDK_DEFLATE_CPU_FEATURE_SSSE3		= 0x02,
+	LIBVMDK_DEFLATE_CPU_FEATURE_AVX2		= 0x04
+};
+
 /* The block types
  */
 enum LIBVMDK_DEFLATE_BLOCK_TYPES
@@ -43,6 +60,9 @@ enum LIBVMDK_DEFLATE_BLOCK_TYPES
 	LIBVMDK_DEFLATE_BLOCK_TYPE_RESERVED		= 0x03
 };
 
+extern const libvmdk_huffman_tree_t libvmdk_deflate_fixed_huffman_literals_tree;
+extern const libvmdk_huffman_tree_t libvmdk_deflate_fixed_huffman_distances_tree;
+
 int libvmdk_deflate_build_dynamic_huffman_trees(
      libvmdk_bit_stream_t *bit_stream,
      libvmdk_huffman_tree_t *literals_tree,
@@ -56,13 +76,48 @@ int libvmdk_deflate_build_fixed_huffman_trees(
 
 int libvmdk_deflate_decode_huffman(
      libvmdk_bit_stream_t *bit_stream,
-     libvmdk_huffman_tree_t *literals_tree,
-     libvmdk_huffman_tree_t *distances_tree,
+     const libvmdk_huffman_tree_t *literals_tree,
+     const libvmdk_huffman_tree_t *distances_tree,
      uint8_t *uncompressed_data,
      size_t uncompressed_data_size,
      size_t *uncompressed_data_offset,
      libcerror_error_t **error );
 
+int libvmdk_deflate_calculate_adler32_scalar(
+     uint32_t *checksum_value,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t initial_value,
+     libcerror_error_t **error );
+
+#if defined( LIBVMDK_DEFLATE_HAVE_X86_SIMD )
+
+int libvmdk_deflate_get_cpu_features(
+     void );
+
+int libvmdk_deflate_calculate_adler32_sse2(
+     uint32_t *checksum_value,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t initial_value,
+     libcerror_error_t **error );
+
+int libvmdk_deflate_calculate_adler32_ssse3(
+     uint32_t *checksum_value,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t initial_value,
+     libcerror_error_t **error );
+
+int libvmdk_deflate_calculate_adler32_avx2(
+     uint32_t *checksum_value,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t initial_value,
+     libcerror_error_t **error );
+
+#endif /* defined( LIBVMDK_DEFLATE_HAVE_X86_SIMD ) */
+
 int libvmdk_deflate_calculate_adler32(
      uint32_t *checksum_value,
      const uint8_t *data,
@@ -85,8 +140,8 @@ int libvmdk_deflate_read_block_header(
 int libvmdk_deflate_read_block(
      libvmdk_bit_stream_t *bit_stream,
      uint8_t block_type,
-     libvmdk_huffman_tree_t *fixed_huffman_literals_tree,
-     libvmdk_huffman_tree_t *fixed_huffman_distances_tree,
+     const libvmdk_huffman_tree_t *fixed_huffman_literals_tree,
+     const libvmdk_huffman_tree_t *fixed_huffman_distances_tree,
      uint8_t *uncompressed_data,
      size_t uncompressed_data_size,
      size_t *uncompressed_data_offset,
@@ -34,6 +34,8 @@
 #include "libvmdk_libcnotify.h"
 #include "libvmdk_libfcache.h"
 #include "libvmdk_libfdata.h"
+#include "libvmdk_statistics.h"
+#include "libvmdk_trace.h"
 #include "libvmdk_types.h"
 #include "libvmdk_unused.h"
 
@@ -52,7 +54,8 @@ int libvmdk_extent_file_initialize(
      libvmdk_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function = "libvmdk_extent_file_initialize";
+	static char *function       = "libvmdk_extent_file_initialize";
+	int number_of_cache_entries = 0;
 
 	if( extent_file == NULL )
 	{
@@ -140,9 +143,15 @@ int libvmdk_extent_file_initialize(
 		goto on_error;
 	}
 /* TODO set mapped offset in grain_groups_list ? */
+	number_of_cache_entries = io_handle->number_of_grain_groups_cache_entries;
+
+	if( number_of_cache_entries <= 0 )
+	{
+		number_of_cache_entries = LIBVMDK_MAXIMUM_CACHE_ENTRIES_GRAIN_GROUPS;
+	}
 	if( libfcache_cache_initialize(
 	     &( ( *extent_file )->grain_groups_cache ),
-	     LIBVMDK_MAXIMUM_CACHE_ENTRIES_GRAIN_GROUPS,
+	     number_of_cache_entries,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -338,6 +347,8 @@ int libvmdk_extent_file_read_file_header_file_io_handle(
 	static char *function     = "libvmdk_extent_file_read_file_header_file_io_handle";
 	size_t read_size          = 0;
 	ssize_t read_count        = 0;
+	uint64_t start_timestamp  = 0;
+	uint8_t is_traced         = 0;
 
 	if( extent_file == NULL )
 	{
@@ -350,6 +361,10 @@ int libvmdk_extent_file_read_file_header_file_io_handle(
 
 		return( -1 );
 	}
+	is_traced = (uint8_t) libvmdk_trace_start_event(
+	                       extent_file->io_handle->trace,
+	                       &start_timestamp );
+
 	file_header_data = (uint8_t *) memory_allocate(
 	                                sizeof( uint8_t ) * 2048 );
 
@@ -456,6 +471,24 @@ int libvmdk_extent_file_read_file_header_file_io_handle(
 
 	file_header_data = NULL;
 
+	if( is_traced != 0 )
+	{
+		if( libvmdk_trace_record_event(
+		     extent_file->io_handle->trace,
+		     LIBVMDK_TRACE_EVENT_OPEN_FILE_HEADER,
+		     start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to record trace event.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
@@ -481,6 +514,8 @@ int libvmdk_extent_file_read_file_header(
 	static char *function     = "libvmdk_extent_file_read_file_header";
 	size_t read_size          = 0;
 	ssize_t read_count        = 0;
+	uint64_t start_timestamp  = 0;
+	uint8_t is_traced         = 0;
 
 	if( extent_file == NULL )
 	{
@@ -493,6 +528,10 @@ int libvmdk_extent_file_read_file_header(
 
 		return( -1 );
 	}
+	is_traced = (uint8_t) libvmdk_trace_start_event(
+	                       extent_file->io_handle->trace,
+	                       &start_timestamp );
+
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -616,6 +655,24 @@ int libvmdk_extent_file_read_file_header(
 
 	file_header_data = NULL;
 
+	if( is_traced != 0 )
+	{
+		if( libvmdk_trace_record_event(
+		     extent_file->io_handle->trace,
+		     LIBVMDK_TRACE_EVENT_OPEN_FILE_HEADER,
+		     start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to record trace event.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
@@ -1382,7 +1439,9 @@ int libvmdk_extent_file_read_grain_directories(
      int file_io_pool_entry,
      libcerror_error_t **error )
 {
-	static char *function = "libvmdk_extent_file_read_grain_directories";
+	static char *function    = "libvmdk_extent_file_read_grain_directories";
+	uint64_t start_timestamp = 0;
+	uint8_t is_traced        = 0;
 
 	if( extent_file == NULL )
 	{
@@ -1395,6 +1454,10 @@ int libvmdk_extent_file_read_grain_directories(
 
 		return( -1 );
 	}
+	is_traced = (uint8_t) libvmdk_trace_start_event(
+	                       extent_file->io_handle->trace,
+	                       &start_timestamp );
+
 	if( ( extent_file->file_type == LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA )
 	 && ( ( extent_file->flags & LIBVMDK_FLAG_USE_SECONDARY_GRAIN_DIRECTORY ) != 0 ) )
 	{
@@ -1446,35 +1509,6 @@ int libvmdk_extent_file_read_grain_directories(
 
 			return( -1 );
 		}
-		if( extent_file->primary_grain_directory_offset > 0 )
-		{
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: reading primary grain directory at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-				 function,
-				 extent_file->primary_grain_directory_offset,
-				 extent_file->primary_grain_directory_offset );
-			}
-#endif
-			if( libvmdk_extent_file_read_backup_grain_directory(
-			     extent_file,
-			     file_io_pool,
-			     file_io_pool_entry,
-			     extent_file->primary_grain_directory_offset,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read primary backup grain directory.",
-				 function );
-
-				return( -1 );
-			}
-		}
 	}
 	else
 	{
@@ -1526,39 +1560,85 @@ int libvmdk_extent_file_read_grain_directories(
 
 			return( -1 );
 		}
-		if( extent_file->secondary_grain_directory_offset > 0 )
+	}
+	if( is_traced != 0 )
+	{
+		if( libvmdk_trace_record_event(
+		     extent_file->io_handle->trace,
+		     LIBVMDK_TRACE_EVENT_OPEN_GRAIN_DIRECTORIES,
+		     start_timestamp,
+		     error ) != 1 )
 		{
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: reading secondary grain directory at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-				 function,
-				 extent_file->secondary_grain_directory_offset,
-				 extent_file->secondary_grain_directory_offset );
-			}
-#endif
-			if( libvmdk_extent_file_read_backup_grain_directory(
-			     extent_file,
-			     file_io_pool,
-			     file_io_pool_entry,
-			     extent_file->secondary_grain_directory_offset,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read secondary backup grain directory.",
-				 function );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to record trace event.",
+			 function );
 
-				return( -1 );
-			}
+			return( -1 );
 		}
 	}
 	return( 1 );
 }
 
+/* Reads the backup grain directory
+ * The backup grain directory is the primary grain directory if the secondary grain directory is used
+ * and the secondary grain directory otherwise
+ * Returns 1 if successful, 0 if the extent file has no backup grain directory or -1 on error
+ */
+int libvmdk_extent_file_read_backup_grain_directories(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	static char *function                 = "libvmdk_extent_file_read_backup_grain_directories";
+	off64_t backup_grain_directory_offset = 0;
+
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_file->file_type == LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA )
+	 && ( ( extent_file->flags & LIBVMDK_FLAG_USE_SECONDARY_GRAIN_DIRECTORY ) != 0 ) )
+	{
+		backup_grain_directory_offset = extent_file->primary_grain_directory_offset;
+	}
+	else
+	{
+		backup_grain_directory_offset = extent_file->secondary_grain_directory_offset;
+	}
+	if( backup_grain_directory_offset <= 0 )
+	{
+		return( 0 );
+	}
+	if( libvmdk_extent_file_read_backup_grain_directory(
+	     extent_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     backup_grain_directory_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read backup grain directory.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Reads the grain directory
  * Returns 1 if successful or -1 on error
  */
@@ -2130,6 +2210,8 @@ int libvmdk_extent_file_read_element_data(
 {
 	libvmdk_extent_file_t *extent_file = NULL;
 	static char *function              = "libvmdk_extent_file_read_element_data";
+	size64_t mapped_size               = 0;
+	int result                         = 0;
 
 	LIBVMDK_UNREFERENCED_PARAMETER( element_offset )
 	LIBVMDK_UNREFERENCED_PARAMETER( element_flags )
@@ -2199,22 +2281,69 @@ int libvmdk_extent_file_read_element_data(
 			goto on_error;
 		}
 	}
-	if( libvmdk_extent_file_read_grain_directory(
+	/* When the extent files are loaded lazily the grain size of the extent file
+	 * is first checked here
+	 */
+	if( ( io_handle->grain_size != 0 )
+	 && ( extent_file->grain_size != io_handle->grain_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: extent file: %d grain size mismatch.",
+		 function,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	if( libvmdk_extent_file_read_grain_directories(
 	     extent_file,
 	     file_io_pool,
 	     file_io_pool_entry,
-	     extent_file->primary_grain_directory_offset,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read primary grain directory.",
+		 "%s: unable to read grain directories.",
+		 function );
+
+		goto on_error;
+	}
+	/* When the extent files are loaded lazily the mapped size of the extent file
+	 * is the extent size in the descriptor file, which is first checked here
+	 */
+	result = libfdata_list_element_get_mapped_size(
+	          element,
+	          &mapped_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve mapped size of extent file.",
 		 function );
 
 		goto on_error;
 	}
+	else if( ( result != 0 )
+	      && ( extent_file->storage_media_size != mapped_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: extent file: %d storage media size does not match extent size in descriptor.",
+		 function,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
 	if( libfdata_list_element_set_element_value(
 	     element,
 	     (intptr_t *) file_io_pool,
@@ -2265,6 +2394,8 @@ int libvmdk_extent_file_read_grain_group_element_data(
 	uint8_t *grain_table_data    = NULL;
 	static char *function        = "libvmdk_extent_file_read_grain_group_element_data";
 	ssize_t read_count           = 0;
+	uint64_t start_timestamp     = 0;
+	uint8_t is_traced            = 0;
 	int grain_index              = 0;
 	int number_of_entries        = 0;
 
@@ -2303,6 +2434,8 @@ int libvmdk_extent_file_read_grain_group_element_data(
 
 		return( -1 );
 	}
+	extent_file->io_handle->number_of_grain_group_reads += 1;
+
 	if( ( grain_group_data_size == 0 )
 	 || ( grain_group_data_size > (size64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
 	{
@@ -2340,6 +2473,10 @@ int libvmdk_extent_file_read_grain_group_element_data(
 
 		goto on_error;
 	}
+	is_traced = (uint8_t) libvmdk_trace_start_event(
+	                       extent_file->io_handle->trace,
+	                       &start_timestamp );
+
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -2367,6 +2504,21 @@ int libvmdk_extent_file_read_grain_group_element_data(
 
 		goto on_error;
 	}
+	if( libvmdk_statistics_add(
+	     extent_file->io_handle->statistics,
+	     LIBVMDK_STATISTIC_SEEKS,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update statistics.",
+		 function );
+
+		goto on_error;
+	}
 	read_count = libbfio_pool_read_buffer(
 	              file_io_pool,
 	              file_io_pool_entry,
@@ -2385,6 +2537,54 @@ int libvmdk_extent_file_read_grain_group_element_data(
 
 		goto on_error;
 	}
+	if( is_traced != 0 )
+	{
+		if( libvmdk_trace_record_event(
+		     extent_file->io_handle->trace,
+		     LIBVMDK_TRACE_EVENT_GRAIN_TABLE_READ,
+		     start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to record trace event.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvmdk_statistics_add(
+	     extent_file->io_handle->statistics,
+	     LIBVMDK_STATISTIC_READS,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_statistics_add(
+	     extent_file->io_handle->statistics,
+	     LIBVMDK_STATISTIC_GRAIN_TABLES_READ,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update statistics.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -2422,8 +2622,7 @@ int libvmdk_extent_file_read_grain_group_element_data(
 	if( libvmdk_grain_group_fill(
 	     grains_list,
 	     grain_index,
-	     extent_file->io_handle->grain_size,
-	     file_io_pool,
+	     extent_file->grain_size,
 	     file_io_pool_entry,
 	     grain_table_data,
 	     (size_t) grain_group_data_size,
@@ -2567,6 +2766,10 @@ int libvmdk_extent_file_get_grain_group_at_offset(
 
 		return( -1 );
 	}
+	if( extent_file->io_handle != NULL )
+	{
+		extent_file->io_handle->number_of_grain_group_lookups += 1;
+	}
 	result = libfdata_list_get_element_value_at_offset(
 		  extent_file->grain_groups_list,
 		  (intptr_t *) file_io_pool,
@@ -2593,6 +2796,128 @@ int libvmdk_extent_file_get_grain_group_at_offset(
 	return( result );
 }
 
+/* Retrieves a specific grain group
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_file_get_grain_group_by_index(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int grain_group_index,
+     libfdata_list_t **grains_list,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_extent_file_get_grain_group_by_index";
+
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_file->io_handle != NULL )
+	{
+		extent_file->io_handle->number_of_grain_group_lookups += 1;
+	}
+	if( libfdata_list_get_element_value_by_index(
+	     extent_file->grain_groups_list,
+	     (intptr_t *) file_io_pool,
+	     (libfdata_cache_t *) extent_file->grain_groups_cache,
+	     grain_group_index,
+	     (intptr_t **) grains_list,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grains list: %d.",
+		 function,
+		 grain_group_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Resizes the grain groups cache
+ * The grain groups in the cache are discarded and are read again when needed
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_file_resize_grain_groups_cache(
+     libvmdk_extent_file_t *extent_file,
+     int number_of_cache_entries,
+     libcerror_error_t **error )
+{
+	libfcache_cache_t *grain_groups_cache = NULL;
+	static char *function                 = "libvmdk_extent_file_resize_grain_groups_cache";
+
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of cache entries value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_initialize(
+	     &grain_groups_cache,
+	     number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create grain groups cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_file->grain_groups_cache != NULL )
+	{
+		if( libfcache_cache_free(
+		     &( extent_file->grain_groups_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free grain groups cache.",
+			 function );
+
+			libfcache_cache_free(
+			 &grain_groups_cache,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	extent_file->grain_groups_cache = grain_groups_cache;
+
+	return( 1 );
+}
+
 /* Reads segment data into a buffer
  * Callback function for the segments stream
  * Returns the number of bytes read or -1 on error
@@ -169,6 +169,12 @@ int libvmdk_extent_file_read_grain_directories(
      int file_io_pool_entry,
      libcerror_error_t **error );
 
+int libvmdk_extent_file_read_backup_grain_directories(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
+
 int libvmdk_extent_file_read_grain_directory(
      libvmdk_extent_file_t *extent_file,
      libbfio_pool_t *file_io_pool,
@@ -229,6 +235,18 @@ int libvmdk_extent_file_get_grain_group_at_offset(
      libfdata_list_t **grains_list,
      libcerror_error_t **error );
 
+int libvmdk_extent_file_get_grain_group_by_index(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int grain_group_index,
+     libfdata_list_t **grains_list,
+     libcerror_error_t **error );
+
+int libvmdk_extent_file_resize_grain_groups_cache(
+     libvmdk_extent_file_t *extent_file,
+     int number_of_cache_entries,
+     libcerror_error_t **error );
+
 ssize_t libvmdk_extent_file_read_segment_data(
          intptr_t *data_handle,
          libbfio_pool_t *file_io_pool,
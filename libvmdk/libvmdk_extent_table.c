@@ -248,6 +248,16 @@ int libvmdk_extent_table_clear(
 			result = -1;
 		}
 	}
+	if( extent_table->extent_sizes != NULL )
+	{
+		memory_free(
+		 extent_table->extent_sizes );
+	}
+	if( extent_table->extent_offsets != NULL )
+	{
+		memory_free(
+		 extent_table->extent_offsets );
+	}
 	if( memory_set(
 	     extent_table,
 	     0,
@@ -1719,8 +1729,9 @@ int libvmdk_extent_table_initialize_extents(
      int disk_type,
      libcerror_error_t **error )
 {
-	static char *function = "libvmdk_extent_table_initialize_extents";
-	int result            = 0;
+	static char *function       = "libvmdk_extent_table_initialize_extents";
+	int number_of_cache_entries = 0;
+	int result                  = 0;
 
 	if( extent_table == NULL )
 	{
@@ -1838,9 +1849,59 @@ int libvmdk_extent_table_initialize_extents(
 
 			goto on_error;
 		}
+		if( ( number_of_extents <= 0 )
+		 || ( (size_t) number_of_extents > ( ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( off64_t ) ) - 1 ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid number of extents value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		extent_table->extent_sizes = (size64_t *) memory_allocate(
+		                                           sizeof( size64_t ) * number_of_extents );
+
+		if( extent_table->extent_sizes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create extent sizes.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     extent_table->extent_sizes,
+		     0,
+		     sizeof( size64_t ) * number_of_extents ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear extent sizes.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_cache_entries = number_of_extents;
+
+		if( number_of_cache_entries < LIBVMDK_MINIMUM_CACHE_ENTRIES_EXTENT_FILES )
+		{
+			number_of_cache_entries = LIBVMDK_MINIMUM_CACHE_ENTRIES_EXTENT_FILES;
+		}
+		else if( number_of_cache_entries > LIBVMDK_MAXIMUM_CACHE_ENTRIES_EXTENT_FILES )
+		{
+			number_of_cache_entries = LIBVMDK_MAXIMUM_CACHE_ENTRIES_EXTENT_FILES;
+		}
 		result = libfcache_cache_initialize(
 			  &( extent_table->extent_files_cache ),
-			  LIBVMDK_MAXIMUM_CACHE_ENTRIES_EXTENT_FILES,
+			  number_of_cache_entries,
 			  error );
 
 		if( result != 1 )
@@ -1861,6 +1922,13 @@ int libvmdk_extent_table_initialize_extents(
 	return( 1 );
 
 on_error:
+	if( extent_table->extent_sizes != NULL )
+	{
+		memory_free(
+		 extent_table->extent_sizes );
+
+		extent_table->extent_sizes = NULL;
+	}
 	if( extent_table->extent_files_list != NULL )
 	{
 		libfdata_list_free(
@@ -1898,6 +1966,18 @@ int libvmdk_extent_table_set_extent_storage_media_size_by_index(
 
 		return( -1 );
 	}
+	if( ( extent_index < 0 )
+	 || ( extent_index >= extent_table->number_of_extents ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
 	if( libfdata_list_set_mapped_size_by_index(
 	     extent_table->extent_files_list,
 	     extent_index,
@@ -1914,6 +1994,339 @@ int libvmdk_extent_table_set_extent_storage_media_size_by_index(
 
 		return( -1 );
 	}
+	if( extent_table->extent_sizes != NULL )
+	{
+		extent_table->extent_sizes[ extent_index ] = storage_media_size;
+	}
+	/* The extent offsets need to be rebuild after the extent sizes have changed
+	 */
+	if( extent_table->extent_offsets != NULL )
+	{
+		memory_free(
+		 extent_table->extent_offsets );
+
+		extent_table->extent_offsets = NULL;
+	}
+	return( 1 );
+}
+
+/* Builds the extent offsets from the sizes of the sparse extents
+ * The extent offsets are used to look up the extent at a specific offset without
+ * traversing the extent files list, by division if the extents have a uniform size
+ * or by a binary search otherwise
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_table_build_extent_offsets(
+     libvmdk_extent_table_t *extent_table,
+     libcerror_error_t **error )
+{
+	static char *function        = "libvmdk_extent_table_build_extent_offsets";
+	size64_t uniform_extent_size = 0;
+	off64_t extent_offset        = 0;
+	int extent_index             = 0;
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table->extent_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid extent table - missing extent sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table->extent_offsets != NULL )
+	{
+		memory_free(
+		 extent_table->extent_offsets );
+
+		extent_table->extent_offsets = NULL;
+	}
+	extent_table->extent_offsets = (off64_t *) memory_allocate(
+	                                            sizeof( off64_t ) * ( extent_table->number_of_extents + 1 ) );
+
+	if( extent_table->extent_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create extent offsets.",
+		 function );
+
+		goto on_error;
+	}
+	uniform_extent_size = extent_table->extent_sizes[ 0 ];
+
+	for( extent_index = 0;
+	     extent_index < extent_table->number_of_extents;
+	     extent_index++ )
+	{
+		if( extent_table->extent_sizes[ extent_index ] == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid extent: %d size value out of bounds.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( extent_table->extent_sizes[ extent_index ] > (size64_t) ( INT64_MAX - extent_offset ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid extent: %d size value exceeds maximum.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		/* The last extent is allowed to differ in size
+		 */
+		if( ( extent_index < ( extent_table->number_of_extents - 1 ) )
+		 && ( extent_table->extent_sizes[ extent_index ] != uniform_extent_size ) )
+		{
+			uniform_extent_size = 0;
+		}
+		extent_table->extent_offsets[ extent_index ] = extent_offset;
+
+		extent_offset += (off64_t) extent_table->extent_sizes[ extent_index ];
+	}
+	extent_table->extent_offsets[ extent_index ] = extent_offset;
+
+	extent_table->uniform_extent_size = uniform_extent_size;
+
+	return( 1 );
+
+on_error:
+	if( extent_table->extent_offsets != NULL )
+	{
+		memory_free(
+		 extent_table->extent_offsets );
+
+		extent_table->extent_offsets = NULL;
+	}
+	extent_table->uniform_extent_size = 0;
+
+	return( -1 );
+}
+
+/* Retrieves the index of the sparse extent at a specific offset from the extent offsets
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_table_get_extent_index_at_offset(
+     libvmdk_extent_table_t *extent_table,
+     off64_t offset,
+     int *extent_index,
+     off64_t *extent_data_offset,
+     libcerror_error_t **error )
+{
+	static char *function   = "libvmdk_extent_table_get_extent_index_at_offset";
+	int lower_extent_index  = 0;
+	int middle_extent_index = 0;
+	int safe_extent_index   = 0;
+	int upper_extent_index  = 0;
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table->extent_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid extent table - missing extent offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( offset >= extent_table->extent_offsets[ extent_table->number_of_extents ] ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent index.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table->uniform_extent_size != 0 )
+	{
+		if( ( (size64_t) offset / extent_table->uniform_extent_size ) >= (size64_t) extent_table->number_of_extents )
+		{
+			safe_extent_index = extent_table->number_of_extents - 1;
+		}
+		else
+		{
+			safe_extent_index = (int) ( (size64_t) offset / extent_table->uniform_extent_size );
+		}
+	}
+	else
+	{
+		lower_extent_index = 0;
+		upper_extent_index = extent_table->number_of_extents - 1;
+
+		while( lower_extent_index < upper_extent_index )
+		{
+			middle_extent_index = lower_extent_index + ( ( upper_extent_index - lower_extent_index + 1 ) / 2 );
+
+			if( offset < extent_table->extent_offsets[ middle_extent_index ] )
+			{
+				upper_extent_index = middle_extent_index - 1;
+			}
+			else
+			{
+				lower_extent_index = middle_extent_index;
+			}
+		}
+		safe_extent_index = lower_extent_index;
+	}
+	*extent_index       = safe_extent_index;
+	*extent_data_offset = offset - extent_table->extent_offsets[ safe_extent_index ];
+
+	return( 1 );
+}
+
+/* Retrieves the extent at a specific offset from the extent table
+ * Unlike libvmdk_extent_table_get_extent_file_at_offset this does not read the extent file
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_table_get_extent_at_offset(
+     libvmdk_extent_table_t *extent_table,
+     off64_t offset,
+     int *extent_index,
+     off64_t *extent_file_data_offset,
+     int *file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	static char *function      = "libvmdk_extent_table_get_extent_at_offset";
+	off64_t extent_file_offset = 0;
+	size64_t extent_file_size  = 0;
+	uint32_t extent_file_flags = 0;
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table->extent_offsets != NULL )
+	{
+		if( libvmdk_extent_table_get_extent_index_at_offset(
+		     extent_table,
+		     offset,
+		     extent_index,
+		     extent_file_data_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent index at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		if( libfdata_list_get_element_by_index(
+		     extent_table->extent_files_list,
+		     *extent_index,
+		     file_io_pool_entry,
+		     &extent_file_offset,
+		     &extent_file_size,
+		     &extent_file_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d from extent files list.",
+			 function,
+			 *extent_index );
+
+			return( -1 );
+		}
+	}
+	else if( libfdata_list_get_element_at_offset(
+	          extent_table->extent_files_list,
+	          offset,
+	          extent_index,
+	          extent_file_data_offset,
+	          file_io_pool_entry,
+	          &extent_file_offset,
+	          &extent_file_size,
+	          &extent_file_flags,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve element at offset: %" PRIi64 " (0x%08" PRIx64 ") from extent files list.",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
 	return( 1 );
 }
 
@@ -1942,13 +2355,99 @@ int libvmdk_extent_table_get_extent_file_at_offset(
 
 		return( -1 );
 	}
-	if( libfdata_list_get_element_value_at_offset(
+	if( extent_table->extent_offsets != NULL )
+	{
+		if( libvmdk_extent_table_get_extent_index_at_offset(
+		     extent_table,
+		     offset,
+		     extent_index,
+		     extent_file_data_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent index at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		if( libfdata_list_get_element_value_by_index(
+		     extent_table->extent_files_list,
+		     (intptr_t *) file_io_pool,
+		     (libfdata_cache_t *) extent_table->extent_files_cache,
+		     *extent_index,
+		     (intptr_t **) extent_file,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d from extent files list.",
+			 function,
+			 *extent_index );
+
+			return( -1 );
+		}
+	}
+	else if( libfdata_list_get_element_value_at_offset(
+	          extent_table->extent_files_list,
+	          (intptr_t *) file_io_pool,
+	          (libfdata_cache_t *) extent_table->extent_files_cache,
+	          offset,
+	          extent_index,
+	          extent_file_data_offset,
+	          (intptr_t **) extent_file,
+	          0,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve element at offset: %" PRIi64 " (0x%08" PRIx64 ") from extent files list.",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific extent file from the extent table
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_table_get_extent_file_by_index(
+     libvmdk_extent_table_t *extent_table,
+     int extent_index,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_extent_file_t **extent_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_extent_table_get_extent_file_by_index";
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_element_value_by_index(
 	     extent_table->extent_files_list,
 	     (intptr_t *) file_io_pool,
 	     (libfdata_cache_t *) extent_table->extent_files_cache,
-	     offset,
 	     extent_index,
-	     extent_file_data_offset,
 	     (intptr_t **) extent_file,
 	     0,
 	     error ) != 1 )
@@ -1957,16 +2456,143 @@ int libvmdk_extent_table_get_extent_file_at_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element at offset: %" PRIi64 " (0x%08" PRIx64 ") from extent files list.",
+		 "%s: unable to retrieve element: %d from extent files list.",
 		 function,
-		 offset,
-		 offset );
+		 extent_index );
 
 		return( -1 );
 	}
 	return( 1 );
 }
 
+/* Resizes the grain groups caches of the extent files in the extent files cache
+ * Extent files that are not cached create their grain groups cache when they are read
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_table_resize_grain_groups_caches(
+     libvmdk_extent_table_t *extent_table,
+     int number_of_cache_entries,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value = NULL;
+	libvmdk_extent_file_t *extent_file   = NULL;
+	static char *function                = "libvmdk_extent_table_resize_grain_groups_caches";
+	int cache_entry_index                = 0;
+	int number_of_extent_file_entries    = 0;
+	int number_of_grain_group_entries    = 0;
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table->extent_files_cache == NULL )
+	{
+		return( 1 );
+	}
+	if( libfcache_cache_get_number_of_entries(
+	     extent_table->extent_files_cache,
+	     &number_of_extent_file_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extent files cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	for( cache_entry_index = 0;
+	     cache_entry_index < number_of_extent_file_entries;
+	     cache_entry_index++ )
+	{
+		if( libfcache_cache_get_value_by_index(
+		     extent_table->extent_files_cache,
+		     cache_entry_index,
+		     &cache_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent files cache value: %d.",
+			 function,
+			 cache_entry_index );
+
+			return( -1 );
+		}
+		if( cache_value == NULL )
+		{
+			continue;
+		}
+		extent_file = NULL;
+
+		if( libfcache_cache_value_get_value(
+		     cache_value,
+		     (intptr_t **) &extent_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent file from cache value: %d.",
+			 function,
+			 cache_entry_index );
+
+			return( -1 );
+		}
+		if( ( extent_file == NULL )
+		 || ( extent_file->grain_groups_cache == NULL ) )
+		{
+			continue;
+		}
+		if( libfcache_cache_get_number_of_entries(
+		     extent_file->grain_groups_cache,
+		     &number_of_grain_group_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of grain groups cache entries.",
+			 function );
+
+			return( -1 );
+		}
+		if( number_of_grain_group_entries == number_of_cache_entries )
+		{
+			continue;
+		}
+		if( libvmdk_extent_file_resize_grain_groups_cache(
+		     extent_file,
+		     number_of_cache_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize grain groups cache of extent file in cache value: %d.",
+			 function,
+			 cache_entry_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
 /* Sets an extent in the extent table based on the extent values
  * Returns 1 if successful or -1 on error
  */
@@ -2005,7 +2631,7 @@ int libvmdk_extent_table_set_extent_by_extent_values(
 		return( -1 );
 	}
 	if( ( extent_index < 0 )
-	 || ( extent_index > extent_table->number_of_extents ) )
+	 || ( extent_index >= extent_table->number_of_extents ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -2184,6 +2810,17 @@ int libvmdk_extent_table_set_extent_by_extent_values(
 
 			return( -1 );
 		}
+		if( extent_table->extent_sizes != NULL )
+		{
+			extent_table->extent_sizes[ extent_index ] = extent_size;
+		}
+		if( extent_table->extent_offsets != NULL )
+		{
+			memory_free(
+			 extent_table->extent_offsets );
+
+			extent_table->extent_offsets = NULL;
+		}
 	}
 	return( 1 );
 }
@@ -76,6 +76,19 @@ struct libvmdk_extent_table
 	/* The extent files stream used for flat (non-sparse) extent files
 	 */
 	libfdata_stream_t *extent_files_stream;
+
+	/* The sizes of the sparse extents
+	 */
+	size64_t *extent_sizes;
+
+	/* The offsets of the sparse extents
+	 * Contains the number of extents + 1 entries, where the last entry contains the end offset of the last extent
+	 */
+	off64_t *extent_offsets;
+
+	/* The size of the sparse extents if all extents, except for the last, have the same size or 0 otherwise
+	 */
+	size64_t uniform_extent_size;
 };
 
 int libvmdk_extent_table_initialize(
@@ -175,6 +188,25 @@ int libvmdk_extent_table_set_extent_storage_media_size_by_index(
      size64_t storage_media_size,
      libcerror_error_t **error );
 
+int libvmdk_extent_table_build_extent_offsets(
+     libvmdk_extent_table_t *extent_table,
+     libcerror_error_t **error );
+
+int libvmdk_extent_table_get_extent_index_at_offset(
+     libvmdk_extent_table_t *extent_table,
+     off64_t offset,
+     int *extent_index,
+     off64_t *extent_data_offset,
+     libcerror_error_t **error );
+
+int libvmdk_extent_table_get_extent_at_offset(
+     libvmdk_extent_table_t *extent_table,
+     off64_t offset,
+     int *extent_index,
+     off64_t *extent_file_data_offset,
+     int *file_io_pool_entry,
+     libcerror_error_t **error );
+
 int libvmdk_extent_table_get_extent_file_at_offset(
      libvmdk_extent_table_t *extent_table,
      off64_t offset,
@@ -184,6 +216,18 @@ int libvmdk_extent_table_get_extent_file_at_offset(
      libvmdk_extent_file_t **extent_file,
      libcerror_error_t **error );
 
+int libvmdk_extent_table_get_extent_file_by_index(
+     libvmdk_extent_table_t *extent_table,
+     int extent_index,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_extent_file_t **extent_file,
+     libcerror_error_t **error );
+
+int libvmdk_extent_table_resize_grain_groups_caches(
+     libvmdk_extent_table_t *extent_table,
+     int number_of_cache_entries,
+     libcerror_error_t **error );
+
 int libvmdk_extent_table_set_extent_by_extent_values(
      libvmdk_extent_table_t *extent_table,
      libvmdk_extent_values_t *extent_values,
@@ -0,0 +1,1288 @@
+/*
+ * Grain cache functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvmdk_definitions.h"
+#include "libvmdk_grain_cache.h"
+#include "libvmdk_grain_data.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcthreads.h"
+
+/* Retrieves the shard of a specific grain
+ */
+#define libvmdk_grain_cache_get_shard( grain_cache, grain_index ) \
+	&( ( grain_cache )->shards[ ( grain_index ) % LIBVMDK_GRAIN_CACHE_NUMBER_OF_SHARDS ] )
+
+/* Retrieves the hash bucket index of a specific grain in a shard
+ */
+#define libvmdk_grain_cache_shard_get_bucket_index( shard, grain_index ) \
+	(int) ( ( ( grain_index ) / LIBVMDK_GRAIN_CACHE_NUMBER_OF_SHARDS ) & (uint64_t) ( ( shard )->number_of_buckets - 1 ) )
+
+/* Creates a grain cache
+ * The maximum number of entries is divided between the shards and rounded up
+ * Make sure the value grain_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_cache_initialize(
+     libvmdk_grain_cache_t **grain_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_grain_cache_initialize";
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	int shard_index       = 0;
+#endif
+
+	if( grain_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *grain_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid grain cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of entries value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*grain_cache = memory_allocate_structure(
+	                libvmdk_grain_cache_t );
+
+	if( *grain_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create grain cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *grain_cache,
+	     0,
+	     sizeof( libvmdk_grain_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear grain cache.",
+		 function );
+
+		memory_free(
+		 *grain_cache );
+
+		*grain_cache = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	for( shard_index = 0;
+	     shard_index < LIBVMDK_GRAIN_CACHE_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		if( libcthreads_mutex_initialize(
+		     &( ( *grain_cache )->shards[ shard_index ].mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+	}
+#endif
+	if( libvmdk_grain_cache_set_maximum_number_of_entries(
+	     *grain_cache,
+	     maximum_number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum number of entries.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *grain_cache != NULL )
+	{
+		libvmdk_grain_cache_free(
+		 grain_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a grain cache and the grain data it contains
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_cache_free(
+     libvmdk_grain_cache_t **grain_cache,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_cache_entry_t *entry = NULL;
+	libvmdk_grain_cache_shard_t *shard = NULL;
+	static char *function              = "libvmdk_grain_cache_free";
+	int queue_index                    = 0;
+	int result                         = 1;
+	int shard_index                    = 0;
+
+	if( grain_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *grain_cache != NULL )
+	{
+		for( shard_index = 0;
+		     shard_index < LIBVMDK_GRAIN_CACHE_NUMBER_OF_SHARDS;
+		     shard_index++ )
+		{
+			shard = &( ( *grain_cache )->shards[ shard_index ] );
+
+			for( queue_index = 0;
+			     queue_index < LIBVMDK_GRAIN_CACHE_NUMBER_OF_QUEUES;
+			     queue_index++ )
+			{
+				while( shard->queues[ queue_index ].first_entry != NULL )
+				{
+					entry = shard->queues[ queue_index ].first_entry;
+
+					shard->queues[ queue_index ].first_entry = entry->next_in_queue;
+
+					if( entry->grain_data != NULL )
+					{
+						if( libvmdk_grain_data_free(
+						     &( entry->grain_data ),
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+							 "%s: unable to free grain: %" PRIu64 " data.",
+							 function,
+							 entry->grain_index );
+
+							result = -1;
+						}
+					}
+					memory_free(
+					 entry );
+				}
+			}
+			if( shard->buckets != NULL )
+			{
+				memory_free(
+				 shard->buckets );
+			}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+			if( shard->mutex != NULL )
+			{
+				if( libcthreads_mutex_free(
+				     &( shard->mutex ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free shard: %d mutex.",
+					 function,
+					 shard_index );
+
+					result = -1;
+				}
+			}
+#endif
+		}
+		memory_free(
+		 *grain_cache );
+
+		*grain_cache = NULL;
+	}
+	return( result );
+}
+
+/* Removes an entry from the queue that contains it
+ */
+static void libvmdk_grain_cache_shard_remove_entry_from_queue(
+             libvmdk_grain_cache_shard_t *shard,
+             libvmdk_grain_cache_entry_t *entry )
+{
+	libvmdk_grain_cache_queue_t *queue = &( shard->queues[ entry->queue ] );
+
+	if( entry->previous_in_queue != NULL )
+	{
+		entry->previous_in_queue->next_in_queue = entry->next_in_queue;
+	}
+	else
+	{
+		queue->first_entry = entry->next_in_queue;
+	}
+	if( entry->next_in_queue != NULL )
+	{
+		entry->next_in_queue->previous_in_queue = entry->previous_in_queue;
+	}
+	else
+	{
+		queue->last_entry = entry->previous_in_queue;
+	}
+	entry->previous_in_queue = NULL;
+	entry->next_in_queue     = NULL;
+
+	queue->number_of_entries -= 1;
+}
+
+/* Adds an entry as the most recently used entry of a queue
+ */
+static void libvmdk_grain_cache_shard_prepend_entry_to_queue(
+             libvmdk_grain_cache_shard_t *shard,
+             libvmdk_grain_cache_entry_t *entry,
+             uint8_t queue_index )
+{
+	libvmdk_grain_cache_queue_t *queue = &( shard->queues[ queue_index ] );
+
+	entry->queue             = queue_index;
+	entry->previous_in_queue = NULL;
+	entry->next_in_queue     = queue->first_entry;
+
+	if( queue->first_entry != NULL )
+	{
+		queue->first_entry->previous_in_queue = entry;
+	}
+	else
+	{
+		queue->last_entry = entry;
+	}
+	queue->first_entry = entry;
+
+	queue->number_of_entries += 1;
+}
+
+/* Retrieves the entry of a specific grain from the hash buckets
+ * Returns the entry or NULL if not available
+ */
+static libvmdk_grain_cache_entry_t *libvmdk_grain_cache_shard_get_entry(
+                                     libvmdk_grain_cache_shard_t *shard,
+                                     uint64_t grain_index )
+{
+	libvmdk_grain_cache_entry_t *entry = NULL;
+
+	entry = shard->buckets[ libvmdk_grain_cache_shard_get_bucket_index( shard, grain_index ) ];
+
+	while( entry != NULL )
+	{
+		if( entry->grain_index == grain_index )
+		{
+			break;
+		}
+		entry = entry->next_in_bucket;
+	}
+	return( entry );
+}
+
+/* Removes an entry from its hash bucket and queue and frees it
+ * Returns 1 if successful or -1 on error
+ */
+static int libvmdk_grain_cache_shard_free_entry(
+            libvmdk_grain_cache_shard_t *shard,
+            libvmdk_grain_cache_entry_t *entry,
+            libcerror_error_t **error )
+{
+	libvmdk_grain_cache_entry_t **bucket_entry = NULL;
+	static char *function                      = "libvmdk_grain_cache_shard_free_entry";
+	int result                                 = 1;
+
+	bucket_entry = &( shard->buckets[ libvmdk_grain_cache_shard_get_bucket_index( shard, entry->grain_index ) ] );
+
+	while( *bucket_entry != NULL )
+	{
+		if( *bucket_entry == entry )
+		{
+			*bucket_entry = entry->next_in_bucket;
+
+			break;
+		}
+		bucket_entry = &( ( *bucket_entry )->next_in_bucket );
+	}
+	libvmdk_grain_cache_shard_remove_entry_from_queue(
+	 shard,
+	 entry );
+
+	if( entry->grain_data != NULL )
+	{
+		if( libvmdk_grain_data_free(
+		     &( entry->grain_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free grain: %" PRIu64 " data.",
+			 function,
+			 entry->grain_index );
+
+			result = -1;
+		}
+	}
+	memory_free(
+	 entry );
+
+	return( result );
+}
+
+/* Evicts the grain data of one entry
+ * The least recently used grain of the recent queue is evicted while the recent queue is over
+ * its maximum size and remembered in the ghost queue, otherwise the least recently used grain
+ * of the frequent queue is evicted. This keeps grains that are read once, such as those of
+ * a sequential scan, from evicting the grains that are read repeatedly
+ * Returns 1 if successful or -1 on error
+ */
+static int libvmdk_grain_cache_shard_evict_entry(
+            libvmdk_grain_cache_shard_t *shard,
+            libcerror_error_t **error )
+{
+	libvmdk_grain_cache_entry_t *entry = NULL;
+	static char *function              = "libvmdk_grain_cache_shard_evict_entry";
+
+	if( ( shard->queues[ LIBVMDK_GRAIN_CACHE_QUEUE_RECENT ].number_of_entries > shard->maximum_number_of_recent_entries )
+	 || ( shard->queues[ LIBVMDK_GRAIN_CACHE_QUEUE_FREQUENT ].number_of_entries == 0 ) )
+	{
+		entry = shard->queues[ LIBVMDK_GRAIN_CACHE_QUEUE_RECENT ].last_entry;
+
+		if( entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing recent entry.",
+			 function );
+
+			return( -1 );
+		}
+		libvmdk_grain_cache_shard_remove_entry_from_queue(
+		 shard,
+		 entry );
+
+		if( libvmdk_grain_data_free(
+		     &( entry->grain_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free grain: %" PRIu64 " data.",
+			 function,
+			 entry->grain_index );
+
+			return( -1 );
+		}
+		libvmdk_grain_cache_shard_prepend_entry_to_queue(
+		 shard,
+		 entry,
+		 LIBVMDK_GRAIN_CACHE_QUEUE_GHOST );
+
+		while( shard->queues[ LIBVMDK_GRAIN_CACHE_QUEUE_GHOST ].number_of_entries > shard->maximum_number_of_ghost_entries )
+		{
+			if( libvmdk_grain_cache_shard_free_entry(
+			     shard,
+			     shard->queues[ LIBVMDK_GRAIN_CACHE_QUEUE_GHOST ].last_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free ghost entry.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	else
+	{
+		if( libvmdk_grain_cache_shard_free_entry(
+		     shard,
+		     shard->queues[ LIBVMDK_GRAIN_CACHE_QUEUE_FREQUENT ].last_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free frequent entry.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the maximum number of entries of a shard
+ * Entries are evicted if the shard contains more than the maximum and the hash buckets are resized
+ * Returns 1 if successful or -1 on error
+ */
+static int libvmdk_grain_cache_shard_set_maximum_number_of_entries(
+            libvmdk_grain_cache_shard_t *shard,
+            int maximum_number_of_entries,
+            libcerror_error_t **error )
+{
+	libvmdk_grain_cache_entry_t **buckets = NULL;
+	libvmdk_grain_cache_entry_t *entry    = NULL;
+	static char *function                 = "libvmdk_grain_cache_shard_set_maximum_number_of_entries";
+	int bucket_index                      = 0;
+	int number_of_buckets                 = 1;
+	int queue_index                       = 0;
+
+	shard->maximum_number_of_entries        = maximum_number_of_entries;
+	shard->maximum_number_of_recent_entries = maximum_number_of_entries / 4;
+	shard->maximum_number_of_ghost_entries  = maximum_number_of_entries / 2;
+
+	if( shard->maximum_number_of_recent_entries < 1 )
+	{
+		shard->maximum_number_of_recent_entries = 1;
+	}
+	if( shard->maximum_number_of_ghost_entries < 1 )
+	{
+		shard->maximum_number_of_ghost_entries = 1;
+	}
+	while( ( shard->queues[ LIBVMDK_GRAIN_CACHE_QUEUE_RECENT ].number_of_entries
+	       + shard->queues[ LIBVMDK_GRAIN_CACHE_QUEUE_FREQUENT ].number_of_entries ) > shard->maximum_number_of_entries )
+	{
+		if( libvmdk_grain_cache_shard_evict_entry(
+		     shard,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to evict entry.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	while( shard->queues[ LIBVMDK_GRAIN_CACHE_QUEUE_GHOST ].number_of_entries > shard->maximum_number_of_ghost_entries )
+	{
+		if( libvmdk_grain_cache_shard_free_entry(
+		     shard,
+		     shard->queues[ LIBVMDK_GRAIN_CACHE_QUEUE_GHOST ].last_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free ghost entry.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* There is a bucket for every entry that can be resident or a ghost
+	 */
+	while( number_of_buckets < ( shard->maximum_number_of_entries + shard->maximum_number_of_ghost_entries ) )
+	{
+		number_of_buckets *= 2;
+	}
+	if( number_of_buckets == shard->number_of_buckets )
+	{
+		return( 1 );
+	}
+	buckets = (libvmdk_grain_cache_entry_t **) memory_allocate(
+	                                            sizeof( libvmdk_grain_cache_entry_t * ) * number_of_buckets );
+
+	if( buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buckets.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     buckets,
+	     0,
+	     sizeof( libvmdk_grain_cache_entry_t * ) * number_of_buckets ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buckets.",
+		 function );
+
+		memory_free(
+		 buckets );
+
+		return( -1 );
+	}
+	if( shard->buckets != NULL )
+	{
+		memory_free(
+		 shard->buckets );
+	}
+	shard->buckets           = buckets;
+	shard->number_of_buckets = number_of_buckets;
+
+	/* Every entry is in exactly one queue, hence the queues are used to rebuild the buckets
+	 */
+	for( queue_index = 0;
+	     queue_index < LIBVMDK_GRAIN_CACHE_NUMBER_OF_QUEUES;
+	     queue_index++ )
+	{
+		for( entry = shard->queues[ queue_index ].first_entry;
+		     entry != NULL;
+		     entry = entry->next_in_queue )
+		{
+			bucket_index = libvmdk_grain_cache_shard_get_bucket_index(
+			                shard,
+			                entry->grain_index );
+
+			entry->next_in_bucket   = buckets[ bucket_index ];
+			buckets[ bucket_index ] = entry;
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the maximum number of entries
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_cache_get_maximum_number_of_entries(
+     libvmdk_grain_cache_t *grain_cache,
+     int *maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_grain_cache_get_maximum_number_of_entries";
+
+	if( grain_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	*maximum_number_of_entries = grain_cache->maximum_number_of_entries;
+
+	return( 1 );
+}
+
+/* Sets the maximum number of entries
+ * The cache is resized in place, grains are evicted if the cache contains more than the maximum
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_cache_set_maximum_number_of_entries(
+     libvmdk_grain_cache_t *grain_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_cache_shard_t *shard  = NULL;
+	static char *function               = "libvmdk_grain_cache_set_maximum_number_of_entries";
+	int maximum_number_of_shard_entries = 0;
+	int result                          = 1;
+	int shard_index                     = 0;
+
+	if( grain_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of entries value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_number_of_shard_entries = maximum_number_of_entries / LIBVMDK_GRAIN_CACHE_NUMBER_OF_SHARDS;
+
+	if( ( maximum_number_of_entries % LIBVMDK_GRAIN_CACHE_NUMBER_OF_SHARDS ) != 0 )
+	{
+		maximum_number_of_shard_entries += 1;
+	}
+	for( shard_index = 0;
+	     shard_index < LIBVMDK_GRAIN_CACHE_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		shard = &( grain_cache->shards[ shard_index ] );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     shard->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		if( libvmdk_grain_cache_shard_set_maximum_number_of_entries(
+		     shard,
+		     maximum_number_of_shard_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set shard: %d maximum number of entries.",
+			 function,
+			 shard_index );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     shard->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		if( result != 1 )
+		{
+			return( -1 );
+		}
+	}
+	grain_cache->maximum_number_of_entries = maximum_number_of_entries;
+
+	return( 1 );
+}
+
+/* Retrieves the grain data of a specific grain
+ * The grain data remains owned by the cache, it stays valid until grain data is inserted
+ * or the cache is resized, which callers of the handle do while holding the cache mutex
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvmdk_grain_cache_get_grain_data(
+     libvmdk_grain_cache_t *grain_cache,
+     uint64_t grain_index,
+     libvmdk_grain_data_t **grain_data,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_cache_entry_t *entry = NULL;
+	libvmdk_grain_cache_shard_t *shard = NULL;
+	static char *function              = "libvmdk_grain_cache_get_grain_data";
+	int result                         = 0;
+
+	if( grain_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain data.",
+		 function );
+
+		return( -1 );
+	}
+	shard = libvmdk_grain_cache_get_shard(
+	         grain_cache,
+	         grain_index );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shard mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	entry = libvmdk_grain_cache_shard_get_entry(
+	         shard,
+	         grain_index );
+
+	if( ( entry != NULL )
+	 && ( entry->grain_data != NULL ) )
+	{
+		if( entry->queue == LIBVMDK_GRAIN_CACHE_QUEUE_FREQUENT )
+		{
+			libvmdk_grain_cache_shard_remove_entry_from_queue(
+			 shard,
+			 entry );
+
+			libvmdk_grain_cache_shard_prepend_entry_to_queue(
+			 shard,
+			 entry,
+			 LIBVMDK_GRAIN_CACHE_QUEUE_FREQUENT );
+		}
+		*grain_data = entry->grain_data;
+
+		shard->number_of_hits += 1;
+
+		result = 1;
+	}
+	else
+	{
+		shard->number_of_misses += 1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shard mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Copies the data of a specific grain into a buffer
+ * Only the shard of the grain is locked, hence this function can be called without the cache mutex
+ * A grain that is not available is counted as a miss
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvmdk_grain_cache_copy_grain_data(
+     libvmdk_grain_cache_t *grain_cache,
+     uint64_t grain_index,
+     size_t grain_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_cache_entry_t *entry = NULL;
+	libvmdk_grain_cache_shard_t *shard = NULL;
+	static char *function              = "libvmdk_grain_cache_copy_grain_data";
+	int result                         = 0;
+
+	if( grain_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	shard = libvmdk_grain_cache_get_shard(
+	         grain_cache,
+	         grain_index );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shard mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	entry = libvmdk_grain_cache_shard_get_entry(
+	         shard,
+	         grain_index );
+
+	if( ( entry != NULL )
+	 && ( entry->grain_data != NULL ) )
+	{
+		if( ( grain_data_offset > entry->grain_data->data_size )
+		 || ( buffer_size > ( entry->grain_data->data_size - grain_data_offset ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid grain data offset or buffer size value out of bounds.",
+			 function );
+
+			result = -1;
+		}
+		else if( memory_copy(
+		          buffer,
+		          &( ( entry->grain_data->data )[ grain_data_offset ] ),
+		          buffer_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy grain data to buffer.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			if( entry->queue == LIBVMDK_GRAIN_CACHE_QUEUE_FREQUENT )
+			{
+				libvmdk_grain_cache_shard_remove_entry_from_queue(
+				 shard,
+				 entry );
+
+				libvmdk_grain_cache_shard_prepend_entry_to_queue(
+				 shard,
+				 entry,
+				 LIBVMDK_GRAIN_CACHE_QUEUE_FREQUENT );
+			}
+			shard->number_of_hits += 1;
+
+			result = 1;
+		}
+	}
+	else
+	{
+		shard->number_of_misses += 1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shard mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Inserts the grain data of a specific grain
+ * The cache takes over the management of the grain data, also on error
+ * A grain that is not remembered as recently evicted enters the recent queue,
+ * otherwise it enters the frequent queue
+ * If the grain data was already inserted, by another reader, the grain data is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_cache_insert_grain_data(
+     libvmdk_grain_cache_t *grain_cache,
+     uint64_t grain_index,
+     libvmdk_grain_data_t *grain_data,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_cache_entry_t *entry = NULL;
+	libvmdk_grain_cache_shard_t *shard = NULL;
+	static char *function              = "libvmdk_grain_cache_insert_grain_data";
+	int bucket_index                   = 0;
+	int result                         = 1;
+
+	if( grain_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( grain_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain data.",
+		 function );
+
+		return( -1 );
+	}
+	shard = libvmdk_grain_cache_get_shard(
+	         grain_cache,
+	         grain_index );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shard mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	entry = libvmdk_grain_cache_shard_get_entry(
+	         shard,
+	         grain_index );
+
+	if( ( entry != NULL )
+	 && ( entry->grain_data != NULL ) )
+	{
+		result = 0;
+	}
+	/* Make room before looking up the entry since evicting can free a ghost entry
+	 */
+	while( ( result == 1 )
+	    && ( ( shard->queues[ LIBVMDK_GRAIN_CACHE_QUEUE_RECENT ].number_of_entries
+	         + shard->queues[ LIBVMDK_GRAIN_CACHE_QUEUE_FREQUENT ].number_of_entries ) >= shard->maximum_number_of_entries ) )
+	{
+		if( libvmdk_grain_cache_shard_evict_entry(
+		     shard,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to evict entry.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( result == 1 )
+	{
+		entry = libvmdk_grain_cache_shard_get_entry(
+		         shard,
+		         grain_index );
+
+		if( entry == NULL )
+		{
+			entry = memory_allocate_structure(
+			         libvmdk_grain_cache_entry_t );
+
+			if( entry == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create entry.",
+				 function );
+
+				result = -1;
+			}
+			else
+			{
+				bucket_index = libvmdk_grain_cache_shard_get_bucket_index(
+				                shard,
+				                grain_index );
+
+				entry->grain_index    = grain_index;
+				entry->grain_data     = grain_data;
+				entry->next_in_bucket = shard->buckets[ bucket_index ];
+
+				shard->buckets[ bucket_index ] = entry;
+
+				libvmdk_grain_cache_shard_prepend_entry_to_queue(
+				 shard,
+				 entry,
+				 LIBVMDK_GRAIN_CACHE_QUEUE_RECENT );
+			}
+		}
+		else
+		{
+			libvmdk_grain_cache_shard_remove_entry_from_queue(
+			 shard,
+			 entry );
+
+			entry->grain_data = grain_data;
+
+			libvmdk_grain_cache_shard_prepend_entry_to_queue(
+			 shard,
+			 entry,
+			 LIBVMDK_GRAIN_CACHE_QUEUE_FREQUENT );
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shard mutex.",
+		 function );
+
+		if( result == 1 )
+		{
+			return( -1 );
+		}
+		result = -1;
+	}
+#endif
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		libvmdk_grain_data_free(
+		 &grain_data,
+		 NULL );
+	}
+	return( 1 );
+
+on_error:
+	libvmdk_grain_data_free(
+	 &grain_data,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Retrieves the number of cache hits and misses of all shards
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_cache_get_statistics(
+     libvmdk_grain_cache_t *grain_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_cache_shard_t *shard = NULL;
+	static char *function              = "libvmdk_grain_cache_get_statistics";
+	uint64_t safe_number_of_hits       = 0;
+	uint64_t safe_number_of_misses     = 0;
+	int shard_index                    = 0;
+
+	if( grain_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+	for( shard_index = 0;
+	     shard_index < LIBVMDK_GRAIN_CACHE_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		shard = &( grain_cache->shards[ shard_index ] );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     shard->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		safe_number_of_hits   += shard->number_of_hits;
+		safe_number_of_misses += shard->number_of_misses;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     shard->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+	}
+	*number_of_hits   = safe_number_of_hits;
+	*number_of_misses = safe_number_of_misses;
+
+	return( 1 );
+}
+
@@ -0,0 +1,190 @@
+/*
+ * Grain cache functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_GRAIN_CACHE_H )
+#define _LIBVMDK_GRAIN_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_definitions.h"
+#include "libvmdk_grain_data.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvmdk_grain_cache_entry libvmdk_grain_cache_entry_t;
+
+struct libvmdk_grain_cache_entry
+{
+	/* The grain index
+	 */
+	uint64_t grain_index;
+
+	/* The grain data or NULL if the entry is a ghost entry
+	 * A ghost entry only remembers that the grain was recently evicted
+	 */
+	libvmdk_grain_data_t *grain_data;
+
+	/* The queue that contains the entry
+	 */
+	uint8_t queue;
+
+	/* The next entry in the same hash bucket
+	 */
+	libvmdk_grain_cache_entry_t *next_in_bucket;
+
+	/* The previous (more recently used) entry in the queue
+	 */
+	libvmdk_grain_cache_entry_t *previous_in_queue;
+
+	/* The next (less recently used) entry in the queue
+	 */
+	libvmdk_grain_cache_entry_t *next_in_queue;
+};
+
+typedef struct libvmdk_grain_cache_queue libvmdk_grain_cache_queue_t;
+
+struct libvmdk_grain_cache_queue
+{
+	/* The most recently used entry
+	 */
+	libvmdk_grain_cache_entry_t *first_entry;
+
+	/* The least recently used entry
+	 */
+	libvmdk_grain_cache_entry_t *last_entry;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+};
+
+typedef struct libvmdk_grain_cache_shard libvmdk_grain_cache_shard_t;
+
+struct libvmdk_grain_cache_shard
+{
+	/* The hash buckets, which contain both the resident and ghost entries
+	 */
+	libvmdk_grain_cache_entry_t **buckets;
+
+	/* The number of hash buckets, which is a power of 2
+	 */
+	int number_of_buckets;
+
+	/* The recent, ghost and frequent queues
+	 */
+	libvmdk_grain_cache_queue_t queues[ LIBVMDK_GRAIN_CACHE_NUMBER_OF_QUEUES ];
+
+	/* The maximum number of entries with grain data
+	 */
+	int maximum_number_of_entries;
+
+	/* The maximum number of entries in the recent queue
+	 */
+	int maximum_number_of_recent_entries;
+
+	/* The maximum number of entries in the ghost queue
+	 */
+	int maximum_number_of_ghost_entries;
+
+	/* The number of lookups that found the grain data
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of lookups that did not find the grain data
+	 */
+	uint64_t number_of_misses;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+typedef struct libvmdk_grain_cache libvmdk_grain_cache_t;
+
+struct libvmdk_grain_cache
+{
+	/* The shards
+	 */
+	libvmdk_grain_cache_shard_t shards[ LIBVMDK_GRAIN_CACHE_NUMBER_OF_SHARDS ];
+
+	/* The maximum number of entries with grain data
+	 */
+	int maximum_number_of_entries;
+};
+
+int libvmdk_grain_cache_initialize(
+     libvmdk_grain_cache_t **grain_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libvmdk_grain_cache_free(
+     libvmdk_grain_cache_t **grain_cache,
+     libcerror_error_t **error );
+
+int libvmdk_grain_cache_get_maximum_number_of_entries(
+     libvmdk_grain_cache_t *grain_cache,
+     int *maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libvmdk_grain_cache_set_maximum_number_of_entries(
+     libvmdk_grain_cache_t *grain_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libvmdk_grain_cache_get_grain_data(
+     libvmdk_grain_cache_t *grain_cache,
+     uint64_t grain_index,
+     libvmdk_grain_data_t **grain_data,
+     libcerror_error_t **error );
+
+int libvmdk_grain_cache_copy_grain_data(
+     libvmdk_grain_cache_t *grain_cache,
+     uint64_t grain_index,
+     size_t grain_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int libvmdk_grain_cache_insert_grain_data(
+     libvmdk_grain_cache_t *grain_cache,
+     uint64_t grain_index,
+     libvmdk_grain_data_t *grain_data,
+     libcerror_error_t **error );
+
+int libvmdk_grain_cache_get_statistics(
+     libvmdk_grain_cache_t *grain_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_GRAIN_CACHE_H ) */
+
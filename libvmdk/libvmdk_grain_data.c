@@ -32,6 +32,8 @@
 #include "libvmdk_libcerror.h"
 #include "libvmdk_libcnotify.h"
 #include "libvmdk_libfdata.h"
+#include "libvmdk_statistics.h"
+#include "libvmdk_trace.h"
 #include "libvmdk_unused.h"
 
 /* Creates grain data
@@ -226,6 +228,21 @@ ssize_t libvmdk_grain_data_read_compressed_header(
 
 		return( -1 );
 	}
+	if( libvmdk_statistics_add(
+	     io_handle->statistics,
+	     LIBVMDK_STATISTIC_READS,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update statistics.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -269,28 +286,233 @@ ssize_t libvmdk_grain_data_read_compressed_header(
 	return( read_count );
 }
 
+/* Reads the compressed data of a grain
+ * The compressed data is allocated by this function and must be freed by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_data_read_compressed_data(
+     libvmdk_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t grain_data_offset,
+     uint8_t **compressed_data,
+     size_t *compressed_data_size,
+     libcerror_error_t **error )
+{
+	uint8_t compressed_data_header[ 12 ];
+
+	uint8_t *safe_compressed_data      = NULL;
+	static char *function              = "libvmdk_grain_data_read_compressed_data";
+	ssize_t read_count                 = 0;
+	uint32_t safe_compressed_data_size = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compressed_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compressed data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     grain_data_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek grain offset: %" PRIi64 " in file IO pool entry: %d.",
+		 function,
+		 grain_data_offset,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	if( libvmdk_statistics_add(
+	     io_handle->statistics,
+	     LIBVMDK_STATISTIC_SEEKS,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update statistics.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_pool_read_buffer(
+		      file_io_pool,
+		      file_io_pool_entry,
+		      compressed_data_header,
+		      12,
+		      error );
+
+	if( read_count != (ssize_t) 12 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read compressed grain data header.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_statistics_add(
+	     io_handle->statistics,
+	     LIBVMDK_STATISTIC_READS,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update statistics.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( compressed_data_header[ 8 ] ),
+	 safe_compressed_data_size );
+
+	if( ( safe_compressed_data_size == 0 )
+	 || ( safe_compressed_data_size > (uint32_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid compressed data size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	safe_compressed_data = (uint8_t *) memory_allocate(
+	                                    sizeof( uint8_t ) * (size_t) safe_compressed_data_size );
+
+	if( safe_compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compressed data.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_pool_read_buffer(
+		      file_io_pool,
+		      file_io_pool_entry,
+		      safe_compressed_data,
+		      (size_t) safe_compressed_data_size,
+		      error );
+
+	if( read_count != (ssize_t) safe_compressed_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read compressed grain data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_statistics_add(
+	     io_handle->statistics,
+	     LIBVMDK_STATISTIC_READS,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update statistics.",
+		 function );
+
+		goto on_error;
+	}
+	*compressed_data      = safe_compressed_data;
+	*compressed_data_size = (size_t) safe_compressed_data_size;
+
+	return( 1 );
+
+on_error:
+	if( safe_compressed_data != NULL )
+	{
+		memory_free(
+		 safe_compressed_data );
+	}
+	return( -1 );
+}
+
 /* Reads a grain
- * Callback function for the grains list
+ * The grain data is created by this function and compressed grains are decompressed
  * Returns 1 if successful or -1 on error
  */
-int libvmdk_grain_data_read_element_data(
+int libvmdk_grain_data_read_file_io_pool(
      libvmdk_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
-     libfdata_list_element_t *element,
-     libfdata_cache_t *cache,
      int file_io_pool_entry,
      off64_t grain_data_offset,
      size64_t grain_data_size,
      uint32_t grain_data_flags,
-     uint8_t read_flags LIBVMDK_ATTRIBUTE_UNUSED,
+     libvmdk_grain_data_t **grain_data,
      libcerror_error_t **error )
 {
-	libvmdk_grain_data_t *grain_data = NULL;
-	uint8_t *compressed_data         = NULL;
-	static char *function            = "libvmdk_grain_data_read_element_data";
-	ssize_t read_count               = 0;
-
-	LIBVMDK_UNREFERENCED_PARAMETER( read_flags )
+	libvmdk_grain_data_t *safe_grain_data = NULL;
+	uint8_t *compressed_data              = NULL;
+	static char *function                 = "libvmdk_grain_data_read_file_io_pool";
+	ssize_t read_count                    = 0;
+	uint64_t start_timestamp              = 0;
+	uint8_t is_traced                     = 0;
 
 	if( io_handle == NULL )
 	{
@@ -303,6 +525,28 @@ int libvmdk_grain_data_read_element_data(
 
 		return( -1 );
 	}
+	if( grain_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *grain_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid grain data value already set.",
+		 function );
+
+		return( -1 );
+	}
 	if( ( grain_data_size == (size64_t) 0 )
 	 || ( grain_data_size > (size64_t) SSIZE_MAX ) )
 	{
@@ -326,6 +570,10 @@ int libvmdk_grain_data_read_element_data(
 
 		return( -1 );
 	}
+	is_traced = (uint8_t) libvmdk_trace_start_event(
+	                       io_handle->trace,
+	                       &start_timestamp );
+
 	if( libbfio_pool_seek_offset(
 	     file_io_pool,
 	     file_io_pool_entry,
@@ -344,6 +592,21 @@ int libvmdk_grain_data_read_element_data(
 
 		goto on_error;
 	}
+	if( libvmdk_statistics_add(
+	     io_handle->statistics,
+	     LIBVMDK_STATISTIC_SEEKS,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update statistics.",
+		 function );
+
+		goto on_error;
+	}
 	if( ( grain_data_flags & LIBVMDK_RANGE_FLAG_IS_COMPRESSED ) != 0 )
 	{
 		if( io_handle->grain_size > (size64_t) SSIZE_MAX )
@@ -358,7 +621,7 @@ int libvmdk_grain_data_read_element_data(
 			goto on_error;
 		}
 		if( libvmdk_grain_data_initialize(
-		     &grain_data,
+		     &safe_grain_data,
 		     (size_t) io_handle->grain_size,
 		     error ) != 1 )
 		{
@@ -372,7 +635,7 @@ int libvmdk_grain_data_read_element_data(
 			goto on_error;
 		}
 		read_count = libvmdk_grain_data_read_compressed_header(
-		              grain_data,
+		              safe_grain_data,
 		              io_handle,
 		              file_io_pool,
 		              file_io_pool_entry,
@@ -389,8 +652,8 @@ int libvmdk_grain_data_read_element_data(
 
 			goto on_error;
 		}
-		if( ( grain_data->compressed_data_size == 0 )
-		 || ( grain_data->compressed_data_size > (uint32_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+		if( ( safe_grain_data->compressed_data_size == 0 )
+		 || ( safe_grain_data->compressed_data_size > (uint32_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
 		{
 			libcerror_error_set(
 			 error,
@@ -402,7 +665,7 @@ int libvmdk_grain_data_read_element_data(
 			goto on_error;
 		}
 		compressed_data = (uint8_t *) memory_allocate(
-		                               sizeof( uint8_t ) * (size_t) grain_data->compressed_data_size );
+		                               sizeof( uint8_t ) * (size_t) safe_grain_data->compressed_data_size );
 
 		if( compressed_data == NULL )
 		{
@@ -419,10 +682,10 @@ int libvmdk_grain_data_read_element_data(
 			      file_io_pool,
 			      file_io_pool_entry,
 			      compressed_data,
-			      (size_t) grain_data->compressed_data_size,
+			      (size_t) safe_grain_data->compressed_data_size,
 			      error );
 
-		if( read_count != (ssize_t) grain_data->compressed_data_size )
+		if( read_count != (ssize_t) safe_grain_data->compressed_data_size )
 		{
 			libcerror_error_set(
 			 error,
@@ -433,12 +696,49 @@ int libvmdk_grain_data_read_element_data(
 
 			goto on_error;
 		}
+		if( is_traced != 0 )
+		{
+			if( libvmdk_trace_record_event(
+			     io_handle->trace,
+			     LIBVMDK_TRACE_EVENT_GRAIN_READ,
+			     start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to record trace event.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		is_traced = (uint8_t) libvmdk_trace_start_event(
+		                       io_handle->trace,
+		                       &start_timestamp );
+
+		if( libvmdk_statistics_add(
+		     io_handle->statistics,
+		     LIBVMDK_STATISTIC_READS,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			goto on_error;
+		}
 		if( libvmdk_decompress_data(
 		     compressed_data,
-		     (size_t) grain_data->compressed_data_size,
+		     (size_t) safe_grain_data->compressed_data_size,
 		     LIBVMDK_COMPRESSION_METHOD_DEFLATE,
-		     grain_data->data,
-		     &( grain_data->data_size ),
+		     safe_grain_data->data,
+		     &( safe_grain_data->data_size ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -450,6 +750,54 @@ int libvmdk_grain_data_read_element_data(
 
 			goto on_error;
 		}
+		if( is_traced != 0 )
+		{
+			if( libvmdk_trace_record_event(
+			     io_handle->trace,
+			     LIBVMDK_TRACE_EVENT_GRAIN_DECOMPRESSION,
+			     start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to record trace event.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libvmdk_statistics_add(
+		     io_handle->statistics,
+		     LIBVMDK_STATISTIC_GRAINS_DECOMPRESSED,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_statistics_add(
+		     io_handle->statistics,
+		     LIBVMDK_STATISTIC_COMPRESSED_BYTES_DECOMPRESSED,
+		     (uint64_t) safe_grain_data->compressed_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			goto on_error;
+		}
 		memory_free(
 		 compressed_data );
 
@@ -458,7 +806,7 @@ int libvmdk_grain_data_read_element_data(
 	else
 	{
 		if( libvmdk_grain_data_initialize(
-		     &grain_data,
+		     &safe_grain_data,
 		     (size_t) grain_data_size,
 		     error ) != 1 )
 		{
@@ -471,7 +819,7 @@ int libvmdk_grain_data_read_element_data(
 
 			goto on_error;
 		}
-		if( grain_data == NULL )
+		if( safe_grain_data == NULL )
 		{
 			libcerror_error_set(
 			 error,
@@ -485,7 +833,7 @@ int libvmdk_grain_data_read_element_data(
 		read_count = libbfio_pool_read_buffer(
 			      file_io_pool,
 			      file_io_pool_entry,
-			      grain_data->data,
+			      safe_grain_data->data,
 			      (size_t) grain_data_size,
 			      error );
 
@@ -500,6 +848,98 @@ int libvmdk_grain_data_read_element_data(
 
 			goto on_error;
 		}
+		if( is_traced != 0 )
+		{
+			if( libvmdk_trace_record_event(
+			     io_handle->trace,
+			     LIBVMDK_TRACE_EVENT_GRAIN_READ,
+			     start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to record trace event.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libvmdk_statistics_add(
+		     io_handle->statistics,
+		     LIBVMDK_STATISTIC_READS,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	*grain_data = safe_grain_data;
+
+	return( 1 );
+
+on_error:
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	if( safe_grain_data != NULL )
+	{
+		libvmdk_grain_data_free(
+		 &safe_grain_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a grain
+ * Callback function for the grains list
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_data_read_element_data(
+     libvmdk_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libfdata_list_element_t *element,
+     libfdata_cache_t *cache,
+     int file_io_pool_entry,
+     off64_t grain_data_offset,
+     size64_t grain_data_size,
+     uint32_t grain_data_flags,
+     uint8_t read_flags LIBVMDK_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_data_t *grain_data = NULL;
+	static char *function            = "libvmdk_grain_data_read_element_data";
+
+	LIBVMDK_UNREFERENCED_PARAMETER( read_flags )
+
+	if( libvmdk_grain_data_read_file_io_pool(
+	     io_handle,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     grain_data_offset,
+	     grain_data_size,
+	     grain_data_flags,
+	     &grain_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read grain data.",
+		 function );
+
+		goto on_error;
 	}
 	if( libfdata_list_element_set_element_value(
 	     element,
@@ -522,11 +962,6 @@ int libvmdk_grain_data_read_element_data(
 	return( 1 );
 
 on_error:
-	if( compressed_data != NULL )
-	{
-		memory_free(
-		 compressed_data );
-	}
 	if( grain_data != NULL )
 	{
 		libvmdk_grain_data_free(
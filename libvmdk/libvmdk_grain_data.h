@@ -70,6 +70,25 @@ ssize_t libvmdk_grain_data_read_compressed_header(
          int file_io_pool_entry,
          libcerror_error_t **error );
 
+int libvmdk_grain_data_read_compressed_data(
+     libvmdk_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t grain_data_offset,
+     uint8_t **compressed_data,
+     size_t *compressed_data_size,
+     libcerror_error_t **error );
+
+int libvmdk_grain_data_read_file_io_pool(
+     libvmdk_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t grain_data_offset,
+     size64_t grain_data_size,
+     uint32_t grain_data_flags,
+     libvmdk_grain_data_t **grain_data,
+     libcerror_error_t **error );
+
 int libvmdk_grain_data_read_element_data(
      libvmdk_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
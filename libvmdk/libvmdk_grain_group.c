@@ -140,7 +140,6 @@ int libvmdk_grain_group_fill(
      libfdata_list_t *grains_list,
      int grain_index,
      size64_t grain_size,
-     libbfio_pool_t *file_io_pool,
      int file_io_pool_entry,
      const uint8_t *grain_group_data,
      size_t grain_group_data_size,
@@ -148,13 +147,10 @@ int libvmdk_grain_group_fill(
      uint32_t extent_file_flags,
      libcerror_error_t **error )
 {
-	uint8_t compressed_data_header[ 12 ];
-
 	const uint8_t *grain_group_entry = NULL;
 	static char *function            = "libvmdk_grain_group_fill";
 	off64_t grain_data_offset        = 0;
 	size64_t grain_data_size         = 0;
-	ssize_t read_count               = 0;
 	uint32_t range_flags             = 0;
 	int element_index                = 0;
 	int grain_group_entry_index      = 0;
@@ -250,52 +246,11 @@ int libvmdk_grain_group_fill(
 		{
 			range_flags = LIBVMDK_RANGE_FLAG_IS_SPARSE;
 		}
-		if( ( extent_file_flags & LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION ) != 0 )
-		{
-			if( libbfio_pool_seek_offset(
-			     file_io_pool,
-			     file_io_pool_entry,
-			     grain_data_offset,
-			     SEEK_SET,
-			     error ) == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_SEEK_FAILED,
-				 "%s: unable to seek grain offset: %" PRIi64 " in file IO pool entry: %d.",
-				 function,
-				 grain_data_offset,
-				 file_io_pool_entry );
-
-				return( -1 );
-			}
-			read_count = libbfio_pool_read_buffer(
-				      file_io_pool,
-				      file_io_pool_entry,
-				      compressed_data_header,
-				      12,
-				      error );
-
-			if( read_count != (ssize_t) 12 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read compressed grain data header.",
-				 function );
-
-				return( -1 );
-			}
-			byte_stream_copy_to_uint32_little_endian(
-			 &( compressed_data_header[ 8 ] ),
-			 grain_data_size );
-		}
-		else
-		{
-			grain_data_size = grain_size;
-		}
+		/* The size of compressed grain data is stored in the compressed grain data header,
+		 * which is read when the grain is read, hence the grain size is used here
+		 */
+		grain_data_size = grain_size;
+
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
 		{
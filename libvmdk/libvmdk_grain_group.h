@@ -62,7 +62,6 @@ int libvmdk_grain_group_fill(
      libfdata_list_t *grains_list,
      int grain_index,
      size64_t grain_size,
-     libbfio_pool_t *file_io_pool,
      int file_io_pool_entry,
      const uint8_t *grain_group_data,
      size_t grain_group_data_size,
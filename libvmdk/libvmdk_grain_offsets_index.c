@@ -0,0 +1,570 @@
+/*
+ * Grain offsets index functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvmdk_definitions.h"
+#include "libvmdk_grain_offsets_index.h"
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcnotify.h"
+#include "libvmdk_libfdata.h"
+
+/* Creates a grain offsets index
+ * Make sure the value grain_offsets_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_offsets_index_initialize(
+     libvmdk_grain_offsets_index_t **grain_offsets_index,
+     size64_t grain_size,
+     uint32_t number_of_grain_groups,
+     uint32_t number_of_grain_table_entries,
+     uint32_t extent_file_flags,
+     libcerror_error_t **error )
+{
+	static char *function      = "libvmdk_grain_offsets_index_initialize";
+	size_t sector_numbers_size = 0;
+
+	if( grain_offsets_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain offsets index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *grain_offsets_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid grain offsets index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid grain size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_grain_groups == 0 )
+	 || ( number_of_grain_groups > (uint32_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of grain groups value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_grain_table_entries == 0 )
+	 || ( (size64_t) number_of_grain_groups * number_of_grain_table_entries > (size64_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint32_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of grain table entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*grain_offsets_index = memory_allocate_structure(
+	                        libvmdk_grain_offsets_index_t );
+
+	if( *grain_offsets_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create grain offsets index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *grain_offsets_index,
+	     0,
+	     sizeof( libvmdk_grain_offsets_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear grain offsets index.",
+		 function );
+
+		memory_free(
+		 *grain_offsets_index );
+
+		*grain_offsets_index = NULL;
+
+		return( -1 );
+	}
+	sector_numbers_size = (size_t) number_of_grain_groups * number_of_grain_table_entries * sizeof( uint32_t );
+
+	( *grain_offsets_index )->sector_numbers = (uint32_t *) memory_allocate(
+	                                                         sector_numbers_size );
+
+	if( ( *grain_offsets_index )->sector_numbers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sector numbers.",
+		 function );
+
+		goto on_error;
+	}
+	( *grain_offsets_index )->grain_group_flags = (uint8_t *) memory_allocate(
+	                                                           sizeof( uint8_t ) * number_of_grain_groups );
+
+	if( ( *grain_offsets_index )->grain_group_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create grain group flags.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *grain_offsets_index )->grain_group_flags,
+	     0,
+	     sizeof( uint8_t ) * number_of_grain_groups ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear grain group flags.",
+		 function );
+
+		goto on_error;
+	}
+	( *grain_offsets_index )->grain_size                    = grain_size;
+	( *grain_offsets_index )->number_of_grain_groups        = number_of_grain_groups;
+	( *grain_offsets_index )->number_of_grain_table_entries = number_of_grain_table_entries;
+
+	if( ( extent_file_flags & LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION ) != 0 )
+	{
+		( *grain_offsets_index )->grain_range_flags = LIBVMDK_RANGE_FLAG_IS_COMPRESSED;
+	}
+	return( 1 );
+
+on_error:
+	if( *grain_offsets_index != NULL )
+	{
+		if( ( *grain_offsets_index )->grain_group_flags != NULL )
+		{
+			memory_free(
+			 ( *grain_offsets_index )->grain_group_flags );
+		}
+		if( ( *grain_offsets_index )->sector_numbers != NULL )
+		{
+			memory_free(
+			 ( *grain_offsets_index )->sector_numbers );
+		}
+		memory_free(
+		 *grain_offsets_index );
+
+		*grain_offsets_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a grain offsets index
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_offsets_index_free(
+     libvmdk_grain_offsets_index_t **grain_offsets_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_grain_offsets_index_free";
+
+	if( grain_offsets_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain offsets index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *grain_offsets_index != NULL )
+	{
+		memory_free(
+		 ( *grain_offsets_index )->grain_group_flags );
+
+		memory_free(
+		 ( *grain_offsets_index )->sector_numbers );
+
+		memory_free(
+		 *grain_offsets_index );
+
+		*grain_offsets_index = NULL;
+	}
+	return( 1 );
+}
+
+/* Reads the grain table of a grain group into the grain offsets index
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_offsets_index_read_grain_group(
+     libvmdk_grain_offsets_index_t *grain_offsets_index,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint32_t grain_group_index,
+     off64_t grain_table_offset,
+     uint32_t grain_table_flags,
+     libcerror_error_t **error )
+{
+	uint8_t *grain_table_data    = NULL;
+	static char *function        = "libvmdk_grain_offsets_index_read_grain_group";
+	size_t grain_table_data_size = 0;
+	ssize_t read_count           = 0;
+
+	if( grain_offsets_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain offsets index.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_group_index >= grain_offsets_index->number_of_grain_groups )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid grain group index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( grain_table_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+	{
+		grain_offsets_index->grain_group_flags[ grain_group_index ] = LIBVMDK_GRAIN_GROUP_FLAG_IS_READ | LIBVMDK_GRAIN_GROUP_FLAG_IS_SPARSE;
+
+		return( 1 );
+	}
+	grain_table_data_size = (size_t) grain_offsets_index->number_of_grain_table_entries * sizeof( uint32_t );
+
+	grain_table_data = (uint8_t *) memory_allocate(
+	                                sizeof( uint8_t ) * grain_table_data_size );
+
+	if( grain_table_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create grain table data.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading grain table: %" PRIu32 " at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 grain_group_index,
+		 grain_table_offset,
+		 grain_table_offset );
+	}
+#endif
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     grain_table_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek grain table offset: %" PRIi64 ".",
+		 function,
+		 grain_table_offset );
+
+		goto on_error;
+	}
+	read_count = libbfio_pool_read_buffer(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              grain_table_data,
+	              grain_table_data_size,
+	              error );
+
+	if( read_count != (ssize_t) grain_table_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read grain table data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_grain_offsets_index_set_grain_group_data(
+	     grain_offsets_index,
+	     grain_group_index,
+	     grain_table_data,
+	     grain_table_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set grain group: %" PRIu32 " data.",
+		 function,
+		 grain_group_index );
+
+		goto on_error;
+	}
+	memory_free(
+	 grain_table_data );
+
+	return( 1 );
+
+on_error:
+	if( grain_table_data != NULL )
+	{
+		memory_free(
+		 grain_table_data );
+	}
+	return( -1 );
+}
+
+/* Sets the sector numbers of a grain group from grain table data
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_offsets_index_set_grain_group_data(
+     libvmdk_grain_offsets_index_t *grain_offsets_index,
+     uint32_t grain_group_index,
+     const uint8_t *grain_table_data,
+     size_t grain_table_data_size,
+     libcerror_error_t **error )
+{
+	uint32_t *sector_numbers         = NULL;
+	static char *function            = "libvmdk_grain_offsets_index_set_grain_group_data";
+	uint32_t grain_table_entry_index = 0;
+	uint8_t grain_group_flags        = LIBVMDK_GRAIN_GROUP_FLAG_IS_READ | LIBVMDK_GRAIN_GROUP_FLAG_IS_SPARSE;
+
+	if( grain_offsets_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain offsets index.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_group_index >= grain_offsets_index->number_of_grain_groups )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid grain group index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_table_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain table data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( grain_table_data_size > (size_t) SSIZE_MAX )
+	 || ( grain_table_data_size < ( (size_t) grain_offsets_index->number_of_grain_table_entries * sizeof( uint32_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid grain table data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	sector_numbers = &( grain_offsets_index->sector_numbers[ (size_t) grain_group_index * grain_offsets_index->number_of_grain_table_entries ] );
+
+	for( grain_table_entry_index = 0;
+	     grain_table_entry_index < grain_offsets_index->number_of_grain_table_entries;
+	     grain_table_entry_index++ )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 grain_table_data,
+		 sector_numbers[ grain_table_entry_index ] );
+
+		if( sector_numbers[ grain_table_entry_index ] != 0 )
+		{
+			grain_group_flags = LIBVMDK_GRAIN_GROUP_FLAG_IS_READ;
+		}
+		grain_table_data += sizeof( uint32_t );
+	}
+	grain_offsets_index->grain_group_flags[ grain_group_index ] = grain_group_flags;
+
+	return( 1 );
+}
+
+/* Retrieves the sector number of the grain at a specific offset
+ * A sector number of 0 represents a sparse grain
+ * Returns 1 if successful, 0 if the grain group has not been read or -1 on error
+ */
+int libvmdk_grain_offsets_index_get_grain_at_offset(
+     libvmdk_grain_offsets_index_t *grain_offsets_index,
+     off64_t offset,
+     uint32_t *grain_group_index,
+     uint32_t *sector_number,
+     libcerror_error_t **error )
+{
+	static char *function           = "libvmdk_grain_offsets_index_get_grain_at_offset";
+	uint64_t grain_number           = 0;
+	uint32_t safe_grain_group_index = 0;
+
+	if( grain_offsets_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain offsets index.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_offsets_index->grain_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid grain offsets index - missing grain size.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_group_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain group index.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector number.",
+		 function );
+
+		return( -1 );
+	}
+	grain_number = (uint64_t) offset / grain_offsets_index->grain_size;
+
+	if( grain_number >= ( (uint64_t) grain_offsets_index->number_of_grain_groups * grain_offsets_index->number_of_grain_table_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	safe_grain_group_index = (uint32_t) ( grain_number / grain_offsets_index->number_of_grain_table_entries );
+
+	*grain_group_index = safe_grain_group_index;
+
+	if( ( grain_offsets_index->grain_group_flags[ safe_grain_group_index ] & LIBVMDK_GRAIN_GROUP_FLAG_IS_READ ) == 0 )
+	{
+		return( 0 );
+	}
+	if( ( grain_offsets_index->grain_group_flags[ safe_grain_group_index ] & LIBVMDK_GRAIN_GROUP_FLAG_IS_SPARSE ) != 0 )
+	{
+		*sector_number = 0;
+	}
+	else
+	{
+		*sector_number = grain_offsets_index->sector_numbers[ grain_number ];
+	}
+	return( 1 );
+}
+
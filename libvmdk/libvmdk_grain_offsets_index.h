@@ -0,0 +1,106 @@
+/*
+ * Grain offsets index functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_GRAIN_OFFSETS_INDEX_H )
+#define _LIBVMDK_GRAIN_OFFSETS_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvmdk_grain_offsets_index libvmdk_grain_offsets_index_t;
+
+struct libvmdk_grain_offsets_index
+{
+	/* The grain size
+	 */
+	size64_t grain_size;
+
+	/* The number of grain groups
+	 */
+	uint32_t number_of_grain_groups;
+
+	/* The number of grain table entries per grain group
+	 */
+	uint32_t number_of_grain_table_entries;
+
+	/* The range flags of a non-sparse grain
+	 */
+	uint32_t grain_range_flags;
+
+	/* The grain sector numbers
+	 * Contains one 32-bit sector number per grain, where 0 represents a sparse grain
+	 */
+	uint32_t *sector_numbers;
+
+	/* The grain group flags
+	 * Contains one byte per grain group
+	 */
+	uint8_t *grain_group_flags;
+};
+
+int libvmdk_grain_offsets_index_initialize(
+     libvmdk_grain_offsets_index_t **grain_offsets_index,
+     size64_t grain_size,
+     uint32_t number_of_grain_groups,
+     uint32_t number_of_grain_table_entries,
+     uint32_t extent_file_flags,
+     libcerror_error_t **error );
+
+int libvmdk_grain_offsets_index_free(
+     libvmdk_grain_offsets_index_t **grain_offsets_index,
+     libcerror_error_t **error );
+
+int libvmdk_grain_offsets_index_read_grain_group(
+     libvmdk_grain_offsets_index_t *grain_offsets_index,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint32_t grain_group_index,
+     off64_t grain_table_offset,
+     uint32_t grain_table_flags,
+     libcerror_error_t **error );
+
+int libvmdk_grain_offsets_index_set_grain_group_data(
+     libvmdk_grain_offsets_index_t *grain_offsets_index,
+     uint32_t grain_group_index,
+     const uint8_t *grain_table_data,
+     size_t grain_table_data_size,
+     libcerror_error_t **error );
+
+int libvmdk_grain_offsets_index_get_grain_at_offset(
+     libvmdk_grain_offsets_index_t *grain_offsets_index,
+     off64_t offset,
+     uint32_t *grain_group_index,
+     uint32_t *sector_number,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_GRAIN_OFFSETS_INDEX_H ) */
+
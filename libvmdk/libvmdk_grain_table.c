@@ -27,6 +27,7 @@
 #include "libvmdk_definitions.h"
 #include "libvmdk_extent_table.h"
 #include "libvmdk_grain_data.h"
+#include "libvmdk_grain_offsets_index.h"
 #include "libvmdk_grain_table.h"
 #include "libvmdk_io_handle.h"
 #include "libvmdk_libbfio.h"
@@ -34,6 +35,8 @@
 #include "libvmdk_libcnotify.h"
 #include "libvmdk_libfcache.h"
 #include "libvmdk_libfdata.h"
+#include "libvmdk_statistics.h"
+#include "libvmdk_trace.h"
 #include "libvmdk_unused.h"
 
 /* Creates a grain table
@@ -131,6 +134,7 @@ int libvmdk_grain_table_free(
      libcerror_error_t **error )
 {
 	static char *function = "libvmdk_grain_table_free";
+	int result            = 1;
 
 	if( grain_table == NULL )
 	{
@@ -147,11 +151,791 @@ int libvmdk_grain_table_free(
 	{
 		/* The IO handle reference is freed elsewhere
 		 */
+		if( ( *grain_table )->grain_offsets_indexes != NULL )
+		{
+			if( libcdata_array_free(
+			     &( ( *grain_table )->grain_offsets_indexes ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_grain_offsets_index_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free grain offsets indexes array.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *grain_table );
 
 		*grain_table = NULL;
 	}
+	return( result );
+}
+
+/* Enables the grain offsets index
+ * The grain offsets index stores the sector numbers of the grains of an extent file
+ * in a single array, which is filled one grain table at a time when first needed
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_table_enable_grain_offsets_index(
+     libvmdk_grain_table_t *grain_table,
+     int number_of_extents,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_grain_table_enable_grain_offsets_index";
+
+	if( grain_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain table.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_table->grain_offsets_indexes != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid grain table - grain offsets indexes value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_extents <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of extents value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( grain_table->grain_offsets_indexes ),
+	     number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create grain offsets indexes array.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the data range of a grain at a specific offset from the grain offsets index
+ * Returns 1 if successful, 0 if the grain is sparse or -1 on error
+ */
+int libvmdk_grain_table_get_grain_range_from_offsets_index(
+     libvmdk_grain_table_t *grain_table,
+     uint64_t grain_index,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_extent_table_t *extent_table,
+     off64_t offset,
+     int *grain_file_index,
+     off64_t *grain_offset,
+     size64_t *grain_size,
+     uint32_t *grain_flags,
+     libcerror_error_t **error )
+{
+	libvmdk_extent_file_t *extent_file                 = NULL;
+	libvmdk_grain_offsets_index_t *grain_offsets_index = NULL;
+	static char *function                              = "libvmdk_grain_table_get_grain_range_from_offsets_index";
+	off64_t extent_file_data_offset                    = 0;
+	off64_t grain_table_offset                         = 0;
+	size64_t grain_table_size                          = 0;
+	uint32_t grain_group_index                         = 0;
+	uint32_t grain_table_flags                         = 0;
+	uint32_t sector_number                             = 0;
+	uint64_t start_timestamp                           = 0;
+	uint8_t is_traced                                  = 0;
+	int extent_number                                  = 0;
+	int file_io_pool_entry                             = 0;
+	int grain_table_file_index                         = 0;
+	int result                                         = 0;
+
+	if( grain_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain table.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_table->grain_offsets_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid grain table - missing grain offsets indexes.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_file_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain file index.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain size.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_extent_table_get_extent_at_offset(
+	     extent_table,
+	     offset,
+	     &extent_number,
+	     &extent_file_data_offset,
+	     &file_io_pool_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent at offset: %" PRIi64 " (0x%08" PRIx64 ") from extent table.",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     grain_table->grain_offsets_indexes,
+	     extent_number,
+	     (intptr_t **) &grain_offsets_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain offsets index: %d from array.",
+		 function,
+		 extent_number );
+
+		return( -1 );
+	}
+	if( grain_offsets_index == NULL )
+	{
+		if( libvmdk_extent_table_get_extent_file_at_offset(
+		     extent_table,
+		     offset,
+		     file_io_pool,
+		     &extent_number,
+		     &extent_file_data_offset,
+		     &extent_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent file at offset: %" PRIi64 " (0x%08" PRIx64 ") from extent table.",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		if( libvmdk_grain_offsets_index_initialize(
+		     &grain_offsets_index,
+		     extent_file->grain_size,
+		     extent_file->number_of_grain_directory_entries,
+		     extent_file->number_of_grain_table_entries,
+		     extent_file->flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create grain offsets index: %d.",
+			 function,
+			 extent_number );
+
+			return( -1 );
+		}
+		if( libcdata_array_set_entry_by_index(
+		     grain_table->grain_offsets_indexes,
+		     extent_number,
+		     (intptr_t *) grain_offsets_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set grain offsets index: %d in array.",
+			 function,
+			 extent_number );
+
+			libvmdk_grain_offsets_index_free(
+			 &grain_offsets_index,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	result = libvmdk_grain_offsets_index_get_grain_at_offset(
+	          grain_offsets_index,
+	          extent_file_data_offset,
+	          &grain_group_index,
+	          &sector_number,
+	          error );
+
+	if( result == 0 )
+	{
+		/* The grain table of the grain group has not been read yet
+		 */
+		if( extent_file == NULL )
+		{
+			if( libvmdk_extent_table_get_extent_file_at_offset(
+			     extent_table,
+			     offset,
+			     file_io_pool,
+			     &extent_number,
+			     &extent_file_data_offset,
+			     &extent_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve extent file at offset: %" PRIi64 " (0x%08" PRIx64 ") from extent table.",
+				 function,
+				 offset,
+				 offset );
+
+				return( -1 );
+			}
+		}
+		if( libfdata_list_get_element_by_index(
+		     extent_file->grain_groups_list,
+		     (int) grain_group_index,
+		     &grain_table_file_index,
+		     &grain_table_offset,
+		     &grain_table_size,
+		     &grain_table_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grain group: %" PRIu32 " from extent file: %d.",
+			 function,
+			 grain_group_index,
+			 extent_number );
+
+			return( -1 );
+		}
+		is_traced = (uint8_t) libvmdk_trace_start_event(
+		                       grain_table->io_handle->trace,
+		                       &start_timestamp );
+
+		if( libvmdk_grain_offsets_index_read_grain_group(
+		     grain_offsets_index,
+		     file_io_pool,
+		     grain_table_file_index,
+		     grain_group_index,
+		     grain_table_offset,
+		     grain_table_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read grain group: %" PRIu32 " of extent file: %d into grain offsets index.",
+			 function,
+			 grain_group_index,
+			 extent_number );
+
+			return( -1 );
+		}
+		if( is_traced != 0 )
+		{
+			if( libvmdk_trace_record_event(
+			     grain_table->io_handle->trace,
+			     LIBVMDK_TRACE_EVENT_GRAIN_TABLE_READ,
+			     start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to record trace event.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( libvmdk_statistics_add(
+		     grain_table->io_handle->statistics,
+		     LIBVMDK_STATISTIC_SEEKS,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			return( -1 );
+		}
+		if( libvmdk_statistics_add(
+		     grain_table->io_handle->statistics,
+		     LIBVMDK_STATISTIC_READS,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			return( -1 );
+		}
+		if( libvmdk_statistics_add(
+		     grain_table->io_handle->statistics,
+		     LIBVMDK_STATISTIC_GRAIN_TABLES_READ,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			return( -1 );
+		}
+		result = libvmdk_grain_offsets_index_get_grain_at_offset(
+		          grain_offsets_index,
+		          extent_file_data_offset,
+		          &grain_group_index,
+		          &sector_number,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain: %" PRIu64 " from grain offsets index: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 grain_index,
+		 extent_number,
+		 extent_file_data_offset,
+		 extent_file_data_offset );
+
+		return( -1 );
+	}
+	if( sector_number == 0 )
+	{
+		*grain_flags = LIBVMDK_RANGE_FLAG_IS_SPARSE;
+
+		return( 0 );
+	}
+	*grain_file_index = file_io_pool_entry;
+	*grain_offset     = (off64_t) sector_number * 512;
+	*grain_size       = grain_offsets_index->grain_size;
+	*grain_flags      = grain_offsets_index->grain_range_flags;
+
+	return( 1 );
+}
+
+/* Sets the grain offsets index of a specific extent
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_table_set_grain_offsets_index(
+     libvmdk_grain_table_t *grain_table,
+     int extent_index,
+     libvmdk_grain_offsets_index_t *grain_offsets_index,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_offsets_index_t *existing_grain_offsets_index = NULL;
+	static char *function                                       = "libvmdk_grain_table_set_grain_offsets_index";
+
+	if( grain_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain table.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_table->grain_offsets_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid grain table - missing grain offsets indexes.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     grain_table->grain_offsets_indexes,
+	     extent_index,
+	     (intptr_t **) &existing_grain_offsets_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain offsets index: %d from array.",
+		 function,
+		 extent_index );
+
+		return( -1 );
+	}
+	if( existing_grain_offsets_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid grain offsets index: %d value already set.",
+		 function,
+		 extent_index );
+
+		return( -1 );
+	}
+	if( libcdata_array_set_entry_by_index(
+	     grain_table->grain_offsets_indexes,
+	     extent_index,
+	     (intptr_t *) grain_offsets_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set grain offsets index: %d in array.",
+		 function,
+		 extent_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads all the grain tables of a specific extent into its grain offsets index
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_table_read_grain_offsets_index(
+     libvmdk_grain_table_t *grain_table,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_extent_table_t *extent_table,
+     int extent_index,
+     libvmdk_grain_offsets_index_t **grain_offsets_index,
+     libcerror_error_t **error )
+{
+	libvmdk_extent_file_t *extent_file                      = NULL;
+	libvmdk_grain_offsets_index_t *safe_grain_offsets_index = NULL;
+	static char *function                                   = "libvmdk_grain_table_read_grain_offsets_index";
+	off64_t grain_table_offset                              = 0;
+	size64_t grain_table_size                               = 0;
+	uint32_t grain_group_index                              = 0;
+	uint32_t grain_table_flags                              = 0;
+	uint64_t start_timestamp                                = 0;
+	uint8_t is_traced                                       = 0;
+	int grain_table_file_index                              = 0;
+
+	if( grain_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain table.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_table->grain_offsets_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid grain table - missing grain offsets indexes.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_offsets_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain offsets index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_extent_table_get_extent_file_by_index(
+	     extent_table,
+	     extent_index,
+	     file_io_pool,
+	     &extent_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent file: %d from extent table.",
+		 function,
+		 extent_index );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     grain_table->grain_offsets_indexes,
+	     extent_index,
+	     (intptr_t **) &safe_grain_offsets_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain offsets index: %d from array.",
+		 function,
+		 extent_index );
+
+		return( -1 );
+	}
+	if( safe_grain_offsets_index == NULL )
+	{
+		if( libvmdk_grain_offsets_index_initialize(
+		     &safe_grain_offsets_index,
+		     extent_file->grain_size,
+		     extent_file->number_of_grain_directory_entries,
+		     extent_file->number_of_grain_table_entries,
+		     extent_file->flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create grain offsets index: %d.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		if( libcdata_array_set_entry_by_index(
+		     grain_table->grain_offsets_indexes,
+		     extent_index,
+		     (intptr_t *) safe_grain_offsets_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set grain offsets index: %d in array.",
+			 function,
+			 extent_index );
+
+			libvmdk_grain_offsets_index_free(
+			 &safe_grain_offsets_index,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	for( grain_group_index = 0;
+	     grain_group_index < safe_grain_offsets_index->number_of_grain_groups;
+	     grain_group_index++ )
+	{
+		if( ( safe_grain_offsets_index->grain_group_flags[ grain_group_index ] & LIBVMDK_GRAIN_GROUP_FLAG_IS_READ ) != 0 )
+		{
+			continue;
+		}
+		if( libfdata_list_get_element_by_index(
+		     extent_file->grain_groups_list,
+		     (int) grain_group_index,
+		     &grain_table_file_index,
+		     &grain_table_offset,
+		     &grain_table_size,
+		     &grain_table_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grain group: %" PRIu32 " from extent file: %d.",
+			 function,
+			 grain_group_index,
+			 extent_index );
+
+			return( -1 );
+		}
+		is_traced = (uint8_t) libvmdk_trace_start_event(
+		                       grain_table->io_handle->trace,
+		                       &start_timestamp );
+
+		if( libvmdk_grain_offsets_index_read_grain_group(
+		     safe_grain_offsets_index,
+		     file_io_pool,
+		     grain_table_file_index,
+		     grain_group_index,
+		     grain_table_offset,
+		     grain_table_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read grain group: %" PRIu32 " of extent file: %d into grain offsets index.",
+			 function,
+			 grain_group_index,
+			 extent_index );
+
+			return( -1 );
+		}
+		if( is_traced != 0 )
+		{
+			if( libvmdk_trace_record_event(
+			     grain_table->io_handle->trace,
+			     LIBVMDK_TRACE_EVENT_GRAIN_TABLE_READ,
+			     start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to record trace event.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( libvmdk_statistics_add(
+		     grain_table->io_handle->statistics,
+		     LIBVMDK_STATISTIC_SEEKS,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			return( -1 );
+		}
+		if( libvmdk_statistics_add(
+		     grain_table->io_handle->statistics,
+		     LIBVMDK_STATISTIC_READS,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			return( -1 );
+		}
+		if( libvmdk_statistics_add(
+		     grain_table->io_handle->statistics,
+		     LIBVMDK_STATISTIC_GRAIN_TABLES_READ,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	*grain_offsets_index = safe_grain_offsets_index;
+
 	return( 1 );
 }
 
@@ -181,17 +965,223 @@ int libvmdk_grain_table_grain_is_sparse_at_offset(
 	int grains_list_index              = 0;
 	int result                         = 0;
 
-	if( grain_table == NULL )
+	if( grain_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain table.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_table->grain_offsets_indexes != NULL )
+	{
+		result = libvmdk_grain_table_get_grain_range_from_offsets_index(
+		          grain_table,
+		          grain_index,
+		          file_io_pool,
+		          extent_table,
+		          offset,
+		          &grain_file_index,
+		          &grain_offset,
+		          &grain_size,
+		          &grain_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grain: %" PRIu64 " range from grain offsets index.",
+			 function,
+			 grain_index );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 1 );
+		}
+		return( 0 );
+	}
+	if( libvmdk_extent_table_get_extent_file_at_offset(
+	     extent_table,
+	     offset,
+	     file_io_pool,
+	     &extent_number,
+	     &extent_file_data_offset,
+	     &extent_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent file at offset: %" PRIi64 " (0x%08" PRIx64 ") from extent table.",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	result = libvmdk_extent_file_grain_group_is_sparse_at_offset(
+	          extent_file,
+	          extent_file_data_offset,
+	          &grain_groups_list_index,
+	          &grain_group_data_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain group from extent file: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 extent_number,
+		 extent_file_data_offset,
+		 extent_file_data_offset );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		return( 1 );
+	}
+	if( libvmdk_extent_file_get_grain_group_at_offset(
+	     extent_file,
+	     file_io_pool,
+	     extent_file_data_offset,
+	     &grain_groups_list_index,
+	     &grain_group_data_offset,
+	     &grains_list,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain group from extent file: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 extent_number,
+		 extent_file_data_offset,
+		 extent_file_data_offset );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_element_at_offset(
+	     grains_list,
+	     grain_group_data_offset,
+	     &grains_list_index,
+	     &grain_data_offset,
+	     &grain_file_index,
+	     &grain_offset,
+	     &grain_size,
+	     &grain_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain: %" PRIu64 " from grain group: %d in extent file: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 grain_index,
+		 grain_groups_list_index,
+		 extent_number,
+		 extent_file_data_offset,
+		 extent_file_data_offset );
+
+		return( -1 );
+	}
+	if( ( grain_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves the data range of a grain at a specific offset
+ * Returns 1 if successful, 0 if the grain is sparse or -1 on error
+ */
+int libvmdk_grain_table_get_grain_range_at_offset(
+     libvmdk_grain_table_t *grain_table,
+     uint64_t grain_index,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_extent_table_t *extent_table,
+     off64_t offset,
+     int *grain_file_index,
+     off64_t *grain_offset,
+     size64_t *grain_size,
+     uint32_t *grain_flags,
+     libcerror_error_t **error )
+{
+	libvmdk_extent_file_t *extent_file = NULL;
+	libfdata_list_t *grains_list       = NULL;
+	static char *function              = "libvmdk_grain_table_get_grain_range_at_offset";
+	off64_t extent_file_data_offset    = 0;
+	off64_t grain_data_offset          = 0;
+	off64_t grain_group_data_offset    = 0;
+	int extent_number                  = 0;
+	int grain_groups_list_index        = 0;
+	int grains_list_index              = 0;
+	int result                         = 0;
+
+	if( grain_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain table.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_flags == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid grain table.",
+		 "%s: invalid grain flags.",
 		 function );
 
 		return( -1 );
 	}
+	if( grain_table->grain_offsets_indexes != NULL )
+	{
+		result = libvmdk_grain_table_get_grain_range_from_offsets_index(
+		          grain_table,
+		          grain_index,
+		          file_io_pool,
+		          extent_table,
+		          offset,
+		          grain_file_index,
+		          grain_offset,
+		          grain_size,
+		          grain_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grain: %" PRIu64 " range from grain offsets index.",
+			 function,
+			 grain_index );
+
+			return( -1 );
+		}
+		return( result );
+	}
 	if( libvmdk_extent_table_get_extent_file_at_offset(
 	     extent_table,
 	     offset,
@@ -235,7 +1225,7 @@ int libvmdk_grain_table_grain_is_sparse_at_offset(
 	}
 	else if( result != 0 )
 	{
-		return( 1 );
+		return( 0 );
 	}
 	if( libvmdk_extent_file_get_grain_group_at_offset(
 	     extent_file,
@@ -263,10 +1253,10 @@ int libvmdk_grain_table_grain_is_sparse_at_offset(
 	     grain_group_data_offset,
 	     &grains_list_index,
 	     &grain_data_offset,
-	     &grain_file_index,
-	     &grain_offset,
-	     &grain_size,
-	     &grain_flags,
+	     grain_file_index,
+	     grain_offset,
+	     grain_size,
+	     grain_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -283,11 +1273,11 @@ int libvmdk_grain_table_grain_is_sparse_at_offset(
 
 		return( -1 );
 	}
-	if( ( grain_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+	if( ( *grain_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
 	{
-		return( 1 );
+		return( 0 );
 	}
-	return( 0 );
+	return( 1 );
 }
 
 /* Retrieves the grain data of a grain at a specific offset
@@ -393,3 +1383,482 @@ int libvmdk_grain_table_get_grain_data_at_offset(
 	return( 1 );
 }
 
+/* Resets a grain cursor
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_table_reset_grain_cursor(
+     libvmdk_grain_cursor_t *grain_cursor,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_grain_table_reset_grain_cursor";
+
+	if( grain_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     grain_cursor,
+	     0,
+	     sizeof( libvmdk_grain_cursor_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear grain cursor.",
+		 function );
+
+		return( -1 );
+	}
+	grain_cursor->extent_index            = -1;
+	grain_cursor->grain_groups_list_index = -1;
+	grain_cursor->grains_list_index       = -1;
+
+	return( 1 );
+}
+
+/* Resolves the grain at a specific offset into the grain cursor
+ * The extent and grain group of the previous grain are reused if the offset is in the same grain group
+ * Returns 1 if successful, 0 if the grain is sparse or -1 on error
+ */
+int libvmdk_grain_table_resolve_grain_at_offset(
+     libvmdk_grain_table_t *grain_table,
+     libvmdk_grain_cursor_t *grain_cursor,
+     uint64_t grain_index,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_extent_table_t *extent_table,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	libvmdk_extent_file_t *extent_file = NULL;
+	libfdata_list_t *grains_list       = NULL;
+	static char *function              = "libvmdk_grain_table_resolve_grain_at_offset";
+	size64_t grain_group_size          = 0;
+	off64_t extent_file_data_offset    = 0;
+	off64_t grain_group_data_offset    = 0;
+	int result                         = 0;
+
+	if( grain_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain table.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_table->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid grain table - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_table->io_handle->grain_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid grain table - invalid IO handle - grain size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	grain_cursor->grain_index       = grain_index;
+	grain_cursor->offset            = offset;
+	grain_cursor->grains_list_index = -1;
+	grain_cursor->grain_data_offset = (off64_t) ( (size64_t) offset % grain_table->io_handle->grain_size );
+	grain_cursor->grain_file_index  = -1;
+	grain_cursor->grain_offset      = 0;
+	grain_cursor->grain_size        = 0;
+	grain_cursor->grain_flags       = 0;
+
+	if( grain_table->grain_offsets_indexes != NULL )
+	{
+		result = libvmdk_grain_table_get_grain_range_from_offsets_index(
+		          grain_table,
+		          grain_index,
+		          file_io_pool,
+		          extent_table,
+		          offset,
+		          &( grain_cursor->grain_file_index ),
+		          &( grain_cursor->grain_offset ),
+		          &( grain_cursor->grain_size ),
+		          &( grain_cursor->grain_flags ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grain: %" PRIu64 " range from grain offsets index.",
+			 function,
+			 grain_index );
+
+			return( -1 );
+		}
+		return( result );
+	}
+	if( ( grain_cursor->extent_index >= 0 )
+	 && ( offset >= grain_cursor->extent_offset )
+	 && ( (size64_t) ( offset - grain_cursor->extent_offset ) < grain_cursor->extent_size ) )
+	{
+		extent_file_data_offset = offset - grain_cursor->extent_offset;
+	}
+	else
+	{
+		if( libvmdk_extent_table_get_extent_file_at_offset(
+		     extent_table,
+		     offset,
+		     file_io_pool,
+		     &( grain_cursor->extent_index ),
+		     &extent_file_data_offset,
+		     &extent_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent file at offset: %" PRIi64 " (0x%08" PRIx64 ") from extent table.",
+			 function,
+			 offset,
+			 offset );
+
+			goto on_error;
+		}
+		if( extent_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing extent file: %d.",
+			 function,
+			 grain_cursor->extent_index );
+
+			goto on_error;
+		}
+		grain_cursor->extent_offset           = offset - extent_file_data_offset;
+		grain_cursor->extent_size             = extent_file->storage_media_size;
+		grain_cursor->grain_groups_list_index = -1;
+	}
+	if( ( grain_cursor->grain_groups_list_index < 0 )
+	 || ( extent_file_data_offset < grain_cursor->grain_group_start_offset )
+	 || ( extent_file_data_offset >= grain_cursor->grain_group_end_offset ) )
+	{
+		if( extent_file == NULL )
+		{
+			if( libvmdk_extent_table_get_extent_file_by_index(
+			     extent_table,
+			     grain_cursor->extent_index,
+			     file_io_pool,
+			     &extent_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve extent file: %d from extent table.",
+				 function,
+				 grain_cursor->extent_index );
+
+				goto on_error;
+			}
+		}
+		result = libvmdk_extent_file_grain_group_is_sparse_at_offset(
+		          extent_file,
+		          extent_file_data_offset,
+		          &( grain_cursor->grain_groups_list_index ),
+		          &grain_group_data_offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grain group from extent file: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 grain_cursor->extent_index,
+			 extent_file_data_offset,
+			 extent_file_data_offset );
+
+			goto on_error;
+		}
+		grain_group_size = (size64_t) extent_file->number_of_grain_table_entries * grain_table->io_handle->grain_size;
+
+		grain_cursor->grain_group_is_sparse    = (uint8_t) result;
+		grain_cursor->grain_group_start_offset = extent_file_data_offset - grain_group_data_offset;
+		grain_cursor->grain_group_end_offset   = grain_cursor->extent_size;
+
+		if( grain_group_size < ( grain_cursor->extent_size - grain_cursor->grain_group_start_offset ) )
+		{
+			grain_cursor->grain_group_end_offset = grain_cursor->grain_group_start_offset + (off64_t) grain_group_size;
+		}
+	}
+	else
+	{
+		grain_group_data_offset = extent_file_data_offset - grain_cursor->grain_group_start_offset;
+	}
+	if( grain_cursor->grain_group_is_sparse != 0 )
+	{
+		grain_cursor->grain_flags = LIBVMDK_RANGE_FLAG_IS_SPARSE;
+
+		return( 0 );
+	}
+	if( extent_file == NULL )
+	{
+		if( libvmdk_extent_table_get_extent_file_by_index(
+		     extent_table,
+		     grain_cursor->extent_index,
+		     file_io_pool,
+		     &extent_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent file: %d from extent table.",
+			 function,
+			 grain_cursor->extent_index );
+
+			goto on_error;
+		}
+	}
+	if( libvmdk_extent_file_get_grain_group_by_index(
+	     extent_file,
+	     file_io_pool,
+	     grain_cursor->grain_groups_list_index,
+	     &grains_list,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain group: %d from extent file: %d.",
+		 function,
+		 grain_cursor->grain_groups_list_index,
+		 grain_cursor->extent_index );
+
+		goto on_error;
+	}
+	grain_cursor->grains_list_index = (int) ( (size64_t) grain_group_data_offset / grain_table->io_handle->grain_size );
+
+	if( libfdata_list_get_element_by_index(
+	     grains_list,
+	     grain_cursor->grains_list_index,
+	     &( grain_cursor->grain_file_index ),
+	     &( grain_cursor->grain_offset ),
+	     &( grain_cursor->grain_size ),
+	     &( grain_cursor->grain_flags ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain: %" PRIu64 " from grain group: %d in extent file: %d.",
+		 function,
+		 grain_index,
+		 grain_cursor->grain_groups_list_index,
+		 grain_cursor->extent_index );
+
+		goto on_error;
+	}
+	if( ( grain_cursor->grain_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+	grain_cursor->extent_index            = -1;
+	grain_cursor->grain_groups_list_index = -1;
+	grain_cursor->grains_list_index       = -1;
+
+	return( -1 );
+}
+
+/* Retrieves the grain data of the grain resolved by the grain cursor
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_table_get_grain_data_at_grain_cursor(
+     libvmdk_grain_table_t *grain_table,
+     libvmdk_grain_cursor_t *grain_cursor,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_extent_table_t *extent_table,
+     libfcache_cache_t *grains_cache,
+     libvmdk_grain_data_t **grain_data,
+     off64_t *grain_data_offset,
+     libcerror_error_t **error )
+{
+	libvmdk_extent_file_t *extent_file = NULL;
+	libfdata_list_t *grains_list       = NULL;
+	static char *function              = "libvmdk_grain_table_get_grain_data_at_grain_cursor";
+
+	if( grain_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain table.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain data offset.",
+		 function );
+
+		return( -1 );
+	}
+	/* Grains resolved from the grain offsets index are not part of a grains list
+	 */
+	if( ( grain_cursor->extent_index < 0 )
+	 || ( grain_cursor->grain_groups_list_index < 0 )
+	 || ( grain_cursor->grains_list_index < 0 ) )
+	{
+		if( libvmdk_grain_table_get_grain_data_at_offset(
+		     grain_table,
+		     grain_cursor->grain_index,
+		     file_io_pool,
+		     extent_table,
+		     grains_cache,
+		     grain_cursor->offset,
+		     grain_data,
+		     grain_data_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grain: %" PRIu64 " data.",
+			 function,
+			 grain_cursor->grain_index );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( libvmdk_extent_table_get_extent_file_by_index(
+	     extent_table,
+	     grain_cursor->extent_index,
+	     file_io_pool,
+	     &extent_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent file: %d from extent table.",
+		 function,
+		 grain_cursor->extent_index );
+
+		return( -1 );
+	}
+	if( libvmdk_extent_file_get_grain_group_by_index(
+	     extent_file,
+	     file_io_pool,
+	     grain_cursor->grain_groups_list_index,
+	     &grains_list,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain group: %d from extent file: %d.",
+		 function,
+		 grain_cursor->grain_groups_list_index,
+		 grain_cursor->extent_index );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_element_value_by_index(
+	     grains_list,
+	     (intptr_t *) file_io_pool,
+	     (libfdata_cache_t *) grains_cache,
+	     grain_cursor->grains_list_index,
+	     (intptr_t **) grain_data,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain: %" PRIu64 " data from grain group: %d in extent file: %d.",
+		 function,
+		 grain_cursor->grain_index,
+		 grain_cursor->grain_groups_list_index,
+		 grain_cursor->extent_index );
+
+		return( -1 );
+	}
+	*grain_data_offset = grain_cursor->grain_data_offset;
+
+	return( 1 );
+}
+
@@ -27,8 +27,10 @@
 
 #include "libvmdk_extent_table.h"
 #include "libvmdk_grain_data.h"
+#include "libvmdk_grain_offsets_index.h"
 #include "libvmdk_io_handle.h"
 #include "libvmdk_libbfio.h"
+#include "libvmdk_libcdata.h"
 #include "libvmdk_libcerror.h"
 #include "libvmdk_libfcache.h"
 #include "libvmdk_libfdata.h"
@@ -56,6 +58,80 @@ struct libvmdk_grain_table
 	/* The last grain offset that was compared
 	 */
 	int last_grain_offset_compared;
+
+	/* The grain offsets indexes
+	 * Contains a grain offsets index per extent or NULL if not used
+	 */
+	libcdata_array_t *grain_offsets_indexes;
+};
+
+typedef struct libvmdk_grain_cursor libvmdk_grain_cursor_t;
+
+/* The grain cursor resolves a grain once and remembers the extent and grain group it is in
+ * so that the next grain in the same grain group can be resolved without looking them up again
+ * The grain cursor only contains indexes and offsets and remains valid when the caches change
+ */
+struct libvmdk_grain_cursor
+{
+	/* The extent index or -1 if not set
+	 */
+	int extent_index;
+
+	/* The (media) offset of the extent
+	 */
+	off64_t extent_offset;
+
+	/* The (media) size of the extent
+	 */
+	size64_t extent_size;
+
+	/* The grain groups list index or -1 if not set
+	 */
+	int grain_groups_list_index;
+
+	/* The start offset of the grain group relative to the start of the extent
+	 */
+	off64_t grain_group_start_offset;
+
+	/* The end offset of the grain group relative to the start of the extent
+	 */
+	off64_t grain_group_end_offset;
+
+	/* Value to indicate the grain group is sparse
+	 */
+	uint8_t grain_group_is_sparse;
+
+	/* The grain index
+	 */
+	uint64_t grain_index;
+
+	/* The (media) offset the grain was resolved at
+	 */
+	off64_t offset;
+
+	/* The grains list index or -1 if not set
+	 */
+	int grains_list_index;
+
+	/* The offset relative to the start of the grain
+	 */
+	off64_t grain_data_offset;
+
+	/* The grain file IO pool entry
+	 */
+	int grain_file_index;
+
+	/* The grain offset (in the extent file)
+	 */
+	off64_t grain_offset;
+
+	/* The grain size (in the extent file)
+	 */
+	size64_t grain_size;
+
+	/* The grain range flags
+	 */
+	uint32_t grain_flags;
 };
 
 int libvmdk_grain_table_initialize(
@@ -67,6 +143,37 @@ int libvmdk_grain_table_free(
      libvmdk_grain_table_t **grain_table,
      libcerror_error_t **error );
 
+int libvmdk_grain_table_enable_grain_offsets_index(
+     libvmdk_grain_table_t *grain_table,
+     int number_of_extents,
+     libcerror_error_t **error );
+
+int libvmdk_grain_table_get_grain_range_from_offsets_index(
+     libvmdk_grain_table_t *grain_table,
+     uint64_t grain_index,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_extent_table_t *extent_table,
+     off64_t offset,
+     int *grain_file_index,
+     off64_t *grain_offset,
+     size64_t *grain_size,
+     uint32_t *grain_flags,
+     libcerror_error_t **error );
+
+int libvmdk_grain_table_set_grain_offsets_index(
+     libvmdk_grain_table_t *grain_table,
+     int extent_index,
+     libvmdk_grain_offsets_index_t *grain_offsets_index,
+     libcerror_error_t **error );
+
+int libvmdk_grain_table_read_grain_offsets_index(
+     libvmdk_grain_table_t *grain_table,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_extent_table_t *extent_table,
+     int extent_index,
+     libvmdk_grain_offsets_index_t **grain_offsets_index,
+     libcerror_error_t **error );
+
 int libvmdk_grain_table_grain_is_sparse_at_offset(
      libvmdk_grain_table_t *grain_table,
      uint64_t grain_index,
@@ -75,6 +182,18 @@ int libvmdk_grain_table_grain_is_sparse_at_offset(
      off64_t offset,
      libcerror_error_t **error );
 
+int libvmdk_grain_table_get_grain_range_at_offset(
+     libvmdk_grain_table_t *grain_table,
+     uint64_t grain_index,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_extent_table_t *extent_table,
+     off64_t offset,
+     int *grain_file_index,
+     off64_t *grain_offset,
+     size64_t *grain_size,
+     uint32_t *grain_flags,
+     libcerror_error_t **error );
+
 int libvmdk_grain_table_get_grain_data_at_offset(
      libvmdk_grain_table_t *grain_table,
      uint64_t grain_index,
@@ -86,6 +205,29 @@ int libvmdk_grain_table_get_grain_data_at_offset(
      off64_t *grain_data_offset,
      libcerror_error_t **error );
 
+int libvmdk_grain_table_reset_grain_cursor(
+     libvmdk_grain_cursor_t *grain_cursor,
+     libcerror_error_t **error );
+
+int libvmdk_grain_table_resolve_grain_at_offset(
+     libvmdk_grain_table_t *grain_table,
+     libvmdk_grain_cursor_t *grain_cursor,
+     uint64_t grain_index,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_extent_table_t *extent_table,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int libvmdk_grain_table_get_grain_data_at_grain_cursor(
+     libvmdk_grain_table_t *grain_table,
+     libvmdk_grain_cursor_t *grain_cursor,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_extent_table_t *extent_table,
+     libfcache_cache_t *grains_cache,
+     libvmdk_grain_data_t **grain_data,
+     off64_t *grain_data_offset,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -26,6 +26,8 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include "libvmdk_cache_budget.h"
+#include "libvmdk_compression.h"
 #include "libvmdk_debug.h"
 #include "libvmdk_definitions.h"
 #include "libvmdk_descriptor_file.h"
@@ -34,6 +36,7 @@
 #include "libvmdk_extent_table.h"
 #include "libvmdk_extent_values.h"
 #include "libvmdk_handle.h"
+#include "libvmdk_grain_cache.h"
 #include "libvmdk_grain_data.h"
 #include "libvmdk_grain_table.h"
 #include "libvmdk_io_handle.h"
@@ -44,8 +47,12 @@
 #include "libvmdk_libcnotify.h"
 #include "libvmdk_libcpath.h"
 #include "libvmdk_libcthreads.h"
-#include "libvmdk_libfcache.h"
 #include "libvmdk_libfdata.h"
+#include "libvmdk_metadata_index.h"
+#include "libvmdk_readahead.h"
+#include "libvmdk_statistics.h"
+#include "libvmdk_trace.h"
+#include "libvmdk_unused.h"
 
 /* Creates a handle
  * Make sure the value handle is referencing, is set to NULL
@@ -152,6 +159,19 @@ int libvmdk_handle_initialize(
 
 		goto on_error;
 	}
+	if( libvmdk_cache_budget_initialize(
+	     &( internal_handle->cache_budget ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cache budget.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_initialize(
 	     &( internal_handle->read_write_lock ),
@@ -166,6 +186,45 @@ int libvmdk_handle_initialize(
 
 		goto on_error;
 	}
+	if( libcthreads_mutex_initialize(
+	     &( internal_handle->cache_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize cache mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( internal_handle->decompression_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize decompression mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( internal_handle->decompression_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize decompression condition.",
+		 function );
+
+		goto on_error;
+	}
 #endif
 	internal_handle->maximum_number_of_open_handles = LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES;
 
@@ -176,6 +235,32 @@ int libvmdk_handle_initialize(
 on_error:
 	if( internal_handle != NULL )
 	{
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+		if( internal_handle->decompression_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( internal_handle->decompression_mutex ),
+			 NULL );
+		}
+		if( internal_handle->cache_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( internal_handle->cache_mutex ),
+			 NULL );
+		}
+		if( internal_handle->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( internal_handle->read_write_lock ),
+			 NULL );
+		}
+#endif
+		if( internal_handle->cache_budget != NULL )
+		{
+			libvmdk_cache_budget_free(
+			 &( internal_handle->cache_budget ),
+			 NULL );
+		}
 		if( internal_handle->extent_table != NULL )
 		{
 			libvmdk_extent_table_free(
@@ -260,7 +345,62 @@ int libvmdk_handle_free(
 
 			result = -1;
 		}
+		if( libcthreads_mutex_free(
+		     &( internal_handle->cache_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free cache mutex.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( internal_handle->decompression_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free decompression mutex.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_condition_free(
+		     &( internal_handle->decompression_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free decompression condition.",
+			 function );
+
+			result = -1;
+		}
 #endif
+		if( internal_handle->metadata_index != NULL )
+		{
+			if( libvmdk_metadata_index_free(
+			     &( internal_handle->metadata_index ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free metadata index.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libvmdk_extent_table_free(
 		     &( internal_handle->extent_table ),
 		     error ) != 1 )
@@ -274,6 +414,19 @@ int libvmdk_handle_free(
 
 			result = -1;
 		}
+		if( libvmdk_cache_budget_free(
+		     &( internal_handle->cache_budget ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free cache budget.",
+			 function );
+
+			result = -1;
+		}
 		if( libcdata_array_free(
 		     &( internal_handle->extent_values_array ),
 		     (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_extent_values_free,
@@ -308,6 +461,8 @@ int libvmdk_handle_free(
 }
 
 /* Signals the handle to abort its current activity
+ * The abort remains signalled until the handle is closed, seeked or read, where a read
+ * at a specific offset resets it after the reads in progress have finished
  * Returns 1 if successful or -1 on error
  */
 int libvmdk_handle_signal_abort(
@@ -341,7 +496,9 @@ int libvmdk_handle_signal_abort(
 
 		return( -1 );
 	}
-	internal_handle->io_handle->abort = 1;
+	libvmdk_io_handle_set_abort(
+	 internal_handle->io_handle,
+	 1 );
 
 	return( 1 );
 }
@@ -1903,6 +2060,40 @@ int libvmdk_handle_close(
 
 		return( -1 );
 	}
+	/* The readahead thread reads from the extent data file IO pool and is stopped first
+	 */
+	if( internal_handle->readahead != NULL )
+	{
+		if( libvmdk_readahead_free(
+		     &( internal_handle->readahead ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free readahead.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->decompression_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( internal_handle->decompression_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join decompression thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
 #endif
 	if( internal_handle->extent_data_file_io_pool_created_in_library != 0 )
 	{
@@ -1936,6 +2127,7 @@ int libvmdk_handle_close(
 	}
 	internal_handle->extent_data_file_io_pool = NULL;
 	internal_handle->current_offset           = 0;
+	internal_handle->sequential_read_offset   = 0;
 
 	if( libvmdk_io_handle_clear(
 	     internal_handle->io_handle,
@@ -1982,22 +2174,40 @@ int libvmdk_handle_close(
 			result = -1;
 		}
 	}
-	if( internal_handle->grains_cache != NULL )
+	if( internal_handle->grain_cache != NULL )
+	{
+		if( libvmdk_grain_cache_free(
+		     &( internal_handle->grain_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free grain cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->layer_map != NULL )
 	{
-		if( libfcache_cache_free(
-		     &( internal_handle->grains_cache ),
+		if( libvmdk_layer_map_free(
+		     &( internal_handle->layer_map ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free grains cache.",
+			 "%s: unable to free layer map.",
 			 function );
 
 			result = -1;
 		}
 	}
+	internal_handle->layer_map_is_unsupported = 0;
+
 	if( libvmdk_extent_table_clear(
 	     internal_handle->extent_table,
 	     error ) != 1 )
@@ -2040,6 +2250,8 @@ int libvmdk_internal_handle_open_read(
 	libvmdk_extent_file_t *extent_file = NULL;
 	uint8_t *descriptor_data           = NULL;
 	static char *function              = "libvmdk_internal_handle_open_read";
+	uint64_t start_timestamp           = 0;
+	uint8_t is_traced                  = 0;
 	uint8_t file_type                  = 0;
 	int result                         = 0;
 
@@ -2076,6 +2288,10 @@ int libvmdk_internal_handle_open_read(
 
 		return( -1 );
 	}
+	is_traced = (uint8_t) libvmdk_trace_start_event(
+	                       internal_handle->io_handle->trace,
+	                       &start_timestamp );
+
 	result = libvmdk_internal_handle_open_read_signature(
 		  file_io_handle,
 		  &file_type,
@@ -2291,6 +2507,24 @@ int libvmdk_internal_handle_open_read(
 
 		goto on_error;
 	}
+	if( is_traced != 0 )
+	{
+		if( libvmdk_trace_record_event(
+		     internal_handle->io_handle->trace,
+		     LIBVMDK_TRACE_EVENT_OPEN_DESCRIPTOR,
+		     start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to record trace event.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
@@ -2322,13 +2556,18 @@ int libvmdk_internal_handle_open_read_extent_data_files(
      libbfio_pool_t *file_io_pool,
      libcerror_error_t **error )
 {
-	libvmdk_extent_file_t *extent_file     = NULL;
-	libvmdk_extent_values_t *extent_values = NULL;
-	static char *function                  = "libvmdk_internal_handle_open_read_extent_data_files";
-	size64_t extent_file_size              = 0;
-	int extent_index                       = 0;
-	int number_of_extents                  = 0;
-	int number_of_file_io_handles          = 0;
+	libvmdk_extent_file_t *extent_file                     = NULL;
+	libvmdk_extent_values_t *extent_values                 = NULL;
+	libvmdk_grain_offsets_index_t *grain_offsets_index     = NULL;
+	libvmdk_internal_extent_file_read_t *extent_file_reads = NULL;
+	static char *function                                  = "libvmdk_internal_handle_open_read_extent_data_files";
+	size64_t extent_file_size                              = 0;
+	size64_t storage_media_size                            = 0;
+	uint8_t grain_directories_read                         = 0;
+	int extent_index                                       = 0;
+	int number_of_extents                                  = 0;
+	int number_of_file_io_handles                          = 0;
+	int result                                             = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -2374,13 +2613,13 @@ int libvmdk_internal_handle_open_read_extent_data_files(
 
 		return( -1 );
 	}
-	if( internal_handle->grains_cache != NULL )
+	if( internal_handle->grain_cache != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - grains cache already set.",
+		 "%s: invalid handle - grain cache already set.",
 		 function );
 
 		return( -1 );
@@ -2464,8 +2703,75 @@ int libvmdk_internal_handle_open_read_extent_data_files(
 
 		goto on_error;
 	}
-	if( libfcache_cache_initialize(
-	     &( internal_handle->grains_cache ),
+	if( internal_handle->use_grain_offsets_index != 0 )
+	{
+		if( libvmdk_grain_table_enable_grain_offsets_index(
+		     internal_handle->grain_table,
+		     number_of_extents,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to enable grain offsets index.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* When the extent files are loaded lazily the grain directories are not read
+	 * when opening, hence the metadata index is not needed
+	 */
+	if( ( internal_handle->metadata_index != NULL )
+	 && ( internal_handle->use_lazy_loading == 0 ) )
+	{
+		/* The metadata index is a cache, if it cannot be read the extent files are read instead
+		 */
+		result = libvmdk_metadata_index_read_file(
+		          internal_handle->metadata_index,
+		          internal_handle->descriptor_file->content_identifier,
+		          internal_handle->descriptor_file->parent_content_identifier,
+		          number_of_extents,
+		          error );
+
+		if( result == -1 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+		else if( ( result != 0 )
+		      && ( internal_handle->grain_table->grain_offsets_indexes == NULL ) )
+		{
+			if( libvmdk_grain_table_enable_grain_offsets_index(
+			     internal_handle->grain_table,
+			     number_of_extents,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to enable grain offsets index.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( libvmdk_grain_cache_initialize(
+	     &( internal_handle->grain_cache ),
 	     LIBVMDK_MAXIMUM_CACHE_ENTRIES_GRAINS,
 	     error ) != 1 )
 	{
@@ -2473,11 +2779,34 @@ int libvmdk_internal_handle_open_read_extent_data_files(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create grains cache.",
+		 "%s: unable to create grain cache.",
 		 function );
 
 		goto on_error;
 	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( ( internal_handle->number_of_open_threads > 0 )
+	 && ( internal_handle->use_lazy_loading == 0 )
+	 && ( number_of_extents > 1 ) )
+	{
+		if( libvmdk_internal_handle_open_read_extent_files_in_threads(
+		     internal_handle,
+		     file_io_pool,
+		     number_of_extents,
+		     &extent_file_reads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read extent files in threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	for( extent_index = 0;
 	     extent_index < number_of_extents;
 	     extent_index++ )
@@ -2534,90 +2863,82 @@ int libvmdk_internal_handle_open_read_extent_data_files(
 
 			goto on_error;
 		}
-		if( ( extent_values->type == LIBVMDK_EXTENT_TYPE_SPARSE )
-		 || ( extent_values->type == LIBVMDK_EXTENT_TYPE_VMFS_SPARSE ) )
+		if( ( internal_handle->use_lazy_loading != 0 )
+		 && ( internal_handle->io_handle->grain_size != 0 )
+		 && ( ( extent_values->type == LIBVMDK_EXTENT_TYPE_SPARSE )
+		  || ( extent_values->type == LIBVMDK_EXTENT_TYPE_VMFS_SPARSE ) ) )
 		{
-			if( libvmdk_extent_file_initialize(
-			     &extent_file,
-			     internal_handle->io_handle,
-			     error ) != 1 )
+			/* Only the file header of the first extent file is read to determine the grain size,
+			 * the file headers and grain directories of the other extent files are read
+			 * when the extent file is first accessed
+			 */
+			if( extent_file_size < 512 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create extent file: %d.",
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid extent file: %d size value out of bounds.",
 				 function,
 				 extent_index );
 
 				goto on_error;
 			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "Reading extent file: %d file header:\n",
-				 extent_index );
-			}
-#endif
-			if( libvmdk_extent_file_read_file_header(
-			     extent_file,
-			     file_io_pool,
-			     extent_index,
-			     0,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read extent file: %d header.",
-				 function,
-				 extent_index );
+		}
+		else if( ( extent_values->type == LIBVMDK_EXTENT_TYPE_SPARSE )
+		      || ( extent_values->type == LIBVMDK_EXTENT_TYPE_VMFS_SPARSE ) )
+		{
+			grain_directories_read = 0;
 
-				goto on_error;
-			}
-			if( ( extent_file->file_type != LIBVMDK_FILE_TYPE_COWD_SPARSE_DATA )
-			 && ( extent_file->file_type != LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA ) )
+			/* Extent files that were read in threads are merged in order of their extent index,
+			 * the ones that could not be read in a thread are read here
+			 */
+			if( ( extent_file_reads != NULL )
+			 && ( extent_file_reads[ extent_index ].result == 1 ) )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-				 "%s: extent file type not supported for extent type.",
-				 function );
+				extent_file            = extent_file_reads[ extent_index ].extent_file;
+				grain_directories_read = extent_file_reads[ extent_index ].read_grain_directories;
 
-				goto on_error;
+				extent_file_reads[ extent_index ].extent_file = NULL;
 			}
-			if( ( internal_handle->disk_type != LIBVMDK_DISK_TYPE_STREAM_OPTIMIZED )
-			 && ( extent_file->file_type == LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA )
-			 && ( ( extent_file->flags & LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION ) != LIBVMDK_COMPRESSION_METHOD_NONE ) )
+			else
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-				 "%s: grain compression not supported for disk type.",
-				 function );
-
-				goto on_error;
-			}
-			if( ( extent_file->file_type == LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA )
-			 && ( extent_file->primary_grain_directory_offset == (off64_t) -1 )
-			 && ( extent_file->compression_method == LIBVMDK_COMPRESSION_METHOD_DEFLATE ) )
-			{
-				if( libvmdk_extent_file_read_file_header(
+				if( libvmdk_extent_file_initialize(
+				     &extent_file,
+				     internal_handle->io_handle,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create extent file: %d.",
+					 function,
+					 extent_index );
+
+					goto on_error;
+				}
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "Reading extent file: %d file header:\n",
+					 extent_index );
+				}
+#endif
+				if( libvmdk_internal_handle_open_read_extent_file_header(
 				     extent_file,
 				     file_io_pool,
 				     extent_index,
-				     extent_file_size - 1024,
+				     extent_file_size,
+				     internal_handle->disk_type,
 				     error ) != 1 )
 				{
 					libcerror_error_set(
 					 error,
 					 LIBCERROR_ERROR_DOMAIN_IO,
 					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read secondary extent file: %d header.",
+					 "%s: unable to read extent file: %d header.",
 					 function,
 					 extent_index );
 
@@ -2644,34 +2965,99 @@ int libvmdk_internal_handle_open_read_extent_data_files(
 			{
 				internal_handle->io_handle->is_dirty = 1;
 			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
+			result = 0;
+
+			if( ( grain_directories_read == 0 )
+			 && ( internal_handle->use_lazy_loading == 0 )
+			 && ( internal_handle->metadata_index != NULL ) )
 			{
-				libcnotify_printf(
-				 "Reading extent file: %d grain directories:\n",
-				 extent_index );
+				result = libvmdk_metadata_index_get_grain_offsets_index(
+				          internal_handle->metadata_index,
+				          extent_index,
+				          extent_file,
+				          extent_file_size,
+				          &storage_media_size,
+				          &grain_offsets_index,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve grain offsets index: %d from metadata index.",
+					 function,
+					 extent_index );
+
+					goto on_error;
+				}
+				else if( result != 0 )
+				{
+					if( libvmdk_grain_table_set_grain_offsets_index(
+					     internal_handle->grain_table,
+					     extent_index,
+					     grain_offsets_index,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to set grain offsets index: %d.",
+						 function,
+						 extent_index );
+
+						goto on_error;
+					}
+					grain_offsets_index = NULL;
+				}
 			}
-#endif
-			if( libvmdk_extent_file_read_grain_directories(
-			     extent_file,
-			     file_io_pool,
-			     extent_index,
-			     error ) != 1 )
+			if( ( result == 0 )
+			 && ( grain_directories_read == 0 )
+			 && ( internal_handle->use_lazy_loading == 0 ) )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read extent file: %d grain directories.",
-				 function,
-				 extent_index );
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "Reading extent file: %d grain directories:\n",
+					 extent_index );
+				}
+#endif
+				if( libvmdk_extent_file_read_grain_directories(
+				     extent_file,
+				     file_io_pool,
+				     extent_index,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read extent file: %d grain directories.",
+					 function,
+					 extent_index );
 
-				goto on_error;
+					goto on_error;
+				}
+				grain_directories_read = 1;
+			}
+			if( grain_directories_read != 0 )
+			{
+				storage_media_size = extent_file->storage_media_size;
+			}
+			else if( internal_handle->use_lazy_loading != 0 )
+			{
+				/* The storage media size of the extent file is checked against
+				 * the extent size when the extent file is first accessed
+				 */
+				storage_media_size = extent_values->size;
 			}
 			if( libvmdk_extent_table_set_extent_storage_media_size_by_index(
 			     internal_handle->extent_table,
 			     extent_index,
-			     extent_file->storage_media_size,
+			     storage_media_size,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -2710,24 +3096,185 @@ int libvmdk_internal_handle_open_read_extent_data_files(
 
 			goto on_error;
 		}
-		if( internal_handle->io_handle->abort == 1 )
+		if( libvmdk_io_handle_get_abort( internal_handle->io_handle ) == 1 )
+		{
+			goto on_error;
+		}
+	}
+	if( extent_file_reads != NULL )
+	{
+		memory_free(
+		 extent_file_reads );
+
+		extent_file_reads = NULL;
+	}
+	if( ( internal_handle->extent_table->extent_type == LIBVMDK_EXTENT_TYPE_SPARSE )
+	 || ( internal_handle->extent_table->extent_type == LIBVMDK_EXTENT_TYPE_VMFS_SPARSE ) )
+	{
+		if( libvmdk_extent_table_build_extent_offsets(
+		     internal_handle->extent_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to build extent offsets.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( internal_handle->metadata_index != NULL )
+	{
+		if( libvmdk_metadata_index_clear_data(
+		     internal_handle->metadata_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to clear metadata index data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( internal_handle->extent_table->extent_files_stream == NULL )
+	{
+		/* Every cached extent file has its own grain groups cache
+		 */
+		if( number_of_extents > LIBVMDK_MAXIMUM_CACHE_ENTRIES_EXTENT_FILES )
+		{
+			number_of_extents = LIBVMDK_MAXIMUM_CACHE_ENTRIES_EXTENT_FILES;
+		}
+		if( libvmdk_cache_budget_set_entry_sizes(
+		     internal_handle->cache_budget,
+		     internal_handle->io_handle->grain_size,
+		     LIBVMDK_CACHE_BUDGET_GRAIN_GROUP_ENTRY_SIZE,
+		     number_of_extents,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set cache budget entry sizes.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_internal_handle_apply_cache_budget(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to apply cache budget.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( ( internal_handle->maximum_number_of_readahead_grains > 0 )
+	 && ( internal_handle->extent_table->extent_files_stream == NULL )
+	 && ( internal_handle->io_handle->grain_size > 0 )
+	 && ( internal_handle->io_handle->grain_size <= (size64_t) SSIZE_MAX )
+	 && ( internal_handle->io_handle->media_size >= internal_handle->io_handle->grain_size ) )
+	{
+		if( libvmdk_grain_table_reset_grain_cursor(
+		     &( internal_handle->readahead_grain_cursor ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to reset readahead grain cursor.",
+			 function );
+
+			goto on_error;
+		}
+		/* Only whole grains are read ahead
+		 */
+		if( libvmdk_readahead_initialize(
+		     &( internal_handle->readahead ),
+		     (size_t) internal_handle->io_handle->grain_size,
+		     internal_handle->io_handle->media_size / internal_handle->io_handle->grain_size,
+		     internal_handle->maximum_number_of_readahead_grains,
+		     (int (*)(intptr_t *, uint64_t, uint8_t *, size_t, libcerror_error_t **)) &libvmdk_internal_handle_read_readahead_grain,
+		     (intptr_t *) internal_handle,
+		     error ) != 1 )
 		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create readahead.",
+			 function );
+
 			goto on_error;
 		}
 	}
+	if( libvmdk_internal_handle_create_decompression_thread_pool(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create decompression thread pool.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	return( 1 );
 
 on_error:
+	if( extent_file_reads != NULL )
+	{
+		for( extent_index = 0;
+		     extent_index < number_of_extents;
+		     extent_index++ )
+		{
+			if( extent_file_reads[ extent_index ].extent_file != NULL )
+			{
+				libvmdk_extent_file_free(
+				 &( extent_file_reads[ extent_index ].extent_file ),
+				 NULL );
+			}
+		}
+		memory_free(
+		 extent_file_reads );
+	}
+	if( grain_offsets_index != NULL )
+	{
+		libvmdk_grain_offsets_index_free(
+		 &grain_offsets_index,
+		 NULL );
+	}
 	if( extent_file != NULL )
 	{
 		libvmdk_extent_file_free(
 		 &extent_file,
 		 NULL );
 	}
-	if( internal_handle->grains_cache != NULL )
+	if( internal_handle->metadata_index != NULL )
 	{
-		libfcache_cache_free(
-		 &( internal_handle->grains_cache ),
+		libvmdk_metadata_index_clear_data(
+		 internal_handle->metadata_index,
+		 NULL );
+	}
+	if( internal_handle->grain_cache != NULL )
+	{
+		libvmdk_grain_cache_free(
+		 &( internal_handle->grain_cache ),
 		 NULL );
 	}
 	if( internal_handle->grain_table != NULL )
@@ -2739,218 +3286,294 @@ on_error:
 	return( -1 );
 }
 
-/* Reads the file signature and tries to determine the file type
- * Returns 1 if successful, 0 if no file type could be determined or -1 on error
+/* Reads the file header of an extent file
+ * If the file header indicates there is a secondary file header at the end of the file it is read as well
+ * This function does not access the handle and can be called from a thread
+ * Returns 1 if successful or -1 on error
  */
-int libvmdk_internal_handle_open_read_signature(
-     libbfio_handle_t *file_io_handle,
-     uint8_t *file_type,
+int libvmdk_internal_handle_open_read_extent_file_header(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t extent_file_size,
+     int disk_type,
      libcerror_error_t **error )
 {
-	libcsplit_narrow_split_string_t *lines = NULL;
-	uint8_t *signature                     = NULL;
-	static char *function                  = "libvmdk_internal_handle_open_read_signature";
-	ssize_t read_count                     = 0;
-	int line_index                         = 0;
-	int number_of_lines                    = 0;
-	int result                             = 0;
+	static char *function = "libvmdk_internal_handle_open_read_extent_file_header";
 
-	if( file_type == NULL )
+	if( extent_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file type.",
+		 "%s: invalid extent file.",
 		 function );
 
 		return( -1 );
 	}
-	signature = (uint8_t *) memory_allocate(
-	                         sizeof( uint8_t ) * 2048 );
-
-	if( signature == NULL )
+	if( libvmdk_extent_file_read_file_header(
+	     extent_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     0,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create signature.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( memory_set(
-	     signature,
-	     0,
-	     sizeof( uint8_t ) * 2048 ) == NULL )
+	if( ( extent_file->file_type != LIBVMDK_FILE_TYPE_COWD_SPARSE_DATA )
+	 && ( extent_file->file_type != LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear signature.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: extent file type not supported for extent type.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	read_count = libbfio_handle_read_buffer_at_offset(
-	              file_io_handle,
-	              signature,
-	              32,
-	              0,
-	              error );
-
-	if( read_count != (ssize_t) 32 )
+	if( ( disk_type != LIBVMDK_DISK_TYPE_STREAM_OPTIMIZED )
+	 && ( extent_file->file_type == LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA )
+	 && ( ( extent_file->flags & LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION ) != LIBVMDK_COMPRESSION_METHOD_NONE ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read signature at offset: 0 (0x00000000).",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: grain compression not supported for disk type.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( memory_compare(
-	     signature,
-	     cowd_sparse_file_signature,
-	     4 ) == 0 )
+	if( ( extent_file->file_type == LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA )
+	 && ( extent_file->primary_grain_directory_offset == (off64_t) -1 )
+	 && ( extent_file->compression_method == LIBVMDK_COMPRESSION_METHOD_DEFLATE ) )
 	{
-		*file_type = LIBVMDK_FILE_TYPE_COWD_SPARSE_DATA;
-		result     = 1;
+		if( libvmdk_extent_file_read_file_header(
+		     extent_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     extent_file_size - 1024,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read secondary file header.",
+			 function );
+
+			return( -1 );
+		}
 	}
-	else if( memory_compare(
-	          signature,
-	          vmdk_sparse_file_signature,
-	          4 ) == 0 )
-	{
-		*file_type = LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA;
-		result     = 1;
+	return( 1 );
+}
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+
+/* Reads the file header and grain directories of an extent file
+ * Callback function for the open thread pool
+ * The extent file is read using a file IO pool of its own that contains the cloned file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_handle_open_read_extent_file(
+     libvmdk_internal_extent_file_read_t *extent_file_read,
+     void *arguments LIBVMDK_ATTRIBUTE_UNUSED )
+{
+	libbfio_pool_t *file_io_pool = NULL;
+	libcerror_error_t *error     = NULL;
+	static char *function        = "libvmdk_internal_handle_open_read_extent_file";
+	int file_io_pool_entry       = 0;
+
+	LIBVMDK_UNREFERENCED_PARAMETER( arguments )
+
+	if( extent_file_read == NULL )
+	{
+		return( -1 );
 	}
-	else if( signature[ 0 ] == '#' )
+	if( libbfio_pool_initialize(
+	     &file_io_pool,
+	     0,
+	     LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	     &error ) != 1 )
 	{
-		read_count = libbfio_handle_read_buffer(
-		              file_io_handle,
-		              &( signature[ 32 ] ),
-		              2048 - 32,
-		              error );
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
 
-		if( read_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read signature.",
-			 function );
+		goto on_error;
+	}
+	if( libbfio_pool_append_handle(
+	     file_io_pool,
+	     &file_io_pool_entry,
+	     extent_file_read->file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append file IO handle to pool.",
+		 function );
 
-			goto on_error;
-		}
-		if( libcsplit_narrow_string_split(
-		     (char *) signature,
-		     32 + read_count,
-		     '\n',
-		     &lines,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to split file data into lines.",
-			 function );
+		goto on_error;
+	}
+	/* The file IO pool now manages the file IO handle
+	 */
+	extent_file_read->file_io_handle = NULL;
 
-			goto on_error;
-		}
-		if( libcsplit_narrow_split_string_get_number_of_segments(
-		     lines,
-		     &number_of_lines,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to retrieve number of lines.",
-			 function );
+	if( libvmdk_extent_file_initialize(
+	     &( extent_file_read->extent_file ),
+	     extent_file_read->io_handle,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create extent file: %d.",
+		 function,
+		 extent_file_read->extent_index );
 
-			goto on_error;
-		}
-		result = libvmdk_descriptor_file_read_signature(
-			  lines,
-			  number_of_lines,
-			  &line_index,
-		          error );
+		goto on_error;
+	}
+	if( libvmdk_internal_handle_open_read_extent_file_header(
+	     extent_file_read->extent_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     extent_file_read->extent_file_size,
+	     extent_file_read->disk_type,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read extent file: %d header.",
+		 function,
+		 extent_file_read->extent_index );
 
-		if( result == -1 )
+		goto on_error;
+	}
+	if( extent_file_read->read_grain_directories != 0 )
+	{
+		if( libvmdk_extent_file_read_grain_directories(
+		     extent_file_read->extent_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read descriptor file.",
-			 function );
+			 "%s: unable to read extent file: %d grain directories.",
+			 function,
+			 extent_file_read->extent_index );
 
 			goto on_error;
 		}
-		else if( result != 0 )
-		{
-			*file_type = LIBVMDK_FILE_TYPE_DESCRIPTOR_FILE;
-		}
-		if( libcsplit_narrow_split_string_free(
-		     &lines,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free lines.",
-			 function );
+	}
+	if( libbfio_pool_close_all(
+	     file_io_pool,
+	     &error ) != 0 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close all file IO pool handles.",
+		 function );
 
-			goto on_error;
-		}
+		goto on_error;
 	}
-	memory_free(
-	 signature );
+	if( libbfio_pool_free(
+	     &file_io_pool,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO pool.",
+		 function );
 
-	return( result );
+		goto on_error;
+	}
+	extent_file_read->result = 1;
+
+	return( 1 );
 
 on_error:
-	if( lines != NULL )
+	if( error != NULL )
 	{
-		libcsplit_narrow_split_string_free(
-		 &lines,
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( extent_file_read->extent_file != NULL )
+	{
+		libvmdk_extent_file_free(
+		 &( extent_file_read->extent_file ),
 		 NULL );
 	}
-	if( signature != NULL )
+	if( file_io_pool != NULL )
 	{
-		memory_free(
-		 signature );
+		libbfio_pool_close_all(
+		 file_io_pool,
+		 NULL );
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
 	}
-	return( -1 );
+	/* The extent file is read again on the calling thread, which reports the actual error
+	 */
+	extent_file_read->result = -1;
+
+	return( 1 );
 }
 
-/* Reads (media) data at the current offset into a buffer using a Basic File IO (bfio) pool
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read or -1 on error
+/* Reads the file headers and grain directories of the sparse extent files using a pool of threads
+ * Every thread reads one extent file at a time using a clone of its file IO handle
+ * The extent files are returned in an array in order of their extent index and are merged
+ * into the extent table by the caller. Extent files that could not be read have a result of 0 or -1
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libvmdk_internal_handle_read_buffer_from_file_io_pool(
-         libvmdk_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libvmdk_internal_handle_open_read_extent_files_in_threads(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int number_of_extents,
+     libvmdk_internal_extent_file_read_t **extent_file_reads,
+     libcerror_error_t **error )
 {
-	libvmdk_grain_data_t *grain_data = NULL;
-	static char *function            = "libvmdk_internal_handle_read_buffer_from_file_io_pool";
-	size_t buffer_offset             = 0;
-	size_t read_size                 = 0;
-	ssize_t read_count               = 0;
-	off64_t grain_data_offset        = 0;
-	uint64_t grain_index             = 0;
-	int grain_is_sparse              = 0;
+	libbfio_handle_t *file_io_handle                            = NULL;
+	libcthreads_thread_pool_t *thread_pool                      = NULL;
+	libvmdk_extent_values_t *extent_values                      = NULL;
+	libvmdk_internal_extent_file_read_t *extent_file_read       = NULL;
+	libvmdk_internal_extent_file_read_t *safe_extent_file_reads = NULL;
+	static char *function                                       = "libvmdk_internal_handle_open_read_extent_files_in_threads";
+	size64_t extent_file_size                                   = 0;
+	uint8_t read_grain_directories                              = 1;
+	int extent_index                                            = 0;
+	int number_of_threads                                       = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -2974,319 +3597,6810 @@ ssize_t libvmdk_internal_handle_read_buffer_from_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( ( number_of_extents <= 0 )
+	 || ( (size_t) number_of_extents > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libvmdk_internal_extent_file_read_t ) ) ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of extents value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->descriptor_file == NULL )
+	if( extent_file_reads == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing descriptor file.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file reads.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->descriptor_file->parent_content_identifier_set != 0 )
-	 && ( internal_handle->descriptor_file->parent_content_identifier != 0xffffffffUL ) )
+	if( *extent_file_reads != NULL )
 	{
-		if( internal_handle->parent_handle == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid handle - missing parent handle.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid extent file reads value already set.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	if( buffer == NULL )
+	number_of_threads = internal_handle->number_of_open_threads;
+
+	if( number_of_threads > number_of_extents )
+	{
+		number_of_threads = number_of_extents;
+	}
+	/* The grain directories are not read if a metadata index was read
+	 * since the grain offsets are retrieved from the metadata index instead
+	 */
+	if( ( internal_handle->metadata_index != NULL )
+	 && ( internal_handle->metadata_index->data != NULL ) )
+	{
+		read_grain_directories = 0;
+	}
+	safe_extent_file_reads = (libvmdk_internal_extent_file_read_t *) memory_allocate(
+	                                                                  sizeof( libvmdk_internal_extent_file_read_t ) * number_of_extents );
+
+	if( safe_extent_file_reads == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create extent file reads.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( memory_set(
+	     safe_extent_file_reads,
+	     0,
+	     sizeof( libvmdk_internal_extent_file_read_t ) * number_of_extents ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid element data size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear extent file reads.",
 		 function );
 
-		return( -1 );
-	}
-	internal_handle->io_handle->abort = 0;
+		memory_free(
+		 safe_extent_file_reads );
 
-	if( buffer_size == 0 )
-	{
-		return( 0 );
+		return( -1 );
 	}
-	if( (size64_t) internal_handle->current_offset >= internal_handle->io_handle->media_size )
+	/* The queue is kept small so that the number of file IO handle clones is limited
+	 */
+	if( libcthreads_thread_pool_create(
+	     &thread_pool,
+	     NULL,
+	     number_of_threads,
+	     number_of_threads * 2,
+	     (int (*)(intptr_t *, void *)) &libvmdk_internal_handle_open_read_extent_file,
+	     NULL,
+	     error ) != 1 )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create open thread pool.",
+		 function );
+
+		goto on_error;
 	}
-	if( internal_handle->extent_table->extent_files_stream != NULL )
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
 	{
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		if( libcdata_array_get_entry_by_index(
+		     internal_handle->extent_values_array,
+		     extent_index,
+		     (intptr_t **) &extent_values,
+		     error ) != 1 )
 		{
-			libcnotify_printf(
-			 "%s: requested offset\t\t\t\t: %" PRIi64 " (0x%08" PRIx64 ")\n",
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent values: %d from array.",
 			 function,
-			 internal_handle->current_offset,
-			 internal_handle->current_offset );
+			 extent_index );
+
+			goto on_error;
 		}
-#endif
-		read_size = buffer_size;
+		if( extent_values == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing extent values: %d.",
+			 function,
+			 extent_index );
 
-		if( ( (size64_t) read_size > internal_handle->io_handle->media_size )
-		 || ( (size64_t) internal_handle->current_offset > ( internal_handle->io_handle->media_size - read_size ) ) )
+			goto on_error;
+		}
+		if( ( extent_values->type != LIBVMDK_EXTENT_TYPE_SPARSE )
+		 && ( extent_values->type != LIBVMDK_EXTENT_TYPE_VMFS_SPARSE ) )
 		{
-			read_size = (size_t) ( internal_handle->io_handle->media_size - internal_handle->current_offset );
+			continue;
 		}
-		read_count = libfdata_stream_read_buffer_at_offset(
-		              internal_handle->extent_table->extent_files_stream,
-			      (intptr_t *) file_io_pool,
-			      (uint8_t *) buffer,
-			      read_size,
-			      internal_handle->current_offset,
-			      0,
-			      error );
+		if( libbfio_pool_get_size(
+		     file_io_pool,
+		     extent_index,
+		     &extent_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve size of file IO pool entry: %d.",
+			 function,
+			 extent_index );
 
-		if( read_count != (ssize_t) read_size )
+			goto on_error;
+		}
+		if( libbfio_pool_get_handle(
+		     file_io_pool,
+		     extent_index,
+		     &file_io_handle,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read buffer from extent files stream at offset: %" PRIi64 " (0x%" PRIx64 ").",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file IO handle: %d from pool.",
 			 function,
-			 internal_handle->current_offset,
-			 internal_handle->current_offset );
+			 extent_index );
 
-			return( -1 );
+			goto on_error;
 		}
-		internal_handle->current_offset += (off64_t) read_size;
+		extent_file_read = &( safe_extent_file_reads[ extent_index ] );
 
-		buffer_offset = read_size;
+		/* If the file IO handle cannot be cloned the extent file is read on the calling thread
+		 */
+		if( libbfio_handle_clone(
+		     &( extent_file_read->file_io_handle ),
+		     file_io_handle,
+		     error ) != 1 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+
+			continue;
+		}
+		extent_file_read->extent_index           = extent_index;
+		extent_file_read->disk_type              = internal_handle->disk_type;
+		extent_file_read->io_handle              = internal_handle->io_handle;
+		extent_file_read->extent_file_size       = extent_file_size;
+		extent_file_read->read_grain_directories = read_grain_directories;
+
+		if( libcthreads_thread_pool_push(
+		     thread_pool,
+		     (intptr_t *) extent_file_read,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push extent file: %d onto open thread pool.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( libvmdk_io_handle_get_abort( internal_handle->io_handle ) != 0 )
+		{
+			break;
+		}
 	}
-	else
+	if( libcthreads_thread_pool_join(
+	     &thread_pool,
+	     error ) != 1 )
 	{
-		grain_index       = internal_handle->current_offset / internal_handle->io_handle->grain_size;
-		grain_data_offset = (off64_t) ( internal_handle->current_offset % internal_handle->io_handle->grain_size );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join open thread pool.",
+		 function );
 
-		while( buffer_offset < buffer_size )
-		{
-			grain_is_sparse = libvmdk_grain_table_grain_is_sparse_at_offset(
-					   internal_handle->grain_table,
-					   grain_index,
-					   file_io_pool,
-					   internal_handle->extent_table,
-					   internal_handle->current_offset,
-					   error );
+		goto on_error;
+	}
+	/* The file IO handle clones of extent files that were not read are still set
+	 */
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		extent_file_read = &( safe_extent_file_reads[ extent_index ] );
 
-			if( grain_is_sparse == -1 )
+		if( extent_file_read->file_io_handle != NULL )
+		{
+			if( libbfio_handle_free(
+			     &( extent_file_read->file_io_handle ),
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine if the grain: %" PRIu64 " is sparse.",
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO handle: %d.",
 				 function,
-				 grain_index );
+				 extent_index );
 
-				return( -1 );
+				goto on_error;
 			}
-			read_size = (size_t) ( internal_handle->io_handle->grain_size - grain_data_offset );
+		}
+	}
+	*extent_file_reads = safe_extent_file_reads;
 
-			if( read_size > ( buffer_size - buffer_offset ) )
-			{
-				read_size = buffer_size - buffer_offset;
-			}
-			if( ( (size64_t) read_size > internal_handle->io_handle->media_size )
-			 || ( (size64_t) internal_handle->current_offset > ( internal_handle->io_handle->media_size - read_size ) ) )
-			{
-				read_size = (size_t) ( internal_handle->io_handle->media_size - internal_handle->current_offset );
-			}
-			if( grain_is_sparse != 0 )
-			{
-				if( internal_handle->parent_handle == NULL )
-				{
-					if( memory_set(
-					     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-					     0,
-					     read_size ) == NULL )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_MEMORY,
-						 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-						 "%s: unable to fill buffer with sparse grain.",
-						 function );
+	return( 1 );
 
-						return( -1 );
-					}
-				}
-				else
-				{
-/* TODO do we need grain offset or current offset ? */
-					if( libvmdk_handle_seek_offset(
-					     internal_handle->parent_handle,
-					     internal_handle->current_offset,
-					     SEEK_SET,
-					     error ) == -1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_SEEK_FAILED,
-						 "%s: unable to seek grain offset: %" PRIi64 " (0x%08" PRIx64 ") in parent.",
-						 function,
-						 internal_handle->current_offset,
-						 internal_handle->current_offset );
+on_error:
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		extent_file_read = &( safe_extent_file_reads[ extent_index ] );
 
-						return( -1 );
-					}
-					read_count = libvmdk_handle_read_buffer(
-						      internal_handle->parent_handle,
-						      &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-						      read_size,
-						      error );
+		if( extent_file_read->extent_file != NULL )
+		{
+			libvmdk_extent_file_free(
+			 &( extent_file_read->extent_file ),
+			 NULL );
+		}
+		if( extent_file_read->file_io_handle != NULL )
+		{
+			libbfio_handle_free(
+			 &( extent_file_read->file_io_handle ),
+			 NULL );
+		}
+	}
+	memory_free(
+	 safe_extent_file_reads );
 
-					if( read_count != (ssize_t) read_size )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: unable to read grain data from parent.",
-						 function );
+	return( -1 );
+}
 
-						return( -1 );
-					}
-				}
-			}
-			else
-			{
-				if( libvmdk_grain_table_get_grain_data_at_offset(
-				     internal_handle->grain_table,
-				     grain_index,
-				     file_io_pool,
-				     internal_handle->extent_table,
-				     internal_handle->grains_cache,
-				     internal_handle->current_offset,
-				     &grain_data,
-				     &grain_data_offset,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve grain: %d data.",
-					 function,
-					 grain_index );
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
 
-					return( -1 );
-				}
-				if( grain_data == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing grain: %d data.",
-					 function,
-					 grain_index );
+/* Reads the file signature and tries to determine the file type
+ * Returns 1 if successful, 0 if no file type could be determined or -1 on error
+ */
+int libvmdk_internal_handle_open_read_signature(
+     libbfio_handle_t *file_io_handle,
+     uint8_t *file_type,
+     libcerror_error_t **error )
+{
+	libcsplit_narrow_split_string_t *lines = NULL;
+	uint8_t *signature                     = NULL;
+	static char *function                  = "libvmdk_internal_handle_open_read_signature";
+	ssize_t read_count                     = 0;
+	int line_index                         = 0;
+	int number_of_lines                    = 0;
+	int result                             = 0;
 
-					return( -1 );
-				}
-				if( (size64_t) grain_data_offset > grain_data->data_size )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-					 "%s: grain data offset value out of bounds.",
-					 function );
+	if( file_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file type.",
+		 function );
 
-					return( -1 );
-				}
-				if( read_size > (size_t) ( grain_data->data_size - grain_data_offset ) )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-					 "%s: read size value out of bounds.",
-					 function );
+		return( -1 );
+	}
+	signature = (uint8_t *) memory_allocate(
+	                         sizeof( uint8_t ) * 2048 );
 
-					return( -1 );
-				}
-				if( memory_copy(
-				     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-				     &( ( grain_data->data )[ grain_data_offset ] ),
-				     read_size ) == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-					 "%s: unable to copy grain data to buffer.",
-					 function );
+	if( signature == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create signature.",
+		 function );
 
-					return( -1 );
-				}
-			}
-			buffer_offset    += read_size;
-			grain_index      += 1;
-			grain_data_offset = 0;
+		goto on_error;
+	}
+	if( memory_set(
+	     signature,
+	     0,
+	     sizeof( uint8_t ) * 2048 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear signature.",
+		 function );
 
-			internal_handle->current_offset += (off64_t) read_size;
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              signature,
+	              32,
+	              0,
+	              error );
 
-			if( (size64_t) internal_handle->current_offset >= internal_handle->io_handle->media_size )
-			{
-				break;
-			}
-			if( internal_handle->io_handle->abort != 0 )
+	if( read_count != (ssize_t) 32 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read signature at offset: 0 (0x00000000).",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     signature,
+	     cowd_sparse_file_signature,
+	     4 ) == 0 )
+	{
+		*file_type = LIBVMDK_FILE_TYPE_COWD_SPARSE_DATA;
+		result     = 1;
+	}
+	else if( memory_compare(
+	          signature,
+	          vmdk_sparse_file_signature,
+	          4 ) == 0 )
+	{
+		*file_type = LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA;
+		result     = 1;
+	}
+	else if( signature[ 0 ] == '#' )
+	{
+		read_count = libbfio_handle_read_buffer(
+		              file_io_handle,
+		              &( signature[ 32 ] ),
+		              2048 - 32,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read signature.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcsplit_narrow_string_split(
+		     (char *) signature,
+		     32 + read_count,
+		     '\n',
+		     &lines,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to split file data into lines.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcsplit_narrow_split_string_get_number_of_segments(
+		     lines,
+		     &number_of_lines,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to retrieve number of lines.",
+			 function );
+
+			goto on_error;
+		}
+		result = libvmdk_descriptor_file_read_signature(
+			  lines,
+			  number_of_lines,
+			  &line_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read descriptor file.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			*file_type = LIBVMDK_FILE_TYPE_DESCRIPTOR_FILE;
+		}
+		if( libcsplit_narrow_split_string_free(
+		     &lines,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free lines.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 signature );
+
+	return( result );
+
+on_error:
+	if( lines != NULL )
+	{
+		libcsplit_narrow_split_string_free(
+		 &lines,
+		 NULL );
+	}
+	if( signature != NULL )
+	{
+		memory_free(
+		 signature );
+	}
+	return( -1 );
+}
+
+/* Sizes the grain and grain groups caches according to the cache budget
+ * The grain cache is resized in place, the grain groups caches are only recreated when their
+ * number of entries changes, which discards the cached grain groups
+ * This function is not multi-thread safe acquire the cache mutex before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_handle_apply_cache_budget(
+     libvmdk_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function                    = "libvmdk_internal_handle_apply_cache_budget";
+	int number_of_cache_entries              = 0;
+	int number_of_grain_groups_cache_entries = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->cache_budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing cache budget.",
+		 function );
+
+		return( -1 );
+	}
+	/* Grain groups caches of extent files opened later on use the number of entries of the IO handle
+	 */
+	number_of_grain_groups_cache_entries = internal_handle->io_handle->number_of_grain_groups_cache_entries;
+
+	internal_handle->io_handle->number_of_grain_groups_cache_entries = internal_handle->cache_budget->number_of_grain_groups_cache_entries;
+
+	if( internal_handle->grain_cache != NULL )
+	{
+		if( libvmdk_grain_cache_get_maximum_number_of_entries(
+		     internal_handle->grain_cache,
+		     &number_of_cache_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve maximum number of grain cache entries.",
+			 function );
+
+			return( -1 );
+		}
+		if( number_of_cache_entries != internal_handle->cache_budget->number_of_grains_cache_entries )
+		{
+			if( libvmdk_grain_cache_set_maximum_number_of_entries(
+			     internal_handle->grain_cache,
+			     internal_handle->cache_budget->number_of_grains_cache_entries,
+			     error ) != 1 )
 			{
-				break;
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set maximum number of grain cache entries.",
+				 function );
+
+				return( -1 );
 			}
 		}
 	}
-	return( (ssize_t) buffer_offset );
+	/* The grain groups caches of the cached extent files are created with the number of entries
+	 * of the IO handle, hence they only need to be resized when it changed
+	 */
+	if( ( internal_handle->extent_table != NULL )
+	 && ( number_of_grain_groups_cache_entries != internal_handle->cache_budget->number_of_grain_groups_cache_entries ) )
+	{
+		if( libvmdk_extent_table_resize_grain_groups_caches(
+		     internal_handle->extent_table,
+		     internal_handle->cache_budget->number_of_grain_groups_cache_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to resize grain groups caches.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
 }
 
-/* Reads (media) data at the current offset into a buffer
- * Returns the number of bytes read or -1 on error
+/* Rebalances the cache budget using the cache lookup and read counts
+ * This function is not multi-thread safe acquire the cache mutex before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_handle_balance_cache_budget(
+     libvmdk_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function           = "libvmdk_internal_handle_balance_cache_budget";
+	uint64_t number_of_grain_hits   = 0;
+	uint64_t number_of_grain_misses = 0;
+	int result                      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->grain_cache != NULL )
+	{
+		if( libvmdk_grain_cache_get_statistics(
+		     internal_handle->grain_cache,
+		     &number_of_grain_hits,
+		     &number_of_grain_misses,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grain cache statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* Every grain cache miss results in the grain being read
+	 */
+	result = libvmdk_cache_budget_balance(
+	          internal_handle->cache_budget,
+	          number_of_grain_hits + number_of_grain_misses,
+	          number_of_grain_misses,
+	          internal_handle->io_handle->number_of_grain_group_lookups,
+	          internal_handle->io_handle->number_of_grain_group_reads,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to balance cache budget.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libvmdk_internal_handle_apply_cache_budget(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to apply cache budget.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Reads the data of a specific grain that is not in the grain cache using a Basic File IO (bfio) pool
+ * The grain data is created by this function, compressed grain data is read into compressed data,
+ * which must be decompressed into the grain data by the caller, other grain data is read into the grain data
+ * This function is not multi-thread safe acquire the cache mutex before call
+ * Returns 1 if successful, 0 if the grain is sparse or -1 on error
+ */
+int libvmdk_internal_handle_read_uncached_grain_data_from_file_io_pool(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_grain_cursor_t *grain_cursor,
+     uint64_t grain_index,
+     off64_t offset,
+     libvmdk_grain_data_t **grain_data,
+     uint8_t **compressed_data,
+     size_t *compressed_data_size,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_data_t *safe_grain_data = NULL;
+	static char *function                 = "libvmdk_internal_handle_read_uncached_grain_data_from_file_io_pool";
+	int result                            = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->io_handle->grain_size == 0 )
+	 || ( internal_handle->io_handle->grain_size > (size64_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - grain size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->cache_budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing cache budget.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *grain_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid grain data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->cache_budget->maximum_size > 0 )
+	{
+		/* The caches are balanced before the grain is resolved
+		 * since resizing them discards the cached grain groups
+		 */
+		if( libvmdk_internal_handle_balance_cache_budget(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to balance cache budget.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	result = libvmdk_grain_table_resolve_grain_at_offset(
+	          internal_handle->grain_table,
+	          grain_cursor,
+	          grain_index,
+	          file_io_pool,
+	          internal_handle->extent_table,
+	          offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to resolve grain: %" PRIu64 ".",
+		 function,
+		 grain_index );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libvmdk_grain_data_initialize(
+	     &safe_grain_data,
+	     (size_t) internal_handle->io_handle->grain_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create grain data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_internal_handle_read_resolved_grain_data_from_file_io_pool(
+	     internal_handle,
+	     file_io_pool,
+	     grain_cursor,
+	     safe_grain_data->data,
+	     safe_grain_data->data_size,
+	     compressed_data,
+	     compressed_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read grain: %" PRIu64 " data.",
+		 function,
+		 grain_index );
+
+		libvmdk_grain_data_free(
+		 &safe_grain_data,
+		 NULL );
+
+		return( -1 );
+	}
+	*grain_data = safe_grain_data;
+
+	return( 1 );
+}
+
+/* Copies grain data into a buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_handle_copy_grain_data_to_buffer(
+     libvmdk_grain_data_t *grain_data,
+     off64_t grain_data_offset,
+     uint8_t *buffer,
+     size_t read_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_internal_handle_copy_grain_data_to_buffer";
+
+	if( grain_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain data.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( grain_data_offset < 0 )
+	 || ( (size64_t) grain_data_offset > grain_data->data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: grain data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size > (size_t) ( grain_data->data_size - grain_data_offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     buffer,
+	     &( ( grain_data->data )[ grain_data_offset ] ),
+	     read_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy grain data to buffer.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+
+/* Reads the data of a specific grain into a buffer using a Basic File IO (bfio) pool
+ * Grain data in the grain cache is copied while only holding the lock of its grain cache shard,
+ * otherwise the cache mutex is only held while the grain is resolved and its data is read,
+ * compressed grain data is decompressed after releasing the cache mutex and the grain data
+ * is inserted into the grain cache afterwards
+ * Returns 1 if successful, 0 if the grain is sparse or -1 on error
+ */
+int libvmdk_internal_handle_read_grain_data_from_file_io_pool(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_grain_cursor_t *grain_cursor,
+     uint64_t grain_index,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t read_size,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_data_t *grain_data = NULL;
+	uint8_t *compressed_data         = NULL;
+	static char *function            = "libvmdk_internal_handle_read_grain_data_from_file_io_pool";
+	size_t compressed_data_size      = 0;
+	off64_t grain_data_offset        = 0;
+	int result                       = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	grain_data_offset = (off64_t) ( (size64_t) offset % internal_handle->io_handle->grain_size );
+
+	result = libvmdk_grain_cache_copy_grain_data(
+	          internal_handle->grain_cache,
+	          grain_index,
+	          (size_t) grain_data_offset,
+	          buffer,
+	          read_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy grain: %" PRIu64 " data from grain cache.",
+		 function,
+		 grain_index );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvmdk_internal_handle_read_uncached_grain_data_from_file_io_pool(
+	          internal_handle,
+	          file_io_pool,
+	          grain_cursor,
+	          grain_index,
+	          offset,
+	          &grain_data,
+	          &compressed_data,
+	          &compressed_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read grain: %" PRIu64 " data.",
+		 function,
+		 grain_index );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( compressed_data != NULL )
+	{
+		if( libvmdk_internal_handle_decompress_compressed_grain_data(
+		     internal_handle,
+		     grain_index,
+		     compressed_data,
+		     compressed_data_size,
+		     grain_data->data,
+		     &( grain_data->data_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress grain: %" PRIu64 " data.",
+			 function,
+			 grain_index );
+
+			goto on_error;
+		}
+		memory_free(
+		 compressed_data );
+
+		compressed_data = NULL;
+	}
+	if( libvmdk_internal_handle_copy_grain_data_to_buffer(
+	     grain_data,
+	     grain_data_offset,
+	     buffer,
+	     read_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy grain: %" PRIu64 " data to buffer.",
+		 function,
+		 grain_index );
+
+		goto on_error;
+	}
+	/* The grain cache takes over the management of the grain data, also on error
+	 * another reader can have inserted the same grain in the meantime
+	 */
+	result = libvmdk_grain_cache_insert_grain_data(
+	          internal_handle->grain_cache,
+	          grain_index,
+	          grain_data,
+	          error );
+
+	grain_data = NULL;
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert grain: %" PRIu64 " data into grain cache.",
+		 function,
+		 grain_index );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	if( grain_data != NULL )
+	{
+		libvmdk_grain_data_free(
+		 &grain_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the data of a resolved grain using a Basic File IO (bfio) pool
+ * Compressed grain data is read into compressed data, which must be decompressed by the caller,
+ * other grain data is read directly into the buffer
+ * This function is not multi-thread safe acquire the cache mutex before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_handle_read_resolved_grain_data_from_file_io_pool(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_grain_cursor_t *grain_cursor,
+     uint8_t *buffer,
+     size_t buffer_size,
+     uint8_t **compressed_data,
+     size_t *compressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function    = "libvmdk_internal_handle_read_resolved_grain_data_from_file_io_pool";
+	ssize_t read_count       = 0;
+	uint64_t start_timestamp = 0;
+	uint8_t is_traced        = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	is_traced = (uint8_t) libvmdk_trace_start_event(
+	                       internal_handle->io_handle->trace,
+	                       &start_timestamp );
+
+	if( ( grain_cursor->grain_flags & LIBVMDK_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		if( libvmdk_grain_data_read_compressed_data(
+		     internal_handle->io_handle,
+		     file_io_pool,
+		     grain_cursor->grain_file_index,
+		     grain_cursor->grain_offset,
+		     compressed_data,
+		     compressed_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read grain: %" PRIu64 " compressed data.",
+			 function,
+			 grain_cursor->grain_index );
+
+			return( -1 );
+		}
+		if( is_traced != 0 )
+		{
+			if( libvmdk_trace_record_event(
+			     internal_handle->io_handle->trace,
+			     LIBVMDK_TRACE_EVENT_GRAIN_READ,
+			     start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to record trace event.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		return( 1 );
+	}
+	if( grain_cursor->grain_size < (size64_t) buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid grain: %" PRIu64 " range size value out of bounds.",
+		 function,
+		 grain_cursor->grain_index );
+
+		return( -1 );
+	}
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     grain_cursor->grain_file_index,
+	     grain_cursor->grain_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek grain offset: %" PRIi64 " in file IO pool entry: %d.",
+		 function,
+		 grain_cursor->grain_offset,
+		 grain_cursor->grain_file_index );
+
+		return( -1 );
+	}
+	if( libvmdk_statistics_add(
+	     internal_handle->io_handle->statistics,
+	     LIBVMDK_STATISTIC_SEEKS,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update statistics.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libbfio_pool_read_buffer(
+		      file_io_pool,
+		      grain_cursor->grain_file_index,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count != (ssize_t) buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read grain: %" PRIu64 " data.",
+		 function,
+		 grain_cursor->grain_index );
+
+		return( -1 );
+	}
+	if( is_traced != 0 )
+	{
+		if( libvmdk_trace_record_event(
+		     internal_handle->io_handle->trace,
+		     LIBVMDK_TRACE_EVENT_GRAIN_READ,
+		     start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to record trace event.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libvmdk_statistics_add(
+	     internal_handle->io_handle->statistics,
+	     LIBVMDK_STATISTIC_READS,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update statistics.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Decompresses the compressed data of a grain
+ * On return the uncompressed data size contains the size of the decompressed data
+ * This function does not use the caches and can be called without holding the cache mutex
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_handle_decompress_compressed_grain_data(
+     libvmdk_internal_handle_t *internal_handle,
+     uint64_t grain_index,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function    = "libvmdk_internal_handle_decompress_compressed_grain_data";
+	uint64_t start_timestamp = 0;
+	uint8_t is_traced        = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	is_traced = (uint8_t) libvmdk_trace_start_event(
+	                       internal_handle->io_handle->trace,
+	                       &start_timestamp );
+
+	if( libvmdk_decompress_data(
+	     compressed_data,
+	     compressed_data_size,
+	     LIBVMDK_COMPRESSION_METHOD_DEFLATE,
+	     uncompressed_data,
+	     uncompressed_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: unable to decompress grain: %" PRIu64 " data.",
+		 function,
+		 grain_index );
+
+		return( -1 );
+	}
+	if( is_traced != 0 )
+	{
+		if( libvmdk_trace_record_event(
+		     internal_handle->io_handle->trace,
+		     LIBVMDK_TRACE_EVENT_GRAIN_DECOMPRESSION,
+		     start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to record trace event.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libvmdk_statistics_add(
+	     internal_handle->io_handle->statistics,
+	     LIBVMDK_STATISTIC_GRAINS_DECOMPRESSED,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_statistics_add(
+	     internal_handle->io_handle->statistics,
+	     LIBVMDK_STATISTIC_COMPRESSED_BYTES_DECOMPRESSED,
+	     (uint64_t) compressed_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update statistics.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the data of one or more whole grains directly into a buffer using a Basic File IO (bfio) pool
+ * Compressed grain data is decompressed directly into the buffer and the grains cache is bypassed
+ * Consecutive grains that are not compressed and are stored contiguously in the same extent file
+ * are read with a single read, up to the size of the buffer
+ * The cache mutex is held while the grains are resolved and their data is read, but not while
+ * compressed grain data is decompressed
+ * Returns the number of bytes read, 0 if the first grain is sparse or -1 on error
+ */
+ssize_t libvmdk_internal_handle_read_grain_data_direct_from_file_io_pool(
+         libvmdk_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libvmdk_grain_cursor_t *grain_cursor,
+         uint64_t grain_index,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	uint8_t *compressed_data      = NULL;
+	static char *function         = "libvmdk_internal_handle_read_grain_data_direct_from_file_io_pool";
+	size_t compressed_data_size   = 0;
+	size_t grain_size             = 0;
+	size_t run_size               = 0;
+	size_t uncompressed_data_size = 0;
+	ssize_t read_count            = 0;
+	uint64_t start_timestamp      = 0;
+	uint8_t is_traced             = 0;
+	off64_t run_offset            = 0;
+	int result                    = 0;
+	int run_file_index            = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->io_handle->grain_size == 0 )
+	 || ( internal_handle->io_handle->grain_size > (size64_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - grain size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	grain_size = (size_t) internal_handle->io_handle->grain_size;
+
+	if( grain_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size > (size_t) SSIZE_MAX )
+	 || ( buffer_size < grain_size )
+	 || ( ( buffer_size % grain_size ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvmdk_grain_table_resolve_grain_at_offset(
+	          internal_handle->grain_table,
+	          grain_cursor,
+	          grain_index,
+	          file_io_pool,
+	          internal_handle->extent_table,
+	          offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to resolve grain: %" PRIu64 ".",
+		 function,
+		 grain_index );
+	}
+	else if( ( result != 0 )
+	      && ( ( grain_cursor->grain_flags & LIBVMDK_RANGE_FLAG_IS_COMPRESSED ) != 0 ) )
+	{
+		if( libvmdk_internal_handle_read_resolved_grain_data_from_file_io_pool(
+		     internal_handle,
+		     file_io_pool,
+		     grain_cursor,
+		     buffer,
+		     grain_size,
+		     &compressed_data,
+		     &compressed_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read grain: %" PRIu64 " data.",
+			 function,
+			 grain_index );
+
+			result = -1;
+		}
+	}
+	else if( result != 0 )
+	{
+		if( grain_cursor->grain_size < (size64_t) grain_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid grain: %" PRIu64 " range size value out of bounds.",
+			 function,
+			 grain_index );
+
+			result = -1;
+		}
+		else
+		{
+			run_file_index = grain_cursor->grain_file_index;
+			run_offset     = grain_cursor->grain_offset;
+			run_size       = grain_size;
+		}
+		/* Extend the run with the grains that directly follow in the same extent file
+		 */
+		while( ( result == 1 )
+		    && ( run_size < buffer_size ) )
+		{
+			result = libvmdk_grain_table_resolve_grain_at_offset(
+			          internal_handle->grain_table,
+			          grain_cursor,
+			          grain_index + ( run_size / grain_size ),
+			          file_io_pool,
+			          internal_handle->extent_table,
+			          offset + (off64_t) run_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to resolve grain: %" PRIu64 ".",
+				 function,
+				 grain_index + ( run_size / grain_size ) );
+
+				break;
+			}
+			else if( ( result == 0 )
+			      || ( ( grain_cursor->grain_flags & LIBVMDK_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+			      || ( grain_cursor->grain_file_index != run_file_index )
+			      || ( grain_cursor->grain_offset != ( run_offset + (off64_t) run_size ) )
+			      || ( grain_cursor->grain_size < (size64_t) grain_size ) )
+			{
+				result = 1;
+
+				break;
+			}
+			run_size += grain_size;
+		}
+		if( result == 1 )
+		{
+			is_traced = (uint8_t) libvmdk_trace_start_event(
+			                       internal_handle->io_handle->trace,
+			                       &start_timestamp );
+		}
+		/* The run is read before the cache mutex is released since the file IO pool is shared
+		 * by the readers, the seek and read must not be interleaved with those of another reader
+		 * and the pool can close and reopen the file IO handles to limit the number of open handles
+		 */
+		if( result == 1 )
+		{
+			if( libbfio_pool_seek_offset(
+			     file_io_pool,
+			     run_file_index,
+			     run_offset,
+			     SEEK_SET,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek grain offset: %" PRIi64 " in file IO pool entry: %d.",
+				 function,
+				 run_offset,
+				 run_file_index );
+
+				result = -1;
+			}
+			else
+			{
+				read_count = libbfio_pool_read_buffer(
+					      file_io_pool,
+					      run_file_index,
+					      buffer,
+					      run_size,
+					      error );
+
+				if( read_count != (ssize_t) run_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read grain: %" PRIu64 " data.",
+					 function,
+					 grain_index );
+
+					result = -1;
+				}
+			}
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( compressed_data != NULL )
+	{
+		uncompressed_data_size = grain_size;
+
+		if( libvmdk_internal_handle_decompress_compressed_grain_data(
+		     internal_handle,
+		     grain_index,
+		     compressed_data,
+		     compressed_data_size,
+		     buffer,
+		     &uncompressed_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress grain: %" PRIu64 " data.",
+			 function,
+			 grain_index );
+
+			goto on_error;
+		}
+		if( uncompressed_data_size != grain_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid grain: %" PRIu64 " uncompressed data size value out of bounds.",
+			 function,
+			 grain_index );
+
+			goto on_error;
+		}
+		memory_free(
+		 compressed_data );
+
+		return( (ssize_t) grain_size );
+	}
+	if( is_traced != 0 )
+	{
+		if( libvmdk_trace_record_event(
+		     internal_handle->io_handle->trace,
+		     LIBVMDK_TRACE_EVENT_GRAIN_READ,
+		     start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to record trace event.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvmdk_statistics_add(
+	     internal_handle->io_handle->statistics,
+	     LIBVMDK_STATISTIC_SEEKS,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_statistics_add(
+	     internal_handle->io_handle->statistics,
+	     LIBVMDK_STATISTIC_READS,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update statistics.",
+		 function );
+
+		goto on_error;
+	}
+	return( (ssize_t) run_size );
+
+on_error:
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+
+/* Reads the data of a whole grain for the readahead
+ * This function is called by the readahead thread, which is the only user of the readahead grain cursor
+ * Returns 1 if successful, 0 if the grain is sparse or -1 on error
+ */
+int libvmdk_internal_handle_read_readahead_grain(
+     libvmdk_internal_handle_t *internal_handle,
+     uint64_t grain_index,
+     uint8_t *grain_data,
+     size_t grain_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_internal_handle_read_readahead_grain";
+	ssize_t read_count    = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libvmdk_internal_handle_read_grain_data_direct_from_file_io_pool(
+	              internal_handle,
+	              internal_handle->extent_data_file_io_pool,
+	              &( internal_handle->readahead_grain_cursor ),
+	              grain_index,
+	              (off64_t) ( grain_index * internal_handle->io_handle->grain_size ),
+	              grain_data,
+	              grain_data_size,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read grain: %" PRIu64 " data.",
+		 function,
+		 grain_index );
+
+		return( -1 );
+	}
+	else if( read_count == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+
+/* Determines if a layer of the parent chain contains the data of the grain at a specific offset
+ * Returns 1 if the layer contains the grain data, 0 if not or -1 on error
+ */
+int libvmdk_internal_handle_layer_has_grain_at_offset(
+     libvmdk_internal_handle_t *layer_internal_handle,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_cursor_t grain_cursor;
+	static char *function = "libvmdk_internal_handle_layer_has_grain_at_offset";
+	int result            = 0;
+
+	if( layer_internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layer handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( layer_internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid layer handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( layer_internal_handle->extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid layer handle - missing extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     layer_internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( (size64_t) offset >= layer_internal_handle->io_handle->media_size )
+	{
+		result = 0;
+	}
+	else if( layer_internal_handle->extent_table->extent_files_stream != NULL )
+	{
+		/* Flat extents contain the data of every grain
+		 */
+		result = 1;
+	}
+	else if( libvmdk_grain_table_reset_grain_cursor(
+	          &grain_cursor,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to reset grain cursor.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     layer_internal_handle->cache_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab cache mutex.",
+			 function );
+
+			result = -1;
+		}
+		else
+#endif
+		{
+			result = libvmdk_grain_table_resolve_grain_at_offset(
+			          layer_internal_handle->grain_table,
+			          &grain_cursor,
+			          (uint64_t) offset / layer_internal_handle->io_handle->grain_size,
+			          layer_internal_handle->extent_data_file_io_pool,
+			          layer_internal_handle->extent_table,
+			          offset,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to resolve grain at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 offset,
+				 offset );
+			}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+			if( libcthreads_mutex_release(
+			     layer_internal_handle->cache_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release cache mutex.",
+				 function );
+
+				result = -1;
+			}
+#endif
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     layer_internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Creates the layer map of the parent chain
+ * The layer map is only created if the sparse layers of the parent chain have the same grain size
+ * and the parent chain is not deeper than LIBVMDK_LAYER_MAP_MAXIMUM_DEPTH
+ * This function is not multi-thread safe acquire the cache mutex before call
+ * Returns 1 if successful, 0 if the layer map is not supported by the parent chain or -1 on error
+ */
+int libvmdk_internal_handle_create_layer_map(
+     libvmdk_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *layer_internal_handle = NULL;
+	static char *function                            = "libvmdk_internal_handle_create_layer_map";
+	uint64_t number_of_grains                        = 0;
+	int depth                                        = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle->grain_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - grain size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->layer_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - layer map value already set.",
+		 function );
+
+		return( -1 );
+	}
+	layer_internal_handle = (libvmdk_internal_handle_t *) internal_handle->parent_handle;
+
+	while( layer_internal_handle != NULL )
+	{
+		depth++;
+
+		if( depth > LIBVMDK_LAYER_MAP_MAXIMUM_DEPTH )
+		{
+			return( 0 );
+		}
+		if( ( layer_internal_handle->io_handle == NULL )
+		 || ( layer_internal_handle->extent_table == NULL ) )
+		{
+			return( 0 );
+		}
+		if( ( layer_internal_handle->extent_table->extent_files_stream == NULL )
+		 && ( layer_internal_handle->io_handle->grain_size != internal_handle->io_handle->grain_size ) )
+		{
+			return( 0 );
+		}
+		layer_internal_handle = (libvmdk_internal_handle_t *) layer_internal_handle->parent_handle;
+	}
+	number_of_grains = internal_handle->io_handle->media_size / internal_handle->io_handle->grain_size;
+
+	if( ( internal_handle->io_handle->media_size % internal_handle->io_handle->grain_size ) != 0 )
+	{
+		number_of_grains += 1;
+	}
+	if( number_of_grains == 0 )
+	{
+		return( 0 );
+	}
+	if( libvmdk_layer_map_initialize(
+	     &( internal_handle->layer_map ),
+	     number_of_grains,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create layer map.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the layer of the parent chain that contains the data of the grain at a specific offset
+ * The layer is looked up in the layer map, which is filled in the first time a grain is read from the parent chain
+ * The layer handle is set to NULL if no layer contains the grain data
+ * Returns 1 if successful, 0 if the layer map is not supported by the parent chain or -1 on error
+ */
+int libvmdk_internal_handle_get_parent_layer_at_offset(
+     libvmdk_internal_handle_t *internal_handle,
+     off64_t offset,
+     libvmdk_handle_t **layer_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *safe_layer_handle = NULL;
+	static char *function               = "libvmdk_internal_handle_get_parent_layer_at_offset";
+	uint64_t grain_index                = 0;
+	uint8_t layer                       = 0;
+	int depth                           = 0;
+	int result                          = 1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle->grain_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - grain size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( layer_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layer handle.",
+		 function );
+
+		return( -1 );
+	}
+	grain_index = (uint64_t) offset / internal_handle->io_handle->grain_size;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->layer_map_is_unsupported != 0 )
+	{
+		result = 0;
+	}
+	else if( internal_handle->layer_map == NULL )
+	{
+		result = libvmdk_internal_handle_create_layer_map(
+		          internal_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create layer map.",
+			 function );
+		}
+		else if( result == 0 )
+		{
+			internal_handle->layer_map_is_unsupported = 1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libvmdk_layer_map_get_layer(
+		     internal_handle->layer_map,
+		     grain_index,
+		     &layer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve layer of grain: %" PRIu64 " from layer map.",
+			 function,
+			 grain_index );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result != 1 )
+	{
+		return( result );
+	}
+	if( layer == LIBVMDK_LAYER_MAP_LAYER_UNRESOLVED )
+	{
+		/* The cache mutex is not held while the layers are checked, since every layer has its own locks
+		 * if another thread resolves the same grain it stores the same layer
+		 */
+		safe_layer_handle = internal_handle->parent_handle;
+		depth             = 1;
+
+		while( safe_layer_handle != NULL )
+		{
+			result = libvmdk_internal_handle_layer_has_grain_at_offset(
+			          (libvmdk_internal_handle_t *) safe_layer_handle,
+			          offset,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if layer: %d contains grain: %" PRIu64 ".",
+				 function,
+				 depth,
+				 grain_index );
+
+				return( -1 );
+			}
+			else if( result != 0 )
+			{
+				break;
+			}
+			safe_layer_handle = ( (libvmdk_internal_handle_t *) safe_layer_handle )->parent_handle;
+
+			depth++;
+		}
+		if( safe_layer_handle == NULL )
+		{
+			layer = LIBVMDK_LAYER_MAP_LAYER_NONE;
+		}
+		else
+		{
+			layer = (uint8_t) depth;
+		}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     internal_handle->cache_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab cache mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		result = libvmdk_layer_map_set_layer(
+		          internal_handle->layer_map,
+		          grain_index,
+		          layer,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set layer of grain: %" PRIu64 " in layer map.",
+			 function,
+			 grain_index );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     internal_handle->cache_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release cache mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( result != 1 )
+		{
+			return( -1 );
+		}
+	}
+	else if( layer != LIBVMDK_LAYER_MAP_LAYER_NONE )
+	{
+		safe_layer_handle = internal_handle->parent_handle;
+
+		for( depth = 1;
+		     depth < (int) layer;
+		     depth++ )
+		{
+			if( safe_layer_handle == NULL )
+			{
+				break;
+			}
+			safe_layer_handle = ( (libvmdk_internal_handle_t *) safe_layer_handle )->parent_handle;
+		}
+		if( safe_layer_handle == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing layer: %" PRIu8 " of grain: %" PRIu64 ".",
+			 function,
+			 layer,
+			 grain_index );
+
+			return( -1 );
+		}
+	}
+	*layer_handle = safe_layer_handle;
+
+	return( 1 );
+}
+
+/* Reads (media) data at a specific offset within a grain from the parent chain into a buffer
+ * The data is read from the layer that contains the grain data, as recorded in the layer map,
+ * or filled with 0-byte values if no layer contains the grain data
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvmdk_internal_handle_read_buffer_from_parent(
+         libvmdk_internal_handle_t *internal_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libvmdk_handle_t *layer_handle = NULL;
+	static char *function          = "libvmdk_internal_handle_read_buffer_from_parent";
+	ssize_t read_count             = 0;
+	int result                     = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvmdk_internal_handle_get_parent_layer_at_offset(
+	          internal_handle,
+	          offset,
+	          &layer_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent layer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		/* The layer map is not supported by the parent chain, read through the parent handle instead
+		 */
+		layer_handle = internal_handle->parent_handle;
+	}
+	else if( layer_handle == NULL )
+	{
+		if( memory_set(
+		     buffer,
+		     0,
+		     buffer_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to fill buffer with sparse grain.",
+			 function );
+
+			return( -1 );
+		}
+		return( (ssize_t) buffer_size );
+	}
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              layer_handle,
+	              buffer,
+	              buffer_size,
+	              offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer from parent layer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+
+/* Creates the decompression thread pool
+ * An existing decompression thread pool is joined first, no pool is created if the number of decompression threads is 0
+ * This function is not multi-thread safe acquire the write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_handle_create_decompression_thread_pool(
+     libvmdk_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_internal_handle_create_decompression_thread_pool";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->decompression_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( internal_handle->decompression_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join decompression thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->number_of_decompression_threads > 0 )
+	{
+		/* The queue is kept small so that only a limited amount of compressed data is kept in memory
+		 */
+		if( libcthreads_thread_pool_create(
+		     &( internal_handle->decompression_thread_pool ),
+		     NULL,
+		     internal_handle->number_of_decompression_threads,
+		     internal_handle->number_of_decompression_threads * 2,
+		     (int (*)(intptr_t *, void *)) &libvmdk_internal_handle_decompress_grain_data,
+		     (void *) internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create decompression thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Decompresses the compressed data of a grain into the uncompressed data of the grain decompression
+ * Callback function for the decompression thread pool
+ * The arguments contain the handle
+ * The outcome of the decompression is stored in the grain decompression and
+ * the number of pending decompressions of the read is decremented
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_handle_decompress_grain_data(
+     libvmdk_internal_grain_decompression_t *grain_decompression,
+     void *arguments )
+{
+	libcerror_error_t *error                   = NULL;
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	libvmdk_trace_t *trace                     = NULL;
+	static char *function                      = "libvmdk_internal_handle_decompress_grain_data";
+	size_t uncompressed_data_size              = 0;
+	uint64_t start_timestamp                   = 0;
+	uint8_t is_traced                          = 0;
+	int result                                 = 1;
+
+	if( ( grain_decompression == NULL )
+	 || ( arguments == NULL ) )
+	{
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) arguments;
+	trace           = internal_handle->io_handle->trace;
+
+	is_traced = (uint8_t) libvmdk_trace_start_event(
+	                       trace,
+	                       &start_timestamp );
+
+	uncompressed_data_size = grain_decompression->uncompressed_data_size;
+
+	if( result == 1 )
+	{
+		if( libvmdk_decompress_data(
+		     grain_decompression->compressed_data,
+		     grain_decompression->compressed_data_size,
+		     LIBVMDK_COMPRESSION_METHOD_DEFLATE,
+		     grain_decompression->uncompressed_data,
+		     &uncompressed_data_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress grain: %" PRIu64 " data.",
+			 function,
+			 grain_decompression->grain_index );
+
+			result = -1;
+		}
+		else if( uncompressed_data_size != grain_decompression->uncompressed_data_size )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid grain: %" PRIu64 " uncompressed data size value out of bounds.",
+			 function,
+			 grain_decompression->grain_index );
+
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( is_traced != 0 ) )
+	{
+		if( libvmdk_trace_record_event(
+		     trace,
+		     LIBVMDK_TRACE_EVENT_GRAIN_DECOMPRESSION,
+		     start_timestamp,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to record trace event.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	memory_free(
+	 grain_decompression->compressed_data );
+
+	grain_decompression->compressed_data = NULL;
+	grain_decompression->result          = result;
+
+	if( libcthreads_mutex_grab(
+	     internal_handle->decompression_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	*( grain_decompression->number_of_pending_decompressions ) -= 1;
+
+	if( ( *( grain_decompression->number_of_pending_decompressions ) == 0 )
+	 && ( libcthreads_condition_broadcast(
+	       internal_handle->decompression_condition,
+	       NULL ) != 1 ) )
+	{
+		libcthreads_mutex_release(
+		 internal_handle->decompression_mutex,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_release(
+	     internal_handle->decompression_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Waits until the pending decompressions of a read have completed
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_handle_wait_for_grain_decompressions(
+     libvmdk_internal_handle_t *internal_handle,
+     int *number_of_pending_decompressions,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_internal_handle_wait_for_grain_decompressions";
+	int result            = 1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_pending_decompressions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of pending decompressions.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_handle->decompression_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab decompression mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( *number_of_pending_decompressions > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     internal_handle->decompression_condition,
+		     internal_handle->decompression_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for decompression condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     internal_handle->decompression_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release decompression mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Reads grain aligned (media) data at a specific offset into a buffer using a Basic File IO (bfio) pool
+ * The compressed grain data is read on the calling thread while the cache mutex is held
+ * and is decompressed directly into the buffer by the decompression thread pool of the handle
+ * Grains that are sparse or not compressed are read on the calling thread
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvmdk_internal_handle_read_grains_from_file_io_pool(
+         libvmdk_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint64_t grain_index,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libvmdk_internal_grain_decompression_t *grain_decompression  = NULL;
+	libvmdk_internal_grain_decompression_t *grain_decompressions = NULL;
+	static char *function                                        = "libvmdk_internal_handle_read_grains_from_file_io_pool";
+	libvmdk_grain_cursor_t grain_cursor;
+	size_t buffer_offset                                         = 0;
+	size_t grain_size                                            = 0;
+	ssize_t read_count                                           = 0;
+	int grain_decompression_index                                = 0;
+	int number_of_grains                                         = 0;
+	int number_of_pending_decompressions                         = 0;
+	int result                                                   = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->io_handle->grain_size == 0 )
+	 || ( internal_handle->io_handle->grain_size > (size64_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - grain size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	grain_size = (size_t) internal_handle->io_handle->grain_size;
+
+	if( internal_handle->decompression_thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing decompression thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size > (size_t) SSIZE_MAX )
+	 || ( ( buffer_size % grain_size ) != 0 )
+	 || ( ( buffer_size / grain_size ) > (size_t) INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( ( (size64_t) offset % grain_size ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_grains = (int) ( buffer_size / grain_size );
+
+	if( number_of_grains == 0 )
+	{
+		return( 0 );
+	}
+	if( libvmdk_grain_table_reset_grain_cursor(
+	     &grain_cursor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to reset grain cursor.",
+		 function );
+
+		return( -1 );
+	}
+	grain_decompressions = (libvmdk_internal_grain_decompression_t *) memory_allocate(
+	                                                                   sizeof( libvmdk_internal_grain_decompression_t ) * number_of_grains );
+
+	if( grain_decompressions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create grain decompressions.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     grain_decompressions,
+	     0,
+	     sizeof( libvmdk_internal_grain_decompression_t ) * number_of_grains ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear grain decompressions.",
+		 function );
+
+		memory_free(
+		 grain_decompressions );
+
+		return( -1 );
+	}
+	for( grain_decompression_index = 0;
+	     grain_decompression_index < number_of_grains;
+	     grain_decompression_index++ )
+	{
+		grain_decompression = &( grain_decompressions[ grain_decompression_index ] );
+
+		grain_decompression->grain_index                      = grain_index;
+		grain_decompression->uncompressed_data                = &( buffer[ buffer_offset ] );
+		grain_decompression->uncompressed_data_size           = grain_size;
+		grain_decompression->number_of_pending_decompressions = &number_of_pending_decompressions;
+
+		if( libcthreads_mutex_grab(
+		     internal_handle->cache_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab cache mutex.",
+			 function );
+
+			goto on_error;
+		}
+		result = libvmdk_grain_table_resolve_grain_at_offset(
+		          internal_handle->grain_table,
+		          &grain_cursor,
+		          grain_index,
+		          file_io_pool,
+		          internal_handle->extent_table,
+		          offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to resolve grain: %" PRIu64 ".",
+			 function,
+			 grain_index );
+		}
+		else if( result != 0 )
+		{
+			/* Grain data that is not compressed is read directly into the buffer
+			 */
+			if( libvmdk_internal_handle_read_resolved_grain_data_from_file_io_pool(
+			     internal_handle,
+			     file_io_pool,
+			     &grain_cursor,
+			     grain_decompression->uncompressed_data,
+			     grain_size,
+			     &( grain_decompression->compressed_data ),
+			     &( grain_decompression->compressed_data_size ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read grain: %" PRIu64 " data.",
+				 function,
+				 grain_index );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_mutex_release(
+		     internal_handle->cache_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release cache mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( result == -1 )
+		{
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			if( libvmdk_statistics_add(
+			     internal_handle->io_handle->statistics,
+			     LIBVMDK_STATISTIC_SPARSE_GRAINS_READ,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update statistics.",
+				 function );
+
+				goto on_error;
+			}
+			if( internal_handle->parent_handle == NULL )
+			{
+				if( memory_set(
+				     grain_decompression->uncompressed_data,
+				     0,
+				     grain_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to fill buffer with sparse grain.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			else
+			{
+				read_count = libvmdk_internal_handle_read_buffer_from_parent(
+					      internal_handle,
+					      grain_decompression->uncompressed_data,
+					      grain_size,
+					      offset,
+					      error );
+
+				if( read_count != (ssize_t) grain_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read grain data from parent at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 offset,
+					 offset );
+
+					goto on_error;
+				}
+			}
+		}
+		else if( grain_decompression->compressed_data != NULL )
+		{
+			/* The decompression is counted before it is pushed since it can complete before the push returns
+			 */
+			if( libcthreads_mutex_grab(
+			     internal_handle->decompression_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab decompression mutex.",
+				 function );
+
+				goto on_error;
+			}
+			number_of_pending_decompressions += 1;
+
+			if( libcthreads_mutex_release(
+			     internal_handle->decompression_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release decompression mutex.",
+				 function );
+
+				goto on_error;
+			}
+			if( libcthreads_thread_pool_push(
+			     internal_handle->decompression_thread_pool,
+			     (intptr_t *) grain_decompression,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push grain: %" PRIu64 " onto decompression thread pool.",
+				 function,
+				 grain_index );
+
+				libcthreads_mutex_grab(
+				 internal_handle->decompression_mutex,
+				 NULL );
+
+				number_of_pending_decompressions -= 1;
+
+				libcthreads_mutex_release(
+				 internal_handle->decompression_mutex,
+				 NULL );
+
+				goto on_error;
+			}
+		}
+		buffer_offset += grain_size;
+		grain_index   += 1;
+
+		offset += (off64_t) grain_size;
+
+		if( libvmdk_io_handle_get_abort( internal_handle->io_handle ) != 0 )
+		{
+			break;
+		}
+	}
+	if( libvmdk_internal_handle_wait_for_grain_decompressions(
+	     internal_handle,
+	     &number_of_pending_decompressions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to wait for grain decompressions.",
+		 function );
+
+		goto on_error;
+	}
+	for( grain_decompression_index = 0;
+	     grain_decompression_index < number_of_grains;
+	     grain_decompression_index++ )
+	{
+		grain_decompression = &( grain_decompressions[ grain_decompression_index ] );
+
+		if( grain_decompression->result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress grain: %" PRIu64 " data.",
+			 function,
+			 grain_decompression->grain_index );
+
+			goto on_error;
+		}
+		else if( ( grain_decompression->result == 1 )
+		      && ( grain_decompression->compressed_data_size > 0 ) )
+		{
+			if( libvmdk_statistics_add(
+			     internal_handle->io_handle->statistics,
+			     LIBVMDK_STATISTIC_GRAINS_DECOMPRESSED,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update statistics.",
+				 function );
+
+				goto on_error;
+			}
+			if( libvmdk_statistics_add(
+			     internal_handle->io_handle->statistics,
+			     LIBVMDK_STATISTIC_COMPRESSED_BYTES_DECOMPRESSED,
+			     (uint64_t) grain_decompression->compressed_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update statistics.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	memory_free(
+	 grain_decompressions );
+
+	return( (ssize_t) buffer_offset );
+
+on_error:
+	/* The grain decompressions cannot be freed while they are used by the decompression threads
+	 */
+	libvmdk_internal_handle_wait_for_grain_decompressions(
+	 internal_handle,
+	 &number_of_pending_decompressions,
+	 NULL );
+
+	if( grain_decompressions != NULL )
+	{
+		for( grain_decompression_index = 0;
+		     grain_decompression_index < number_of_grains;
+		     grain_decompression_index++ )
+		{
+			grain_decompression = &( grain_decompressions[ grain_decompression_index ] );
+
+			if( grain_decompression->compressed_data != NULL )
+			{
+				memory_free(
+				 grain_decompression->compressed_data );
+			}
+		}
+		memory_free(
+		 grain_decompressions );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+
+/* Determines if a read continues where the previous read ended and sets the offset
+ * directly after the read as the sequential read offset
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_handle_update_sequential_read_offset(
+     libvmdk_internal_handle_t *internal_handle,
+     off64_t offset,
+     size_t read_size,
+     uint8_t *is_sequential,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_internal_handle_update_sequential_read_offset";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( is_sequential == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid is sequential.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( offset == internal_handle->sequential_read_offset )
+	{
+		*is_sequential = 1;
+	}
+	else
+	{
+		*is_sequential = 0;
+	}
+	internal_handle->sequential_read_offset = offset + (off64_t) read_size;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Reads (media) data at a specific offset into a buffer using a Basic File IO (bfio) pool
+ * This function does not change the current offset of the handle
+ * This function is multi-thread safe if the read lock is acquired before call
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvmdk_internal_handle_read_buffer_from_file_io_pool(
+         libvmdk_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function     = "libvmdk_internal_handle_read_buffer_from_file_io_pool";
+	libvmdk_grain_cursor_t grain_cursor;
+	size_t buffer_offset      = 0;
+	size_t direct_read_size   = 0;
+	size_t read_size          = 0;
+	ssize_t read_count        = 0;
+	off64_t grain_data_offset = 0;
+	uint64_t grain_index      = 0;
+	uint8_t is_sequential     = 0;
+	int result                = 0;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	size_t grains_read_size   = 0;
+#endif
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->descriptor_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing descriptor file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->descriptor_file->parent_content_identifier_set != 0 )
+	 && ( internal_handle->descriptor_file->parent_content_identifier != 0xffffffffUL ) )
+	{
+		if( internal_handle->parent_handle == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid handle - missing parent handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid element data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size == 0 )
+	{
+		return( 0 );
+	}
+	if( (size64_t) offset >= internal_handle->io_handle->media_size )
+	{
+		return( 0 );
+	}
+	if( internal_handle->extent_table->extent_files_stream != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: requested offset\t\t\t\t: %" PRIi64 " (0x%08" PRIx64 ")\n",
+			 function,
+			 offset,
+			 offset );
+		}
+#endif
+		read_size = buffer_size;
+
+		if( ( (size64_t) read_size > internal_handle->io_handle->media_size )
+		 || ( (size64_t) offset > ( internal_handle->io_handle->media_size - read_size ) ) )
+		{
+			read_size = (size_t) ( internal_handle->io_handle->media_size - offset );
+		}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     internal_handle->cache_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab cache mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		read_count = libfdata_stream_read_buffer_at_offset(
+		              internal_handle->extent_table->extent_files_stream,
+			      (intptr_t *) file_io_pool,
+			      (uint8_t *) buffer,
+			      read_size,
+			      offset,
+			      0,
+			      error );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     internal_handle->cache_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release cache mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from extent files stream at offset: %" PRIi64 " (0x%" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		buffer_offset = read_size;
+	}
+	else
+	{
+		if( libvmdk_grain_table_reset_grain_cursor(
+		     &grain_cursor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to reset grain cursor.",
+			 function );
+
+			return( -1 );
+		}
+		if( libvmdk_internal_handle_update_sequential_read_offset(
+		     internal_handle,
+		     offset,
+		     buffer_size,
+		     &is_sequential,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update sequential read offset.",
+			 function );
+
+			return( -1 );
+		}
+		/* A buffer that spans multiple grains is read sequentially
+		 */
+		if( (size64_t) buffer_size > internal_handle->io_handle->grain_size )
+		{
+			is_sequential = 1;
+		}
+		grain_index       = offset / internal_handle->io_handle->grain_size;
+		grain_data_offset = (off64_t) ( offset % internal_handle->io_handle->grain_size );
+
+		while( buffer_offset < buffer_size )
+		{
+			read_size = (size_t) ( internal_handle->io_handle->grain_size - grain_data_offset );
+
+			if( read_size > ( buffer_size - buffer_offset ) )
+			{
+				read_size = buffer_size - buffer_offset;
+			}
+			if( ( (size64_t) read_size > internal_handle->io_handle->media_size )
+			 || ( (size64_t) offset > ( internal_handle->io_handle->media_size - read_size ) ) )
+			{
+				read_size = (size_t) ( internal_handle->io_handle->media_size - offset );
+			}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+			if( internal_handle->readahead != NULL )
+			{
+				result = libvmdk_readahead_read_grain_data(
+				          internal_handle->readahead,
+				          grain_index,
+				          (size_t) grain_data_offset,
+				          &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+				          read_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read grain: %" PRIu64 " data from readahead.",
+					 function,
+					 grain_index );
+
+					return( -1 );
+				}
+				else if( result != 0 )
+				{
+					buffer_offset    += read_size;
+					grain_data_offset = 0;
+
+					offset     += (off64_t) read_size;
+					grain_index = (uint64_t) offset / internal_handle->io_handle->grain_size;
+
+					if( (size64_t) offset >= internal_handle->io_handle->media_size )
+					{
+						break;
+					}
+					if( libvmdk_io_handle_get_abort( internal_handle->io_handle ) != 0 )
+					{
+						break;
+					}
+					continue;
+				}
+			}
+			/* Reads that span multiple whole grains are decompressed by the decompression threads
+			 * unless the grains are read ahead
+			 */
+			if( ( internal_handle->decompression_thread_pool != NULL )
+			 && ( internal_handle->readahead == NULL )
+			 && ( grain_data_offset == 0 ) )
+			{
+				grains_read_size = buffer_size - buffer_offset;
+
+				if( (size64_t) grains_read_size > ( internal_handle->io_handle->media_size - offset ) )
+				{
+					grains_read_size = (size_t) ( internal_handle->io_handle->media_size - offset );
+				}
+				grains_read_size -= grains_read_size % (size_t) internal_handle->io_handle->grain_size;
+
+				if( ( grains_read_size / (size_t) internal_handle->io_handle->grain_size ) >= LIBVMDK_MINIMUM_NUMBER_OF_GRAINS_PER_THREADED_READ )
+				{
+					read_count = libvmdk_internal_handle_read_grains_from_file_io_pool(
+						      internal_handle,
+						      file_io_pool,
+						      grain_index,
+						      &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+						      grains_read_size,
+						      offset,
+						      error );
+
+					if( read_count == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read grains: %" PRIu64 " and on.",
+						 function,
+						 grain_index );
+
+						return( -1 );
+					}
+					buffer_offset += (size_t) read_count;
+					grain_index   += (uint64_t) read_count / internal_handle->io_handle->grain_size;
+
+					offset += (off64_t) read_count;
+
+					if( (size64_t) offset >= internal_handle->io_handle->media_size )
+					{
+						break;
+					}
+					if( libvmdk_io_handle_get_abort( internal_handle->io_handle ) != 0 )
+					{
+						break;
+					}
+					continue;
+				}
+			}
+#endif
+			/* Whole grains of sequential reads are read directly into the buffer, bypassing
+			 * the grains cache, contiguous grains that are not compressed are read as one run
+			 * Whole grains of random reads are read using the grains cache
+			 */
+			if( ( is_sequential != 0 )
+			 && ( grain_data_offset == 0 )
+			 && ( (size64_t) read_size == internal_handle->io_handle->grain_size ) )
+			{
+				direct_read_size = buffer_size - buffer_offset;
+
+				if( (size64_t) direct_read_size > ( internal_handle->io_handle->media_size - offset ) )
+				{
+					direct_read_size = (size_t) ( internal_handle->io_handle->media_size - offset );
+				}
+				direct_read_size -= direct_read_size % (size_t) internal_handle->io_handle->grain_size;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+				/* The readahead has to see every grain that is read, hence the grains are read one at a time
+				 */
+				if( internal_handle->readahead != NULL )
+				{
+					direct_read_size = (size_t) internal_handle->io_handle->grain_size;
+				}
+#endif
+				read_count = libvmdk_internal_handle_read_grain_data_direct_from_file_io_pool(
+				              internal_handle,
+				              file_io_pool,
+				              &grain_cursor,
+				              grain_index,
+				              offset,
+				              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+				              direct_read_size,
+				              error );
+
+				if( read_count == -1 )
+				{
+					result = -1;
+				}
+				else if( read_count == 0 )
+				{
+					result = 0;
+				}
+				else
+				{
+					read_size = (size_t) read_count;
+					result    = 1;
+				}
+			}
+			else
+			{
+				result = libvmdk_internal_handle_read_grain_data_from_file_io_pool(
+				          internal_handle,
+				          file_io_pool,
+				          &grain_cursor,
+				          grain_index,
+				          offset,
+				          &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+				          read_size,
+				          error );
+			}
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read grain: %" PRIu64 " data.",
+				 function,
+				 grain_index );
+
+				return( -1 );
+			}
+			else if( result == 0 )
+			{
+				if( libvmdk_statistics_add(
+				     internal_handle->io_handle->statistics,
+				     LIBVMDK_STATISTIC_SPARSE_GRAINS_READ,
+				     1,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to update statistics.",
+					 function );
+
+					return( -1 );
+				}
+				if( internal_handle->parent_handle == NULL )
+				{
+					if( memory_set(
+					     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+					     0,
+					     read_size ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+						 "%s: unable to fill buffer with sparse grain.",
+						 function );
+
+						return( -1 );
+					}
+				}
+				else
+				{
+					read_count = libvmdk_internal_handle_read_buffer_from_parent(
+						      internal_handle,
+						      &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+						      read_size,
+						      offset,
+						      error );
+
+					if( read_count != (ssize_t) read_size )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read grain data from parent at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+						 function,
+						 offset,
+						 offset );
+
+						return( -1 );
+					}
+				}
+			}
+			buffer_offset    += read_size;
+			grain_data_offset = 0;
+
+			offset     += (off64_t) read_size;
+			grain_index = (uint64_t) offset / internal_handle->io_handle->grain_size;
+
+			if( (size64_t) offset >= internal_handle->io_handle->media_size )
+			{
+				break;
+			}
+			if( libvmdk_io_handle_get_abort( internal_handle->io_handle ) != 0 )
+			{
+				break;
+			}
+		}
+	}
+	if( libvmdk_statistics_add(
+	     internal_handle->io_handle->statistics,
+	     LIBVMDK_STATISTIC_BYTES_READ,
+	     (uint64_t) buffer_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update statistics.",
+		 function );
+
+		return( -1 );
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Reads (media) data at the current offset into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvmdk_handle_read_buffer(
+         libvmdk_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_read_buffer";
+	ssize_t read_count                         = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* The abort is only reset while the read/write lock is held for writing
+	 * so that it cannot clear an abort signalled to a concurrent read
+	 */
+	libvmdk_io_handle_set_abort(
+	 internal_handle->io_handle,
+	 0 );
+
+	read_count = libvmdk_internal_handle_read_buffer_from_file_io_pool(
+		      internal_handle,
+		      internal_handle->extent_data_file_io_pool,
+		      buffer,
+		      buffer_size,
+		      internal_handle->current_offset,
+		      error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
+	}
+	else
+	{
+		internal_handle->current_offset += (off64_t) read_count;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Resets the abort before a read at a specific offset
+ * The abort is only reset while the read/write lock is held for writing, hence after
+ * the reads that were in progress when the abort was signalled have finished
+ * This function is not multi-thread safe if the read/write lock is held by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_handle_reset_abort(
+     libvmdk_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_internal_handle_reset_abort";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_io_handle_get_abort( internal_handle->io_handle ) == 0 )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	libvmdk_io_handle_set_abort(
+	 internal_handle->io_handle,
+	 0 );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Reads (media) data at a specific offset
+ * This function does not change the current offset and can be called by multiple threads concurrently
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvmdk_handle_read_buffer_at_offset(
+         libvmdk_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_read_buffer_at_offset";
+	ssize_t read_count                         = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_internal_handle_reset_abort(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to reset abort.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libvmdk_internal_handle_read_buffer_from_file_io_pool(
+		      internal_handle,
+		      internal_handle->extent_data_file_io_pool,
+		      buffer,
+		      buffer_size,
+		      offset,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+
+on_error:
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Compares two read ranges by their offset
+ * Returns -1 if the first offset is less than the second, 0 if equal or 1 if greater
+ */
+int libvmdk_internal_handle_compare_read_ranges(
+     const void *first_read_range,
+     const void *second_read_range )
+{
+	off64_t first_offset  = 0;
+	off64_t second_offset = 0;
+
+	first_offset  = ( (libvmdk_internal_read_range_t *) first_read_range )->offset;
+	second_offset = ( (libvmdk_internal_read_range_t *) second_read_range )->offset;
+
+	if( first_offset < second_offset )
+	{
+		return( -1 );
+	}
+	else if( first_offset > second_offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Reads (media) data of multiple read ranges using a Basic File IO (bfio) pool
+ * The read ranges are expected to be sorted by offset, a read range that starts at or beyond
+ * the end of the media data is an error, a read range that ends beyond it is truncated
+ * Read ranges that share a grain are read with a single lookup of the grain
+ * The cache mutex is only held while a grain is resolved and read, hence other readers are not blocked for the whole call
+ * Grains in the grain cache are copied from the cache, whole grains of sequential reads that are not
+ * are read directly into the range buffer, where contiguous grains are read as one run
+ * This function does not change the current offset of the handle
+ * This function is multi-thread safe if the read lock is acquired before call
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvmdk_internal_handle_read_buffers_from_file_io_pool(
+         libvmdk_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libvmdk_internal_read_range_t *read_ranges,
+         int number_of_read_ranges,
+         libcerror_error_t **error )
+{
+	uint8_t *grain_buffer       = NULL;
+	uint8_t *range_buffer       = NULL;
+	uint8_t *read_buffer        = NULL;
+	static char *function       = "libvmdk_internal_handle_read_buffers_from_file_io_pool";
+	libvmdk_grain_cursor_t grain_cursor;
+	size_t buffer_offset        = 0;
+	size_t direct_read_size     = 0;
+	size_t grain_read_size      = 0;
+	size_t range_size           = 0;
+	size_t read_size            = 0;
+	size_t shared_read_size     = 0;
+	ssize_t read_count          = 0;
+	ssize_t total_read_count    = 0;
+	off64_t grain_data_offset   = 0;
+	off64_t grain_end_offset    = 0;
+	off64_t next_shared_offset  = 0;
+	off64_t offset              = 0;
+	off64_t range_end_offset    = 0;
+	off64_t shared_end_offset   = 0;
+	off64_t shared_offset       = 0;
+	uint64_t grain_index        = 0;
+	uint8_t is_sequential       = 0;
+	int number_of_shared_ranges = 0;
+	int range_index             = 0;
+	int result                  = 0;
+	int shared_range_index      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read ranges.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_read_ranges < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of read ranges value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	for( range_index = 0;
+	     range_index < number_of_read_ranges;
+	     range_index++ )
+	{
+		if( ( read_ranges[ range_index ].buffer == NULL )
+		 || ( read_ranges[ range_index ].size > (size_t) SSIZE_MAX )
+		 || ( read_ranges[ range_index ].offset < 0 )
+		 || ( (size64_t) read_ranges[ range_index ].offset >= internal_handle->io_handle->media_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid read range: %d value out of bounds.",
+			 function,
+			 range_index );
+
+			return( -1 );
+		}
+		if( (size64_t) read_ranges[ range_index ].size > ( internal_handle->io_handle->media_size - read_ranges[ range_index ].offset ) )
+		{
+			read_ranges[ range_index ].size = (size_t) ( internal_handle->io_handle->media_size - read_ranges[ range_index ].offset );
+		}
+		read_ranges[ range_index ].buffer_offset = 0;
+	}
+	if( internal_handle->extent_table->extent_files_stream != NULL )
+	{
+		/* Flat extents have no grains to share between the read ranges
+		 */
+		for( range_index = 0;
+		     range_index < number_of_read_ranges;
+		     range_index++ )
+		{
+			read_count = libvmdk_internal_handle_read_buffer_from_file_io_pool(
+			              internal_handle,
+			              file_io_pool,
+			              read_ranges[ range_index ].buffer,
+			              read_ranges[ range_index ].size,
+			              read_ranges[ range_index ].offset,
+			              error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read range: %d.",
+				 function,
+				 range_index );
+
+				return( -1 );
+			}
+			total_read_count += read_count;
+		}
+		return( total_read_count );
+	}
+	if( libvmdk_grain_table_reset_grain_cursor(
+	     &grain_cursor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to reset grain cursor.",
+		 function );
+
+		return( -1 );
+	}
+	for( range_index = 0;
+	     range_index < number_of_read_ranges;
+	     range_index++ )
+	{
+		range_buffer  = read_ranges[ range_index ].buffer;
+		range_size    = read_ranges[ range_index ].size;
+		buffer_offset = read_ranges[ range_index ].buffer_offset;
+
+		/* The read range was already read as part of the grains of the preceding read ranges
+		 */
+		if( buffer_offset >= range_size )
+		{
+			continue;
+		}
+		offset           = read_ranges[ range_index ].offset + (off64_t) buffer_offset;
+		range_end_offset = read_ranges[ range_index ].offset + (off64_t) range_size;
+
+		if( libvmdk_internal_handle_update_sequential_read_offset(
+		     internal_handle,
+		     offset,
+		     range_size - buffer_offset,
+		     &is_sequential,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update sequential read offset.",
+			 function );
+
+			goto on_error;
+		}
+		/* A range that spans multiple grains is read sequentially
+		 */
+		if( (size64_t) ( range_size - buffer_offset ) > internal_handle->io_handle->grain_size )
+		{
+			is_sequential = 1;
+		}
+		while( buffer_offset < range_size )
+		{
+			grain_index       = offset / internal_handle->io_handle->grain_size;
+			grain_data_offset = (off64_t) ( offset % internal_handle->io_handle->grain_size );
+			grain_end_offset  = (off64_t) ( ( grain_index + 1 ) * internal_handle->io_handle->grain_size );
+
+			read_size = (size_t) ( internal_handle->io_handle->grain_size - grain_data_offset );
+
+			if( read_size > ( range_size - buffer_offset ) )
+			{
+				read_size = range_size - buffer_offset;
+			}
+			/* Determine the following read ranges that continue in the grain and
+			 * the offset of the first following read range that continues after it
+			 */
+			number_of_shared_ranges = 0;
+			shared_end_offset       = offset + (off64_t) read_size;
+			next_shared_offset      = range_end_offset;
+
+			for( shared_range_index = range_index + 1;
+			     shared_range_index < number_of_read_ranges;
+			     shared_range_index++ )
+			{
+				if( ( read_ranges[ shared_range_index ].offset >= range_end_offset )
+				 && ( read_ranges[ shared_range_index ].offset >= grain_end_offset ) )
+				{
+					break;
+				}
+				if( read_ranges[ shared_range_index ].buffer_offset >= read_ranges[ shared_range_index ].size )
+				{
+					continue;
+				}
+				shared_offset = read_ranges[ shared_range_index ].offset + (off64_t) read_ranges[ shared_range_index ].buffer_offset;
+
+				if( shared_offset < grain_end_offset )
+				{
+					number_of_shared_ranges++;
+
+					if( ( read_ranges[ shared_range_index ].offset + (off64_t) read_ranges[ shared_range_index ].size ) >= grain_end_offset )
+					{
+						shared_end_offset = grain_end_offset;
+					}
+					else if( ( read_ranges[ shared_range_index ].offset + (off64_t) read_ranges[ shared_range_index ].size ) > shared_end_offset )
+					{
+						shared_end_offset = read_ranges[ shared_range_index ].offset + (off64_t) read_ranges[ shared_range_index ].size;
+					}
+				}
+				else if( shared_offset < next_shared_offset )
+				{
+					next_shared_offset = shared_offset;
+				}
+			}
+			read_buffer     = &( range_buffer[ buffer_offset ] );
+			grain_read_size = read_size;
+
+			/* The part of the grain that is shared with the following read ranges is read once,
+			 * into the range buffer if it contains the whole part or into a grain buffer otherwise
+			 */
+			if( number_of_shared_ranges > 0 )
+			{
+				grain_read_size = (size_t) ( shared_end_offset - offset );
+
+				if( grain_read_size > read_size )
+				{
+					if( grain_buffer == NULL )
+					{
+						grain_buffer = (uint8_t *) memory_allocate(
+						                            (size_t) internal_handle->io_handle->grain_size );
+
+						if( grain_buffer == NULL )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_MEMORY,
+							 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+							 "%s: unable to create grain buffer.",
+							 function );
+
+							goto on_error;
+						}
+					}
+					read_buffer = grain_buffer;
+				}
+				result = libvmdk_internal_handle_read_grain_data_from_file_io_pool(
+				          internal_handle,
+				          file_io_pool,
+				          &grain_cursor,
+				          grain_index,
+				          offset,
+				          read_buffer,
+				          grain_read_size,
+				          error );
+			}
+			/* Whole grains of sequential reads that are not in the grain cache are read directly
+			 * into the range buffer, contiguous grains that are not compressed are read as one run
+			 * up to the grain of the next read range
+			 * Whole grains of random reads are read using the grains cache
+			 */
+			else if( ( is_sequential != 0 )
+			      && ( grain_data_offset == 0 )
+			      && ( (size64_t) read_size == internal_handle->io_handle->grain_size ) )
+			{
+				result = libvmdk_grain_cache_copy_grain_data(
+				          internal_handle->grain_cache,
+				          grain_index,
+				          0,
+				          read_buffer,
+				          read_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+					 "%s: unable to copy grain: %" PRIu64 " data from grain cache.",
+					 function,
+					 grain_index );
+
+					goto on_error;
+				}
+				else if( result == 0 )
+				{
+					direct_read_size  = (size_t) ( next_shared_offset - offset );
+					direct_read_size -= direct_read_size % (size_t) internal_handle->io_handle->grain_size;
+
+					read_count = libvmdk_internal_handle_read_grain_data_direct_from_file_io_pool(
+					              internal_handle,
+					              file_io_pool,
+					              &grain_cursor,
+					              grain_index,
+					              offset,
+					              read_buffer,
+					              direct_read_size,
+					              error );
+
+					if( read_count == -1 )
+					{
+						result = -1;
+					}
+					else if( read_count != 0 )
+					{
+						read_size       = (size_t) read_count;
+						grain_read_size = read_size;
+						result          = 1;
+					}
+				}
+			}
+			else
+			{
+				result = libvmdk_internal_handle_read_grain_data_from_file_io_pool(
+				          internal_handle,
+				          file_io_pool,
+				          &grain_cursor,
+				          grain_index,
+				          offset,
+				          read_buffer,
+				          read_size,
+				          error );
+			}
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read grain: %" PRIu64 " data.",
+				 function,
+				 grain_index );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				if( libvmdk_statistics_add(
+				     internal_handle->io_handle->statistics,
+				     LIBVMDK_STATISTIC_SPARSE_GRAINS_READ,
+				     1,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to update statistics.",
+					 function );
+
+					goto on_error;
+				}
+				if( internal_handle->parent_handle == NULL )
+				{
+					if( memory_set(
+					     read_buffer,
+					     0,
+					     grain_read_size ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+						 "%s: unable to fill buffer with sparse grain.",
+						 function );
+
+						goto on_error;
+					}
+				}
+				else
+				{
+					read_count = libvmdk_internal_handle_read_buffer_from_parent(
+						      internal_handle,
+						      read_buffer,
+						      grain_read_size,
+						      offset,
+						      error );
+
+					if( read_count != (ssize_t) grain_read_size )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read grain data from parent at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+						 function,
+						 offset,
+						 offset );
+
+						goto on_error;
+					}
+				}
+			}
+			if( number_of_shared_ranges > 0 )
+			{
+				if( read_buffer == grain_buffer )
+				{
+					if( memory_copy(
+					     &( range_buffer[ buffer_offset ] ),
+					     grain_buffer,
+					     read_size ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+						 "%s: unable to copy grain data to range: %d.",
+						 function,
+						 range_index );
+
+						goto on_error;
+					}
+				}
+				for( shared_range_index = range_index + 1;
+				     shared_range_index < number_of_read_ranges;
+				     shared_range_index++ )
+				{
+					if( read_ranges[ shared_range_index ].offset >= grain_end_offset )
+					{
+						break;
+					}
+					if( read_ranges[ shared_range_index ].buffer_offset >= read_ranges[ shared_range_index ].size )
+					{
+						continue;
+					}
+					shared_offset = read_ranges[ shared_range_index ].offset + (off64_t) read_ranges[ shared_range_index ].buffer_offset;
+
+					if( shared_offset >= grain_end_offset )
+					{
+						continue;
+					}
+					shared_read_size = read_ranges[ shared_range_index ].size - read_ranges[ shared_range_index ].buffer_offset;
+
+					if( (off64_t) shared_read_size > ( grain_end_offset - shared_offset ) )
+					{
+						shared_read_size = (size_t) ( grain_end_offset - shared_offset );
+					}
+					if( memory_copy(
+					     &( read_ranges[ shared_range_index ].buffer[ read_ranges[ shared_range_index ].buffer_offset ] ),
+					     &( read_buffer[ shared_offset - offset ] ),
+					     shared_read_size ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+						 "%s: unable to copy grain data to range: %d.",
+						 function,
+						 shared_range_index );
+
+						goto on_error;
+					}
+					read_ranges[ shared_range_index ].buffer_offset += shared_read_size;
+
+					total_read_count += (ssize_t) shared_read_size;
+				}
+			}
+			buffer_offset += read_size;
+			offset        += (off64_t) read_size;
+
+			total_read_count += (ssize_t) read_size;
+		}
+		read_ranges[ range_index ].buffer_offset = buffer_offset;
+
+		if( libvmdk_io_handle_get_abort( internal_handle->io_handle ) != 0 )
+		{
+			break;
+		}
+	}
+	if( grain_buffer != NULL )
+	{
+		memory_free(
+		 grain_buffer );
+
+		grain_buffer = NULL;
+	}
+	if( libvmdk_statistics_add(
+	     internal_handle->io_handle->statistics,
+	     LIBVMDK_STATISTIC_BYTES_READ,
+	     (uint64_t) total_read_count,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update statistics.",
+		 function );
+
+		return( -1 );
+	}
+	return( total_read_count );
+
+on_error:
+	if( grain_buffer != NULL )
+	{
+		memory_free(
+		 grain_buffer );
+	}
+	return( -1 );
+}
+
+/* Reads (media) data of multiple buffers at specific offsets
+ * The reads are sorted by offset so that the grains are read in order of their offset
+ * and the grains shared by multiple reads are read once
+ * This function does not change the current offset and can be called by multiple threads concurrently
+ * Returns the total number of bytes read or -1 on error
+ */
+ssize_t libvmdk_handle_read_buffers_at_offsets(
+         libvmdk_handle_t *handle,
+         uint8_t **buffers,
+         size_t *buffer_sizes,
+         off64_t *offsets,
+         int number_of_buffers,
+         libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	libvmdk_internal_read_range_t *read_ranges = NULL;
+	static char *function                      = "libvmdk_handle_read_buffers_at_offsets";
+	ssize_t read_count                         = 0;
+	int buffer_index                           = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_buffers <= 0 )
+	 || ( (size_t) number_of_buffers > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libvmdk_internal_read_range_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of buffers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_internal_handle_reset_abort(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to reset abort.",
+		 function );
+
+		return( -1 );
+	}
+	read_ranges = (libvmdk_internal_read_range_t *) memory_allocate(
+	                                                 sizeof( libvmdk_internal_read_range_t ) * number_of_buffers );
+
+	if( read_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read ranges.",
+		 function );
+
+		return( -1 );
+	}
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		read_ranges[ buffer_index ].buffer = buffers[ buffer_index ];
+		read_ranges[ buffer_index ].size   = buffer_sizes[ buffer_index ];
+		read_ranges[ buffer_index ].offset = offsets[ buffer_index ];
+
+		read_ranges[ buffer_index ].buffer_offset = 0;
+	}
+	qsort(
+	 read_ranges,
+	 (size_t) number_of_buffers,
+	 sizeof( libvmdk_internal_read_range_t ),
+	 &libvmdk_internal_handle_compare_read_ranges );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	read_count = libvmdk_internal_handle_read_buffers_from_file_io_pool(
+		      internal_handle,
+		      internal_handle->extent_data_file_io_pool,
+		      read_ranges,
+		      number_of_buffers,
+		      error );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffers.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 read_ranges );
+
+	return( read_count );
+
+on_error:
+	if( read_ranges != NULL )
+	{
+		memory_free(
+		 read_ranges );
+	}
+	return( -1 );
+}
+
+/* Seeks a certain offset of the (media) data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libvmdk_internal_handle_seek_offset(
+         libvmdk_internal_handle_t *internal_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libvmdk_internal_handle_seek_offset";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += internal_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) internal_handle->io_handle->media_size;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Seeks a certain offset of the (media) data
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libvmdk_handle_seek_offset(
+         libvmdk_handle_t *handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_seek_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	libvmdk_io_handle_set_abort(
+	 internal_handle->io_handle,
+	 0 );
+
+	offset = libvmdk_internal_handle_seek_offset(
+	          internal_handle,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		offset = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( offset );
+}
+
+/* Retrieves the current offset of the (media) data
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_get_offset(
+     libvmdk_handle_t *handle,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*offset = internal_handle->current_offset;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum number of (concurrent) open file handles
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_set_maximum_number_of_open_handles(
+     libvmdk_handle_t *handle,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_set_maximum_number_of_open_handles";
+	int result                                 = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->extent_data_file_io_pool != NULL )
+	{
+		if( libbfio_pool_set_maximum_number_of_open_handles(
+		     internal_handle->extent_data_file_io_pool,
+		     maximum_number_of_open_handles,
+		     error ) != -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in extent data file IO pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of decompression threads
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_get_number_of_decompression_threads(
+     libvmdk_handle_t *handle,
+     int *number_of_threads,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_number_of_decompression_threads";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( number_of_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of threads.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_threads = internal_handle->number_of_decompression_threads;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the number of decompression threads
+ * A value of 0 decompresses the grains on the calling thread
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_set_number_of_decompression_threads(
+     libvmdk_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_set_number_of_decompression_threads";
+	int result                                 = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( number_of_threads < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of threads value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->number_of_decompression_threads = number_of_threads;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	/* The decompression thread pool of an open handle is recreated with the new number of threads
+	 */
+	if( internal_handle->extent_data_file_io_pool != NULL )
+	{
+		result = libvmdk_internal_handle_create_decompression_thread_pool(
+		          internal_handle,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create decompression thread pool.",
+			 function );
+		}
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of open threads
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_get_number_of_open_threads(
+     libvmdk_handle_t *handle,
+     int *number_of_threads,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_number_of_open_threads";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( number_of_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of threads.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_threads = internal_handle->number_of_open_threads;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the number of open threads
+ * A value of 0 reads the extent files on the calling thread
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_set_number_of_open_threads(
+     libvmdk_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_set_number_of_open_threads";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( number_of_threads < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of threads value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->number_of_open_threads = number_of_threads;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the maximum number of readahead grains
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_get_maximum_number_of_readahead_grains(
+     libvmdk_handle_t *handle,
+     int *maximum_number_of_grains,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_maximum_number_of_readahead_grains";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( maximum_number_of_grains == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of grains.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*maximum_number_of_grains = internal_handle->maximum_number_of_readahead_grains;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum number of readahead grains
+ * When set sequential reads of the sparse extent files are detected and the grains that follow
+ * are read and decompressed ahead of the caller by a background thread, up to this number of grains
+ * A value of 0 disables the readahead, which is the default
+ * The value must be set before the handle is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_set_maximum_number_of_readahead_grains(
+     libvmdk_handle_t *handle,
+     int maximum_number_of_grains,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_set_maximum_number_of_readahead_grains";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->grain_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - grain table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_grains < 0 )
+	 || ( maximum_number_of_grains > LIBVMDK_MAXIMUM_NUMBER_OF_READAHEAD_GRAINS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of grains value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->maximum_number_of_readahead_grains = maximum_number_of_grains;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the maximum cache size
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_get_maximum_cache_size(
+     libvmdk_handle_t *handle,
+     size64_t *maximum_cache_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_maximum_cache_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->cache_budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing cache budget.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_cache_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum cache size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*maximum_cache_size = internal_handle->cache_budget->maximum_size;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum cache size
+ * The maximum cache size is the amount of memory, in bytes, shared by the grains cache
+ * and the grain groups caches. The budget is divided between the caches based on
+ * how often each of them misses and is rebalanced while the handle is read
+ * A value of 0 uses a fixed number of cache entries, which is the default
+ * The value can be changed while the handle is open, which discards the cached data
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_set_maximum_cache_size(
+     libvmdk_handle_t *handle,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_set_maximum_cache_size";
+	int result                                 = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	if( libvmdk_cache_budget_set_maximum_size(
+	     internal_handle->cache_budget,
+	     maximum_cache_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum cache size.",
+		 function );
+
+		result = -1;
+	}
+	else if( internal_handle->grain_cache != NULL )
+	{
+		if( libvmdk_internal_handle_apply_cache_budget(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to apply cache budget.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the current cache sizes
+ * The sizes are the estimated amount of memory, in bytes, the grain groups caches
+ * and the grains cache can use with their current number of entries
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_get_cache_sizes(
+     libvmdk_handle_t *handle,
+     size64_t *grain_groups_cache_size,
+     size64_t *grains_cache_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_cache_sizes";
+	int result                                 = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvmdk_cache_budget_get_cache_sizes(
+	     internal_handle->cache_budget,
+	     grain_groups_cache_size,
+	     grains_cache_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache sizes.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the statistics of reading the media data
+ * The statistics are counted from when the handle was opened and are indexed by LIBVMDK_STATISTIC_
+ * The seeks and reads are those issued to the extent data files while reading the media data
+ * Statistics beyond the number of statistics are set to 0
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_get_statistics(
+     libvmdk_handle_t *handle,
+     uint64_t *statistics,
+     int number_of_statistics,
+     libcerror_error_t **error )
+{
+	uint64_t values[ LIBVMDK_NUMBER_OF_STATISTICS ];
+
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_statistics";
+	int result                                 = 1;
+	int statistic_index                        = 0;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	uint8_t cache_mutex_grabbed                = 0;
+#endif
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_statistics <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of statistics value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvmdk_statistics_get_values(
+	     internal_handle->io_handle->statistics,
+	     values,
+	     LIBVMDK_NUMBER_OF_STATISTICS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve statistics values.",
+		 function );
+
+		result = -1;
+	}
+	else if( internal_handle->grain_cache != NULL )
+	{
+		if( libvmdk_grain_cache_get_statistics(
+		     internal_handle->grain_cache,
+		     &( values[ LIBVMDK_STATISTIC_GRAIN_CACHE_HITS ] ),
+		     &( values[ LIBVMDK_STATISTIC_GRAIN_CACHE_MISSES ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grain cache statistics.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( result == 1 )
+	{
+		if( libcthreads_mutex_grab(
+		     internal_handle->cache_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab cache mutex.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			cache_mutex_grabbed = 1;
+		}
+	}
+#endif
+	if( result == 1 )
+	{
+		/* Every grain group lookup that did not find the grain group in the grain groups cache
+		 * results in the grain table being read
+		 */
+		values[ LIBVMDK_STATISTIC_GRAIN_TABLE_CACHE_HITS ]   = internal_handle->io_handle->number_of_grain_group_lookups
+		                                                      - internal_handle->io_handle->number_of_grain_group_reads;
+		values[ LIBVMDK_STATISTIC_GRAIN_TABLE_CACHE_MISSES ] = internal_handle->io_handle->number_of_grain_group_reads;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( cache_mutex_grabbed != 0 )
+	{
+		if( libcthreads_mutex_release(
+		     internal_handle->cache_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release cache mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	for( statistic_index = 0;
+	     statistic_index < number_of_statistics;
+	     statistic_index++ )
+	{
+		if( statistic_index < LIBVMDK_NUMBER_OF_STATISTICS )
+		{
+			statistics[ statistic_index ] = values[ statistic_index ];
+		}
+		else
+		{
+			statistics[ statistic_index ] = 0;
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the trace callback function
+ * The callback function is called after every open phase, grain table read, grain read
+ * and grain decompression with the LIBVMDK_TRACE_EVENT_ of the operation, its start timestamp
+ * and its duration, both in nanoseconds of a monotonic clock if available
+ * The callback function can be called from multiple threads at the same time and must not call
+ * the handle functions
+ * A callback function of NULL disables the callback
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_set_trace_callback(
+     libvmdk_handle_t *handle,
+     void (*callback)(
+            int trace_event,
+            uint64_t start_timestamp,
+            uint64_t duration,
+            void *callback_data ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_set_trace_callback";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_trace_set_callback(
+	     internal_handle->io_handle->trace,
+	     callback,
+	     callback_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set trace callback.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the value to indicate the latency histograms should be used
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_get_use_latency_histograms(
+     libvmdk_handle_t *handle,
+     uint8_t *use_latency_histograms,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_use_latency_histograms";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_trace_get_use_latency_histograms(
+	     internal_handle->io_handle->trace,
+	     use_latency_histograms,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve use latency histograms.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the value to indicate the latency histograms should be used
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_set_use_latency_histograms(
+     libvmdk_handle_t *handle,
+     uint8_t use_latency_histograms,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_set_use_latency_histograms";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_trace_set_use_latency_histograms(
+	     internal_handle->io_handle->trace,
+	     use_latency_histograms,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set use latency histograms.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the latency histogram of a specific trace event
+ * The latency histogram contains the number of operations per bucket, where bucket N
+ * contains the operations that took 2^N up to 2^(N+1) nanoseconds
+ * The latency histograms are counted from when the handle was opened while they are used
+ * Buckets beyond the number of latency histogram buckets are set to 0
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_get_latency_histogram(
+     libvmdk_handle_t *handle,
+     int trace_event,
+     uint64_t *buckets,
+     int number_of_buckets,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_latency_histogram";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_trace_get_latency_histogram(
+	     internal_handle->io_handle->trace,
+	     trace_event,
+	     buckets,
+	     number_of_buckets,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve latency histogram.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the value to indicate the grain offsets index should be used
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_get_use_grain_offsets_index(
+     libvmdk_handle_t *handle,
+     uint8_t *use_grain_offsets_index,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_use_grain_offsets_index";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( use_grain_offsets_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid use grain offsets index.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*use_grain_offsets_index = internal_handle->use_grain_offsets_index;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the value to indicate the grain offsets index should be used
+ * The value must be set before the handle is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_set_use_grain_offsets_index(
+     libvmdk_handle_t *handle,
+     uint8_t use_grain_offsets_index,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_set_use_grain_offsets_index";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->grain_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - grain table value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( use_grain_offsets_index != 0 )
+	{
+		internal_handle->use_grain_offsets_index = 1;
+	}
+	else
+	{
+		internal_handle->use_grain_offsets_index = 0;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the value to indicate the extent files should be loaded lazily
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_get_use_lazy_loading(
+     libvmdk_handle_t *handle,
+     uint8_t *use_lazy_loading,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_use_lazy_loading";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( use_lazy_loading == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid use lazy loading.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*use_lazy_loading = internal_handle->use_lazy_loading;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the value to indicate the extent files should be loaded lazily
+ * When set only the descriptor and the sizes of the extent files are checked when opening,
+ * the grain directories of an extent file are read when the extent file is first accessed
+ * The value must be set before the handle is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_set_use_lazy_loading(
+     libvmdk_handle_t *handle,
+     uint8_t use_lazy_loading,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_set_use_lazy_loading";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->grain_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - grain table value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( use_lazy_loading != 0 )
+	{
+		internal_handle->use_lazy_loading = 1;
+	}
+	else
+	{
+		internal_handle->use_lazy_loading = 0;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the metadata index filename
+ * The metadata index is used to open the handle without reading the grain directories
+ * of the extent files when it matches the extent files
+ * The value must be set before the handle is opened
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libvmdk_handle_read_buffer(
-         libvmdk_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libvmdk_handle_set_metadata_index_filename(
+     libvmdk_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
 {
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_read_buffer";
-	ssize_t read_count                         = 0;
+	static char *function                      = "libvmdk_handle_set_metadata_index_filename";
+	int result                                 = 1;
 
 	if( handle == NULL )
 	{
@@ -3301,13 +10415,13 @@ ssize_t libvmdk_handle_read_buffer(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-	if( internal_handle->extent_data_file_io_pool == NULL )
+	if( internal_handle->grain_table != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing extent data file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - grain table value already set.",
 		 function );
 
 		return( -1 );
@@ -3327,23 +10441,39 @@ ssize_t libvmdk_handle_read_buffer(
 		return( -1 );
 	}
 #endif
-	read_count = libvmdk_internal_handle_read_buffer_from_file_io_pool(
-		      internal_handle,
-		      internal_handle->extent_data_file_io_pool,
-		      buffer,
-		      buffer_size,
-		      error );
+	if( internal_handle->metadata_index == NULL )
+	{
+		if( libvmdk_metadata_index_initialize(
+		     &( internal_handle->metadata_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create metadata index.",
+			 function );
 
-	if( read_count < 0 )
+			result = -1;
+		}
+	}
+	if( result == 1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
+		if( libvmdk_metadata_index_set_filename(
+		     internal_handle->metadata_index,
+		     filename,
+		     filename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set metadata index filename.",
+			 function );
 
-		read_count = -1;
+			result = -1;
+		}
 	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -3360,22 +10490,26 @@ ssize_t libvmdk_handle_read_buffer(
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( result );
 }
 
-/* Reads (media) data at a specific offset
- * Returns the number of bytes read or -1 on error
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Sets the metadata index filename
+ * The metadata index is used to open the handle without reading the grain directories
+ * of the extent files when it matches the extent files
+ * The value must be set before the handle is opened
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libvmdk_handle_read_buffer_at_offset(
-         libvmdk_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int libvmdk_handle_set_metadata_index_filename_wide(
+     libvmdk_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
 {
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_read_buffer_at_offset";
-	ssize_t read_count                         = 0;
+	static char *function                      = "libvmdk_handle_set_metadata_index_filename_wide";
+	int result                                 = 1;
 
 	if( handle == NULL )
 	{
@@ -3390,13 +10524,13 @@ ssize_t libvmdk_handle_read_buffer_at_offset(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-	if( internal_handle->extent_data_file_io_pool == NULL )
+	if( internal_handle->grain_table != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing extent data file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - grain table value already set.",
 		 function );
 
 		return( -1 );
@@ -3416,38 +10550,39 @@ ssize_t libvmdk_handle_read_buffer_at_offset(
 		return( -1 );
 	}
 #endif
-	if( libvmdk_internal_handle_seek_offset(
-	     internal_handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( internal_handle->metadata_index == NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
+		if( libvmdk_metadata_index_initialize(
+		     &( internal_handle->metadata_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create metadata index.",
+			 function );
 
-		goto on_error;
+			result = -1;
+		}
 	}
-	read_count = libvmdk_internal_handle_read_buffer_from_file_io_pool(
-		      internal_handle,
-		      internal_handle->extent_data_file_io_pool,
-		      buffer,
-		      buffer_size,
-		      error );
-
-	if( read_count == -1 )
+	if( result == 1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
+		if( libvmdk_metadata_index_set_filename_wide(
+		     internal_handle->metadata_index,
+		     filename,
+		     filename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set metadata index filename.",
+			 function );
 
-		goto on_error;
+			result = -1;
+		}
 	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -3464,30 +10599,25 @@ ssize_t libvmdk_handle_read_buffer_at_offset(
 		return( -1 );
 	}
 #endif
-	return( read_count );
-
-on_error:
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
+	return( result );
 }
 
-/* Seeks a certain offset of the (media) data
- * This function is not multi-thread safe acquire write lock before call
- * Returns the offset if seek is successful or -1 on error
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Writes the metadata index file
+ * This reads the grain tables of all the extent files, which can take some time
+ * Returns 1 if successful or -1 on error
  */
-off64_t libvmdk_internal_handle_seek_offset(
-         libvmdk_internal_handle_t *internal_handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libvmdk_handle_write_metadata_index(
+     libvmdk_handle_t *handle,
+     libcerror_error_t **error )
 {
-	static char *function = "libvmdk_internal_handle_seek_offset";
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_write_metadata_index";
+	int number_of_extents                      = 0;
+	int result                                 = 1;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -3498,86 +10628,48 @@ off64_t libvmdk_internal_handle_seek_offset(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->descriptor_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 "%s: invalid handle - missing descriptor file.",
 		 function );
 
 		return( -1 );
 	}
-	if( whence == SEEK_CUR )
-	{
-		offset += internal_handle->current_offset;
-	}
-	else if( whence == SEEK_END )
-	{
-		offset += (off64_t) internal_handle->io_handle->media_size;
-	}
-	if( offset < 0 )
+	if( internal_handle->metadata_index == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing metadata index.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->current_offset = offset;
-
-	return( offset );
-}
-
-/* Seeks a certain offset of the (media) data
- * Returns the offset if seek is successful or -1 on error
- */
-off64_t libvmdk_handle_seek_offset(
-         libvmdk_handle_t *handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
-{
-	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_seek_offset";
-
-	if( handle == NULL )
+	if( internal_handle->extent_data_file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libvmdk_internal_handle_t *) handle;
-
-	if( internal_handle->extent_data_file_io_pool == NULL )
+	if( internal_handle->grain_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing extent data file IO pool.",
+		 "%s: invalid handle - missing grain table.",
 		 function );
 
 		return( -1 );
@@ -3597,22 +10689,61 @@ off64_t libvmdk_handle_seek_offset(
 		return( -1 );
 	}
 #endif
-	offset = libvmdk_internal_handle_seek_offset(
-	          internal_handle,
-	          offset,
-	          whence,
-	          error );
-
-	if( offset == -1 )
+	if( libcdata_array_get_number_of_entries(
+	     internal_handle->extent_values_array,
+	     &number_of_extents,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
 		 function );
 
-		offset = -1;
+		result = -1;
+	}
+	if( ( result == 1 )
+	 && ( internal_handle->grain_table->grain_offsets_indexes == NULL ) )
+	{
+		/* The metadata index is written from the grain offsets index
+		 */
+		if( libvmdk_grain_table_enable_grain_offsets_index(
+		     internal_handle->grain_table,
+		     number_of_extents,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to enable grain offsets index.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libvmdk_metadata_index_write_file(
+		     internal_handle->metadata_index,
+		     internal_handle->grain_table,
+		     internal_handle->extent_table,
+		     internal_handle->extent_data_file_io_pool,
+		     internal_handle->descriptor_file->content_identifier,
+		     internal_handle->descriptor_file->parent_content_identifier,
+		     number_of_extents,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write metadata index.",
+			 function );
+
+			result = -1;
+		}
 	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -3629,21 +10760,27 @@ off64_t libvmdk_handle_seek_offset(
 		return( -1 );
 	}
 #endif
-	return( offset );
+	return( result );
 }
 
-/* Retrieves the current offset of the (media) data
+/* Verifies the extent data files
+ * This reads the file header, grain directories and backup grain directory of all the sparse extent files
+ * and checks them against the descriptor, which can take some time
  * Returns 1 if successful or -1 on error
  */
-int libvmdk_handle_get_offset(
-     libvmdk_handle_t *handle,
-     off64_t *offset,
+int libvmdk_internal_handle_verify_extent_data_files(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
      libcerror_error_t **error )
 {
-	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_offset";
+	libvmdk_extent_file_t *extent_file     = NULL;
+	libvmdk_extent_values_t *extent_values = NULL;
+	static char *function                  = "libvmdk_internal_handle_verify_extent_data_files";
+	size64_t extent_file_size              = 0;
+	int extent_index                       = 0;
+	int number_of_extents                  = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -3654,8 +10791,6 @@ int libvmdk_handle_get_offset(
 
 		return( -1 );
 	}
-	internal_handle = (libvmdk_internal_handle_t *) handle;
-
 	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -3667,73 +10802,202 @@ int libvmdk_handle_get_offset(
 
 		return( -1 );
 	}
-	if( internal_handle->extent_data_file_io_pool == NULL )
+	if( libcdata_array_get_number_of_entries(
+	     internal_handle->extent_values_array,
+	     &number_of_extents,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing extent data file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( offset == NULL )
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
-		 function );
+		if( libcdata_array_get_entry_by_index(
+		     internal_handle->extent_values_array,
+		     extent_index,
+		     (intptr_t **) &extent_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent values: %d from array.",
+			 function,
+			 extent_index );
 
-		return( -1 );
-	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
-		 function );
+			goto on_error;
+		}
+		if( extent_values == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing extent values: %d.",
+			 function,
+			 extent_index );
 
-		return( -1 );
-	}
-#endif
-	*offset = internal_handle->current_offset;
+			goto on_error;
+		}
+		if( ( extent_values->type != LIBVMDK_EXTENT_TYPE_SPARSE )
+		 && ( extent_values->type != LIBVMDK_EXTENT_TYPE_VMFS_SPARSE ) )
+		{
+			continue;
+		}
+		if( libbfio_pool_get_size(
+		     file_io_pool,
+		     extent_index,
+		     &extent_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve size of file IO pool entry: %d.",
+			 function,
+			 extent_index );
 
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
-		 function );
+			goto on_error;
+		}
+		if( libvmdk_extent_file_initialize(
+		     &extent_file,
+		     internal_handle->io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create extent file: %d.",
+			 function,
+			 extent_index );
 
-		return( -1 );
+			goto on_error;
+		}
+		if( libvmdk_internal_handle_open_read_extent_file_header(
+		     extent_file,
+		     file_io_pool,
+		     extent_index,
+		     extent_file_size,
+		     internal_handle->disk_type,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read extent file: %d header.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( extent_file->grain_size != internal_handle->io_handle->grain_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: extent file: %d grain size mismatch.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( libvmdk_extent_file_read_grain_directories(
+		     extent_file,
+		     file_io_pool,
+		     extent_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read extent file: %d grain directories.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( extent_file->storage_media_size != extent_values->size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: extent file: %d storage media size does not match extent size in descriptor.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( libvmdk_extent_file_read_backup_grain_directories(
+		     extent_file,
+		     file_io_pool,
+		     extent_index,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read extent file: %d backup grain directory.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( libvmdk_extent_file_free(
+		     &extent_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free extent file.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_io_handle_get_abort( internal_handle->io_handle ) == 1 )
+		{
+			goto on_error;
+		}
 	}
-#endif
 	return( 1 );
+
+on_error:
+	if( extent_file != NULL )
+	{
+		libvmdk_extent_file_free(
+		 &extent_file,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Sets the maximum number of (concurrent) open file handles
+/* Verifies the extent data files
+ * The backup grain directories are only read when the extent data files are verified
  * Returns 1 if successful or -1 on error
  */
-int libvmdk_handle_set_maximum_number_of_open_handles(
+int libvmdk_handle_verify_extent_data_files(
      libvmdk_handle_t *handle,
-     int maximum_number_of_open_handles,
      libcerror_error_t **error )
 {
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_set_maximum_number_of_open_handles";
+	static char *function                      = "libvmdk_handle_verify_extent_data_files";
 	int result                                 = 1;
 
 	if( handle == NULL )
@@ -3749,6 +11013,17 @@ int libvmdk_handle_set_maximum_number_of_open_handles(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -3764,26 +11039,19 @@ int libvmdk_handle_set_maximum_number_of_open_handles(
 		return( -1 );
 	}
 #endif
-	if( internal_handle->extent_data_file_io_pool != NULL )
+	if( libvmdk_internal_handle_verify_extent_data_files(
+	     internal_handle,
+	     internal_handle->extent_data_file_io_pool,
+	     error ) != 1 )
 	{
-		if( libbfio_pool_set_maximum_number_of_open_handles(
-		     internal_handle->extent_data_file_io_pool,
-		     maximum_number_of_open_handles,
-		     error ) != -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set maximum number of open handles in extent data file IO pool.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to verify extent data files.",
+		 function );
 
-			result = -1;
-		}
-	}
-	if( result == 1 )
-	{
-		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+		result = -1;
 	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -3879,7 +11147,26 @@ int libvmdk_handle_set_parent_handle(
 
 		goto on_error;
 	}
-	internal_handle->parent_handle = parent_handle;
+	/* The layer map is rebuilt for the new parent chain
+	 */
+	if( internal_handle->layer_map != NULL )
+	{
+		if( libvmdk_layer_map_free(
+		     &( internal_handle->layer_map ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free layer map.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	internal_handle->parent_handle            = parent_handle;
+	internal_handle->layer_map_is_unsupported = 0;
 
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -25,21 +25,118 @@
 #include <common.h>
 #include <types.h>
 
+#include "libvmdk_cache_budget.h"
 #include "libvmdk_descriptor_file.h"
+#include "libvmdk_extent_file.h"
 #include "libvmdk_extent_table.h"
 #include "libvmdk_extern.h"
+#include "libvmdk_grain_cache.h"
+#include "libvmdk_grain_data.h"
 #include "libvmdk_grain_table.h"
 #include "libvmdk_io_handle.h"
+#include "libvmdk_layer_map.h"
 #include "libvmdk_libbfio.h"
 #include "libvmdk_libcerror.h"
 #include "libvmdk_libcthreads.h"
-#include "libvmdk_libfcache.h"
 #include "libvmdk_libfdata.h"
+#include "libvmdk_metadata_index.h"
+#include "libvmdk_readahead.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+typedef struct libvmdk_internal_read_range libvmdk_internal_read_range_t;
+
+struct libvmdk_internal_read_range
+{
+	/* The (storage media) offset
+	 */
+	off64_t offset;
+
+	/* The size
+	 */
+	size_t size;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The offset in the buffer of the data that was not yet read
+	 */
+	size_t buffer_offset;
+};
+
+typedef struct libvmdk_internal_grain_decompression libvmdk_internal_grain_decompression_t;
+
+struct libvmdk_internal_grain_decompression
+{
+	/* The grain index
+	 */
+	uint64_t grain_index;
+
+	/* The compressed data
+	 */
+	uint8_t *compressed_data;
+
+	/* The compressed data size
+	 */
+	size_t compressed_data_size;
+
+	/* The uncompressed data, which is part of the read buffer
+	 */
+	uint8_t *uncompressed_data;
+
+	/* The uncompressed data size
+	 */
+	size_t uncompressed_data_size;
+
+	/* The result of the decompression
+	 */
+	int result;
+
+	/* The number of pending decompressions of the read, which is protected by the decompression mutex
+	 */
+	int *number_of_pending_decompressions;
+};
+
+typedef struct libvmdk_internal_extent_file_read libvmdk_internal_extent_file_read_t;
+
+struct libvmdk_internal_extent_file_read
+{
+	/* The extent index
+	 */
+	int extent_index;
+
+	/* The disk type
+	 */
+	int disk_type;
+
+	/* The IO handle
+	 */
+	libvmdk_io_handle_t *io_handle;
+
+	/* The file IO handle, which is a clone of the one in the file IO pool
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The extent file size
+	 */
+	size64_t extent_file_size;
+
+	/* Value to indicate the grain directories should be read
+	 */
+	uint8_t read_grain_directories;
+
+	/* The extent file
+	 */
+	libvmdk_extent_file_t *extent_file;
+
+	/* The result of the read
+	 */
+	int result;
+};
+
 typedef struct libvmdk_internal_handle libvmdk_internal_handle_t;
 
 struct libvmdk_internal_handle
@@ -48,6 +145,10 @@ struct libvmdk_internal_handle
 	 */
 	off64_t current_offset;
 
+	/* The (storage media) offset directly after the last read, used to detect sequential reads
+	 */
+	off64_t sequential_read_offset;
+
 	/* The disk type
 	 */
 	int disk_type;
@@ -72,9 +173,13 @@ struct libvmdk_internal_handle
 	 */
 	libvmdk_grain_table_t *grain_table;
 
-	/* The grains cache
+	/* The grain cache
+	 */
+	libvmdk_grain_cache_t *grain_cache;
+
+	/* The cache (memory) budget
 	 */
-	libfcache_cache_t *grains_cache;
+	libvmdk_cache_budget_t *cache_budget;
 
 	/* The extent data file IO pool
 	 */
@@ -96,10 +201,67 @@ struct libvmdk_internal_handle
 	 */
 	libvmdk_handle_t *parent_handle;
 
+	/* The layer map of the parent chain
+	 */
+	libvmdk_layer_map_t *layer_map;
+
+	/* Value to indicate the layer map is not supported by the parent chain
+	 */
+	uint8_t layer_map_is_unsupported;
+
+	/* The number of decompression threads
+	 */
+	int number_of_decompression_threads;
+
+	/* The number of threads used to read the extent files when opening
+	 */
+	int number_of_open_threads;
+
+	/* The maximum number of grains to read ahead
+	 */
+	int maximum_number_of_readahead_grains;
+
+	/* Value to indicate the grain offsets index should be used
+	 */
+	uint8_t use_grain_offsets_index;
+
+	/* Value to indicate the extent files should be loaded lazily
+	 */
+	uint8_t use_lazy_loading;
+
+	/* The metadata index
+	 */
+	libvmdk_metadata_index_t *metadata_index;
+
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
+
+	/* The cache mutex, serializes access to the extent files, grain groups and grains caches
+	 * and the file IO pool while the read/write lock is held for reading
+	 */
+	libcthreads_mutex_t *cache_mutex;
+
+	/* The decompression thread pool, which is created when the handle is opened
+	 */
+	libcthreads_thread_pool_t *decompression_thread_pool;
+
+	/* The decompression mutex
+	 */
+	libcthreads_mutex_t *decompression_mutex;
+
+	/* The decompression condition, which is signalled when the last pending decompression of a read completes
+	 */
+	libcthreads_condition_t *decompression_condition;
+
+	/* The readahead
+	 */
+	libvmdk_readahead_t *readahead;
+
+	/* The grain cursor of the readahead thread
+	 */
+	libvmdk_grain_cursor_t readahead_grain_cursor;
 #endif
 };
 
@@ -187,16 +349,171 @@ int libvmdk_internal_handle_open_read_extent_data_files(
      libbfio_pool_t *file_io_pool,
      libcerror_error_t **error );
 
+int libvmdk_internal_handle_open_read_extent_file_header(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t extent_file_size,
+     int disk_type,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+
+int libvmdk_internal_handle_open_read_extent_file(
+     libvmdk_internal_extent_file_read_t *extent_file_read,
+     void *arguments );
+
+int libvmdk_internal_handle_open_read_extent_files_in_threads(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int number_of_extents,
+     libvmdk_internal_extent_file_read_t **extent_file_reads,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+
 int libvmdk_internal_handle_open_read_signature(
      libbfio_handle_t *file_io_handle,
      uint8_t *file_type,
      libcerror_error_t **error );
 
+int libvmdk_internal_handle_apply_cache_budget(
+     libvmdk_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libvmdk_internal_handle_balance_cache_budget(
+     libvmdk_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libvmdk_internal_handle_read_uncached_grain_data_from_file_io_pool(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_grain_cursor_t *grain_cursor,
+     uint64_t grain_index,
+     off64_t offset,
+     libvmdk_grain_data_t **grain_data,
+     uint8_t **compressed_data,
+     size_t *compressed_data_size,
+     libcerror_error_t **error );
+
+int libvmdk_internal_handle_copy_grain_data_to_buffer(
+     libvmdk_grain_data_t *grain_data,
+     off64_t grain_data_offset,
+     uint8_t *buffer,
+     size_t read_size,
+     libcerror_error_t **error );
+
+int libvmdk_internal_handle_read_grain_data_from_file_io_pool(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_grain_cursor_t *grain_cursor,
+     uint64_t grain_index,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t read_size,
+     libcerror_error_t **error );
+
+int libvmdk_internal_handle_read_resolved_grain_data_from_file_io_pool(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_grain_cursor_t *grain_cursor,
+     uint8_t *buffer,
+     size_t buffer_size,
+     uint8_t **compressed_data,
+     size_t *compressed_data_size,
+     libcerror_error_t **error );
+
+int libvmdk_internal_handle_decompress_compressed_grain_data(
+     libvmdk_internal_handle_t *internal_handle,
+     uint64_t grain_index,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error );
+
+ssize_t libvmdk_internal_handle_read_grain_data_direct_from_file_io_pool(
+         libvmdk_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libvmdk_grain_cursor_t *grain_cursor,
+         uint64_t grain_index,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+
+int libvmdk_internal_handle_read_readahead_grain(
+     libvmdk_internal_handle_t *internal_handle,
+     uint64_t grain_index,
+     uint8_t *grain_data,
+     size_t grain_data_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+
+int libvmdk_internal_handle_layer_has_grain_at_offset(
+     libvmdk_internal_handle_t *layer_internal_handle,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int libvmdk_internal_handle_create_layer_map(
+     libvmdk_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libvmdk_internal_handle_get_parent_layer_at_offset(
+     libvmdk_internal_handle_t *internal_handle,
+     off64_t offset,
+     libvmdk_handle_t **layer_handle,
+     libcerror_error_t **error );
+
+ssize_t libvmdk_internal_handle_read_buffer_from_parent(
+         libvmdk_internal_handle_t *internal_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+
+int libvmdk_internal_handle_create_decompression_thread_pool(
+     libvmdk_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libvmdk_internal_handle_decompress_grain_data(
+     libvmdk_internal_grain_decompression_t *grain_decompression,
+     void *arguments );
+
+int libvmdk_internal_handle_wait_for_grain_decompressions(
+     libvmdk_internal_handle_t *internal_handle,
+     int *number_of_pending_decompressions,
+     libcerror_error_t **error );
+
+ssize_t libvmdk_internal_handle_read_grains_from_file_io_pool(
+         libvmdk_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint64_t grain_index,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+
+int libvmdk_internal_handle_update_sequential_read_offset(
+     libvmdk_internal_handle_t *internal_handle,
+     off64_t offset,
+     size_t read_size,
+     uint8_t *is_sequential,
+     libcerror_error_t **error );
+
 ssize_t libvmdk_internal_handle_read_buffer_from_file_io_pool(
          libvmdk_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
          void *buffer,
          size_t buffer_size,
+         off64_t offset,
          libcerror_error_t **error );
 
 LIBVMDK_EXTERN \
@@ -206,6 +523,10 @@ ssize_t libvmdk_handle_read_buffer(
          size_t buffer_size,
          libcerror_error_t **error );
 
+int libvmdk_internal_handle_reset_abort(
+     libvmdk_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
 LIBVMDK_EXTERN \
 ssize_t libvmdk_handle_read_buffer_at_offset(
          libvmdk_handle_t *handle,
@@ -214,6 +535,26 @@ ssize_t libvmdk_handle_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+int libvmdk_internal_handle_compare_read_ranges(
+     const void *first_read_range,
+     const void *second_read_range );
+
+ssize_t libvmdk_internal_handle_read_buffers_from_file_io_pool(
+         libvmdk_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libvmdk_internal_read_range_t *read_ranges,
+         int number_of_read_ranges,
+         libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+ssize_t libvmdk_handle_read_buffers_at_offsets(
+         libvmdk_handle_t *handle,
+         uint8_t **buffers,
+         size_t *buffer_sizes,
+         off64_t *offsets,
+         int number_of_buffers,
+         libcerror_error_t **error );
+
 off64_t libvmdk_internal_handle_seek_offset(
          libvmdk_internal_handle_t *internal_handle,
          off64_t offset,
@@ -239,6 +580,156 @@ int libvmdk_handle_set_maximum_number_of_open_handles(
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_number_of_decompression_threads(
+     libvmdk_handle_t *handle,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_set_number_of_decompression_threads(
+     libvmdk_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_number_of_open_threads(
+     libvmdk_handle_t *handle,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_set_number_of_open_threads(
+     libvmdk_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_maximum_number_of_readahead_grains(
+     libvmdk_handle_t *handle,
+     int *maximum_number_of_grains,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_set_maximum_number_of_readahead_grains(
+     libvmdk_handle_t *handle,
+     int maximum_number_of_grains,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_maximum_cache_size(
+     libvmdk_handle_t *handle,
+     size64_t *maximum_cache_size,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_set_maximum_cache_size(
+     libvmdk_handle_t *handle,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_cache_sizes(
+     libvmdk_handle_t *handle,
+     size64_t *grain_groups_cache_size,
+     size64_t *grains_cache_size,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_statistics(
+     libvmdk_handle_t *handle,
+     uint64_t *statistics,
+     int number_of_statistics,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_set_trace_callback(
+     libvmdk_handle_t *handle,
+     void (*callback)(
+            int trace_event,
+            uint64_t start_timestamp,
+            uint64_t duration,
+            void *callback_data ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_use_latency_histograms(
+     libvmdk_handle_t *handle,
+     uint8_t *use_latency_histograms,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_set_use_latency_histograms(
+     libvmdk_handle_t *handle,
+     uint8_t use_latency_histograms,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_latency_histogram(
+     libvmdk_handle_t *handle,
+     int trace_event,
+     uint64_t *buckets,
+     int number_of_buckets,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_use_grain_offsets_index(
+     libvmdk_handle_t *handle,
+     uint8_t *use_grain_offsets_index,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_set_use_grain_offsets_index(
+     libvmdk_handle_t *handle,
+     uint8_t use_grain_offsets_index,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_use_lazy_loading(
+     libvmdk_handle_t *handle,
+     uint8_t *use_lazy_loading,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_set_use_lazy_loading(
+     libvmdk_handle_t *handle,
+     uint8_t use_lazy_loading,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_set_metadata_index_filename(
+     libvmdk_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_set_metadata_index_filename_wide(
+     libvmdk_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_write_metadata_index(
+     libvmdk_handle_t *handle,
+     libcerror_error_t **error );
+
+int libvmdk_internal_handle_verify_extent_data_files(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_verify_extent_data_files(
+     libvmdk_handle_t *handle,
+     libcerror_error_t **error );
+
 LIBVMDK_EXTERN \
 int libvmdk_handle_set_parent_handle(
      libvmdk_handle_t *handle,
@@ -181,11 +181,56 @@ int libvmdk_huffman_tree_initialize(
 	}
 	( *huffman_tree )->maximum_code_size = maximum_code_size;
 
+	if( maximum_code_size < LIBVMDK_HUFFMAN_TREE_LOOKUP_TABLE_BITS )
+	{
+		( *huffman_tree )->lookup_table_bits = maximum_code_size;
+	}
+	else
+	{
+		( *huffman_tree )->lookup_table_bits = LIBVMDK_HUFFMAN_TREE_LOOKUP_TABLE_BITS;
+	}
+	( *huffman_tree )->number_of_lookup_table_entries = 1 << ( *huffman_tree )->lookup_table_bits;
+
+	array_size = sizeof( uint32_t ) * ( *huffman_tree )->number_of_lookup_table_entries;
+
+	( *huffman_tree )->lookup_table = (uint32_t *) memory_allocate(
+	                                                array_size );
+
+	if( ( *huffman_tree )->lookup_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create lookup table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *huffman_tree )->lookup_table,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear lookup table.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
 	if( *huffman_tree != NULL )
 	{
+		if( ( *huffman_tree )->lookup_table != NULL )
+		{
+			memory_free(
+			 ( *huffman_tree )->lookup_table );
+		}
 		if( ( *huffman_tree )->code_size_counts != NULL )
 		{
 			memory_free(
@@ -226,6 +271,11 @@ int libvmdk_huffman_tree_free(
 	}
 	if( *huffman_tree != NULL )
 	{
+		if( ( *huffman_tree )->lookup_table != NULL )
+		{
+			memory_free(
+			 ( *huffman_tree )->lookup_table );
+		}
 		if( ( *huffman_tree )->code_size_counts != NULL )
 		{
 			memory_free(
@@ -339,6 +389,22 @@ int libvmdk_huffman_tree_build(
 	 */
 	if( huffman_tree->code_size_counts[ 0 ] == number_of_code_sizes )
 	{
+		/* Clear the lookup table so that every Huffman code is invalid
+		 */
+		if( memory_set(
+		     huffman_tree->lookup_table,
+		     0,
+		     sizeof( uint32_t ) * ( 1 << huffman_tree->lookup_table_bits ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear lookup table.",
+			 function );
+
+			goto on_error;
+		}
 		return( 0 );
 	}
 	/* Check if the set of code sizes is incomplete or over-subscribed
@@ -437,6 +503,21 @@ int libvmdk_huffman_tree_build(
 	memory_free(
 	 symbol_offsets );
 
+	symbol_offsets = NULL;
+
+	if( libvmdk_huffman_tree_build_lookup_table(
+	     huffman_tree,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to build lookup table.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
@@ -448,24 +529,226 @@ on_error:
 	return( -1 );
 }
 
+/* Builds the lookup table from the symbols sorted by code size
+ * The lookup table is indexed by the Huffman code bits in the order they are stored
+ * in the bit stream, hence the least significant bit contains the first bit of the code.
+ * Codes that are longer than the lookup table bits are stored in sub tables
+ * Returns 1 on success or -1 on error
+ */
+int libvmdk_huffman_tree_build_lookup_table(
+     libvmdk_huffman_tree_t *huffman_tree,
+     libcerror_error_t **error )
+{
+	uint32_t *reallocation            = NULL;
+	static char *function             = "libvmdk_huffman_tree_build_lookup_table";
+	uint32_t lookup_table_entry       = 0;
+	uint32_t prefix_code              = 0;
+	uint32_t reversed_code            = 0;
+	uint32_t sub_table_prefix_code    = 0;
+	uint8_t bit_index                 = 0;
+	uint8_t code_size                 = 0;
+	uint8_t look_ahead_code_size      = 0;
+	uint8_t sub_table_bits            = 0;
+	uint8_t sub_table_code_size       = 0;
+	int code                          = 0;
+	int code_index                    = 0;
+	int code_size_count               = 0;
+	int look_ahead_code               = 0;
+	int look_ahead_remaining          = 0;
+	int lookup_table_index            = 0;
+	int number_of_lookup_table_entries = 0;
+	int number_of_primary_entries     = 0;
+	int sub_table_index               = 0;
+	int symbol_index                  = 0;
+
+	if( huffman_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid Huffman tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( huffman_tree->lookup_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid Huffman tree - missing lookup table.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_primary_entries      = 1 << huffman_tree->lookup_table_bits;
+	number_of_lookup_table_entries = number_of_primary_entries;
+
+	if( memory_set(
+	     huffman_tree->lookup_table,
+	     0,
+	     sizeof( uint32_t ) * number_of_primary_entries ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear lookup table.",
+		 function );
+
+		return( -1 );
+	}
+	sub_table_prefix_code = 0xffffffffUL;
+
+	for( code_size = 1;
+	     code_size <= huffman_tree->maximum_code_size;
+	     code_size++ )
+	{
+		code_size_count = huffman_tree->code_size_counts[ code_size ];
+
+		for( code_index = 0;
+		     code_index < code_size_count;
+		     code_index++ )
+		{
+			/* Reverse the bits of the code since the first bit of the code is stored
+			 * in the least significant bit of the bit stream
+			 */
+			reversed_code = 0;
+
+			for( bit_index = 0;
+			     bit_index < code_size;
+			     bit_index++ )
+			{
+				reversed_code <<= 1;
+				reversed_code  |= (uint32_t) ( code >> bit_index ) & 0x00000001UL;
+			}
+			lookup_table_entry = ( (uint32_t) huffman_tree->symbols[ symbol_index ] << 8 ) | code_size;
+
+			if( code_size <= huffman_tree->lookup_table_bits )
+			{
+				for( lookup_table_index = (int) reversed_code;
+				     lookup_table_index < number_of_primary_entries;
+				     lookup_table_index += 1 << code_size )
+				{
+					huffman_tree->lookup_table[ lookup_table_index ] = lookup_table_entry;
+				}
+			}
+			else
+			{
+				prefix_code = (uint32_t) code >> ( code_size - huffman_tree->lookup_table_bits );
+
+				/* The codes that share the same prefix are consecutive, hence a new prefix
+				 * starts a new sub table that is sized to fit the longest code of the prefix
+				 */
+				if( prefix_code != sub_table_prefix_code )
+				{
+					look_ahead_code      = code;
+					look_ahead_code_size = code_size;
+					look_ahead_remaining = code_size_count - code_index;
+					sub_table_bits       = code_size - huffman_tree->lookup_table_bits;
+
+					while( look_ahead_code_size <= huffman_tree->maximum_code_size )
+					{
+						look_ahead_code      += 1;
+						look_ahead_remaining -= 1;
+
+						while( ( look_ahead_remaining == 0 )
+						    && ( look_ahead_code_size < huffman_tree->maximum_code_size ) )
+						{
+							look_ahead_code      <<= 1;
+							look_ahead_code_size  += 1;
+							look_ahead_remaining   = huffman_tree->code_size_counts[ look_ahead_code_size ];
+						}
+						if( look_ahead_remaining <= 0 )
+						{
+							break;
+						}
+						if( ( (uint32_t) look_ahead_code >> ( look_ahead_code_size - huffman_tree->lookup_table_bits ) ) != prefix_code )
+						{
+							break;
+						}
+						sub_table_bits = look_ahead_code_size - huffman_tree->lookup_table_bits;
+					}
+					sub_table_index = number_of_lookup_table_entries;
+
+					number_of_lookup_table_entries += 1 << sub_table_bits;
+
+					if( number_of_lookup_table_entries > huffman_tree->number_of_lookup_table_entries )
+					{
+						reallocation = (uint32_t *) memory_reallocate(
+						                             huffman_tree->lookup_table,
+						                             sizeof( uint32_t ) * number_of_lookup_table_entries );
+
+						if( reallocation == NULL )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_MEMORY,
+							 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+							 "%s: unable to resize lookup table.",
+							 function );
+
+							return( -1 );
+						}
+						huffman_tree->lookup_table                   = reallocation;
+						huffman_tree->number_of_lookup_table_entries = number_of_lookup_table_entries;
+					}
+					if( memory_set(
+					     &( huffman_tree->lookup_table[ sub_table_index ] ),
+					     0,
+					     sizeof( uint32_t ) * ( 1 << sub_table_bits ) ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+						 "%s: unable to clear sub table.",
+						 function );
+
+						return( -1 );
+					}
+					/* The primary entry is indexed by the reversed prefix, which are the lower bits of the reversed code
+					 */
+					lookup_table_index = (int) ( reversed_code & ( (uint32_t) number_of_primary_entries - 1 ) );
+
+					huffman_tree->lookup_table[ lookup_table_index ] = ( (uint32_t) sub_table_index << 8 )
+					                                                 | LIBVMDK_HUFFMAN_TREE_LOOKUP_ENTRY_FLAG_SUB_TABLE
+					                                                 | sub_table_bits;
+
+					sub_table_prefix_code = prefix_code;
+				}
+				sub_table_code_size = code_size - huffman_tree->lookup_table_bits;
+
+				for( lookup_table_index = (int) ( reversed_code >> huffman_tree->lookup_table_bits );
+				     lookup_table_index < ( 1 << sub_table_bits );
+				     lookup_table_index += 1 << sub_table_code_size )
+				{
+					huffman_tree->lookup_table[ sub_table_index + lookup_table_index ] = lookup_table_entry;
+				}
+			}
+			code         += 1;
+			symbol_index += 1;
+		}
+		code <<= 1;
+	}
+	return( 1 );
+}
+
 /* Retrieves a symbol based on the Huffman code read from the bit-stream
  * Returns 1 on success or -1 on error
  */
 int libvmdk_huffman_tree_get_symbol_from_bit_stream(
-     libvmdk_huffman_tree_t *huffman_tree,
+     const libvmdk_huffman_tree_t *huffman_tree,
      libvmdk_bit_stream_t *bit_stream,
      uint16_t *symbol,
      libcerror_error_t **error )
 {
-	static char *function  = "libvmdk_huffman_tree_get_symbol_from_bit_stream";
-	uint32_t value_32bit   = 0;
-	uint16_t safe_symbol   = 0;
-	uint8_t bit_index      = 0;
-	int code_size_count    = 0;
-	int first_huffman_code = 0;
-	int first_index        = 0;
-	int huffman_code       = 0;
-	int result             = 0;
+	static char *function       = "libvmdk_huffman_tree_get_symbol_from_bit_stream";
+	uint32_t lookup_table_entry = 0;
+	uint32_t value_32bit        = 0;
+	uint8_t code_size           = 0;
 
 	if( huffman_tree == NULL )
 	{
@@ -500,15 +783,29 @@ int libvmdk_huffman_tree_get_symbol_from_bit_stream(
 
 		return( -1 );
 	}
-/* TODO get maximum_code_size of bits into local bit buffer */
+	/* The lookup table is indexed by bit-reversed codes, which only matches
+	 * the bit order of a back-to-front stored bit stream
+	 */
+	if( bit_stream->storage_type != LIBVMDK_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported bit stream storage type: 0x%02" PRIx8 ".",
+		 function,
+		 bit_stream->storage_type );
 
-	for( bit_index = 1;
-	     bit_index <= huffman_tree->maximum_code_size;
-	     bit_index++ )
+		return( -1 );
+	}
+	/* Fast path: peek the bits directly when the bit buffer already contains them
+	 */
+	if( ( huffman_tree->maximum_code_size == 0 )
+	 || ( huffman_tree->maximum_code_size > bit_stream->bit_buffer_size ) )
 	{
-		if( libvmdk_bit_stream_get_value(
+		if( libvmdk_bit_stream_peek_value(
 		     bit_stream,
-		     1,
+		     huffman_tree->maximum_code_size,
 		     &value_32bit,
 		     error ) != 1 )
 		{
@@ -521,24 +818,25 @@ int libvmdk_huffman_tree_get_symbol_from_bit_stream(
 
 			return( -1 );
 		}
-		huffman_code <<= 1;
-		huffman_code  |= (int) value_32bit;
-
-		code_size_count = huffman_tree->code_size_counts[ bit_index ];
-
-		if( ( huffman_code - code_size_count ) < first_huffman_code )
-		{
-			safe_symbol = huffman_tree->symbols[ first_index + ( huffman_code - first_huffman_code ) ];
+	}
+	else
+	{
+		value_32bit = LIBVMDK_BIT_STREAM_PEEK_VALUE_BACK_TO_FRONT(
+		               bit_stream,
+		               huffman_tree->maximum_code_size );
+	}
+	lookup_table_entry = huffman_tree->lookup_table[ value_32bit & ( ( 1UL << huffman_tree->lookup_table_bits ) - 1 ) ];
 
-			result = 1;
+	if( ( lookup_table_entry & LIBVMDK_HUFFMAN_TREE_LOOKUP_ENTRY_FLAG_SUB_TABLE ) != 0 )
+	{
+		code_size = (uint8_t) ( lookup_table_entry & LIBVMDK_HUFFMAN_TREE_LOOKUP_ENTRY_CODE_SIZE_MASK );
 
-			break;
-		}
-		first_huffman_code  += code_size_count;
-		first_huffman_code <<= 1;
-		first_index         += code_size_count;
+		lookup_table_entry = huffman_tree->lookup_table[ ( lookup_table_entry >> 8 ) + ( ( value_32bit >> huffman_tree->lookup_table_bits ) & ( ( 1UL << code_size ) - 1 ) ) ];
 	}
-	if( result != 1 )
+	code_size = (uint8_t) ( lookup_table_entry & LIBVMDK_HUFFMAN_TREE_LOOKUP_ENTRY_CODE_SIZE_MASK );
+
+	if( ( code_size == 0 )
+	 || ( code_size > bit_stream->bit_buffer_size ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -546,11 +844,15 @@ int libvmdk_huffman_tree_get_symbol_from_bit_stream(
 		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
 		 "%s: invalid Huffman code: 0x%08" PRIx32 ".",
 		 function,
-		 huffman_code );
+		 value_32bit );
 
 		return( -1 );
 	}
-	*symbol = safe_symbol;
+	LIBVMDK_BIT_STREAM_SKIP_BITS_BACK_TO_FRONT(
+	 bit_stream,
+	 code_size );
+
+	*symbol = (uint16_t) ( lookup_table_entry >> 8 );
 
 	return( 1 );
 }
@@ -32,6 +32,19 @@
 extern "C" {
 #endif
 
+/* The number of bits of the Huffman code used as index in the (primary) lookup table
+ */
+#define LIBVMDK_HUFFMAN_TREE_LOOKUP_TABLE_BITS			10
+
+/* A lookup table entry contains:
+ * bits 0 - 5	the code size or for a sub table entry the number of bits of the sub table
+ * bit 7	the sub table flag
+ * bits 8 - 31	the symbol or for a sub table entry the index of the sub table
+ * An entry with a code size of 0 represents an invalid Huffman code
+ */
+#define LIBVMDK_HUFFMAN_TREE_LOOKUP_ENTRY_CODE_SIZE_MASK	0x0000003fUL
+#define LIBVMDK_HUFFMAN_TREE_LOOKUP_ENTRY_FLAG_SUB_TABLE	0x00000080UL
+
 typedef struct libvmdk_huffman_tree libvmdk_huffman_tree_t;
 
 struct libvmdk_huffman_tree
@@ -47,6 +60,18 @@ struct libvmdk_huffman_tree
 	/* The code size counts array
 	 */
 	int *code_size_counts;
+
+	/* The number of bits used as index in the (primary) lookup table
+	 */
+	uint8_t lookup_table_bits;
+
+	/* The lookup table, contains the primary table followed by the sub tables
+	 */
+	uint32_t *lookup_table;
+
+	/* The number of allocated lookup table entries
+	 */
+	int number_of_lookup_table_entries;
 };
 
 int libvmdk_huffman_tree_initialize(
@@ -65,8 +90,12 @@ int libvmdk_huffman_tree_build(
      int number_of_code_sizes,
      libcerror_error_t **error );
 
-int libvmdk_huffman_tree_get_symbol_from_bit_stream(
+int libvmdk_huffman_tree_build_lookup_table(
      libvmdk_huffman_tree_t *huffman_tree,
+     libcerror_error_t **error );
+
+int libvmdk_huffman_tree_get_symbol_from_bit_stream(
+     const libvmdk_huffman_tree_t *huffman_tree,
      libvmdk_bit_stream_t *bit_stream,
      uint16_t *symbol,
      libcerror_error_t **error );
@@ -30,6 +30,8 @@
 #include "libvmdk_libbfio.h"
 #include "libvmdk_libcerror.h"
 #include "libvmdk_libcnotify.h"
+#include "libvmdk_statistics.h"
+#include "libvmdk_trace.h"
 
 /* Creates an IO handle
  * Make sure the value io_handle is referencing, is set to NULL
@@ -89,6 +91,37 @@ int libvmdk_io_handle_initialize(
 		 "%s: unable to clear file.",
 		 function );
 
+		memory_free(
+		 *io_handle );
+
+		*io_handle = NULL;
+
+		return( -1 );
+	}
+	if( libvmdk_statistics_initialize(
+	     &( ( *io_handle )->statistics ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_trace_initialize(
+	     &( ( *io_handle )->trace ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create trace.",
+		 function );
+
 		goto on_error;
 	}
 	return( 1 );
@@ -96,6 +129,12 @@ int libvmdk_io_handle_initialize(
 on_error:
 	if( *io_handle != NULL )
 	{
+		if( ( *io_handle )->statistics != NULL )
+		{
+			libvmdk_statistics_free(
+			 &( ( *io_handle )->statistics ),
+			 NULL );
+		}
 		memory_free(
 		 *io_handle );
 
@@ -112,6 +151,7 @@ int libvmdk_io_handle_free(
      libcerror_error_t **error )
 {
 	static char *function = "libvmdk_io_handle_free";
+	int result            = 1;
 
 	if( io_handle == NULL )
 	{
@@ -126,12 +166,44 @@ int libvmdk_io_handle_free(
 	}
 	if( *io_handle != NULL )
 	{
+		if( ( *io_handle )->statistics != NULL )
+		{
+			if( libvmdk_statistics_free(
+			     &( ( *io_handle )->statistics ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free statistics.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *io_handle )->trace != NULL )
+		{
+			if( libvmdk_trace_free(
+			     &( ( *io_handle )->trace ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free trace.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *io_handle );
 
 		*io_handle = NULL;
 	}
-	return( 1 );
+	return( result );
 }
 
 /* Clears the IO handle
@@ -141,7 +213,9 @@ int libvmdk_io_handle_clear(
      libvmdk_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function = "libvmdk_io_handle_clear";
+	libvmdk_statistics_t *statistics = NULL;
+	libvmdk_trace_t *trace           = NULL;
+	static char *function            = "libvmdk_io_handle_clear";
 
 	if( io_handle == NULL )
 	{
@@ -154,6 +228,9 @@ int libvmdk_io_handle_clear(
 
 		return( -1 );
 	}
+	statistics = io_handle->statistics;
+	trace      = io_handle->trace;
+
 	if( memory_set(
 	     io_handle,
 	     0,
@@ -166,8 +243,49 @@ int libvmdk_io_handle_clear(
 		 "%s: unable to clear IO handle.",
 		 function );
 
+		io_handle->statistics = statistics;
+		io_handle->trace      = trace;
+
 		return( -1 );
 	}
+	io_handle->statistics = statistics;
+	io_handle->trace      = trace;
+
+	if( statistics != NULL )
+	{
+		if( libvmdk_statistics_clear(
+		     statistics,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to clear statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* The trace callback and options are retained but the latency histograms
+	 * only cover the media that was last opened
+	 */
+	if( trace != NULL )
+	{
+		if( libvmdk_trace_clear_latency_histograms(
+		     trace,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to clear latency histograms.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( 1 );
 }
 
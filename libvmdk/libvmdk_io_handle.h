@@ -27,11 +27,39 @@
 
 #include "libvmdk_libbfio.h"
 #include "libvmdk_libcerror.h"
+#include "libvmdk_libcthreads.h"
+#include "libvmdk_statistics.h"
+#include "libvmdk_trace.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The abort value is signalled and read without holding the read/write lock of the handle
+ */
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) && defined( __GNUC__ )
+#define libvmdk_io_handle_get_abort( io_handle ) \
+	__atomic_load_n( &( ( io_handle )->abort ), __ATOMIC_RELAXED )
+
+#define libvmdk_io_handle_set_abort( io_handle, value ) \
+	__atomic_store_n( &( ( io_handle )->abort ), value, __ATOMIC_RELAXED )
+
+#elif defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) && defined( WINAPI )
+#define libvmdk_io_handle_get_abort( io_handle ) \
+	(int) InterlockedCompareExchange( (LONG volatile *) &( ( io_handle )->abort ), 0, 0 )
+
+#define libvmdk_io_handle_set_abort( io_handle, value ) \
+	InterlockedExchange( (LONG volatile *) &( ( io_handle )->abort ), (LONG) value )
+
+#else
+#define libvmdk_io_handle_get_abort( io_handle ) \
+	( io_handle )->abort
+
+#define libvmdk_io_handle_set_abort( io_handle, value ) \
+	( io_handle )->abort = value
+
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) && defined( __GNUC__ ) */
+
 typedef struct libvmdk_io_handle libvmdk_io_handle_t;
 
 struct libvmdk_io_handle
@@ -63,6 +91,26 @@ struct libvmdk_io_handle
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
+
+	/* The number of entries of the grain groups cache of an extent file or 0 for the default
+	 */
+	int number_of_grain_groups_cache_entries;
+
+	/* The number of grain group lookups in the grain groups caches
+	 */
+	uint64_t number_of_grain_group_lookups;
+
+	/* The number of grain groups read, which are the grain groups cache misses
+	 */
+	uint64_t number_of_grain_group_reads;
+
+	/* The statistics of reading the media data
+	 */
+	libvmdk_statistics_t *statistics;
+
+	/* The trace of the open and read operations
+	 */
+	libvmdk_trace_t *trace;
 };
 
 int libvmdk_io_handle_initialize(
@@ -0,0 +1,353 @@
+/*
+ * Layer map functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvmdk_definitions.h"
+#include "libvmdk_layer_map.h"
+#include "libvmdk_libcerror.h"
+
+/* Creates a layer map
+ * Make sure the value layer_map is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_layer_map_initialize(
+     libvmdk_layer_map_t **layer_map,
+     uint64_t number_of_grains,
+     libcerror_error_t **error )
+{
+	static char *function     = "libvmdk_layer_map_initialize";
+	uint64_t number_of_blocks = 0;
+
+	if( layer_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layer map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *layer_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid layer map value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_grains == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of grains value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_blocks = number_of_grains / LIBVMDK_LAYER_MAP_NUMBER_OF_GRAINS_PER_BLOCK;
+
+	if( ( number_of_grains % LIBVMDK_LAYER_MAP_NUMBER_OF_GRAINS_PER_BLOCK ) != 0 )
+	{
+		number_of_blocks += 1;
+	}
+	if( number_of_blocks > (uint64_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint8_t * ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of grains value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*layer_map = memory_allocate_structure(
+	              libvmdk_layer_map_t );
+
+	if( *layer_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create layer map.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *layer_map,
+	     0,
+	     sizeof( libvmdk_layer_map_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear layer map.",
+		 function );
+
+		memory_free(
+		 *layer_map );
+
+		*layer_map = NULL;
+
+		return( -1 );
+	}
+	( *layer_map )->blocks = (uint8_t **) memory_allocate(
+	                                       sizeof( uint8_t * ) * (size_t) number_of_blocks );
+
+	if( ( *layer_map )->blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create blocks.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *layer_map )->blocks,
+	     0,
+	     sizeof( uint8_t * ) * (size_t) number_of_blocks ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear blocks.",
+		 function );
+
+		goto on_error;
+	}
+	( *layer_map )->number_of_grains = number_of_grains;
+	( *layer_map )->number_of_blocks = (size_t) number_of_blocks;
+
+	return( 1 );
+
+on_error:
+	if( *layer_map != NULL )
+	{
+		if( ( *layer_map )->blocks != NULL )
+		{
+			memory_free(
+			 ( *layer_map )->blocks );
+		}
+		memory_free(
+		 *layer_map );
+
+		*layer_map = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a layer map
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_layer_map_free(
+     libvmdk_layer_map_t **layer_map,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_layer_map_free";
+	size_t block_index    = 0;
+
+	if( layer_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layer map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *layer_map != NULL )
+	{
+		for( block_index = 0;
+		     block_index < ( *layer_map )->number_of_blocks;
+		     block_index++ )
+		{
+			if( ( *layer_map )->blocks[ block_index ] != NULL )
+			{
+				memory_free(
+				 ( *layer_map )->blocks[ block_index ] );
+			}
+		}
+		memory_free(
+		 ( *layer_map )->blocks );
+
+		memory_free(
+		 *layer_map );
+
+		*layer_map = NULL;
+	}
+	return( 1 );
+}
+
+/* Retrieves the layer of a specific grain
+ * The layer is LIBVMDK_LAYER_MAP_LAYER_UNRESOLVED if it has not been set
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_layer_map_get_layer(
+     libvmdk_layer_map_t *layer_map,
+     uint64_t grain_index,
+     uint8_t *layer,
+     libcerror_error_t **error )
+{
+	uint8_t *block        = NULL;
+	static char *function = "libvmdk_layer_map_get_layer";
+
+	if( layer_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layer map.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_index >= layer_map->number_of_grains )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid grain index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( layer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layer.",
+		 function );
+
+		return( -1 );
+	}
+	block = layer_map->blocks[ grain_index / LIBVMDK_LAYER_MAP_NUMBER_OF_GRAINS_PER_BLOCK ];
+
+	if( block == NULL )
+	{
+		*layer = LIBVMDK_LAYER_MAP_LAYER_UNRESOLVED;
+	}
+	else
+	{
+		*layer = block[ grain_index % LIBVMDK_LAYER_MAP_NUMBER_OF_GRAINS_PER_BLOCK ];
+	}
+	return( 1 );
+}
+
+/* Sets the layer of a specific grain
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_layer_map_set_layer(
+     libvmdk_layer_map_t *layer_map,
+     uint64_t grain_index,
+     uint8_t layer,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_layer_map_set_layer";
+	size_t block_index    = 0;
+
+	if( layer_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layer map.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_index >= layer_map->number_of_grains )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid grain index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	block_index = (size_t) ( grain_index / LIBVMDK_LAYER_MAP_NUMBER_OF_GRAINS_PER_BLOCK );
+
+	if( layer_map->blocks[ block_index ] == NULL )
+	{
+		layer_map->blocks[ block_index ] = (uint8_t *) memory_allocate(
+		                                                sizeof( uint8_t ) * LIBVMDK_LAYER_MAP_NUMBER_OF_GRAINS_PER_BLOCK );
+
+		if( layer_map->blocks[ block_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create block.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     layer_map->blocks[ block_index ],
+		     LIBVMDK_LAYER_MAP_LAYER_UNRESOLVED,
+		     sizeof( uint8_t ) * LIBVMDK_LAYER_MAP_NUMBER_OF_GRAINS_PER_BLOCK ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear block.",
+			 function );
+
+			memory_free(
+			 layer_map->blocks[ block_index ] );
+
+			layer_map->blocks[ block_index ] = NULL;
+
+			return( -1 );
+		}
+	}
+	( layer_map->blocks[ block_index ] )[ grain_index % LIBVMDK_LAYER_MAP_NUMBER_OF_GRAINS_PER_BLOCK ] = layer;
+
+	return( 1 );
+}
+
@@ -0,0 +1,78 @@
+/*
+ * Layer map functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_LAYER_MAP_H )
+#define _LIBVMDK_LAYER_MAP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvmdk_layer_map libvmdk_layer_map_t;
+
+struct libvmdk_layer_map
+{
+	/* The number of grains
+	 */
+	uint64_t number_of_grains;
+
+	/* The number of blocks
+	 */
+	size_t number_of_blocks;
+
+	/* The blocks
+	 * Contains one layer value per grain, a block is allocated when a layer value in it is first set
+	 */
+	uint8_t **blocks;
+};
+
+int libvmdk_layer_map_initialize(
+     libvmdk_layer_map_t **layer_map,
+     uint64_t number_of_grains,
+     libcerror_error_t **error );
+
+int libvmdk_layer_map_free(
+     libvmdk_layer_map_t **layer_map,
+     libcerror_error_t **error );
+
+int libvmdk_layer_map_get_layer(
+     libvmdk_layer_map_t *layer_map,
+     uint64_t grain_index,
+     uint8_t *layer,
+     libcerror_error_t **error );
+
+int libvmdk_layer_map_set_layer(
+     libvmdk_layer_map_t *layer_map,
+     uint64_t grain_index,
+     uint8_t layer,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_LAYER_MAP_H ) */
+
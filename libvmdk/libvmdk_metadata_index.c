@@ -0,0 +1,1687 @@
+/*
+ * Metadata index functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "libvmdk_definitions.h"
+#include "libvmdk_deflate.h"
+#include "libvmdk_extent_file.h"
+#include "libvmdk_extent_table.h"
+#include "libvmdk_grain_offsets_index.h"
+#include "libvmdk_grain_table.h"
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcnotify.h"
+#include "libvmdk_metadata_index.h"
+#include "libvmdk_system_string.h"
+
+#include "vmdk_metadata_index.h"
+
+const char *vmdk_metadata_index_signature = "VMDKMIDX";
+
+/* Creates a metadata index
+ * Make sure the value metadata_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_metadata_index_initialize(
+     libvmdk_metadata_index_t **metadata_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_metadata_index_initialize";
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *metadata_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid metadata index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*metadata_index = memory_allocate_structure(
+	                   libvmdk_metadata_index_t );
+
+	if( *metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create metadata index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *metadata_index,
+	     0,
+	     sizeof( libvmdk_metadata_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear metadata index.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *metadata_index != NULL )
+	{
+		memory_free(
+		 *metadata_index );
+
+		*metadata_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a metadata index
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_metadata_index_free(
+     libvmdk_metadata_index_t **metadata_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_metadata_index_free";
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *metadata_index != NULL )
+	{
+		if( ( *metadata_index )->data != NULL )
+		{
+			memory_free(
+			 ( *metadata_index )->data );
+		}
+		if( ( *metadata_index )->filename != NULL )
+		{
+			memory_free(
+			 ( *metadata_index )->filename );
+		}
+		memory_free(
+		 *metadata_index );
+
+		*metadata_index = NULL;
+	}
+	return( 1 );
+}
+
+/* Clears the data read from the metadata index file
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_metadata_index_clear_data(
+     libvmdk_metadata_index_t *metadata_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_metadata_index_clear_data";
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_index->data != NULL )
+	{
+		memory_free(
+		 metadata_index->data );
+
+		metadata_index->data = NULL;
+	}
+	metadata_index->data_size         = 0;
+	metadata_index->number_of_extents = 0;
+
+	return( 1 );
+}
+
+/* Sets the filename
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_metadata_index_set_filename(
+     libvmdk_metadata_index_t *metadata_index,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_metadata_index_set_filename";
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( filename_length == 0 )
+	 || ( filename_length > (size_t) ( SSIZE_MAX - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_index->filename != NULL )
+	{
+		memory_free(
+		 metadata_index->filename );
+
+		metadata_index->filename      = NULL;
+		metadata_index->filename_size = 0;
+	}
+	if( libvmdk_system_string_size_from_narrow_string(
+	     filename,
+	     filename_length + 1,
+	     &( metadata_index->filename_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine filename size.",
+		 function );
+
+		goto on_error;
+	}
+	metadata_index->filename = system_string_allocate(
+	                            metadata_index->filename_size );
+
+	if( metadata_index->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_system_string_copy_from_narrow_string(
+	     metadata_index->filename,
+	     metadata_index->filename_size,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set filename.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( metadata_index->filename != NULL )
+	{
+		memory_free(
+		 metadata_index->filename );
+
+		metadata_index->filename = NULL;
+	}
+	metadata_index->filename_size = 0;
+
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Sets the filename
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_metadata_index_set_filename_wide(
+     libvmdk_metadata_index_t *metadata_index,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_metadata_index_set_filename_wide";
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( filename_length == 0 )
+	 || ( filename_length > (size_t) ( SSIZE_MAX - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_index->filename != NULL )
+	{
+		memory_free(
+		 metadata_index->filename );
+
+		metadata_index->filename      = NULL;
+		metadata_index->filename_size = 0;
+	}
+	if( libvmdk_system_string_size_from_wide_string(
+	     filename,
+	     filename_length + 1,
+	     &( metadata_index->filename_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine filename size.",
+		 function );
+
+		goto on_error;
+	}
+	metadata_index->filename = system_string_allocate(
+	                            metadata_index->filename_size );
+
+	if( metadata_index->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_system_string_copy_from_wide_string(
+	     metadata_index->filename,
+	     metadata_index->filename_size,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set filename.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( metadata_index->filename != NULL )
+	{
+		memory_free(
+		 metadata_index->filename );
+
+		metadata_index->filename = NULL;
+	}
+	metadata_index->filename_size = 0;
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Opens the metadata index file
+ * Returns 1 if successful, 0 if the file does not exist and is not opened for writing or -1 on error
+ */
+int libvmdk_metadata_index_open_file(
+     libvmdk_metadata_index_t *metadata_index,
+     int access_flags,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *safe_file_io_handle = NULL;
+	static char *function                 = "libvmdk_metadata_index_open_file";
+	int result                            = 0;
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_index->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid metadata index - missing filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &safe_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfio_file_set_name_wide(
+	          safe_file_io_handle,
+	          metadata_index->filename,
+	          metadata_index->filename_size,
+	          error );
+#else
+	result = libbfio_file_set_name(
+	          safe_file_io_handle,
+	          metadata_index->filename,
+	          metadata_index->filename_size,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) == 0 )
+	{
+		result = libbfio_handle_exists(
+		          safe_file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to determine if metadata index file exists.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			libbfio_handle_free(
+			 &safe_file_io_handle,
+			 NULL );
+
+			return( 0 );
+		}
+	}
+	if( libbfio_handle_open(
+	     safe_file_io_handle,
+	     access_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open metadata index file.",
+		 function );
+
+		goto on_error;
+	}
+	*file_io_handle = safe_file_io_handle;
+
+	return( 1 );
+
+on_error:
+	if( safe_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &safe_file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the metadata index file header data
+ * Returns 1 if successful, 0 if the metadata index does not match or -1 on error
+ */
+int libvmdk_metadata_index_read_file_header_data(
+     libvmdk_metadata_index_t *metadata_index,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t content_identifier,
+     uint32_t parent_content_identifier,
+     int number_of_extents,
+     uint32_t *data_checksum,
+     libcerror_error_t **error )
+{
+	static char *function                     = "libvmdk_metadata_index_read_file_header_data";
+	uint64_t index_data_size                  = 0;
+	uint32_t format_version                   = 0;
+	uint32_t index_content_identifier         = 0;
+	uint32_t index_number_of_extents          = 0;
+	uint32_t index_parent_content_identifier  = 0;
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( vmdk_metadata_index_file_header_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_checksum == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data checksum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vmdk_metadata_index_file_header_t *) data )->format_version,
+	 format_version );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vmdk_metadata_index_file_header_t *) data )->number_of_extents,
+	 index_number_of_extents );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vmdk_metadata_index_file_header_t *) data )->content_identifier,
+	 index_content_identifier );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vmdk_metadata_index_file_header_t *) data )->parent_content_identifier,
+	 index_parent_content_identifier );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (vmdk_metadata_index_file_header_t *) data )->data_size,
+	 index_data_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vmdk_metadata_index_file_header_t *) data )->data_checksum,
+	 *data_checksum );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: format version\t\t\t: %" PRIu32 "\n",
+		 function,
+		 format_version );
+
+		libcnotify_printf(
+		 "%s: number of extents\t\t\t: %" PRIu32 "\n",
+		 function,
+		 index_number_of_extents );
+
+		libcnotify_printf(
+		 "%s: content identifier\t\t: 0x%08" PRIx32 "\n",
+		 function,
+		 index_content_identifier );
+
+		libcnotify_printf(
+		 "%s: parent content identifier\t\t: 0x%08" PRIx32 "\n",
+		 function,
+		 index_parent_content_identifier );
+
+		libcnotify_printf(
+		 "%s: data size\t\t\t\t: %" PRIu64 "\n",
+		 function,
+		 index_data_size );
+
+		libcnotify_printf(
+		 "%s: data checksum\t\t\t: 0x%08" PRIx32 "\n",
+		 function,
+		 *data_checksum );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+
+	if( memory_compare(
+	     ( (vmdk_metadata_index_file_header_t *) data )->signature,
+	     vmdk_metadata_index_signature,
+	     8 ) != 0 )
+	{
+		return( 0 );
+	}
+	if( format_version != 1 )
+	{
+		return( 0 );
+	}
+	if( ( number_of_extents <= 0 )
+	 || ( index_number_of_extents != (uint32_t) number_of_extents ) )
+	{
+		return( 0 );
+	}
+	if( ( index_content_identifier != content_identifier )
+	 || ( index_parent_content_identifier != parent_content_identifier ) )
+	{
+		return( 0 );
+	}
+	if( ( index_data_size < ( (uint64_t) index_number_of_extents * sizeof( vmdk_metadata_index_extent_record_t ) ) )
+	 || ( index_data_size > (uint64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		return( 0 );
+	}
+	metadata_index->number_of_extents = index_number_of_extents;
+	metadata_index->data_size         = (size_t) index_data_size;
+
+	return( 1 );
+}
+
+/* Reads the metadata index file
+ * Returns 1 if successful, 0 if the metadata index file does not exist or does not match or -1 on error
+ */
+int libvmdk_metadata_index_read_file(
+     libvmdk_metadata_index_t *metadata_index,
+     uint32_t content_identifier,
+     uint32_t parent_content_identifier,
+     int number_of_extents,
+     libcerror_error_t **error )
+{
+	uint8_t file_header_data[ sizeof( vmdk_metadata_index_file_header_t ) ];
+
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libvmdk_metadata_index_read_file";
+	size64_t file_size               = 0;
+	ssize_t read_count               = 0;
+	uint32_t calculated_checksum     = 0;
+	uint32_t stored_checksum         = 0;
+	int result                       = 0;
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_index->data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid metadata index - data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvmdk_metadata_index_open_file(
+	          metadata_index,
+	          LIBBFIO_OPEN_READ,
+	          &file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open metadata index file.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve metadata index file size.",
+		 function );
+
+		goto on_error;
+	}
+	result = 0;
+
+	if( file_size >= (size64_t) sizeof( vmdk_metadata_index_file_header_t ) )
+	{
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              file_io_handle,
+		              file_header_data,
+		              sizeof( vmdk_metadata_index_file_header_t ),
+		              0,
+		              error );
+
+		if( read_count != (ssize_t) sizeof( vmdk_metadata_index_file_header_t ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read metadata index file header data.",
+			 function );
+
+			goto on_error;
+		}
+		result = libvmdk_metadata_index_read_file_header_data(
+		          metadata_index,
+		          file_header_data,
+		          sizeof( vmdk_metadata_index_file_header_t ),
+		          content_identifier,
+		          parent_content_identifier,
+		          number_of_extents,
+		          &stored_checksum,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read metadata index file header.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( result != 0 )
+	 && ( ( file_size - sizeof( vmdk_metadata_index_file_header_t ) ) != (size64_t) metadata_index->data_size ) )
+	{
+		result = 0;
+	}
+	if( result != 0 )
+	{
+		metadata_index->data = (uint8_t *) memory_allocate(
+		                                    sizeof( uint8_t ) * metadata_index->data_size );
+
+		if( metadata_index->data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create data.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              file_io_handle,
+		              metadata_index->data,
+		              metadata_index->data_size,
+		              sizeof( vmdk_metadata_index_file_header_t ),
+		              error );
+
+		if( read_count != (ssize_t) metadata_index->data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read metadata index data.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_deflate_calculate_adler32(
+		     &calculated_checksum,
+		     metadata_index->data,
+		     metadata_index->data_size,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate data checksum.",
+			 function );
+
+			goto on_error;
+		}
+		if( stored_checksum != calculated_checksum )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: mismatch in data checksum ( 0x%08" PRIx32 " != 0x%08" PRIx32 " ).\n",
+				 function,
+				 stored_checksum,
+				 calculated_checksum );
+			}
+#endif
+			result = 0;
+		}
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close metadata index file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( result == 0 )
+	{
+		if( libvmdk_metadata_index_clear_data(
+		     metadata_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to clear metadata index data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	libvmdk_metadata_index_clear_data(
+	 metadata_index,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Retrieves the grain offsets index of a specific extent from the metadata index
+ * The extent file is used to verify that the extent record matches the extent file header
+ * Returns 1 if successful, 0 if not available or the extent record does not match or -1 on error
+ */
+int libvmdk_metadata_index_get_grain_offsets_index(
+     libvmdk_metadata_index_t *metadata_index,
+     int extent_index,
+     libvmdk_extent_file_t *extent_file,
+     size64_t extent_file_size,
+     size64_t *storage_media_size,
+     libvmdk_grain_offsets_index_t **grain_offsets_index,
+     libcerror_error_t **error )
+{
+	vmdk_metadata_index_extent_record_t *extent_record      = NULL;
+	libvmdk_grain_offsets_index_t *safe_grain_offsets_index = NULL;
+	static char *function                                   = "libvmdk_metadata_index_get_grain_offsets_index";
+	size_t grain_table_data_size                            = 0;
+	uint64_t expected_storage_media_size                    = 0;
+	uint64_t grain_offsets_offset                           = 0;
+	uint64_t grain_offsets_size                             = 0;
+	uint64_t record_extent_file_size                        = 0;
+	uint64_t record_grain_size                              = 0;
+	uint64_t record_storage_media_size                      = 0;
+	uint32_t grain_group_index                              = 0;
+	uint32_t record_flags                                   = 0;
+	uint32_t record_number_of_grain_directory_entries       = 0;
+	uint32_t record_number_of_grain_table_entries           = 0;
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid extent index value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media size.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_offsets_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain offsets index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( metadata_index->data == NULL )
+	 || ( (uint32_t) extent_index >= metadata_index->number_of_extents ) )
+	{
+		return( 0 );
+	}
+	extent_record = &( ( (vmdk_metadata_index_extent_record_t *) metadata_index->data )[ extent_index ] );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 extent_record->extent_file_size,
+	 record_extent_file_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 extent_record->storage_media_size,
+	 record_storage_media_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 extent_record->grain_size,
+	 record_grain_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 extent_record->grain_offsets_offset,
+	 grain_offsets_offset );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 extent_record->number_of_grain_directory_entries,
+	 record_number_of_grain_directory_entries );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 extent_record->number_of_grain_table_entries,
+	 record_number_of_grain_table_entries );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 extent_record->flags,
+	 record_flags );
+
+	if( ( record_extent_file_size != (uint64_t) extent_file_size )
+	 || ( record_grain_size != (uint64_t) extent_file->grain_size )
+	 || ( record_number_of_grain_directory_entries != extent_file->number_of_grain_directory_entries )
+	 || ( record_number_of_grain_table_entries != extent_file->number_of_grain_table_entries )
+	 || ( record_flags != ( extent_file->flags & LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION ) ) )
+	{
+		return( 0 );
+	}
+	if( ( record_grain_size == 0 )
+	 || ( record_number_of_grain_directory_entries == 0 )
+	 || ( record_number_of_grain_table_entries == 0 ) )
+	{
+		return( 0 );
+	}
+	grain_table_data_size = (size_t) record_number_of_grain_table_entries * sizeof( uint32_t );
+	grain_offsets_size    = (uint64_t) record_number_of_grain_directory_entries * grain_table_data_size;
+
+	/* The last grain table can contain less entries than the maximum
+	 */
+	expected_storage_media_size = record_grain_size * record_number_of_grain_table_entries * record_number_of_grain_directory_entries;
+
+	if( expected_storage_media_size > (uint64_t) extent_file->maximum_data_size )
+	{
+		expected_storage_media_size = ( ( extent_file->maximum_data_size + record_grain_size - 1 ) / record_grain_size ) * record_grain_size;
+	}
+	if( record_storage_media_size != expected_storage_media_size )
+	{
+		return( 0 );
+	}
+	if( ( grain_offsets_offset < sizeof( vmdk_metadata_index_file_header_t ) )
+	 || ( ( grain_offsets_offset - sizeof( vmdk_metadata_index_file_header_t ) ) > (uint64_t) metadata_index->data_size )
+	 || ( grain_offsets_size > ( (uint64_t) metadata_index->data_size - ( grain_offsets_offset - sizeof( vmdk_metadata_index_file_header_t ) ) ) ) )
+	{
+		return( 0 );
+	}
+	if( libvmdk_grain_offsets_index_initialize(
+	     &safe_grain_offsets_index,
+	     (size64_t) record_grain_size,
+	     record_number_of_grain_directory_entries,
+	     record_number_of_grain_table_entries,
+	     record_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create grain offsets index.",
+		 function );
+
+		goto on_error;
+	}
+	grain_offsets_offset -= sizeof( vmdk_metadata_index_file_header_t );
+
+	for( grain_group_index = 0;
+	     grain_group_index < record_number_of_grain_directory_entries;
+	     grain_group_index++ )
+	{
+		if( libvmdk_grain_offsets_index_set_grain_group_data(
+		     safe_grain_offsets_index,
+		     grain_group_index,
+		     &( metadata_index->data[ grain_offsets_offset ] ),
+		     grain_table_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set grain group: %" PRIu32 " data.",
+			 function,
+			 grain_group_index );
+
+			goto on_error;
+		}
+		grain_offsets_offset += grain_table_data_size;
+	}
+	*storage_media_size  = (size64_t) record_storage_media_size;
+	*grain_offsets_index = safe_grain_offsets_index;
+
+	return( 1 );
+
+on_error:
+	if( safe_grain_offsets_index != NULL )
+	{
+		libvmdk_grain_offsets_index_free(
+		 &safe_grain_offsets_index,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the metadata index file
+ * This reads all the grain tables of the extent files that were not read before
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_metadata_index_write_file(
+     libvmdk_metadata_index_t *metadata_index,
+     libvmdk_grain_table_t *grain_table,
+     libvmdk_extent_table_t *extent_table,
+     libbfio_pool_t *file_io_pool,
+     uint32_t content_identifier,
+     uint32_t parent_content_identifier,
+     int number_of_extents,
+     libcerror_error_t **error )
+{
+	uint8_t file_header_data[ sizeof( vmdk_metadata_index_file_header_t ) ];
+
+	vmdk_metadata_index_extent_record_t *extent_record = NULL;
+	libbfio_handle_t *file_io_handle                   = NULL;
+	libvmdk_extent_file_t *extent_file                 = NULL;
+	libvmdk_grain_offsets_index_t *grain_offsets_index = NULL;
+	uint8_t *extent_records_data                       = NULL;
+	uint8_t *grain_offsets_data                        = NULL;
+	static char *function                              = "libvmdk_metadata_index_write_file";
+	size64_t extent_file_size                          = 0;
+	size64_t storage_media_size                        = 0;
+	size_t extent_records_data_size                    = 0;
+	size_t grain_offsets_data_offset                   = 0;
+	size_t grain_offsets_data_size                     = 0;
+	ssize_t write_count                                = 0;
+	uint64_t data_size                                 = 0;
+	uint64_t grain_offsets_offset                      = 0;
+	uint32_t data_checksum                             = 1;
+	uint32_t extent_flags                              = 0;
+	uint32_t grain_index                               = 0;
+	uint32_t number_of_grains                          = 0;
+	int extent_index                                   = 0;
+	int result                                         = 0;
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table->extent_files_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported extent table - metadata index requires sparse extent files.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_extents <= 0 )
+	 || ( (size_t) number_of_extents > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( vmdk_metadata_index_extent_record_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of extents value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	extent_records_data_size = sizeof( vmdk_metadata_index_extent_record_t ) * number_of_extents;
+
+	extent_records_data = (uint8_t *) memory_allocate(
+	                                   sizeof( uint8_t ) * extent_records_data_size );
+
+	if( extent_records_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create extent records data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     extent_records_data,
+	     0,
+	     extent_records_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear extent records data.",
+		 function );
+
+		goto on_error;
+	}
+	/* Read all the grain tables first so the extent records can be written before the grain offsets
+	 */
+	grain_offsets_offset = sizeof( vmdk_metadata_index_file_header_t ) + extent_records_data_size;
+
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( libvmdk_grain_table_read_grain_offsets_index(
+		     grain_table,
+		     file_io_pool,
+		     extent_table,
+		     extent_index,
+		     &grain_offsets_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read grain offsets index: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( libbfio_pool_get_size(
+		     file_io_pool,
+		     extent_index,
+		     &extent_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve size of file IO pool entry: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( libvmdk_extent_table_get_extent_file_by_index(
+		     extent_table,
+		     extent_index,
+		     file_io_pool,
+		     &extent_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent file: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		/* The last grain table can contain less entries than the maximum
+		 */
+		storage_media_size = grain_offsets_index->grain_size * grain_offsets_index->number_of_grain_table_entries * grain_offsets_index->number_of_grain_groups;
+
+		if( storage_media_size > extent_file->maximum_data_size )
+		{
+			storage_media_size = ( ( extent_file->maximum_data_size + grain_offsets_index->grain_size - 1 ) / grain_offsets_index->grain_size ) * grain_offsets_index->grain_size;
+		}
+		extent_flags = extent_file->flags & LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION;
+
+		extent_record = &( ( (vmdk_metadata_index_extent_record_t *) extent_records_data )[ extent_index ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 extent_record->extent_file_size,
+		 extent_file_size );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 extent_record->storage_media_size,
+		 storage_media_size );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 extent_record->grain_size,
+		 grain_offsets_index->grain_size );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 extent_record->grain_offsets_offset,
+		 grain_offsets_offset );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 extent_record->number_of_grain_directory_entries,
+		 grain_offsets_index->number_of_grain_groups );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 extent_record->number_of_grain_table_entries,
+		 grain_offsets_index->number_of_grain_table_entries );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 extent_record->flags,
+		 extent_flags );
+
+		grain_offsets_offset += (uint64_t) grain_offsets_index->number_of_grain_groups * grain_offsets_index->number_of_grain_table_entries * sizeof( uint32_t );
+	}
+	data_size = grain_offsets_offset - sizeof( vmdk_metadata_index_file_header_t );
+
+	if( libvmdk_deflate_calculate_adler32(
+	     &data_checksum,
+	     extent_records_data,
+	     extent_records_data_size,
+	     data_checksum,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate data checksum.",
+		 function );
+
+		goto on_error;
+	}
+	result = libvmdk_metadata_index_open_file(
+	          metadata_index,
+	          LIBBFIO_OPEN_WRITE_TRUNCATE,
+	          &file_io_handle,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open metadata index file.",
+		 function );
+
+		goto on_error;
+	}
+	/* The file header is written last, once the data checksum is known
+	 */
+	if( memory_set(
+	     file_header_data,
+	     0,
+	     sizeof( vmdk_metadata_index_file_header_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file header data.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer_at_offset(
+	               file_io_handle,
+	               file_header_data,
+	               sizeof( vmdk_metadata_index_file_header_t ),
+	               0,
+	               error );
+
+	if( write_count != (ssize_t) sizeof( vmdk_metadata_index_file_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file header data.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               extent_records_data,
+	               extent_records_data_size,
+	               error );
+
+	if( write_count != (ssize_t) extent_records_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write extent records data.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 extent_records_data );
+
+	extent_records_data = NULL;
+
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( libvmdk_grain_table_read_grain_offsets_index(
+		     grain_table,
+		     file_io_pool,
+		     extent_table,
+		     extent_index,
+		     &grain_offsets_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read grain offsets index: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		number_of_grains        = grain_offsets_index->number_of_grain_groups * grain_offsets_index->number_of_grain_table_entries;
+		grain_offsets_data_size = (size_t) number_of_grains * sizeof( uint32_t );
+
+		grain_offsets_data = (uint8_t *) memory_allocate(
+		                                  sizeof( uint8_t ) * grain_offsets_data_size );
+
+		if( grain_offsets_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create grain offsets data.",
+			 function );
+
+			goto on_error;
+		}
+		grain_offsets_data_offset = 0;
+
+		for( grain_index = 0;
+		     grain_index < number_of_grains;
+		     grain_index++ )
+		{
+			if( ( grain_offsets_index->grain_group_flags[ grain_index / grain_offsets_index->number_of_grain_table_entries ] & LIBVMDK_GRAIN_GROUP_FLAG_IS_SPARSE ) != 0 )
+			{
+				byte_stream_copy_from_uint32_little_endian(
+				 &( grain_offsets_data[ grain_offsets_data_offset ] ),
+				 0 );
+			}
+			else
+			{
+				byte_stream_copy_from_uint32_little_endian(
+				 &( grain_offsets_data[ grain_offsets_data_offset ] ),
+				 grain_offsets_index->sector_numbers[ grain_index ] );
+			}
+			grain_offsets_data_offset += sizeof( uint32_t );
+		}
+		if( libvmdk_deflate_calculate_adler32(
+		     &data_checksum,
+		     grain_offsets_data,
+		     grain_offsets_data_size,
+		     data_checksum,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate data checksum.",
+			 function );
+
+			goto on_error;
+		}
+		write_count = libbfio_handle_write_buffer(
+		               file_io_handle,
+		               grain_offsets_data,
+		               grain_offsets_data_size,
+		               error );
+
+		if( write_count != (ssize_t) grain_offsets_data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write grain offsets: %d data.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		memory_free(
+		 grain_offsets_data );
+
+		grain_offsets_data = NULL;
+	}
+	if( memory_copy(
+	     ( (vmdk_metadata_index_file_header_t *) file_header_data )->signature,
+	     vmdk_metadata_index_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (vmdk_metadata_index_file_header_t *) file_header_data )->format_version,
+	 1 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (vmdk_metadata_index_file_header_t *) file_header_data )->number_of_extents,
+	 number_of_extents );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (vmdk_metadata_index_file_header_t *) file_header_data )->content_identifier,
+	 content_identifier );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (vmdk_metadata_index_file_header_t *) file_header_data )->parent_content_identifier,
+	 parent_content_identifier );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (vmdk_metadata_index_file_header_t *) file_header_data )->data_size,
+	 data_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (vmdk_metadata_index_file_header_t *) file_header_data )->data_checksum,
+	 data_checksum );
+
+	write_count = libbfio_handle_write_buffer_at_offset(
+	               file_io_handle,
+	               file_header_data,
+	               sizeof( vmdk_metadata_index_file_header_t ),
+	               0,
+	               error );
+
+	if( write_count != (ssize_t) sizeof( vmdk_metadata_index_file_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file header data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close metadata index file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( grain_offsets_data != NULL )
+	{
+		memory_free(
+		 grain_offsets_data );
+	}
+	if( extent_records_data != NULL )
+	{
+		memory_free(
+		 extent_records_data );
+	}
+	return( -1 );
+}
+
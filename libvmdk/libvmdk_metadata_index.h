@@ -0,0 +1,140 @@
+/*
+ * Metadata index functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_METADATA_INDEX_H )
+#define _LIBVMDK_METADATA_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_extent_file.h"
+#include "libvmdk_extent_table.h"
+#include "libvmdk_grain_offsets_index.h"
+#include "libvmdk_grain_table.h"
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvmdk_metadata_index libvmdk_metadata_index_t;
+
+struct libvmdk_metadata_index
+{
+	/* The filename
+	 */
+	system_character_t *filename;
+
+	/* The filename size
+	 */
+	size_t filename_size;
+
+	/* The number of extents
+	 */
+	uint32_t number_of_extents;
+
+	/* The data
+	 * Contains the extent records and grain offsets that follow the file header
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+};
+
+int libvmdk_metadata_index_initialize(
+     libvmdk_metadata_index_t **metadata_index,
+     libcerror_error_t **error );
+
+int libvmdk_metadata_index_free(
+     libvmdk_metadata_index_t **metadata_index,
+     libcerror_error_t **error );
+
+int libvmdk_metadata_index_clear_data(
+     libvmdk_metadata_index_t *metadata_index,
+     libcerror_error_t **error );
+
+int libvmdk_metadata_index_set_filename(
+     libvmdk_metadata_index_t *metadata_index,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+int libvmdk_metadata_index_set_filename_wide(
+     libvmdk_metadata_index_t *metadata_index,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+int libvmdk_metadata_index_open_file(
+     libvmdk_metadata_index_t *metadata_index,
+     int access_flags,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error );
+
+int libvmdk_metadata_index_read_file_header_data(
+     libvmdk_metadata_index_t *metadata_index,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t content_identifier,
+     uint32_t parent_content_identifier,
+     int number_of_extents,
+     uint32_t *data_checksum,
+     libcerror_error_t **error );
+
+int libvmdk_metadata_index_read_file(
+     libvmdk_metadata_index_t *metadata_index,
+     uint32_t content_identifier,
+     uint32_t parent_content_identifier,
+     int number_of_extents,
+     libcerror_error_t **error );
+
+int libvmdk_metadata_index_get_grain_offsets_index(
+     libvmdk_metadata_index_t *metadata_index,
+     int extent_index,
+     libvmdk_extent_file_t *extent_file,
+     size64_t extent_file_size,
+     size64_t *storage_media_size,
+     libvmdk_grain_offsets_index_t **grain_offsets_index,
+     libcerror_error_t **error );
+
+int libvmdk_metadata_index_write_file(
+     libvmdk_metadata_index_t *metadata_index,
+     libvmdk_grain_table_t *grain_table,
+     libvmdk_extent_table_t *extent_table,
+     libbfio_pool_t *file_io_pool,
+     uint32_t content_identifier,
+     uint32_t parent_content_identifier,
+     int number_of_extents,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_METADATA_INDEX_H ) */
+
@@ -0,0 +1,924 @@
+/*
+ * Readahead functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvmdk_definitions.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcnotify.h"
+#include "libvmdk_libcthreads.h"
+#include "libvmdk_readahead.h"
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+
+/* Creates a readahead and starts its thread
+ * The readahead reads whole grains ahead of the caller into a staging area of maximum window size + 1 slots
+ * Make sure the value readahead is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_readahead_initialize(
+     libvmdk_readahead_t **readahead,
+     size_t grain_size,
+     uint64_t number_of_grains,
+     int maximum_window_size,
+     int (*read_grain_function)(
+            intptr_t *data,
+            uint64_t grain_index,
+            uint8_t *grain_data,
+            size_t grain_data_size,
+            libcerror_error_t **error ),
+     intptr_t *data,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_readahead_initialize";
+	int number_of_slots   = 0;
+
+	if( readahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid readahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *readahead != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid readahead value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( grain_size == 0 )
+	 || ( grain_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid grain size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_grains == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of grains value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_window_size <= 0 )
+	 || ( maximum_window_size > LIBVMDK_MAXIMUM_NUMBER_OF_READAHEAD_GRAINS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum window size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_grain_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read grain function.",
+		 function );
+
+		return( -1 );
+	}
+	/* The slot of the grain last read by the caller is not reused while a full window is read ahead
+	 */
+	number_of_slots = maximum_window_size + 1;
+
+	if( grain_size > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / (size_t) number_of_slots ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum window size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*readahead = memory_allocate_structure(
+	              libvmdk_readahead_t );
+
+	if( *readahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create readahead.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *readahead,
+	     0,
+	     sizeof( libvmdk_readahead_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear readahead.",
+		 function );
+
+		memory_free(
+		 *readahead );
+
+		*readahead = NULL;
+
+		return( -1 );
+	}
+	( *readahead )->slot_states = (uint8_t *) memory_allocate(
+	                                           sizeof( uint8_t ) * number_of_slots );
+
+	if( ( *readahead )->slot_states == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create slot states.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *readahead )->slot_states,
+	     LIBVMDK_READAHEAD_SLOT_STATE_EMPTY,
+	     sizeof( uint8_t ) * number_of_slots ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear slot states.",
+		 function );
+
+		goto on_error;
+	}
+	( *readahead )->slot_grain_indexes = (uint64_t *) memory_allocate(
+	                                                   sizeof( uint64_t ) * number_of_slots );
+
+	if( ( *readahead )->slot_grain_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create slot grain indexes.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *readahead )->slot_grain_indexes,
+	     0,
+	     sizeof( uint64_t ) * number_of_slots ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear slot grain indexes.",
+		 function );
+
+		goto on_error;
+	}
+	( *readahead )->slots_data = (uint8_t *) memory_allocate(
+	                                          grain_size * number_of_slots );
+
+	if( ( *readahead )->slots_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create slots data.",
+		 function );
+
+		goto on_error;
+	}
+	( *readahead )->grain_size          = grain_size;
+	( *readahead )->number_of_grains    = number_of_grains;
+	( *readahead )->number_of_slots     = number_of_slots;
+	( *readahead )->maximum_window_size = maximum_window_size;
+	( *readahead )->read_grain_function = read_grain_function;
+	( *readahead )->data                = data;
+
+	if( maximum_window_size < LIBVMDK_READAHEAD_MINIMUM_WINDOW_SIZE )
+	{
+		( *readahead )->window_size = maximum_window_size;
+	}
+	else
+	{
+		( *readahead )->window_size = LIBVMDK_READAHEAD_MINIMUM_WINDOW_SIZE;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *readahead )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *readahead )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_create(
+	     &( ( *readahead )->thread ),
+	     NULL,
+	     (int (*)(void *)) &libvmdk_readahead_thread_callback_function,
+	     (void *) *readahead,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create readahead thread.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *readahead != NULL )
+	{
+		if( ( *readahead )->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *readahead )->condition ),
+			 NULL );
+		}
+		if( ( *readahead )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *readahead )->mutex ),
+			 NULL );
+		}
+		if( ( *readahead )->slots_data != NULL )
+		{
+			memory_free(
+			 ( *readahead )->slots_data );
+		}
+		if( ( *readahead )->slot_grain_indexes != NULL )
+		{
+			memory_free(
+			 ( *readahead )->slot_grain_indexes );
+		}
+		if( ( *readahead )->slot_states != NULL )
+		{
+			memory_free(
+			 ( *readahead )->slot_states );
+		}
+		memory_free(
+		 *readahead );
+
+		*readahead = NULL;
+	}
+	return( -1 );
+}
+
+/* Stops the thread of a readahead and frees the readahead
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_readahead_free(
+     libvmdk_readahead_t **readahead,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_readahead_free";
+	int result            = 1;
+
+	if( readahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid readahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *readahead != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     ( *readahead )->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		( *readahead )->stop = 1;
+
+		if( libcthreads_condition_broadcast(
+		     ( *readahead )->condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_release(
+		     ( *readahead )->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+		/* The readahead cannot be freed while its thread is running
+		 */
+		if( result != 1 )
+		{
+			return( -1 );
+		}
+		if( libcthreads_thread_join(
+		     &( ( *readahead )->thread ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join readahead thread.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcthreads_condition_free(
+		     &( ( *readahead )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *readahead )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *readahead )->slots_data );
+
+		memory_free(
+		 ( *readahead )->slot_grain_indexes );
+
+		memory_free(
+		 ( *readahead )->slot_states );
+
+		memory_free(
+		 *readahead );
+
+		*readahead = NULL;
+	}
+	return( result );
+}
+
+/* Reads grains ahead of the caller until the readahead is stopped
+ * The mutex is not held while a grain is read, the slot of the grain is marked pending instead
+ * Errors are not returned to the caller, a grain that could not be read is left empty
+ * and is read again by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_readahead_thread_callback_function(
+     libvmdk_readahead_t *readahead )
+{
+	libcerror_error_t *error = NULL;
+	uint8_t *grain_data      = NULL;
+	static char *function    = "libvmdk_readahead_thread_callback_function";
+	uint64_t grain_index     = 0;
+	int result               = 0;
+	int slot_index           = 0;
+
+	if( readahead == NULL )
+	{
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     readahead->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	while( readahead->stop == 0 )
+	{
+		if( readahead->next_grain_index >= readahead->end_grain_index )
+		{
+			readahead->thread_is_idle = 1;
+
+			if( libcthreads_condition_wait(
+			     readahead->condition,
+			     readahead->mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 readahead->mutex,
+				 NULL );
+
+				goto on_error;
+			}
+			readahead->thread_is_idle = 0;
+
+			continue;
+		}
+		grain_index = readahead->next_grain_index;
+		slot_index  = (int) ( grain_index % readahead->number_of_slots );
+
+		readahead->next_grain_index += 1;
+
+		if( ( readahead->slot_grain_indexes[ slot_index ] == grain_index )
+		 && ( readahead->slot_states[ slot_index ] != LIBVMDK_READAHEAD_SLOT_STATE_EMPTY ) )
+		{
+			continue;
+		}
+		readahead->slot_grain_indexes[ slot_index ] = grain_index;
+		readahead->slot_states[ slot_index ]        = LIBVMDK_READAHEAD_SLOT_STATE_PENDING;
+
+		grain_data = &( readahead->slots_data[ slot_index * readahead->grain_size ] );
+
+		if( libcthreads_mutex_release(
+		     readahead->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		result = readahead->read_grain_function(
+		          readahead->data,
+		          grain_index,
+		          grain_data,
+		          readahead->grain_size,
+		          &error );
+
+		if( result == -1 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_print_error_backtrace(
+				 error );
+			}
+#endif
+			libcerror_error_free(
+			 &error );
+		}
+		if( libcthreads_mutex_grab(
+		     readahead->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( result == 1 )
+		{
+			readahead->slot_states[ slot_index ] = LIBVMDK_READAHEAD_SLOT_STATE_READY;
+		}
+		else if( result == 0 )
+		{
+			readahead->slot_states[ slot_index ] = LIBVMDK_READAHEAD_SLOT_STATE_UNAVAILABLE;
+		}
+		else
+		{
+			readahead->slot_states[ slot_index ] = LIBVMDK_READAHEAD_SLOT_STATE_EMPTY;
+		}
+		/* Wake up the caller if it is waiting for the grain
+		 */
+		if( libcthreads_condition_broadcast(
+		     readahead->condition,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 readahead->mutex,
+			 NULL );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     readahead->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Updates the readahead window after the caller has read a grain
+ * Sequential reads extend the grains to read ahead to a window beyond the grain, other reads stop the reading ahead.
+ * The window size doubles when the caller has caught up with the readahead thread and decreases by 1 grain
+ * when the thread is idle, so that the window follows the rate at which the caller reads the grains
+ * This function is not multi-thread safe acquire the mutex before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_readahead_update_window(
+     libvmdk_readahead_t *readahead,
+     uint64_t grain_index,
+     uint8_t caller_caught_up,
+     libcerror_error_t **error )
+{
+	static char *function    = "libvmdk_readahead_update_window";
+	uint64_t end_grain_index = 0;
+
+	if( readahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid readahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( readahead->last_grain_index_is_set != 0 )
+	 && ( grain_index == readahead->last_grain_index ) )
+	{
+		return( 1 );
+	}
+	if( ( readahead->last_grain_index_is_set != 0 )
+	 && ( grain_index == ( readahead->last_grain_index + 1 ) ) )
+	{
+		if( caller_caught_up != 0 )
+		{
+			if( readahead->window_size > ( readahead->maximum_window_size / 2 ) )
+			{
+				readahead->window_size = readahead->maximum_window_size;
+			}
+			else
+			{
+				readahead->window_size *= 2;
+			}
+		}
+		else if( ( readahead->thread_is_idle != 0 )
+		      && ( readahead->window_size > LIBVMDK_READAHEAD_MINIMUM_WINDOW_SIZE ) )
+		{
+			readahead->window_size -= 1;
+		}
+		end_grain_index = grain_index + 1 + (uint64_t) readahead->window_size;
+
+		if( end_grain_index > readahead->number_of_grains )
+		{
+			end_grain_index = readahead->number_of_grains;
+		}
+		if( readahead->next_grain_index <= grain_index )
+		{
+			readahead->next_grain_index = grain_index + 1;
+		}
+		if( readahead->end_grain_index < end_grain_index )
+		{
+			readahead->end_grain_index = end_grain_index;
+		}
+		if( readahead->next_grain_index < readahead->end_grain_index )
+		{
+			if( libcthreads_condition_broadcast(
+			     readahead->condition,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to broadcast condition.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	else
+	{
+		if( readahead->maximum_window_size < LIBVMDK_READAHEAD_MINIMUM_WINDOW_SIZE )
+		{
+			readahead->window_size = readahead->maximum_window_size;
+		}
+		else
+		{
+			readahead->window_size = LIBVMDK_READAHEAD_MINIMUM_WINDOW_SIZE;
+		}
+		readahead->next_grain_index = grain_index + 1;
+		readahead->end_grain_index  = grain_index + 1;
+	}
+	readahead->last_grain_index        = grain_index;
+	readahead->last_grain_index_is_set = 1;
+
+	return( 1 );
+}
+
+/* Reads (grain) data of a specific grain from the readahead into a buffer
+ * The caller waits if the readahead thread is reading the grain
+ * Every call updates the readahead window, hence this function must be called for every grain read
+ * Returns 1 if successful, 0 if the grain was not read ahead or -1 on error
+ */
+int libvmdk_readahead_read_grain_data(
+     libvmdk_readahead_t *readahead,
+     uint64_t grain_index,
+     size_t grain_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function    = "libvmdk_readahead_read_grain_data";
+	uint8_t caller_caught_up = 0;
+	int result               = 0;
+	int slot_index           = 0;
+
+	if( readahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid readahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_data_offset >= readahead->grain_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid grain data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > ( readahead->grain_size - grain_data_offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_index >= readahead->number_of_grains )
+	{
+		return( 0 );
+	}
+	if( libcthreads_mutex_grab(
+	     readahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	slot_index = (int) ( grain_index % readahead->number_of_slots );
+
+	if( readahead->slot_grain_indexes[ slot_index ] != grain_index )
+	{
+		caller_caught_up = 1;
+	}
+	else
+	{
+		while( ( readahead->slot_states[ slot_index ] == LIBVMDK_READAHEAD_SLOT_STATE_PENDING )
+		    && ( readahead->stop == 0 ) )
+		{
+			caller_caught_up = 1;
+
+			if( libcthreads_condition_wait(
+			     readahead->condition,
+			     readahead->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+		}
+		if( ( result != -1 )
+		 && ( readahead->slot_grain_indexes[ slot_index ] == grain_index ) )
+		{
+			if( readahead->slot_states[ slot_index ] == LIBVMDK_READAHEAD_SLOT_STATE_READY )
+			{
+				if( memory_copy(
+				     buffer,
+				     &( readahead->slots_data[ ( slot_index * readahead->grain_size ) + grain_data_offset ] ),
+				     buffer_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy grain data.",
+					 function );
+
+					result = -1;
+				}
+				else
+				{
+					result = 1;
+				}
+			}
+			else if( readahead->slot_states[ slot_index ] == LIBVMDK_READAHEAD_SLOT_STATE_EMPTY )
+			{
+				caller_caught_up = 1;
+			}
+		}
+	}
+	if( result != -1 )
+	{
+		if( libvmdk_readahead_update_window(
+		     readahead,
+		     grain_index,
+		     caller_caught_up,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update window.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     readahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,165 @@
+/*
+ * Readahead functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_READAHEAD_H )
+#define _LIBVMDK_READAHEAD_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+
+typedef struct libvmdk_readahead libvmdk_readahead_t;
+
+struct libvmdk_readahead
+{
+	/* The grain size
+	 */
+	size_t grain_size;
+
+	/* The number of (whole) grains that can be read ahead
+	 */
+	uint64_t number_of_grains;
+
+	/* The number of slots
+	 */
+	int number_of_slots;
+
+	/* The slot states
+	 */
+	uint8_t *slot_states;
+
+	/* The grain index of each slot
+	 */
+	uint64_t *slot_grain_indexes;
+
+	/* The slots data, which contains grain size bytes per slot
+	 */
+	uint8_t *slots_data;
+
+	/* The current window size in number of grains
+	 */
+	int window_size;
+
+	/* The maximum window size in number of grains
+	 */
+	int maximum_window_size;
+
+	/* The index of the last grain that was read by the caller
+	 */
+	uint64_t last_grain_index;
+
+	/* Value to indicate the last grain index is set
+	 */
+	uint8_t last_grain_index_is_set;
+
+	/* The index of the next grain to read ahead
+	 */
+	uint64_t next_grain_index;
+
+	/* The index of the grain after the last grain to read ahead
+	 */
+	uint64_t end_grain_index;
+
+	/* Value to indicate the readahead thread is waiting for work
+	 */
+	uint8_t thread_is_idle;
+
+	/* Value to indicate the readahead thread should stop
+	 */
+	uint8_t stop;
+
+	/* The read grain function
+	 */
+	int (*read_grain_function)(
+	       intptr_t *data,
+	       uint64_t grain_index,
+	       uint8_t *grain_data,
+	       size_t grain_data_size,
+	       libcerror_error_t **error );
+
+	/* The read grain function data
+	 */
+	intptr_t *data;
+
+	/* The mutex, protects the slots and the readahead state
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition, signalled when work is added, a slot changes state or the thread should stop
+	 */
+	libcthreads_condition_t *condition;
+
+	/* The readahead thread
+	 */
+	libcthreads_thread_t *thread;
+};
+
+int libvmdk_readahead_initialize(
+     libvmdk_readahead_t **readahead,
+     size_t grain_size,
+     uint64_t number_of_grains,
+     int maximum_window_size,
+     int (*read_grain_function)(
+            intptr_t *data,
+            uint64_t grain_index,
+            uint8_t *grain_data,
+            size_t grain_data_size,
+            libcerror_error_t **error ),
+     intptr_t *data,
+     libcerror_error_t **error );
+
+int libvmdk_readahead_free(
+     libvmdk_readahead_t **readahead,
+     libcerror_error_t **error );
+
+int libvmdk_readahead_thread_callback_function(
+     libvmdk_readahead_t *readahead );
+
+int libvmdk_readahead_update_window(
+     libvmdk_readahead_t *readahead,
+     uint64_t grain_index,
+     uint8_t caller_caught_up,
+     libcerror_error_t **error );
+
+int libvmdk_readahead_read_grain_data(
+     libvmdk_readahead_t *readahead,
+     uint64_t grain_index,
+     size_t grain_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_READAHEAD_H ) */
+
@@ -0,0 +1,429 @@
+/*
+ * Statistics functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvmdk_definitions.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcthreads.h"
+#include "libvmdk_statistics.h"
+
+#if defined( LIBVMDK_STATISTICS_HAVE_ATOMIC_VALUES ) && defined( __GNUC__ )
+#define libvmdk_statistics_value_add( value, addend ) \
+	__atomic_fetch_add( value, addend, __ATOMIC_RELAXED )
+
+#define libvmdk_statistics_value_get( value ) \
+	__atomic_load_n( value, __ATOMIC_RELAXED )
+
+#define libvmdk_statistics_value_set( value, new_value ) \
+	__atomic_store_n( value, new_value, __ATOMIC_RELAXED )
+
+#elif defined( LIBVMDK_STATISTICS_HAVE_ATOMIC_VALUES )
+#define libvmdk_statistics_value_add( value, addend ) \
+	InterlockedExchangeAdd64( (LONG64 volatile *) value, (LONG64) addend )
+
+#define libvmdk_statistics_value_get( value ) \
+	(uint64_t) InterlockedCompareExchange64( (LONG64 volatile *) value, 0, 0 )
+
+#define libvmdk_statistics_value_set( value, new_value ) \
+	InterlockedExchange64( (LONG64 volatile *) value, (LONG64) new_value )
+
+#else
+#define libvmdk_statistics_value_add( value, addend ) \
+	*( value ) += addend
+
+#define libvmdk_statistics_value_get( value ) \
+	*( value )
+
+#define libvmdk_statistics_value_set( value, new_value ) \
+	*( value ) = new_value
+
+#endif /* defined( LIBVMDK_STATISTICS_HAVE_ATOMIC_VALUES ) && defined( __GNUC__ ) */
+
+/* Creates statistics
+ * Make sure the value statistics is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_statistics_initialize(
+     libvmdk_statistics_t **statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_statistics_initialize";
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( *statistics != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid statistics value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*statistics = memory_allocate_structure(
+	               libvmdk_statistics_t );
+
+	if( *statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *statistics,
+	     0,
+	     sizeof( libvmdk_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear statistics.",
+		 function );
+
+		memory_free(
+		 *statistics );
+
+		*statistics = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) && !defined( LIBVMDK_STATISTICS_HAVE_ATOMIC_VALUES )
+	if( libcthreads_mutex_initialize(
+	     &( ( *statistics )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *statistics != NULL )
+	{
+		memory_free(
+		 *statistics );
+
+		*statistics = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_statistics_free(
+     libvmdk_statistics_t **statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_statistics_free";
+	int result            = 1;
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( *statistics != NULL )
+	{
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) && !defined( LIBVMDK_STATISTICS_HAVE_ATOMIC_VALUES )
+		if( libcthreads_mutex_free(
+		     &( ( *statistics )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *statistics );
+
+		*statistics = NULL;
+	}
+	return( result );
+}
+
+/* Sets all the statistics values to 0
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_statistics_clear(
+     libvmdk_statistics_t *statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_statistics_clear";
+	int statistic         = 0;
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) && !defined( LIBVMDK_STATISTICS_HAVE_ATOMIC_VALUES )
+	if( libcthreads_mutex_grab(
+	     statistics->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( statistic = 0;
+	     statistic < LIBVMDK_NUMBER_OF_STATISTICS;
+	     statistic++ )
+	{
+		libvmdk_statistics_value_set(
+		 &( statistics->values[ statistic ] ),
+		 0 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) && !defined( LIBVMDK_STATISTICS_HAVE_ATOMIC_VALUES )
+	if( libcthreads_mutex_release(
+	     statistics->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Adds a value to a specific statistic
+ * This function is multi-thread safe, the statistics are updated atomically if supported
+ * by the compiler, otherwise while holding their mutex
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_statistics_add(
+     libvmdk_statistics_t *statistics,
+     int statistic,
+     uint64_t value,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_statistics_add";
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( statistic < 0 )
+	 || ( statistic >= LIBVMDK_NUMBER_OF_STATISTICS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid statistic value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) && !defined( LIBVMDK_STATISTICS_HAVE_ATOMIC_VALUES )
+	if( libcthreads_mutex_grab(
+	     statistics->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	libvmdk_statistics_value_add(
+	 &( statistics->values[ statistic ] ),
+	 value );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) && !defined( LIBVMDK_STATISTICS_HAVE_ATOMIC_VALUES )
+	if( libcthreads_mutex_release(
+	     statistics->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the statistics values
+ * Values beyond the number of statistics are set to 0
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_statistics_get_values(
+     libvmdk_statistics_t *statistics,
+     uint64_t *values,
+     int number_of_values,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_statistics_get_values";
+	int value_index       = 0;
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid values.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_values <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of values value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) && !defined( LIBVMDK_STATISTICS_HAVE_ATOMIC_VALUES )
+	if( libcthreads_mutex_grab(
+	     statistics->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( value_index = 0;
+	     value_index < number_of_values;
+	     value_index++ )
+	{
+		if( value_index < LIBVMDK_NUMBER_OF_STATISTICS )
+		{
+			values[ value_index ] = libvmdk_statistics_value_get(
+			                         &( statistics->values[ value_index ] ) );
+		}
+		else
+		{
+			values[ value_index ] = 0;
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) && !defined( LIBVMDK_STATISTICS_HAVE_ATOMIC_VALUES )
+	if( libcthreads_mutex_release(
+	     statistics->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
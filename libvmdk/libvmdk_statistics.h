@@ -0,0 +1,86 @@
+/*
+ * Statistics functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_STATISTICS_H )
+#define _LIBVMDK_STATISTICS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_definitions.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The statistics values are updated without a mutex if the compiler provides atomic operations
+ */
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) && ( defined( __GNUC__ ) || defined( WINAPI ) )
+#define LIBVMDK_STATISTICS_HAVE_ATOMIC_VALUES	1
+#endif
+
+typedef struct libvmdk_statistics libvmdk_statistics_t;
+
+struct libvmdk_statistics
+{
+	/* The values
+	 */
+	uint64_t values[ LIBVMDK_NUMBER_OF_STATISTICS ];
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) && !defined( LIBVMDK_STATISTICS_HAVE_ATOMIC_VALUES )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libvmdk_statistics_initialize(
+     libvmdk_statistics_t **statistics,
+     libcerror_error_t **error );
+
+int libvmdk_statistics_free(
+     libvmdk_statistics_t **statistics,
+     libcerror_error_t **error );
+
+int libvmdk_statistics_clear(
+     libvmdk_statistics_t *statistics,
+     libcerror_error_t **error );
+
+int libvmdk_statistics_add(
+     libvmdk_statistics_t *statistics,
+     int statistic,
+     uint64_t value,
+     libcerror_error_t **error );
+
+int libvmdk_statistics_get_values(
+     libvmdk_statistics_t *statistics,
+     uint64_t *values,
+     int number_of_values,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_STATISTICS_H ) */
+
@@ -0,0 +1,1354 @@
+/*
+ * Stream reader functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvmdk_compression.h"
+#include "libvmdk_debug.h"
+#include "libvmdk_definitions.h"
+#include "libvmdk_extent_file.h"
+#include "libvmdk_io_handle.h"
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcnotify.h"
+#include "libvmdk_libcthreads.h"
+#include "libvmdk_stream_reader.h"
+
+#include "vmdk_sparse_file_header.h"
+
+/* Creates a stream reader
+ * Make sure the value stream_reader is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_stream_reader_initialize(
+     libvmdk_stream_reader_t **stream_reader,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_stream_reader_t *internal_stream_reader = NULL;
+	static char *function                                    = "libvmdk_stream_reader_initialize";
+
+	if( stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *stream_reader != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid stream reader value already set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream_reader = memory_allocate_structure(
+	                          libvmdk_internal_stream_reader_t );
+
+	if( internal_stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stream reader.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_stream_reader,
+	     0,
+	     sizeof( libvmdk_internal_stream_reader_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear stream reader.",
+		 function );
+
+		memory_free(
+		 internal_stream_reader );
+
+		return( -1 );
+	}
+	if( libvmdk_io_handle_initialize(
+	     &( internal_stream_reader->io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( internal_stream_reader->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	*stream_reader = (libvmdk_stream_reader_t *) internal_stream_reader;
+
+	return( 1 );
+
+on_error:
+	if( internal_stream_reader != NULL )
+	{
+		if( internal_stream_reader->io_handle != NULL )
+		{
+			libvmdk_io_handle_free(
+			 &( internal_stream_reader->io_handle ),
+			 NULL );
+		}
+		memory_free(
+		 internal_stream_reader );
+	}
+	return( -1 );
+}
+
+/* Frees a stream reader
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_stream_reader_free(
+     libvmdk_stream_reader_t **stream_reader,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_stream_reader_t *internal_stream_reader = NULL;
+	static char *function                                    = "libvmdk_stream_reader_free";
+	int result                                               = 1;
+
+	if( stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *stream_reader != NULL )
+	{
+		internal_stream_reader = (libvmdk_internal_stream_reader_t *) *stream_reader;
+
+		if( internal_stream_reader->file_io_handle != NULL )
+		{
+			if( libvmdk_stream_reader_close(
+			     *stream_reader,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close stream reader.",
+				 function );
+
+				result = -1;
+			}
+		}
+		*stream_reader = NULL;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( internal_stream_reader->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( libvmdk_io_handle_free(
+		     &( internal_stream_reader->io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free IO handle.",
+			 function );
+
+			result = -1;
+		}
+		if( internal_stream_reader->compressed_data != NULL )
+		{
+			memory_free(
+			 internal_stream_reader->compressed_data );
+		}
+		memory_free(
+		 internal_stream_reader );
+	}
+	return( result );
+}
+
+/* Opens a stream reader using a Basic File IO (bfio) handle
+ * The stream is read forward only from the current offset of the file IO handle
+ * and must start with the sparse file header of a streamOptimized extent file
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_stream_reader_open_file_io_handle(
+     libvmdk_stream_reader_t *stream_reader,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_stream_reader_t *internal_stream_reader = NULL;
+	static char *function                                    = "libvmdk_stream_reader_open_file_io_handle";
+	uint8_t file_io_handle_opened_in_library                 = 0;
+	int file_io_handle_is_open                               = 0;
+	int result                                               = 1;
+
+	if( stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream_reader = (libvmdk_internal_stream_reader_t *) stream_reader;
+
+	if( internal_stream_reader->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid stream reader - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          file_io_handle,
+	                          error );
+
+	if( file_io_handle_is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		return( -1 );
+	}
+	else if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_ACCESS_FLAG_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle.",
+			 function );
+
+			return( -1 );
+		}
+		file_io_handle_opened_in_library = 1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_stream_reader->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	internal_stream_reader->file_io_handle                   = file_io_handle;
+	internal_stream_reader->file_io_handle_opened_in_library = file_io_handle_opened_in_library;
+	internal_stream_reader->current_offset                   = 0;
+	internal_stream_reader->end_of_stream                    = 0;
+
+	if( libvmdk_internal_stream_reader_read_file_header(
+	     internal_stream_reader,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header.",
+		 function );
+
+		internal_stream_reader->file_io_handle                   = NULL;
+		internal_stream_reader->file_io_handle_opened_in_library = 0;
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_stream_reader->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( result != 1 )
+	 && ( file_io_handle_opened_in_library != 0 ) )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+	}
+	return( result );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+on_error:
+	if( file_io_handle_opened_in_library != 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+#endif
+}
+
+/* Closes a stream reader
+ * Returns 0 if successful or -1 on error
+ */
+int libvmdk_stream_reader_close(
+     libvmdk_stream_reader_t *stream_reader,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_stream_reader_t *internal_stream_reader = NULL;
+	static char *function                                    = "libvmdk_stream_reader_close";
+	int result                                               = 0;
+
+	if( stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream_reader = (libvmdk_internal_stream_reader_t *) stream_reader;
+
+	if( internal_stream_reader->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid stream reader - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_stream_reader->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_stream_reader->file_io_handle_opened_in_library != 0 )
+	{
+		if( libbfio_handle_close(
+		     internal_stream_reader->file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		internal_stream_reader->file_io_handle_opened_in_library = 0;
+	}
+	internal_stream_reader->file_io_handle = NULL;
+	internal_stream_reader->current_offset = 0;
+	internal_stream_reader->end_of_stream  = 0;
+
+	if( libvmdk_io_handle_clear(
+	     internal_stream_reader->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear IO handle.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_stream_reader->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads data from the stream
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_stream_reader_read_data(
+     libvmdk_internal_stream_reader_t *internal_stream_reader,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_internal_stream_reader_read_data";
+	ssize_t read_count    = 0;
+
+	if( internal_stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* The file IO handle is not seeked so the stream can be read from a pipe
+	 */
+	read_count = libbfio_handle_read_buffer(
+	              internal_stream_reader->file_io_handle,
+	              data,
+	              data_size,
+	              error );
+
+	if( read_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 internal_stream_reader->current_offset,
+		 internal_stream_reader->current_offset );
+
+		return( -1 );
+	}
+	internal_stream_reader->current_offset += (off64_t) data_size;
+
+	return( 1 );
+}
+
+/* Skips data in the stream
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_stream_reader_skip_data(
+     libvmdk_internal_stream_reader_t *internal_stream_reader,
+     size64_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_internal_stream_reader_skip_data";
+	size_t read_size      = 0;
+
+	if( internal_stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_size > 0 )
+	{
+		read_size = sizeof( internal_stream_reader->marker_data );
+
+		if( data_size < (size64_t) read_size )
+		{
+			read_size = (size_t) data_size;
+		}
+		if( libvmdk_internal_stream_reader_read_data(
+		     internal_stream_reader,
+		     internal_stream_reader->marker_data,
+		     read_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data.",
+			 function );
+
+			return( -1 );
+		}
+		data_size -= read_size;
+	}
+	return( 1 );
+}
+
+/* Reads the file header and skips the metadata up to the first marker
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_stream_reader_read_file_header(
+     libvmdk_internal_stream_reader_t *internal_stream_reader,
+     libcerror_error_t **error )
+{
+	libvmdk_extent_file_t *extent_file = NULL;
+	static char *function              = "libvmdk_internal_stream_reader_read_file_header";
+	uint64_t metadata_number_of_sectors = 0;
+
+	if( internal_stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_internal_stream_reader_read_data(
+	     internal_stream_reader,
+	     internal_stream_reader->marker_data,
+	     sizeof( vmdk_sparse_file_header_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_extent_file_initialize(
+	     &extent_file,
+	     internal_stream_reader->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create extent file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_extent_file_read_file_header_data(
+	     extent_file,
+	     internal_stream_reader->marker_data,
+	     sizeof( vmdk_sparse_file_header_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( extent_file->file_type != LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA )
+	 || ( ( extent_file->flags & LIBVMDK_FLAG_HAS_DATA_MARKERS ) == 0 )
+	 || ( extent_file->compression_method != LIBVMDK_COMPRESSION_METHOD_DEFLATE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported extent file - only compressed sparse data with markers is supported.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (vmdk_sparse_file_header_t *) internal_stream_reader->marker_data )->metadata_number_of_sectors,
+	 metadata_number_of_sectors );
+
+	if( ( metadata_number_of_sectors == 0 )
+	 || ( metadata_number_of_sectors > ( (uint64_t) INT64_MAX / 512 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid metadata number of sectors value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( extent_file->grain_size > (size64_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / 2 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid grain size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	internal_stream_reader->io_handle->file_type          = extent_file->file_type;
+	internal_stream_reader->io_handle->maximum_data_size  = extent_file->maximum_data_size;
+	internal_stream_reader->io_handle->media_size         = extent_file->maximum_data_size;
+	internal_stream_reader->io_handle->grain_size         = extent_file->grain_size;
+	internal_stream_reader->io_handle->compression_method = extent_file->compression_method;
+
+	if( libvmdk_extent_file_free(
+	     &extent_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free extent file.",
+		 function );
+
+		goto on_error;
+	}
+	/* Skip the descriptor and any other metadata that precedes the first marker
+	 */
+	if( libvmdk_internal_stream_reader_skip_data(
+	     internal_stream_reader,
+	     ( metadata_number_of_sectors * 512 ) - sizeof( vmdk_sparse_file_header_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to skip metadata.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( extent_file != NULL )
+	{
+		libvmdk_extent_file_free(
+		 &extent_file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the marker data
+ * The marker type is only set if the compressed data size is 0
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_stream_reader_read_marker_data(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t *marker_value,
+     uint32_t *compressed_data_size,
+     uint32_t *marker_type,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_stream_reader_read_marker_data";
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < 16 )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( marker_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid marker value.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( marker_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid marker type.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 &( data[ 0 ] ),
+	 *marker_value );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( data[ 8 ] ),
+	 *compressed_data_size );
+
+	if( *compressed_data_size == 0 )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( data[ 12 ] ),
+		 *marker_type );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: marker value\t\t\t: %" PRIu64 "\n",
+		 function,
+		 *marker_value );
+
+		libcnotify_printf(
+		 "%s: compressed data size\t\t: %" PRIu32 "\n",
+		 function,
+		 *compressed_data_size );
+
+		if( *compressed_data_size == 0 )
+		{
+			libcnotify_printf(
+			 "%s: marker type\t\t\t: %" PRIu32 " (%s)\n",
+			 function,
+			 *marker_type,
+			 libvmdk_debug_get_marker_description(
+			  *marker_type ) );
+		}
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+
+	return( 1 );
+}
+
+/* Reads the next grain from the stream
+ * The buffer must be able to hold at least grain size bytes
+ * Metadata markers, such as grain tables, grain directories and the footer, are skipped
+ * Returns the number of bytes read, 0 when the end of stream marker was read or -1 on error
+ */
+ssize_t libvmdk_stream_reader_read_grain(
+         libvmdk_stream_reader_t *stream_reader,
+         void *buffer,
+         size_t buffer_size,
+         off64_t *offset,
+         libcerror_error_t **error )
+{
+	libvmdk_internal_stream_reader_t *internal_stream_reader = NULL;
+	uint8_t *reallocation                                    = NULL;
+	static char *function                                    = "libvmdk_stream_reader_read_grain";
+	size_t compressed_data_buffer_size                       = 0;
+	size_t uncompressed_data_size                            = 0;
+	ssize_t read_count                                       = 0;
+	uint64_t marker_value                                    = 0;
+	uint32_t compressed_data_size                            = 0;
+	uint32_t marker_type                                     = 0;
+
+	if( stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream_reader = (libvmdk_internal_stream_reader_t *) stream_reader;
+
+	if( internal_stream_reader->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid stream reader - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_stream_reader->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid stream reader - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size < (size_t) internal_stream_reader->io_handle->grain_size )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_stream_reader->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	while( internal_stream_reader->end_of_stream == 0 )
+	{
+		if( libvmdk_internal_stream_reader_read_data(
+		     internal_stream_reader,
+		     internal_stream_reader->marker_data,
+		     512,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read marker data.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_stream_reader_read_marker_data(
+		     internal_stream_reader->marker_data,
+		     512,
+		     &marker_value,
+		     &compressed_data_size,
+		     &marker_type,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read marker.",
+			 function );
+
+			goto on_error;
+		}
+		if( compressed_data_size != 0 )
+		{
+			break;
+		}
+		if( marker_type == LIBVMDK_MARKER_END_OF_STREAM )
+		{
+			internal_stream_reader->end_of_stream = 1;
+		}
+		else if( ( marker_type == LIBVMDK_MARKER_GRAIN_TABLE )
+		      || ( marker_type == LIBVMDK_MARKER_GRAIN_DIRECTORY )
+		      || ( marker_type == LIBVMDK_MARKER_FOOTER ) )
+		{
+			/* The marker value contains the number of sectors of metadata that follow the marker
+			 */
+			if( marker_value > ( (uint64_t) INT64_MAX / 512 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid marker value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			if( libvmdk_internal_stream_reader_skip_data(
+			     internal_stream_reader,
+			     (size64_t) marker_value * 512,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to skip marker: %" PRIu32 " data.",
+				 function,
+				 marker_type );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported marker type: %" PRIu32 ".",
+			 function,
+			 marker_type );
+
+			goto on_error;
+		}
+	}
+	if( internal_stream_reader->end_of_stream == 0 )
+	{
+		/* The marker value contains the grain sector number and the grain is padded to a sector boundary
+		 */
+		if( ( (size64_t) compressed_data_size > ( 2 * internal_stream_reader->io_handle->grain_size ) )
+		 || ( marker_value > ( (uint64_t) INT64_MAX / 512 ) )
+		 || ( ( marker_value * 512 ) >= internal_stream_reader->io_handle->media_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid grain marker value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		compressed_data_buffer_size = ( ( (size_t) compressed_data_size + 12 + 511 ) / 512 ) * 512 - 12;
+
+		if( compressed_data_buffer_size > internal_stream_reader->compressed_data_size )
+		{
+			reallocation = (uint8_t *) memory_reallocate(
+			                            internal_stream_reader->compressed_data,
+			                            sizeof( uint8_t ) * compressed_data_buffer_size );
+
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize compressed data.",
+				 function );
+
+				goto on_error;
+			}
+			internal_stream_reader->compressed_data      = reallocation;
+			internal_stream_reader->compressed_data_size = compressed_data_buffer_size;
+		}
+		if( memory_copy(
+		     internal_stream_reader->compressed_data,
+		     &( internal_stream_reader->marker_data[ 12 ] ),
+		     500 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy compressed data.",
+			 function );
+
+			goto on_error;
+		}
+		if( compressed_data_buffer_size > 500 )
+		{
+			if( libvmdk_internal_stream_reader_read_data(
+			     internal_stream_reader,
+			     &( internal_stream_reader->compressed_data[ 500 ] ),
+			     compressed_data_buffer_size - 500,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read compressed grain data.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		uncompressed_data_size = (size_t) internal_stream_reader->io_handle->grain_size;
+
+		if( libvmdk_decompress_data(
+		     internal_stream_reader->compressed_data,
+		     (size_t) compressed_data_size,
+		     internal_stream_reader->io_handle->compression_method,
+		     (uint8_t *) buffer,
+		     &uncompressed_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress grain data.",
+			 function );
+
+			goto on_error;
+		}
+		*offset    = (off64_t) ( marker_value * 512 );
+		read_count = (ssize_t) uncompressed_data_size;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_stream_reader->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+
+on_error:
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_stream_reader->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the grain size
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_stream_reader_get_grain_size(
+     libvmdk_stream_reader_t *stream_reader,
+     size64_t *grain_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_stream_reader_t *internal_stream_reader = NULL;
+	static char *function                                    = "libvmdk_stream_reader_get_grain_size";
+
+	if( stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream_reader = (libvmdk_internal_stream_reader_t *) stream_reader;
+
+	if( internal_stream_reader->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid stream reader - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_stream_reader->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*grain_size = internal_stream_reader->io_handle->grain_size;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_stream_reader->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the media size
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_stream_reader_get_media_size(
+     libvmdk_stream_reader_t *stream_reader,
+     size64_t *media_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_stream_reader_t *internal_stream_reader = NULL;
+	static char *function                                    = "libvmdk_stream_reader_get_media_size";
+
+	if( stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream_reader = (libvmdk_internal_stream_reader_t *) stream_reader;
+
+	if( internal_stream_reader->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid stream reader - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_stream_reader->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*media_size = internal_stream_reader->io_handle->media_size;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_stream_reader->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
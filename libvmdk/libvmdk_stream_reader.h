@@ -0,0 +1,151 @@
+/*
+ * Stream reader functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_STREAM_READER_H )
+#define _LIBVMDK_STREAM_READER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_extern.h"
+#include "libvmdk_io_handle.h"
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcthreads.h"
+#include "libvmdk_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvmdk_internal_stream_reader libvmdk_internal_stream_reader_t;
+
+struct libvmdk_internal_stream_reader
+{
+	/* The IO handle
+	 */
+	libvmdk_io_handle_t *io_handle;
+
+	/* The file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* Value to indicate if the file IO handle was opened inside the library
+	 */
+	uint8_t file_io_handle_opened_in_library;
+
+	/* The current offset in the stream
+	 */
+	off64_t current_offset;
+
+	/* The marker data
+	 */
+	uint8_t marker_data[ 512 ];
+
+	/* The compressed data
+	 */
+	uint8_t *compressed_data;
+
+	/* The compressed data size
+	 */
+	size_t compressed_data_size;
+
+	/* Value to indicate the end of stream marker was read
+	 */
+	uint8_t end_of_stream;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+LIBVMDK_EXTERN \
+int libvmdk_stream_reader_initialize(
+     libvmdk_stream_reader_t **stream_reader,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_stream_reader_free(
+     libvmdk_stream_reader_t **stream_reader,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_stream_reader_open_file_io_handle(
+     libvmdk_stream_reader_t *stream_reader,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_stream_reader_close(
+     libvmdk_stream_reader_t *stream_reader,
+     libcerror_error_t **error );
+
+int libvmdk_internal_stream_reader_read_data(
+     libvmdk_internal_stream_reader_t *internal_stream_reader,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libvmdk_internal_stream_reader_skip_data(
+     libvmdk_internal_stream_reader_t *internal_stream_reader,
+     size64_t data_size,
+     libcerror_error_t **error );
+
+int libvmdk_internal_stream_reader_read_file_header(
+     libvmdk_internal_stream_reader_t *internal_stream_reader,
+     libcerror_error_t **error );
+
+int libvmdk_stream_reader_read_marker_data(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t *marker_value,
+     uint32_t *compressed_data_size,
+     uint32_t *marker_type,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+ssize_t libvmdk_stream_reader_read_grain(
+     libvmdk_stream_reader_t *stream_reader,
+     void *buffer,
+     size_t buffer_size,
+     off64_t *offset,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_stream_reader_get_grain_size(
+     libvmdk_stream_reader_t *stream_reader,
+     size64_t *grain_size,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_stream_reader_get_media_size(
+     libvmdk_stream_reader_t *stream_reader,
+     size64_t *media_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_STREAM_READER_H ) */
+
@@ -0,0 +1,836 @@
+/*
+ * Trace functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if !defined( WINAPI )
+#include <time.h>
+#endif
+
+#if defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#endif
+
+#include "libvmdk_definitions.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcthreads.h"
+#include "libvmdk_trace.h"
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) && defined( __GNUC__ )
+#define libvmdk_trace_value_get( value ) \
+	__atomic_load_n( value, __ATOMIC_RELAXED )
+
+#define libvmdk_trace_value_set( value, new_value ) \
+	__atomic_store_n( value, new_value, __ATOMIC_RELAXED )
+
+#elif defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) && defined( WINAPI )
+#define libvmdk_trace_value_get( value ) \
+	(uint32_t) InterlockedCompareExchange( (LONG volatile *) value, 0, 0 )
+
+#define libvmdk_trace_value_set( value, new_value ) \
+	InterlockedExchange( (LONG volatile *) value, (LONG) new_value )
+
+#else
+#define libvmdk_trace_value_get( value ) \
+	*( value )
+
+#define libvmdk_trace_value_set( value, new_value ) \
+	*( value ) = new_value
+
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) && defined( __GNUC__ ) */
+
+/* Creates a trace
+ * Make sure the value trace is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_trace_initialize(
+     libvmdk_trace_t **trace,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_trace_initialize";
+
+	if( trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( *trace != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid trace value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*trace = memory_allocate_structure(
+	          libvmdk_trace_t );
+
+	if( *trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create trace.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *trace,
+	     0,
+	     sizeof( libvmdk_trace_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear trace.",
+		 function );
+
+		memory_free(
+		 *trace );
+
+		*trace = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *trace )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *trace != NULL )
+	{
+		memory_free(
+		 *trace );
+
+		*trace = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a trace
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_trace_free(
+     libvmdk_trace_t **trace,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_trace_free";
+	int result            = 1;
+
+	if( trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( *trace != NULL )
+	{
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *trace )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *trace );
+
+		*trace = NULL;
+	}
+	return( result );
+}
+
+/* Sets all the buckets of the latency histograms to 0
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_trace_clear_latency_histograms(
+     libvmdk_trace_t *trace,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_trace_clear_latency_histograms";
+	int result            = 1;
+
+	if( trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     trace->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( memory_set(
+	     trace->latency_histograms,
+	     0,
+	     sizeof( uint64_t ) * LIBVMDK_NUMBER_OF_TRACE_EVENTS * LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear latency histograms.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     trace->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the callback function
+ * The callback function is called after every trace event, with the start timestamp
+ * and duration of the event in nanoseconds, and can be called from multiple threads
+ * A callback function of NULL removes the callback function
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_trace_set_callback(
+     libvmdk_trace_t *trace,
+     void (*callback)(
+            int trace_event,
+            uint64_t start_timestamp,
+            uint64_t duration,
+            void *callback_data ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_trace_set_callback";
+
+	if( trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     trace->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	trace->callback      = callback;
+	trace->callback_data = callback_data;
+
+	if( ( trace->callback != NULL )
+	 || ( trace->use_latency_histograms != 0 ) )
+	{
+		libvmdk_trace_value_set(
+		 &( trace->is_enabled ),
+		 1 );
+	}
+	else
+	{
+		libvmdk_trace_value_set(
+		 &( trace->is_enabled ),
+		 0 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     trace->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the value to indicate the latency histograms should be used
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_trace_get_use_latency_histograms(
+     libvmdk_trace_t *trace,
+     uint8_t *use_latency_histograms,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_trace_get_use_latency_histograms";
+
+	if( trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( use_latency_histograms == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid use latency histograms.",
+		 function );
+
+		return( -1 );
+	}
+	*use_latency_histograms = trace->use_latency_histograms;
+
+	return( 1 );
+}
+
+/* Sets the value to indicate the latency histograms should be used
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_trace_set_use_latency_histograms(
+     libvmdk_trace_t *trace,
+     uint8_t use_latency_histograms,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_trace_set_use_latency_histograms";
+
+	if( trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     trace->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( use_latency_histograms != 0 )
+	{
+		trace->use_latency_histograms = 1;
+	}
+	else
+	{
+		trace->use_latency_histograms = 0;
+	}
+	if( ( trace->callback != NULL )
+	 || ( trace->use_latency_histograms != 0 ) )
+	{
+		libvmdk_trace_value_set(
+		 &( trace->is_enabled ),
+		 1 );
+	}
+	else
+	{
+		libvmdk_trace_value_set(
+		 &( trace->is_enabled ),
+		 0 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     trace->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the current timestamp in nanoseconds
+ * A monotonic clock is used if available, otherwise the wall clock
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_trace_get_timestamp(
+     uint64_t *timestamp,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+#elif defined( HAVE_CLOCK_GETTIME )
+	struct timespec time_structure;
+
+#elif defined( HAVE_GETTIMEOFDAY )
+	struct timeval time_structure;
+
+#elif defined( HAVE_TIME )
+	time_t time_value = 0;
+#endif
+
+	static char *function = "libvmdk_trace_get_timestamp";
+
+	if( timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( QueryPerformanceCounter(
+	       &counter ) == 0 )
+	 || ( frequency.QuadPart <= 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve performance counter.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) ( counter.QuadPart / frequency.QuadPart ) * 1000000000 )
+	           + ( (uint64_t) ( counter.QuadPart % frequency.QuadPart ) * 1000000000 / (uint64_t) frequency.QuadPart );
+
+#elif defined( HAVE_CLOCK_GETTIME )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve monotonic clock time.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) time_structure.tv_sec * 1000000000 ) + (uint64_t) time_structure.tv_nsec;
+
+#elif defined( HAVE_GETTIMEOFDAY )
+	/* Fall back to the wall clock time when there is no monotonic clock
+	 */
+	if( gettimeofday(
+	     &time_structure,
+	     NULL ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve time of day.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) time_structure.tv_sec * 1000000000 ) + ( (uint64_t) time_structure.tv_usec * 1000 );
+
+#elif defined( HAVE_TIME )
+	/* Fall back to the wall clock time in seconds
+	 */
+	time_value = time(
+	              NULL );
+
+	if( time_value == (time_t) -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve time.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = (uint64_t) time_value * 1000000000;
+
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: no timestamp available.",
+	 function );
+
+	return( -1 );
+
+#endif
+	return( 1 );
+}
+
+/* Determines the latency histogram bucket of a duration in nanoseconds
+ * Returns the bucket index
+ */
+int libvmdk_trace_get_latency_histogram_bucket_index(
+     uint64_t duration )
+{
+	int bucket_index = 0;
+
+	while( ( duration > 1 )
+	    && ( bucket_index < ( LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS - 1 ) ) )
+	{
+		duration    >>= 1;
+		bucket_index += 1;
+	}
+	return( bucket_index );
+}
+
+/* Starts a trace event
+ * Tracing is best-effort, the event is not traced if the trace is not enabled
+ * or the start timestamp cannot be retrieved
+ * Returns 1 if the event is traced or 0 if not
+ */
+int libvmdk_trace_start_event(
+     libvmdk_trace_t *trace,
+     uint64_t *start_timestamp )
+{
+	if( ( trace == NULL )
+	 || ( start_timestamp == NULL ) )
+	{
+		return( 0 );
+	}
+	if( libvmdk_trace_value_get(
+	     &( trace->is_enabled ) ) == 0 )
+	{
+		return( 0 );
+	}
+	if( libvmdk_trace_get_timestamp(
+	     start_timestamp,
+	     NULL ) != 1 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Records a trace event that started at a specific timestamp and ends now
+ * The callback function is called without holding the mutex
+ * The event is not recorded if the end timestamp cannot be retrieved
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_trace_record_event(
+     libvmdk_trace_t *trace,
+     int trace_event,
+     uint64_t start_timestamp,
+     libcerror_error_t **error )
+{
+	void (*callback)(
+	       int trace_event,
+	       uint64_t start_timestamp,
+	       uint64_t duration,
+	       void *callback_data ) = NULL;
+
+	void *callback_data    = NULL;
+	static char *function  = "libvmdk_trace_record_event";
+	uint64_t duration      = 0;
+	uint64_t end_timestamp = 0;
+	int bucket_index       = 0;
+
+	if( trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( trace_event < 0 )
+	 || ( trace_event >= LIBVMDK_NUMBER_OF_TRACE_EVENTS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid trace event value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_trace_get_timestamp(
+	     &end_timestamp,
+	     NULL ) != 1 )
+	{
+		return( 1 );
+	}
+	if( end_timestamp > start_timestamp )
+	{
+		duration = end_timestamp - start_timestamp;
+	}
+	bucket_index = libvmdk_trace_get_latency_histogram_bucket_index(
+	                duration );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     trace->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( trace->use_latency_histograms != 0 )
+	{
+		trace->latency_histograms[ trace_event ][ bucket_index ] += 1;
+	}
+	callback      = trace->callback;
+	callback_data = trace->callback_data;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     trace->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( callback != NULL )
+	{
+		callback(
+		 trace_event,
+		 start_timestamp,
+		 duration,
+		 callback_data );
+	}
+	return( 1 );
+}
+
+/* Retrieves the latency histogram of a specific trace event
+ * Buckets beyond the number of latency histogram buckets are set to 0
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_trace_get_latency_histogram(
+     libvmdk_trace_t *trace,
+     int trace_event,
+     uint64_t *buckets,
+     int number_of_buckets,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_trace_get_latency_histogram";
+	int bucket_index      = 0;
+
+	if( trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( trace_event < 0 )
+	 || ( trace_event >= LIBVMDK_NUMBER_OF_TRACE_EVENTS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid trace event value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buckets.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buckets <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of buckets value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     trace->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( bucket_index = 0;
+	     bucket_index < number_of_buckets;
+	     bucket_index++ )
+	{
+		if( bucket_index < LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS )
+		{
+			buckets[ bucket_index ] = trace->latency_histograms[ trace_event ][ bucket_index ];
+		}
+		else
+		{
+			buckets[ bucket_index ] = 0;
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     trace->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
@@ -0,0 +1,134 @@
+/*
+ * Trace functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_TRACE_H )
+#define _LIBVMDK_TRACE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_definitions.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvmdk_trace libvmdk_trace_t;
+
+struct libvmdk_trace
+{
+	/* Value to indicate the trace is enabled
+	 * The trace is enabled when the callback is set or the latency histograms are used
+	 * The value is read without holding the mutex, hence it is accessed atomically
+	 */
+	uint32_t is_enabled;
+
+	/* Value to indicate the latency histograms should be used
+	 */
+	uint8_t use_latency_histograms;
+
+	/* The callback function
+	 */
+	void (*callback)(
+	       int trace_event,
+	       uint64_t start_timestamp,
+	       uint64_t duration,
+	       void *callback_data );
+
+	/* The callback data
+	 */
+	void *callback_data;
+
+	/* The latency histograms per trace event
+	 */
+	uint64_t latency_histograms[ LIBVMDK_NUMBER_OF_TRACE_EVENTS ][ LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS ];
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libvmdk_trace_initialize(
+     libvmdk_trace_t **trace,
+     libcerror_error_t **error );
+
+int libvmdk_trace_free(
+     libvmdk_trace_t **trace,
+     libcerror_error_t **error );
+
+int libvmdk_trace_clear_latency_histograms(
+     libvmdk_trace_t *trace,
+     libcerror_error_t **error );
+
+int libvmdk_trace_set_callback(
+     libvmdk_trace_t *trace,
+     void (*callback)(
+            int trace_event,
+            uint64_t start_timestamp,
+            uint64_t duration,
+            void *callback_data ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+int libvmdk_trace_get_use_latency_histograms(
+     libvmdk_trace_t *trace,
+     uint8_t *use_latency_histograms,
+     libcerror_error_t **error );
+
+int libvmdk_trace_set_use_latency_histograms(
+     libvmdk_trace_t *trace,
+     uint8_t use_latency_histograms,
+     libcerror_error_t **error );
+
+int libvmdk_trace_get_timestamp(
+     uint64_t *timestamp,
+     libcerror_error_t **error );
+
+int libvmdk_trace_get_latency_histogram_bucket_index(
+     uint64_t duration );
+
+int libvmdk_trace_start_event(
+     libvmdk_trace_t *trace,
+     uint64_t *start_timestamp );
+
+int libvmdk_trace_record_event(
+     libvmdk_trace_t *trace,
+     int trace_event,
+     uint64_t start_timestamp,
+     libcerror_error_t **error );
+
+int libvmdk_trace_get_latency_histogram(
+     libvmdk_trace_t *trace,
+     int trace_event,
+     uint64_t *buckets,
+     int number_of_buckets,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_TRACE_H ) */
+
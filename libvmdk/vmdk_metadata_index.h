@@ -0,0 +1,138 @@
+/*
+ * The metadata index file definitions of libvmdk
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _VMDK_METADATA_INDEX_H )
+#define _VMDK_METADATA_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct vmdk_metadata_index_file_header vmdk_metadata_index_file_header_t;
+
+struct vmdk_metadata_index_file_header
+{
+	/* The signature
+	 * Consists of 8 bytes
+	 * Contains: "VMDKMIDX"
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The format version
+	 * Consists of 4 bytes
+	 */
+	uint8_t format_version[ 4 ];
+
+	/* The number of extents
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_extents[ 4 ];
+
+	/* The content identifier
+	 * Consists of 4 bytes
+	 */
+	uint8_t content_identifier[ 4 ];
+
+	/* The parent content identifier
+	 * Consists of 4 bytes
+	 */
+	uint8_t parent_content_identifier[ 4 ];
+
+	/* The data size
+	 * Consists of 8 bytes
+	 * Contains the size of the extent records and grain offsets
+	 * that follow the file header
+	 */
+	uint8_t data_size[ 8 ];
+
+	/* The data checksum
+	 * Consists of 4 bytes
+	 * Contains an Adler-32 of the data that follows the file header
+	 */
+	uint8_t data_checksum[ 4 ];
+
+	/* Unknown (reserved)
+	 * Consists of 28 bytes
+	 */
+	uint8_t unknown1[ 28 ];
+};
+
+typedef struct vmdk_metadata_index_extent_record vmdk_metadata_index_extent_record_t;
+
+struct vmdk_metadata_index_extent_record
+{
+	/* The extent file size
+	 * Consists of 8 bytes
+	 */
+	uint8_t extent_file_size[ 8 ];
+
+	/* The storage media size
+	 * Consists of 8 bytes
+	 */
+	uint8_t storage_media_size[ 8 ];
+
+	/* The grain size
+	 * Consists of 8 bytes
+	 * Contains a value in bytes, 0 if the extent is not sparse
+	 */
+	uint8_t grain_size[ 8 ];
+
+	/* The grain offsets offset
+	 * Consists of 8 bytes
+	 * Contains the offset of the grain offsets relative to the start of the file
+	 */
+	uint8_t grain_offsets_offset[ 8 ];
+
+	/* The number of grain directory entries
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_grain_directory_entries[ 4 ];
+
+	/* The number of grain table entries
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_grain_table_entries[ 4 ];
+
+	/* The extent file flags
+	 * Consists of 4 bytes
+	 */
+	uint8_t flags[ 4 ];
+
+	/* Unknown (reserved)
+	 * Consists of 4 bytes
+	 */
+	uint8_t unknown1[ 4 ];
+};
+
+/* The grain offsets of an extent consist of a 32-bit little-endian sector number
+ * per grain, where 0 represents a sparse grain, for every grain table entry of
+ * every grain directory entry
+ */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _VMDK_METADATA_INDEX_H ) */
+
@@ -160,6 +160,13 @@ PyMethodDef pyvmdk_handle_object_methods[] = {
 	  "\n"
 	  "Retrieves the current offset within the data." },
 
+	{ "get_statistics",
+	  (PyCFunction) pyvmdk_handle_get_statistics,
+	  METH_NOARGS,
+	  "get_statistics() -> Dictionary\n"
+	  "\n"
+	  "Retrieves the statistics of reading the media data since the handle was opened." },
+
 	/* Functions to access the metadata */
 
 	{ "get_disk_type",
@@ -1636,6 +1643,119 @@ PyObject *pyvmdk_handle_get_offset(
 	return( integer_object );
 }
 
+/* Retrieves the statistics of reading the media data
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvmdk_handle_get_statistics(
+           pyvmdk_handle_t *pyvmdk_handle,
+           PyObject *arguments PYVMDK_ATTRIBUTE_UNUSED )
+{
+	uint64_t statistics[ LIBVMDK_NUMBER_OF_STATISTICS ];
+
+	static char *statistic_names[ LIBVMDK_NUMBER_OF_STATISTICS ] = {
+		"bytes_read",
+		"sparse_grains_read",
+		"grains_decompressed",
+		"compressed_bytes_decompressed",
+		"grain_tables_read",
+		"grain_cache_hits",
+		"grain_cache_misses",
+		"grain_table_cache_hits",
+		"grain_table_cache_misses",
+		"seeks",
+		"reads" };
+
+	libcerror_error_t *error    = NULL;
+	PyObject *dictionary_object = NULL;
+	PyObject *integer_object    = NULL;
+	static char *function       = "pyvmdk_handle_get_statistics";
+	int result                  = 0;
+	int statistic_index         = 0;
+
+	PYVMDK_UNREFERENCED_PARAMETER( arguments )
+
+	if( pyvmdk_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libvmdk_handle_get_statistics(
+	          pyvmdk_handle->handle,
+	          statistics,
+	          LIBVMDK_NUMBER_OF_STATISTICS,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyvmdk_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve statistics.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	dictionary_object = PyDict_New();
+
+	if( dictionary_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create dictionary object.",
+		 function );
+
+		goto on_error;
+	}
+	for( statistic_index = 0;
+	     statistic_index < LIBVMDK_NUMBER_OF_STATISTICS;
+	     statistic_index++ )
+	{
+		integer_object = pyvmdk_integer_unsigned_new_from_64bit(
+		                  statistics[ statistic_index ] );
+
+		if( integer_object == NULL )
+		{
+			goto on_error;
+		}
+		if( PyDict_SetItemString(
+		     dictionary_object,
+		     statistic_names[ statistic_index ],
+		     integer_object ) != 0 )
+		{
+			goto on_error;
+		}
+		Py_DecRef(
+		 integer_object );
+
+		integer_object = NULL;
+	}
+	return( dictionary_object );
+
+on_error:
+	if( integer_object != NULL )
+	{
+		Py_DecRef(
+		 integer_object );
+	}
+	if( dictionary_object != NULL )
+	{
+		Py_DecRef(
+		 dictionary_object );
+	}
+	return( NULL );
+}
+
 /* Retrieves the disk type
  * Returns a Python object if successful or NULL on error
  */
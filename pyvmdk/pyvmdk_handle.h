@@ -131,6 +131,10 @@ PyObject *pyvmdk_handle_get_offset(
            pyvmdk_handle_t *pyvmdk_handle,
            PyObject *arguments );
 
+PyObject *pyvmdk_handle_get_statistics(
+           pyvmdk_handle_t *pyvmdk_handle,
+           PyObject *arguments );
+
 PyObject *pyvmdk_handle_get_disk_type(
            pyvmdk_handle_t *pyvmdk_handle,
            PyObject *arguments );
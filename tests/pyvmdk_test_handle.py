@@ -390,6 +390,26 @@ class HandleTypeTests(unittest.TestCase):
 
     vmdk_handle.close()
 
+  def test_get_statistics(self):
+    """Tests the get_statistics function."""
+    test_source = getattr(unittest, "source", None)
+    if not test_source:
+      raise unittest.SkipTest("missing source")
+
+    vmdk_handle = pyvmdk.handle()
+
+    vmdk_handle.open(test_source)
+    vmdk_handle.open_extent_data_files()
+
+    media_size = vmdk_handle.get_media_size()
+    data = vmdk_handle.read_buffer(size=min(media_size, 4096))
+
+    statistics = vmdk_handle.get_statistics()
+    self.assertIsNotNone(statistics)
+    self.assertEqual(statistics["bytes_read"], len(data))
+
+    vmdk_handle.close()
+
   def test_get_disk_type(self):
     """Tests the get_disk_type function and disk_type property."""
     test_source = getattr(unittest, "source", None)
@@ -7,7 +7,7 @@ EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
 EXIT_IGNORE=77;
 
-LIBRARY_TESTS="bit_stream compression deflate descriptor_file error extent_descriptor extent_file extent_table extent_values grain_data grain_group grain_table huffman_tree io_handle notify system_string";
+LIBRARY_TESTS="bit_stream cache_budget compression deflate descriptor_file error extent_descriptor extent_file extent_table extent_values grain_cache grain_data grain_group grain_offsets_index grain_table huffman_tree io_handle layer_map metadata_index notify readahead statistics stream_reader system_string trace";
 LIBRARY_TESTS_WITH_INPUT="handle support";
 OPTION_SETS=();
 
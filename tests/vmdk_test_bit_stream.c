@@ -435,10 +435,10 @@ int vmdk_test_bit_stream_get_value(
 	 bit_stream->byte_stream_offset,
 	 (size_t) 0 );
 
-	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
 	 "bit_stream->bit_buffer",
 	 bit_stream->bit_buffer,
-	 (uint32_t) 0x00000000UL );
+	 (uint64_t) 0x0000000000000000ULL );
 
 	VMDK_TEST_ASSERT_EQUAL_UINT8(
 	 "bit_stream->bit_buffer_size",
@@ -468,17 +468,17 @@ int vmdk_test_bit_stream_get_value(
 	VMDK_TEST_ASSERT_EQUAL_SIZE(
 	 "bit_stream->byte_stream_offset",
 	 bit_stream->byte_stream_offset,
-	 (size_t) 1 );
+	 (size_t) 8 );
 
-	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
 	 "bit_stream->bit_buffer",
 	 bit_stream->bit_buffer,
-	 (uint32_t) 0x00000007UL );
+	 (uint64_t) 0x0b8db8f6d59bdda7ULL );
 
 	VMDK_TEST_ASSERT_EQUAL_UINT8(
 	 "bit_stream->bit_buffer_size",
 	 bit_stream->bit_buffer_size,
-	 (uint8_t) 4 );
+	 (uint8_t) 60 );
 
 	result = libvmdk_bit_stream_get_value(
 	          bit_stream,
@@ -503,17 +503,17 @@ int vmdk_test_bit_stream_get_value(
 	VMDK_TEST_ASSERT_EQUAL_SIZE(
 	 "bit_stream->byte_stream_offset",
 	 bit_stream->byte_stream_offset,
-	 (size_t) 2 );
+	 (size_t) 8 );
 
-	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
 	 "bit_stream->bit_buffer",
 	 bit_stream->bit_buffer,
-	 (uint32_t) 0x00000000UL );
+	 (uint64_t) 0x0000b8db8f6d59bdULL );
 
 	VMDK_TEST_ASSERT_EQUAL_UINT8(
 	 "bit_stream->bit_buffer_size",
 	 bit_stream->bit_buffer_size,
-	 (uint8_t) 0 );
+	 (uint8_t) 48 );
 
 	result = libvmdk_bit_stream_get_value(
 	          bit_stream,
@@ -538,17 +538,17 @@ int vmdk_test_bit_stream_get_value(
 	VMDK_TEST_ASSERT_EQUAL_SIZE(
 	 "bit_stream->byte_stream_offset",
 	 bit_stream->byte_stream_offset,
-	 (size_t) 6 );
+	 (size_t) 8 );
 
-	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
 	 "bit_stream->bit_buffer",
 	 bit_stream->bit_buffer,
-	 (uint32_t) 0x00000000UL );
+	 (uint64_t) 0x000000000000b8dbULL );
 
 	VMDK_TEST_ASSERT_EQUAL_UINT8(
 	 "bit_stream->bit_buffer_size",
 	 bit_stream->bit_buffer_size,
-	 (uint8_t) 0 );
+	 (uint8_t) 16 );
 
 	/* Test error cases
 	 */
@@ -656,6 +656,259 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvmdk_bit_stream_peek_value and libvmdk_bit_stream_skip_bits functions
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_bit_stream_peek_value(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libvmdk_bit_stream_t *bit_stream = NULL;
+	uint32_t value_32bit             = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_bit_stream_initialize(
+	          &bit_stream,
+	          vmdk_test_bit_stream_data,
+	          16,
+	          0,
+	          LIBVMDK_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_bit_stream_peek_value(
+	          bit_stream,
+	          4,
+	          &value_32bit,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 0x00000008UL );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "bit_stream->bit_buffer_size",
+	 bit_stream->bit_buffer_size,
+	 (uint8_t) 64 );
+
+	result = libvmdk_bit_stream_peek_value(
+	          bit_stream,
+	          12,
+	          &value_32bit,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 0x00000a78UL );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_bit_stream_skip_bits(
+	          bit_stream,
+	          4,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_bit_stream_get_value(
+	          bit_stream,
+	          12,
+	          &value_32bit,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 0x00000da7UL );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_bit_stream_peek_value(
+	          NULL,
+	          4,
+	          &value_32bit,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_bit_stream_peek_value(
+	          bit_stream,
+	          64,
+	          &value_32bit,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_bit_stream_peek_value(
+	          bit_stream,
+	          4,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_bit_stream_skip_bits(
+	          NULL,
+	          4,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_bit_stream_skip_bits(
+	          bit_stream,
+	          bit_stream->bit_buffer_size + 1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test skipping 0 bits of a full bit buffer
+	 */
+	bit_stream->storage_type    = LIBVMDK_BIT_STREAM_STORAGE_TYPE_BYTE_FRONT_TO_BACK;
+	bit_stream->bit_buffer      = 0xffffffffffffffffULL;
+	bit_stream->bit_buffer_size = 64;
+
+	result = libvmdk_bit_stream_skip_bits(
+	          bit_stream,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "bit_stream->bit_buffer",
+	 bit_stream->bit_buffer,
+	 (uint64_t) 0xffffffffffffffffULL );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libvmdk_bit_stream_free(
+	          &bit_stream,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( bit_stream != NULL )
+	{
+		libvmdk_bit_stream_free(
+		 &bit_stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
 
 /* The main program
@@ -695,6 +948,10 @@ int main(
 	 "libvmdk_bit_stream_get_value",
 	 vmdk_test_bit_stream_get_value );
 
+	VMDK_TEST_RUN(
+	 "libvmdk_bit_stream_peek_value",
+	 vmdk_test_bit_stream_peek_value );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
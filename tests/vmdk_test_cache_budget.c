@@ -0,0 +1,995 @@
+/*
+ * Library cache_budget type test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_memory.h"
+#include "vmdk_test_unused.h"
+
+#include "../libvmdk/libvmdk_definitions.h"
+#include "../libvmdk/libvmdk_cache_budget.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+/* Tests the libvmdk_cache_budget_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_cache_budget_initialize(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libvmdk_cache_budget_t *cache_budget = NULL;
+	int result                           = 0;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+	int number_of_malloc_fail_tests      = 1;
+	int number_of_memset_fail_tests      = 1;
+	int test_number                      = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvmdk_cache_budget_initialize(
+	          &cache_budget,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "cache_budget",
+	 cache_budget );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "cache_budget->number_of_grains_cache_entries",
+	 cache_budget->number_of_grains_cache_entries,
+	 LIBVMDK_MAXIMUM_CACHE_ENTRIES_GRAINS );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "cache_budget->number_of_grain_groups_cache_entries",
+	 cache_budget->number_of_grain_groups_cache_entries,
+	 LIBVMDK_MAXIMUM_CACHE_ENTRIES_GRAIN_GROUPS );
+
+	result = libvmdk_cache_budget_free(
+	          &cache_budget,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "cache_budget",
+	 cache_budget );
+
+	/* Test error cases
+	 */
+	result = libvmdk_cache_budget_initialize(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	cache_budget = (libvmdk_cache_budget_t *) 0x12345678UL;
+
+	result = libvmdk_cache_budget_initialize(
+	          &cache_budget,
+	          &error );
+
+	cache_budget = NULL;
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_cache_budget_initialize with malloc failing
+		 */
+		vmdk_test_malloc_attempts_before_fail = test_number;
+
+		result = libvmdk_cache_budget_initialize(
+		          &cache_budget,
+		          &error );
+
+		if( vmdk_test_malloc_attempts_before_fail != -1 )
+		{
+			vmdk_test_malloc_attempts_before_fail = -1;
+
+			if( cache_budget != NULL )
+			{
+				libvmdk_cache_budget_free(
+				 &cache_budget,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "cache_budget",
+			 cache_budget );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_cache_budget_initialize with memset failing
+		 */
+		vmdk_test_memset_attempts_before_fail = test_number;
+
+		result = libvmdk_cache_budget_initialize(
+		          &cache_budget,
+		          &error );
+
+		if( vmdk_test_memset_attempts_before_fail != -1 )
+		{
+			vmdk_test_memset_attempts_before_fail = -1;
+
+			if( cache_budget != NULL )
+			{
+				libvmdk_cache_budget_free(
+				 &cache_budget,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "cache_budget",
+			 cache_budget );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache_budget != NULL )
+	{
+		libvmdk_cache_budget_free(
+		 &cache_budget,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_cache_budget_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_cache_budget_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_cache_budget_free(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_cache_budget_set_maximum_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_cache_budget_set_maximum_size(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libvmdk_cache_budget_t *cache_budget = NULL;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_cache_budget_initialize(
+	          &cache_budget,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "cache_budget",
+	 cache_budget );
+
+	result = libvmdk_cache_budget_set_entry_sizes(
+	          cache_budget,
+	          65536,
+	          32768,
+	          2,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_cache_budget_set_maximum_size(
+	          cache_budget,
+	          16 * 1024 * 1024,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "cache_budget->number_of_grains_cache_entries",
+	 cache_budget->number_of_grains_cache_entries,
+	 128 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "cache_budget->number_of_grain_groups_cache_entries",
+	 cache_budget->number_of_grain_groups_cache_entries,
+	 128 );
+
+	/* Test the number of cache entries is bounded
+	 */
+	result = libvmdk_cache_budget_set_maximum_size(
+	          cache_budget,
+	          1024,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "cache_budget->number_of_grains_cache_entries",
+	 cache_budget->number_of_grains_cache_entries,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "cache_budget->number_of_grain_groups_cache_entries",
+	 cache_budget->number_of_grain_groups_cache_entries,
+	 1 );
+
+	/* Test a maximum size of 0 restores the default number of cache entries
+	 */
+	result = libvmdk_cache_budget_set_maximum_size(
+	          cache_budget,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "cache_budget->number_of_grains_cache_entries",
+	 cache_budget->number_of_grains_cache_entries,
+	 LIBVMDK_MAXIMUM_CACHE_ENTRIES_GRAINS );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "cache_budget->number_of_grain_groups_cache_entries",
+	 cache_budget->number_of_grain_groups_cache_entries,
+	 LIBVMDK_MAXIMUM_CACHE_ENTRIES_GRAIN_GROUPS );
+
+	/* Test error cases
+	 */
+	result = libvmdk_cache_budget_set_maximum_size(
+	          NULL,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_cache_budget_set_entry_sizes(
+	          cache_budget,
+	          65536,
+	          32768,
+	          -1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_cache_budget_free(
+	          &cache_budget,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "cache_budget",
+	 cache_budget );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache_budget != NULL )
+	{
+		libvmdk_cache_budget_free(
+		 &cache_budget,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_cache_budget_balance function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_cache_budget_balance(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libvmdk_cache_budget_t *cache_budget = NULL;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_cache_budget_initialize(
+	          &cache_budget,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "cache_budget",
+	 cache_budget );
+
+	result = libvmdk_cache_budget_set_entry_sizes(
+	          cache_budget,
+	          65536,
+	          32768,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_cache_budget_set_maximum_size(
+	          cache_budget,
+	          16 * 1024 * 1024,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_cache_budget_balance(
+	          cache_budget,
+	          100,
+	          100,
+	          100,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test the grains cache gets a larger share when it misses more often
+	 * for consecutive balance intervals
+	 */
+	result = libvmdk_cache_budget_balance(
+	          cache_budget,
+	          1024,
+	          600,
+	          1024,
+	          10,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "cache_budget->grains_share",
+	 cache_budget->grains_share,
+	 LIBVMDK_CACHE_BUDGET_DEFAULT_GRAINS_SHARE );
+
+	result = libvmdk_cache_budget_balance(
+	          cache_budget,
+	          2048,
+	          1200,
+	          2048,
+	          20,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "cache_budget->grains_share",
+	 cache_budget->grains_share,
+	 LIBVMDK_CACHE_BUDGET_DEFAULT_GRAINS_SHARE + 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "cache_budget->number_of_grains_cache_entries",
+	 cache_budget->number_of_grains_cache_entries,
+	 144 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "cache_budget->number_of_grain_groups_cache_entries",
+	 cache_budget->number_of_grain_groups_cache_entries,
+	 224 );
+
+	/* Test the misses are weighted by the entry size, without weighting
+	 * the grain groups caches would be favoured
+	 */
+	result = libvmdk_cache_budget_balance(
+	          cache_budget,
+	          3072,
+	          1400,
+	          3072,
+	          520,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "cache_budget->pending_share_move",
+	 cache_budget->pending_share_move,
+	 0 );
+
+	/* Test the grain groups caches get a larger share when they miss more often
+	 * for consecutive balance intervals
+	 */
+	result = libvmdk_cache_budget_balance(
+	          cache_budget,
+	          4096,
+	          1410,
+	          4096,
+	          1120,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_cache_budget_balance(
+	          cache_budget,
+	          5120,
+	          1420,
+	          5120,
+	          1720,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "cache_budget->grains_share",
+	 cache_budget->grains_share,
+	 LIBVMDK_CACHE_BUDGET_DEFAULT_GRAINS_SHARE );
+
+	/* Test the counters restarting resets the balance
+	 */
+	result = libvmdk_cache_budget_balance(
+	          cache_budget,
+	          0,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "cache_budget->last_number_of_grain_lookups",
+	 (uint64_t) cache_budget->last_number_of_grain_lookups,
+	 (uint64_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_cache_budget_balance(
+	          NULL,
+	          0,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_cache_budget_free(
+	          &cache_budget,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "cache_budget",
+	 cache_budget );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache_budget != NULL )
+	{
+		libvmdk_cache_budget_free(
+		 &cache_budget,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_cache_budget_get_cache_sizes function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_cache_budget_get_cache_sizes(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libvmdk_cache_budget_t *cache_budget = NULL;
+	size64_t grain_groups_cache_size     = 0;
+	size64_t grains_cache_size           = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_cache_budget_initialize(
+	          &cache_budget,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "cache_budget",
+	 cache_budget );
+
+	result = libvmdk_cache_budget_set_entry_sizes(
+	          cache_budget,
+	          65536,
+	          32768,
+	          2,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_cache_budget_set_maximum_size(
+	          cache_budget,
+	          16 * 1024 * 1024,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_cache_budget_get_cache_sizes(
+	          cache_budget,
+	          &grain_groups_cache_size,
+	          &grains_cache_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "grain_groups_cache_size",
+	 (uint64_t) grain_groups_cache_size,
+	 (uint64_t) 8 * 1024 * 1024 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "grains_cache_size",
+	 (uint64_t) grains_cache_size,
+	 (uint64_t) 8 * 1024 * 1024 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_cache_budget_get_cache_sizes(
+	          NULL,
+	          &grain_groups_cache_size,
+	          &grains_cache_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_cache_budget_get_cache_sizes(
+	          cache_budget,
+	          NULL,
+	          &grains_cache_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_cache_budget_get_cache_sizes(
+	          cache_budget,
+	          &grain_groups_cache_size,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_cache_budget_free(
+	          &cache_budget,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "cache_budget",
+	 cache_budget );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache_budget != NULL )
+	{
+		libvmdk_cache_budget_free(
+		 &cache_budget,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_cache_budget_initialize",
+	 vmdk_test_cache_budget_initialize );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_cache_budget_free",
+	 vmdk_test_cache_budget_free );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_cache_budget_set_maximum_size",
+	 vmdk_test_cache_budget_set_maximum_size );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_cache_budget_balance",
+	 vmdk_test_cache_budget_balance );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_cache_budget_get_cache_sizes",
+	 vmdk_test_cache_budget_get_cache_sizes );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+}
+
@@ -867,6 +867,405 @@ on_error:
 	return( 0 );
 }
 
+/* Decompression function that counts the number of times it is called
+ * Returns 1 if successful or -1 on error
+ */
+int vmdk_test_compression_decompression_function(
+     const uint8_t *compressed_data,
+     size_t compressed_data_size VMDK_TEST_ATTRIBUTE_UNUSED,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     void *user_data )
+{
+	int *number_of_calls = (int *) user_data;
+
+	VMDK_TEST_UNREFERENCED_PARAMETER( compressed_data_size )
+
+	if( ( compressed_data == NULL )
+	 || ( uncompressed_data == NULL )
+	 || ( uncompressed_data_size == NULL )
+	 || ( number_of_calls == NULL ) )
+	{
+		return( -1 );
+	}
+	*number_of_calls += 1;
+
+	*uncompressed_data_size = 0;
+
+	return( 1 );
+}
+
+/* Tests the libvmdk_get_decompression_backend and libvmdk_set_decompression_backend functions
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_set_decompression_backend(
+     void )
+{
+	uint8_t uncompressed_data[ 8192 ];
+
+	libcerror_error_t *error      = NULL;
+	size_t uncompressed_data_size = 0;
+	int backend                   = 0;
+	int default_backend           = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_get_decompression_backend(
+	          &default_backend,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_set_decompression_backend(
+	          LIBVMDK_DECOMPRESSION_BACKEND_BUILTIN,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_get_decompression_backend(
+	          &backend,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "backend",
+	 backend,
+	 LIBVMDK_DECOMPRESSION_BACKEND_BUILTIN );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	uncompressed_data_size = 8192;
+
+	result = libvmdk_decompress_data(
+	          vmdk_test_compression_deflate_compressed_data1,
+	          2627,
+	          LIBVMDK_COMPRESSION_METHOD_DEFLATE,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_set_decompression_backend(
+	          LIBVMDK_DECOMPRESSION_BACKEND_AUTO_DETECT,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_get_decompression_backend(
+	          &backend,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	 "backend",
+	 backend,
+	 LIBVMDK_DECOMPRESSION_BACKEND_AUTO_DETECT );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_get_decompression_backend(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_set_decompression_backend(
+	          LIBVMDK_DECOMPRESSION_BACKEND_USER_DEFINED,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_set_decompression_backend(
+	          default_backend,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	libvmdk_set_decompression_backend(
+	 default_backend,
+	 NULL );
+
+	return( 0 );
+}
+
+/* Tests the libvmdk_set_decompression_function function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_set_decompression_function(
+     void )
+{
+	uint8_t uncompressed_data[ 8192 ];
+
+	libcerror_error_t *error      = NULL;
+	size_t uncompressed_data_size = 0;
+	int backend                   = 0;
+	int default_backend           = 0;
+	int number_of_calls           = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_get_decompression_backend(
+	          &default_backend,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_set_decompression_function(
+	          &vmdk_test_compression_decompression_function,
+	          &number_of_calls,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_get_decompression_backend(
+	          &backend,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "backend",
+	 backend,
+	 LIBVMDK_DECOMPRESSION_BACKEND_USER_DEFINED );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	uncompressed_data_size = 8192;
+
+	result = libvmdk_decompress_data(
+	          vmdk_test_compression_deflate_compressed_data1,
+	          2627,
+	          LIBVMDK_COMPRESSION_METHOD_DEFLATE,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "number_of_calls",
+	 number_of_calls,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_data_size",
+	 uncompressed_data_size,
+	 (size_t) 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test decompression function failing
+	 */
+	result = libvmdk_set_decompression_function(
+	          &vmdk_test_compression_decompression_function,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	uncompressed_data_size = 8192;
+
+	result = libvmdk_decompress_data(
+	          vmdk_test_compression_deflate_compressed_data1,
+	          2627,
+	          LIBVMDK_COMPRESSION_METHOD_DEFLATE,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test restoring the default backend
+	 */
+	result = libvmdk_set_decompression_function(
+	          NULL,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_get_decompression_backend(
+	          &backend,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	 "backend",
+	 backend,
+	 LIBVMDK_DECOMPRESSION_BACKEND_USER_DEFINED );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libvmdk_set_decompression_backend(
+	          default_backend,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	libvmdk_set_decompression_backend(
+	 default_backend,
+	 NULL );
+
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
 
 /* The main program
@@ -890,6 +1289,14 @@ int main(
 	 "libvmdk_decompress_data",
 	 vmdk_test_decompress_data );
 
+	VMDK_TEST_RUN(
+	 "libvmdk_set_decompression_backend",
+	 vmdk_test_set_decompression_backend );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_set_decompression_function",
+	 vmdk_test_set_decompression_function );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
@@ -689,6 +689,19 @@ uint8_t vmdk_test_deflate_uncompressed_data[ 7640 ] = {
 	0x72, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x74, 0x68, 0x65, 0x0a, 0x4c, 0x69,
 	0x62, 0x72, 0x61, 0x72, 0x79, 0x2e, 0x0a, 0x0a };
 
+/* Fixed Huffman compressed data with matches at a distance of 1, a distance smaller
+ * than the match size and a distance larger than the match size
+ */
+uint8_t vmdk_test_deflate_matches_compressed_data[ 25 ] = {
+	0x4b, 0x4c, 0x4a, 0x4e, 0x49, 0x4d, 0x4b, 0xcf, 0xc8, 0xcc, 0xca, 0xce, 0xc9, 0xcd, 0xcb, 0x2f,
+	0x80, 0x23, 0x5c, 0x2c, 0xb0, 0x3a, 0x04, 0x00, 0x00 };
+
+uint8_t vmdk_test_deflate_matches_uncompressed_data[ 64 ] = {
+	0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f, 0x70,
+	0x6e, 0x6f, 0x70, 0x6e, 0x6f, 0x70, 0x6e, 0x6f, 0x70, 0x70, 0x6e, 0x6f, 0x70, 0x6e, 0x6f, 0x70,
+	0x6e, 0x6f, 0x70, 0x70, 0x6e, 0x6f, 0x70, 0x6e, 0x6f, 0x70, 0x6e, 0x6f, 0x70, 0x70, 0x6e, 0x6f,
+	0x70, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6e, 0x6e, 0x6e, 0x6e, 0x6e, 0x6e, 0x6e, 0x6e, 0x6e, 0x6e };
+
 #if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
 
 /* Tests the libvmdk_deflate_build_dynamic_huffman_trees function
@@ -1247,6 +1260,172 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvmdk_deflate_fixed_huffman_literals_tree and libvmdk_deflate_fixed_huffman_distances_tree
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_deflate_fixed_huffman_trees(
+     void )
+{
+	libvmdk_huffman_tree_t *distances_tree = NULL;
+	libvmdk_huffman_tree_t *literals_tree  = NULL;
+	libcerror_error_t *error               = NULL;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_huffman_tree_initialize(
+	          &literals_tree,
+	          288,
+	          libvmdk_deflate_fixed_huffman_literals_tree.maximum_code_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "literals_tree",
+	 literals_tree );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_huffman_tree_initialize(
+	          &distances_tree,
+	          30,
+	          libvmdk_deflate_fixed_huffman_distances_tree.maximum_code_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "distances_tree",
+	 distances_tree );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_deflate_build_fixed_huffman_trees(
+	          literals_tree,
+	          distances_tree,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "libvmdk_deflate_fixed_huffman_literals_tree.lookup_table_bits",
+	 libvmdk_deflate_fixed_huffman_literals_tree.lookup_table_bits,
+	 literals_tree->lookup_table_bits );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "libvmdk_deflate_fixed_huffman_literals_tree.number_of_lookup_table_entries",
+	 libvmdk_deflate_fixed_huffman_literals_tree.number_of_lookup_table_entries,
+	 literals_tree->number_of_lookup_table_entries );
+
+	result = memory_compare(
+	          libvmdk_deflate_fixed_huffman_literals_tree.lookup_table,
+	          literals_tree->lookup_table,
+	          sizeof( uint32_t ) * literals_tree->number_of_lookup_table_entries );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "libvmdk_deflate_fixed_huffman_distances_tree.lookup_table_bits",
+	 libvmdk_deflate_fixed_huffman_distances_tree.lookup_table_bits,
+	 distances_tree->lookup_table_bits );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "libvmdk_deflate_fixed_huffman_distances_tree.number_of_lookup_table_entries",
+	 libvmdk_deflate_fixed_huffman_distances_tree.number_of_lookup_table_entries,
+	 distances_tree->number_of_lookup_table_entries );
+
+	result = memory_compare(
+	          libvmdk_deflate_fixed_huffman_distances_tree.lookup_table,
+	          distances_tree->lookup_table,
+	          sizeof( uint32_t ) * distances_tree->number_of_lookup_table_entries );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Clean up
+	 */
+	result = libvmdk_huffman_tree_free(
+	          &distances_tree,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "distances_tree",
+	 distances_tree );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_huffman_tree_free(
+	          &literals_tree,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "literals_tree",
+	 literals_tree );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( distances_tree != NULL )
+	{
+		libvmdk_huffman_tree_free(
+		 &distances_tree,
+		 NULL );
+	}
+	if( literals_tree != NULL )
+	{
+		libvmdk_huffman_tree_free(
+		 &literals_tree,
+		 NULL );
+	}
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libvmdk_deflate_decode_huffman function
  * Returns 1 if successful or 0 if not
  */
@@ -1769,6 +1948,203 @@ on_error:
 	return( 0 );
 }
 
+#if defined( LIBVMDK_DEFLATE_HAVE_X86_SIMD )
+
+/* Tests the libvmdk_deflate_calculate_adler32_sse2, libvmdk_deflate_calculate_adler32_ssse3
+ * and libvmdk_deflate_calculate_adler32_avx2 functions against libvmdk_deflate_calculate_adler32_scalar
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_deflate_calculate_adler32_simd(
+     void )
+{
+	int (*calculate_adler32_functions[ 3 ])( uint32_t *, const uint8_t *, size_t, uint32_t, libcerror_error_t ** ) = {
+		libvmdk_deflate_calculate_adler32_sse2,
+		libvmdk_deflate_calculate_adler32_ssse3,
+		libvmdk_deflate_calculate_adler32_avx2 };
+
+	uint8_t data[ 16384 ];
+
+	int cpu_feature_flags[ 3 ] = {
+		LIBVMDK_DEFLATE_CPU_FEATURE_SSE2,
+		LIBVMDK_DEFLATE_CPU_FEATURE_SSSE3,
+		LIBVMDK_DEFLATE_CPU_FEATURE_AVX2 };
+
+	size_t data_sizes[ 13 ] = {
+		0, 1, 15, 16, 17, 31, 32, 33, 100, 5551, 5552, 5553, 7636 };
+
+	uint32_t initial_values[ 2 ] = {
+		1, 0xfff0fff0UL };
+
+	libcerror_error_t *error     = NULL;
+	uint32_t checksum            = 0;
+	uint32_t expected_checksum   = 0;
+	int cpu_features             = 0;
+	int data_size_index          = 0;
+	int function_index           = 0;
+	int initial_value_index      = 0;
+	int result                   = 0;
+
+	cpu_features = libvmdk_deflate_get_cpu_features();
+
+	result = memory_set(
+	          data,
+	          0xff,
+	          16384 ) != NULL;
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	for( function_index = 0;
+	     function_index < 3;
+	     function_index++ )
+	{
+		if( ( cpu_features & cpu_feature_flags[ function_index ] ) == 0 )
+		{
+			continue;
+		}
+		for( initial_value_index = 0;
+		     initial_value_index < 2;
+		     initial_value_index++ )
+		{
+			/* Test regular cases
+			 */
+			for( data_size_index = 0;
+			     data_size_index < 13;
+			     data_size_index++ )
+			{
+				/* Use an unaligned start of the data
+				 */
+				result = libvmdk_deflate_calculate_adler32_scalar(
+				          &expected_checksum,
+				          &( vmdk_test_deflate_uncompressed_data[ 3 ] ),
+				          data_sizes[ data_size_index ],
+				          initial_values[ initial_value_index ],
+				          &error );
+
+				VMDK_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				VMDK_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				result = calculate_adler32_functions[ function_index ](
+				          &checksum,
+				          &( vmdk_test_deflate_uncompressed_data[ 3 ] ),
+				          data_sizes[ data_size_index ],
+				          initial_values[ initial_value_index ],
+				          &error );
+
+				VMDK_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				VMDK_TEST_ASSERT_EQUAL_UINT32(
+				 "checksum",
+				 checksum,
+				 expected_checksum );
+
+				VMDK_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+			}
+			/* Test the maximum byte values to detect overflows of the sums
+			 */
+			result = libvmdk_deflate_calculate_adler32_scalar(
+			          &expected_checksum,
+			          data,
+			          16384,
+			          initial_values[ initial_value_index ],
+			          &error );
+
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = calculate_adler32_functions[ function_index ](
+			          &checksum,
+			          data,
+			          16384,
+			          initial_values[ initial_value_index ],
+			          &error );
+
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VMDK_TEST_ASSERT_EQUAL_UINT32(
+			 "checksum",
+			 checksum,
+			 expected_checksum );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		/* Test error cases
+		 */
+		result = calculate_adler32_functions[ function_index ](
+		          NULL,
+		          data,
+		          16384,
+		          1,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = calculate_adler32_functions[ function_index ](
+		          &checksum,
+		          NULL,
+		          16384,
+		          1,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( LIBVMDK_DEFLATE_HAVE_X86_SIMD ) */
+
 /* Tests the libvmdk_deflate_read_data_header function
  * Returns 1 if successful or 0 if not
  */
@@ -2464,6 +2840,43 @@ int vmdk_test_deflate_decompress(
 	 "error",
 	 error );
 
+	/* Test regular cases with overlapping matches
+	 */
+	uncompressed_data_size = 64;
+
+	result = libvmdk_deflate_decompress(
+	          vmdk_test_deflate_matches_compressed_data,
+	          25,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_data_size",
+	 uncompressed_data_size,
+	 (size_t) 64 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          uncompressed_data,
+	          vmdk_test_deflate_matches_uncompressed_data,
+	          64 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	uncompressed_data_size = 7640;
+
 /* TODO: test uncompressed data too small */
 
 	/* Test error cases
@@ -2716,6 +3129,10 @@ int main(
 	 "libvmdk_deflate_build_fixed_huffman_trees",
 	 vmdk_test_deflate_build_fixed_huffman_trees );
 
+	VMDK_TEST_RUN(
+	 "libvmdk_deflate_fixed_huffman_trees",
+	 vmdk_test_deflate_fixed_huffman_trees );
+
 	VMDK_TEST_RUN(
 	 "libvmdk_deflate_decode_huffman",
 	 vmdk_test_deflate_decode_huffman );
@@ -2724,6 +3141,14 @@ int main(
 	 "libvmdk_deflate_calculate_adler32",
 	 vmdk_test_deflate_calculate_adler32 );
 
+#if defined( LIBVMDK_DEFLATE_HAVE_X86_SIMD )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_deflate_calculate_adler32_simd",
+	 vmdk_test_deflate_calculate_adler32_simd );
+
+#endif /* defined( LIBVMDK_DEFLATE_HAVE_X86_SIMD ) */
+
 	VMDK_TEST_RUN(
 	 "libvmdk_deflate_read_data_header",
 	 vmdk_test_deflate_read_data_header );
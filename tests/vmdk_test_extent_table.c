@@ -2084,6 +2084,455 @@ on_error:
 
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
+/* Tests the libvmdk_extent_table_get_extent_index_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_extent_table_get_extent_index_at_offset(
+     void )
+{
+	size64_t extent_sizes[ 3 ]             = { 8192, 8192, 4096 };
+	libcerror_error_t *error               = NULL;
+	libvmdk_extent_table_t *extent_table   = NULL;
+	libvmdk_extent_values_t *extent_values = NULL;
+	libvmdk_io_handle_t *io_handle         = NULL;
+	off64_t extent_data_offset             = 0;
+	int extent_index                       = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_initialize(
+	          &extent_table,
+	          io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "extent_table",
+	 extent_table );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_initialize_extents(
+	          extent_table,
+	          3,
+	          LIBVMDK_DISK_TYPE_SPARSE_2GB_EXTENT,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_values_initialize(
+	          &extent_values,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "extent_values",
+	 extent_values );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	extent_values->type = LIBVMDK_EXTENT_TYPE_SPARSE;
+
+	for( extent_index = 0;
+	     extent_index < 3;
+	     extent_index++ )
+	{
+		result = libvmdk_extent_table_set_extent_by_extent_values(
+		          extent_table,
+		          extent_values,
+		          extent_index,
+		          extent_index,
+		          65536,
+		          0,
+		          extent_sizes[ extent_index ],
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          0,
+	          &extent_index,
+	          &extent_data_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test regular cases with extents of a uniform size
+	 */
+	result = libvmdk_extent_table_build_extent_offsets(
+	          extent_table,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_table->uniform_extent_size",
+	 extent_table->uniform_extent_size,
+	 (uint64_t) 8192 );
+
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          8192 + 100,
+	          &extent_index,
+	          &extent_data_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "extent_index",
+	 extent_index,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "extent_data_offset",
+	 (int64_t) extent_data_offset,
+	 (int64_t) 100 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          16384 + 4095,
+	          &extent_index,
+	          &extent_data_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "extent_index",
+	 extent_index,
+	 2 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "extent_data_offset",
+	 (int64_t) extent_data_offset,
+	 (int64_t) 4095 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases with extents of a varying size
+	 */
+	result = libvmdk_extent_table_set_extent_storage_media_size_by_index(
+	          extent_table,
+	          0,
+	          4096,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_build_extent_offsets(
+	          extent_table,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_table->uniform_extent_size",
+	 extent_table->uniform_extent_size,
+	 (uint64_t) 0 );
+
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          4096,
+	          &extent_index,
+	          &extent_data_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "extent_index",
+	 extent_index,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "extent_data_offset",
+	 (int64_t) extent_data_offset,
+	 (int64_t) 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          12288 + 10,
+	          &extent_index,
+	          &extent_data_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "extent_index",
+	 extent_index,
+	 2 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "extent_data_offset",
+	 (int64_t) extent_data_offset,
+	 (int64_t) 10 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          NULL,
+	          0,
+	          &extent_index,
+	          &extent_data_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          16384,
+	          &extent_index,
+	          &extent_data_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          0,
+	          NULL,
+	          &extent_data_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          0,
+	          &extent_index,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_extent_values_free(
+	          &extent_values,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "extent_values",
+	 extent_values );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_free(
+	          &extent_table,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "extent_table",
+	 extent_table );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( extent_values != NULL )
+	{
+		libvmdk_extent_values_free(
+		 &extent_values,
+		 NULL );
+	}
+	if( extent_table != NULL )
+	{
+		libvmdk_extent_table_free(
+		 &extent_table,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libvmdk_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
 
 /* The main program
@@ -2155,6 +2604,10 @@ int main(
 
 	/* TODO: add tests for libvmdk_extent_table_set_extent_storage_media_size_by_index */
 
+	VMDK_TEST_RUN(
+	 "libvmdk_extent_table_get_extent_index_at_offset",
+	 vmdk_test_extent_table_get_extent_index_at_offset );
+
 	/* TODO: add tests for libvmdk_extent_table_get_extent_file_at_offset */
 
 	/* TODO: add tests for libvmdk_extent_table_set_extent_by_extent_values */
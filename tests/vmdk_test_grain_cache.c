@@ -0,0 +1,1332 @@
+/*
+ * Library grain_cache type test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_memory.h"
+#include "vmdk_test_unused.h"
+
+#include "../libvmdk/libvmdk_definitions.h"
+#include "../libvmdk/libvmdk_grain_cache.h"
+#include "../libvmdk/libvmdk_grain_data.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+/* Creates test grain data filled with the lower 8 bits of the grain index
+ * Returns 1 if successful or -1 on error
+ */
+int vmdk_test_grain_cache_create_grain_data(
+     uint64_t grain_index,
+     libvmdk_grain_data_t **grain_data,
+     libcerror_error_t **error )
+{
+	if( libvmdk_grain_data_initialize(
+	     grain_data,
+	     512,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( memory_set(
+	     ( *grain_data )->data,
+	     (uint8_t) grain_index,
+	     512 ) == NULL )
+	{
+		libvmdk_grain_data_free(
+		 grain_data,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests the libvmdk_grain_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_grain_cache_initialize(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	libvmdk_grain_cache_t *grain_cache = NULL;
+	int result                         = 0;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+	int number_of_malloc_fail_tests    = 2;
+	int number_of_memset_fail_tests    = 2;
+	int test_number                    = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvmdk_grain_cache_initialize(
+	          &grain_cache,
+	          12,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "grain_cache",
+	 grain_cache );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "grain_cache->maximum_number_of_entries",
+	 grain_cache->maximum_number_of_entries,
+	 12 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "grain_cache->shards[ 0 ].maximum_number_of_entries",
+	 grain_cache->shards[ 0 ].maximum_number_of_entries,
+	 2 );
+
+	result = libvmdk_grain_cache_free(
+	          &grain_cache,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "grain_cache",
+	 grain_cache );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_grain_cache_initialize(
+	          NULL,
+	          12,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	grain_cache = (libvmdk_grain_cache_t *) 0x12345678UL;
+
+	result = libvmdk_grain_cache_initialize(
+	          &grain_cache,
+	          12,
+	          &error );
+
+	grain_cache = NULL;
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_cache_initialize(
+	          &grain_cache,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_grain_cache_initialize with malloc failing
+		 */
+		vmdk_test_malloc_attempts_before_fail = test_number;
+
+		result = libvmdk_grain_cache_initialize(
+		          &grain_cache,
+		          12,
+		          &error );
+
+		if( vmdk_test_malloc_attempts_before_fail != -1 )
+		{
+			vmdk_test_malloc_attempts_before_fail = -1;
+
+			if( grain_cache != NULL )
+			{
+				libvmdk_grain_cache_free(
+				 &grain_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "grain_cache",
+			 grain_cache );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_grain_cache_initialize with memset failing
+		 */
+		vmdk_test_memset_attempts_before_fail = test_number;
+
+		result = libvmdk_grain_cache_initialize(
+		          &grain_cache,
+		          12,
+		          &error );
+
+		if( vmdk_test_memset_attempts_before_fail != -1 )
+		{
+			vmdk_test_memset_attempts_before_fail = -1;
+
+			if( grain_cache != NULL )
+			{
+				libvmdk_grain_cache_free(
+				 &grain_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "grain_cache",
+			 grain_cache );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( grain_cache != NULL )
+	{
+		libvmdk_grain_cache_free(
+		 &grain_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_grain_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_grain_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_grain_cache_free(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_grain_cache_get_maximum_number_of_entries and libvmdk_grain_cache_set_maximum_number_of_entries functions
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_grain_cache_set_maximum_number_of_entries(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	libvmdk_grain_cache_t *grain_cache = NULL;
+	libvmdk_grain_data_t *grain_data   = NULL;
+	uint64_t grain_index               = 0;
+	int maximum_number_of_entries      = 0;
+	int result                         = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_grain_cache_initialize(
+	          &grain_cache,
+	          64,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "grain_cache",
+	 grain_cache );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( grain_index = 0;
+	     grain_index < 64;
+	     grain_index++ )
+	{
+		result = vmdk_test_grain_cache_create_grain_data(
+		          grain_index,
+		          &grain_data,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libvmdk_grain_cache_insert_grain_data(
+		          grain_cache,
+		          grain_index,
+		          grain_data,
+		          &error );
+
+		grain_data = NULL;
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	result = libvmdk_grain_cache_get_maximum_number_of_entries(
+	          grain_cache,
+	          &maximum_number_of_entries,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "maximum_number_of_entries",
+	 maximum_number_of_entries,
+	 64 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Shrinking the cache evicts grains
+	 */
+	result = libvmdk_grain_cache_set_maximum_number_of_entries(
+	          grain_cache,
+	          16,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_grain_cache_get_maximum_number_of_entries(
+	          grain_cache,
+	          &maximum_number_of_entries,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "maximum_number_of_entries",
+	 maximum_number_of_entries,
+	 16 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "grain_cache->shards[ 0 ].queues[ LIBVMDK_GRAIN_CACHE_QUEUE_RECENT ].number_of_entries",
+	 grain_cache->shards[ 0 ].queues[ LIBVMDK_GRAIN_CACHE_QUEUE_RECENT ].number_of_entries,
+	 2 );
+
+	/* The most recently inserted grains remain cached
+	 */
+	result = libvmdk_grain_cache_get_grain_data(
+	          grain_cache,
+	          56,
+	          &grain_data,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "grain_data",
+	 grain_data );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	grain_data = NULL;
+
+	result = libvmdk_grain_cache_get_grain_data(
+	          grain_cache,
+	          0,
+	          &grain_data,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Growing the cache retains the cached grains
+	 */
+	result = libvmdk_grain_cache_set_maximum_number_of_entries(
+	          grain_cache,
+	          256,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_grain_cache_get_grain_data(
+	          grain_cache,
+	          56,
+	          &grain_data,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	grain_data = NULL;
+
+	/* Test error cases
+	 */
+	result = libvmdk_grain_cache_get_maximum_number_of_entries(
+	          NULL,
+	          &maximum_number_of_entries,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_cache_get_maximum_number_of_entries(
+	          grain_cache,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_cache_set_maximum_number_of_entries(
+	          NULL,
+	          16,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_cache_set_maximum_number_of_entries(
+	          grain_cache,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_grain_cache_free(
+	          &grain_cache,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "grain_cache",
+	 grain_cache );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( grain_cache != NULL )
+	{
+		libvmdk_grain_cache_free(
+		 &grain_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_grain_cache_insert_grain_data, libvmdk_grain_cache_get_grain_data,
+ * libvmdk_grain_cache_copy_grain_data and libvmdk_grain_cache_get_statistics functions
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_grain_cache_insert_grain_data(
+     void )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error           = NULL;
+	libvmdk_grain_cache_t *grain_cache = NULL;
+	libvmdk_grain_data_t *grain_data   = NULL;
+	libvmdk_grain_data_t *cached_data  = NULL;
+	uint64_t number_of_hits            = 0;
+	uint64_t number_of_misses          = 0;
+	int result                         = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_grain_cache_initialize(
+	          &grain_cache,
+	          16,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "grain_cache",
+	 grain_cache );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_grain_cache_create_grain_data(
+	          3,
+	          &grain_data,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_grain_cache_get_grain_data(
+	          grain_cache,
+	          3,
+	          &cached_data,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_grain_cache_insert_grain_data(
+	          grain_cache,
+	          3,
+	          grain_data,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_grain_cache_get_grain_data(
+	          grain_cache,
+	          3,
+	          &cached_data,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "cached_data",
+	 cached_data );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "cached_data->data[ 0 ]",
+	 cached_data->data[ 0 ],
+	 3 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	grain_data = NULL;
+
+	result = libvmdk_grain_cache_copy_grain_data(
+	          grain_cache,
+	          3,
+	          496,
+	          buffer,
+	          16,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 15 ]",
+	 buffer[ 15 ],
+	 3 );
+
+	result = libvmdk_grain_cache_copy_grain_data(
+	          grain_cache,
+	          11,
+	          0,
+	          buffer,
+	          16,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_grain_cache_get_statistics(
+	          grain_cache,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_hits",
+	 number_of_hits,
+	 (uint64_t) 2 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_misses",
+	 number_of_misses,
+	 (uint64_t) 2 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The grain data of a grain that is already cached is freed by the cache
+	 */
+	result = vmdk_test_grain_cache_create_grain_data(
+	          3,
+	          &grain_data,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvmdk_grain_cache_insert_grain_data(
+	          grain_cache,
+	          3,
+	          grain_data,
+	          &error );
+
+	grain_data = NULL;
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_grain_cache_get_grain_data(
+	          grain_cache,
+	          3,
+	          &grain_data,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "grain_data == cached_data",
+	 (int) ( grain_data == cached_data ),
+	 1 );
+
+	grain_data = NULL;
+
+	/* Test error cases
+	 */
+	result = libvmdk_grain_cache_copy_grain_data(
+	          grain_cache,
+	          3,
+	          504,
+	          buffer,
+	          16,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_cache_copy_grain_data(
+	          grain_cache,
+	          3,
+	          0,
+	          NULL,
+	          16,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_cache_get_grain_data(
+	          NULL,
+	          3,
+	          &cached_data,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_cache_get_grain_data(
+	          grain_cache,
+	          3,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_cache_insert_grain_data(
+	          grain_cache,
+	          4,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_cache_get_statistics(
+	          NULL,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_cache_get_statistics(
+	          grain_cache,
+	          NULL,
+	          &number_of_misses,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_cache_get_statistics(
+	          grain_cache,
+	          &number_of_hits,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_grain_cache_free(
+	          &grain_cache,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "grain_cache",
+	 grain_cache );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( grain_data != NULL )
+	{
+		libvmdk_grain_data_free(
+		 &grain_data,
+		 NULL );
+	}
+	if( grain_cache != NULL )
+	{
+		libvmdk_grain_cache_free(
+		 &grain_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests that a sequential scan does not evict frequently used grains
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_grain_cache_scan_resistance(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	libvmdk_grain_cache_t *grain_cache = NULL;
+	libvmdk_grain_data_t *grain_data   = NULL;
+	uint64_t grain_index               = 0;
+	int result                         = 0;
+
+	/* Initialize test
+	 * All the grains in this test are in the first shard, which contains 8 entries
+	 */
+	result = libvmdk_grain_cache_initialize(
+	          &grain_cache,
+	          8 * LIBVMDK_GRAIN_CACHE_NUMBER_OF_SHARDS,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "grain_cache",
+	 grain_cache );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Read grain 0 and let it be evicted to the ghost queue, after which reading it
+	 * again promotes it to the frequent queue
+	 */
+	for( grain_index = 0;
+	     grain_index <= 9 * LIBVMDK_GRAIN_CACHE_NUMBER_OF_SHARDS;
+	     grain_index += LIBVMDK_GRAIN_CACHE_NUMBER_OF_SHARDS )
+	{
+		result = vmdk_test_grain_cache_create_grain_data(
+		          grain_index,
+		          &grain_data,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libvmdk_grain_cache_insert_grain_data(
+		          grain_cache,
+		          grain_index,
+		          grain_data,
+		          &error );
+
+		grain_data = NULL;
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libvmdk_grain_cache_get_grain_data(
+	          grain_cache,
+	          0,
+	          &grain_data,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_grain_cache_create_grain_data(
+	          0,
+	          &grain_data,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvmdk_grain_cache_insert_grain_data(
+	          grain_cache,
+	          0,
+	          grain_data,
+	          &error );
+
+	grain_data = NULL;
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "grain_cache->shards[ 0 ].queues[ LIBVMDK_GRAIN_CACHE_QUEUE_FREQUENT ].number_of_entries",
+	 grain_cache->shards[ 0 ].queues[ LIBVMDK_GRAIN_CACHE_QUEUE_FREQUENT ].number_of_entries,
+	 1 );
+
+	/* Scan a large number of grains that are read once
+	 */
+	for( grain_index = 100 * LIBVMDK_GRAIN_CACHE_NUMBER_OF_SHARDS;
+	     grain_index < 200 * LIBVMDK_GRAIN_CACHE_NUMBER_OF_SHARDS;
+	     grain_index += LIBVMDK_GRAIN_CACHE_NUMBER_OF_SHARDS )
+	{
+		result = vmdk_test_grain_cache_create_grain_data(
+		          grain_index,
+		          &grain_data,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libvmdk_grain_cache_insert_grain_data(
+		          grain_cache,
+		          grain_index,
+		          grain_data,
+		          &error );
+
+		grain_data = NULL;
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	result = libvmdk_grain_cache_get_grain_data(
+	          grain_cache,
+	          0,
+	          &grain_data,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "grain_data",
+	 grain_data );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "grain_data->data[ 0 ]",
+	 grain_data->data[ 0 ],
+	 0 );
+
+	grain_data = NULL;
+
+	result = libvmdk_grain_cache_get_grain_data(
+	          grain_cache,
+	          100 * LIBVMDK_GRAIN_CACHE_NUMBER_OF_SHARDS,
+	          &grain_data,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "grain_cache->shards[ 0 ].queues[ LIBVMDK_GRAIN_CACHE_QUEUE_GHOST ].number_of_entries",
+	 grain_cache->shards[ 0 ].queues[ LIBVMDK_GRAIN_CACHE_QUEUE_GHOST ].number_of_entries,
+	 4 );
+
+	/* Clean up
+	 */
+	result = libvmdk_grain_cache_free(
+	          &grain_cache,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "grain_cache",
+	 grain_cache );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( grain_cache != NULL )
+	{
+		libvmdk_grain_cache_free(
+		 &grain_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_grain_cache_initialize",
+	 vmdk_test_grain_cache_initialize );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_grain_cache_free",
+	 vmdk_test_grain_cache_free );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_grain_cache_set_maximum_number_of_entries",
+	 vmdk_test_grain_cache_set_maximum_number_of_entries );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_grain_cache_insert_grain_data",
+	 vmdk_test_grain_cache_insert_grain_data );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_grain_cache_scan_resistance",
+	 vmdk_test_grain_cache_scan_resistance );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+}
+
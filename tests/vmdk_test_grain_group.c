@@ -20,7 +20,9 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -33,10 +35,28 @@
 #include "vmdk_test_memory.h"
 #include "vmdk_test_unused.h"
 
+#include "../libvmdk/libvmdk_compression.h"
+#include "../libvmdk/libvmdk_definitions.h"
 #include "../libvmdk/libvmdk_grain_group.h"
+#include "../libvmdk/libvmdk_libfdata.h"
 
 #if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
 
+/* Grain table with a compressed grain at sector 1 and a sparse grain
+ */
+uint8_t vmdk_test_grain_group_grain_table_data[ 8 ] = {
+	0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+/* Compressed grain data header followed by the deflate compressed data of 4096 bytes
+ */
+uint8_t vmdk_test_grain_group_compressed_grain_data[ 51 ] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x27, 0x00, 0x00, 0x00, 0x78, 0xda, 0xed, 0xc1,
+	0x81, 0x11, 0x00, 0x30, 0x04, 0x00, 0xb1, 0xa3, 0xa8, 0xfd, 0x27, 0x36, 0xc8, 0x7f, 0x12, 0x21,
+	0xb2, 0x14, 0xda, 0x13, 0x5a, 0x09, 0xad, 0x85, 0x36, 0x42, 0xfb, 0x42, 0x5b, 0xa1, 0x1d, 0x4b,
+	0xe8, 0x48, 0x01 };
+
+uint8_t vmdk_test_grain_group_extent_data[ 512 + 4096 ];
+
 /* Tests the libvmdk_grain_group_initialize function
  * Returns 1 if successful or 0 if not
  */
@@ -270,6 +290,308 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvmdk_grain_group_fill function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_grain_group_fill(
+     void )
+{
+	uint8_t expected_data[ 4096 ];
+	uint8_t uncompressed_data[ 4096 ];
+
+	libcerror_error_t *error      = NULL;
+	libfdata_list_t *grains_list  = NULL;
+	size64_t element_size         = 0;
+	size_t data_offset            = 0;
+	size_t uncompressed_data_size = 0;
+	off64_t element_offset        = 0;
+	uint32_t compressed_data_size = 0;
+	uint32_t element_flags        = 0;
+	int element_file_index        = 0;
+	int number_of_elements        = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	if( memory_set(
+	     vmdk_test_grain_group_extent_data,
+	     0,
+	     sizeof( vmdk_test_grain_group_extent_data ) ) == NULL )
+	{
+		goto on_error;
+	}
+	if( memory_copy(
+	     &( vmdk_test_grain_group_extent_data[ 512 ] ),
+	     vmdk_test_grain_group_compressed_grain_data,
+	     sizeof( vmdk_test_grain_group_compressed_grain_data ) ) == NULL )
+	{
+		goto on_error;
+	}
+	for( data_offset = 0;
+	     data_offset < 4096;
+	     data_offset++ )
+	{
+		expected_data[ data_offset ] = (uint8_t) ( 1 + ( data_offset / 512 ) );
+	}
+	result = libfdata_list_initialize(
+	          &grains_list,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "grains_list",
+	 grains_list );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_grain_group_fill(
+	          grains_list,
+	          0,
+	          4096,
+	          0,
+	          vmdk_test_grain_group_grain_table_data,
+	          8,
+	          2,
+	          LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_list_get_number_of_elements(
+	          grains_list,
+	          &number_of_elements,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "number_of_elements",
+	 number_of_elements,
+	 2 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The range of a compressed grain has the size of the grain
+	 */
+	result = libfdata_list_get_element_by_index(
+	          grains_list,
+	          0,
+	          &element_file_index,
+	          &element_offset,
+	          &element_size,
+	          &element_flags,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "element_offset",
+	 (int64_t) element_offset,
+	 (int64_t) 512 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "element_size",
+	 (uint64_t) element_size,
+	 (uint64_t) 4096 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "element_flags",
+	 element_flags,
+	 (uint32_t) LIBVMDK_RANGE_FLAG_IS_COMPRESSED );
+
+	/* The range sized data contains the compressed grain data header
+	 * and the compressed data, which can be decompressed
+	 */
+	byte_stream_copy_to_uint32_little_endian(
+	 &( vmdk_test_grain_group_extent_data[ element_offset + 8 ] ),
+	 compressed_data_size );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "compressed_data_size",
+	 compressed_data_size,
+	 (uint32_t) 39 );
+
+	uncompressed_data_size = 4096;
+
+	result = libvmdk_decompress_data(
+	          &( vmdk_test_grain_group_extent_data[ element_offset + 12 ] ),
+	          (size_t) element_size - 12,
+	          LIBVMDK_COMPRESSION_METHOD_DEFLATE,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_data_size",
+	 uncompressed_data_size,
+	 (size_t) 4096 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          uncompressed_data,
+	          expected_data,
+	          4096 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* The range of a sparse grain has the size of the grain
+	 */
+	result = libfdata_list_get_element_by_index(
+	          grains_list,
+	          1,
+	          &element_file_index,
+	          &element_offset,
+	          &element_size,
+	          &element_flags,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "element_size",
+	 (uint64_t) element_size,
+	 (uint64_t) 4096 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "element_flags",
+	 element_flags,
+	 (uint32_t) LIBVMDK_RANGE_FLAG_IS_SPARSE );
+
+	/* Test error cases
+	 */
+	result = libvmdk_grain_group_fill(
+	          NULL,
+	          0,
+	          4096,
+	          0,
+	          vmdk_test_grain_group_grain_table_data,
+	          8,
+	          2,
+	          LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_group_fill(
+	          grains_list,
+	          0,
+	          0,
+	          0,
+	          vmdk_test_grain_group_grain_table_data,
+	          8,
+	          2,
+	          LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_list_free(
+	          &grains_list,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "grains_list",
+	 grains_list );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( grains_list != NULL )
+	{
+		libfdata_list_free(
+		 &grains_list,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
 
 /* The main program
@@ -297,7 +619,9 @@ int main(
 	 "libvmdk_grain_group_free",
 	 vmdk_test_grain_group_free );
 
-	/* TODO: add tests for libvmdk_grain_group_fill */
+	VMDK_TEST_RUN(
+	 "libvmdk_grain_group_fill",
+	 vmdk_test_grain_group_fill );
 
 #endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
 
@@ -0,0 +1,904 @@
+/*
+ * Library grain_offsets_index type test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_memory.h"
+#include "vmdk_test_unused.h"
+
+#include "../libvmdk/libvmdk_definitions.h"
+#include "../libvmdk/libvmdk_grain_offsets_index.h"
+#include "../libvmdk/libvmdk_libfdata.h"
+
+uint8_t vmdk_test_grain_offsets_index_grain_table_data[ 16 ] = {
+	0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+/* Tests the libvmdk_grain_offsets_index_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_grain_offsets_index_initialize(
+     void )
+{
+	libcerror_error_t *error                           = NULL;
+	libvmdk_grain_offsets_index_t *grain_offsets_index = NULL;
+	int result                                         = 0;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+	int number_of_malloc_fail_tests                    = 3;
+	int number_of_memset_fail_tests                    = 2;
+	int test_number                                    = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvmdk_grain_offsets_index_initialize(
+	          &grain_offsets_index,
+	          65536,
+	          2,
+	          4,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "grain_offsets_index",
+	 grain_offsets_index );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_grain_offsets_index_free(
+	          &grain_offsets_index,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "grain_offsets_index",
+	 grain_offsets_index );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_grain_offsets_index_initialize(
+	          NULL,
+	          65536,
+	          2,
+	          4,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	grain_offsets_index = (libvmdk_grain_offsets_index_t *) 0x12345678UL;
+
+	result = libvmdk_grain_offsets_index_initialize(
+	          &grain_offsets_index,
+	          65536,
+	          2,
+	          4,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	grain_offsets_index = NULL;
+
+	result = libvmdk_grain_offsets_index_initialize(
+	          &grain_offsets_index,
+	          0,
+	          2,
+	          4,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_offsets_index_initialize(
+	          &grain_offsets_index,
+	          65536,
+	          0,
+	          4,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_offsets_index_initialize(
+	          &grain_offsets_index,
+	          65536,
+	          2,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_grain_offsets_index_initialize with malloc failing
+		 */
+		vmdk_test_malloc_attempts_before_fail = test_number;
+
+		result = libvmdk_grain_offsets_index_initialize(
+		          &grain_offsets_index,
+		          65536,
+		          2,
+		          4,
+		          0,
+		          &error );
+
+		if( vmdk_test_malloc_attempts_before_fail != -1 )
+		{
+			vmdk_test_malloc_attempts_before_fail = -1;
+
+			if( grain_offsets_index != NULL )
+			{
+				libvmdk_grain_offsets_index_free(
+				 &grain_offsets_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "grain_offsets_index",
+			 grain_offsets_index );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_grain_offsets_index_initialize with memset failing
+		 */
+		vmdk_test_memset_attempts_before_fail = test_number;
+
+		result = libvmdk_grain_offsets_index_initialize(
+		          &grain_offsets_index,
+		          65536,
+		          2,
+		          4,
+		          0,
+		          &error );
+
+		if( vmdk_test_memset_attempts_before_fail != -1 )
+		{
+			vmdk_test_memset_attempts_before_fail = -1;
+
+			if( grain_offsets_index != NULL )
+			{
+				libvmdk_grain_offsets_index_free(
+				 &grain_offsets_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "grain_offsets_index",
+			 grain_offsets_index );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( grain_offsets_index != NULL )
+	{
+		libvmdk_grain_offsets_index_free(
+		 &grain_offsets_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_grain_offsets_index_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_grain_offsets_index_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_grain_offsets_index_free(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_grain_offsets_index_set_grain_group_data function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_grain_offsets_index_set_grain_group_data(
+     void )
+{
+	libcerror_error_t *error                           = NULL;
+	libvmdk_grain_offsets_index_t *grain_offsets_index = NULL;
+	int result                                         = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_grain_offsets_index_initialize(
+	          &grain_offsets_index,
+	          65536,
+	          2,
+	          4,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "grain_offsets_index",
+	 grain_offsets_index );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_grain_offsets_index_set_grain_group_data(
+	          grain_offsets_index,
+	          0,
+	          vmdk_test_grain_offsets_index_grain_table_data,
+	          16,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "grain_offsets_index->grain_group_flags[ 0 ]",
+	 grain_offsets_index->grain_group_flags[ 0 ],
+	 LIBVMDK_GRAIN_GROUP_FLAG_IS_READ );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "grain_offsets_index->sector_numbers[ 0 ]",
+	 grain_offsets_index->sector_numbers[ 0 ],
+	 (uint32_t) 0x00000080UL );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "grain_offsets_index->sector_numbers[ 2 ]",
+	 grain_offsets_index->sector_numbers[ 2 ],
+	 (uint32_t) 0x00000100UL );
+
+	/* Test error cases
+	 */
+	result = libvmdk_grain_offsets_index_set_grain_group_data(
+	          NULL,
+	          0,
+	          vmdk_test_grain_offsets_index_grain_table_data,
+	          16,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_offsets_index_set_grain_group_data(
+	          grain_offsets_index,
+	          2,
+	          vmdk_test_grain_offsets_index_grain_table_data,
+	          16,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_offsets_index_set_grain_group_data(
+	          grain_offsets_index,
+	          0,
+	          NULL,
+	          16,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_offsets_index_set_grain_group_data(
+	          grain_offsets_index,
+	          0,
+	          vmdk_test_grain_offsets_index_grain_table_data,
+	          8,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_grain_offsets_index_free(
+	          &grain_offsets_index,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "grain_offsets_index",
+	 grain_offsets_index );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( grain_offsets_index != NULL )
+	{
+		libvmdk_grain_offsets_index_free(
+		 &grain_offsets_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_grain_offsets_index_get_grain_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_grain_offsets_index_get_grain_at_offset(
+     void )
+{
+	libcerror_error_t *error                           = NULL;
+	libvmdk_grain_offsets_index_t *grain_offsets_index = NULL;
+	uint32_t grain_group_index                         = 0;
+	uint32_t sector_number                             = 0;
+	int result                                         = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_grain_offsets_index_initialize(
+	          &grain_offsets_index,
+	          65536,
+	          2,
+	          4,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "grain_offsets_index",
+	 grain_offsets_index );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test retrieving a grain of a grain group that has not been read
+	 */
+	result = libvmdk_grain_offsets_index_get_grain_at_offset(
+	          grain_offsets_index,
+	          0,
+	          &grain_group_index,
+	          &sector_number,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "grain_group_index",
+	 grain_group_index,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_grain_offsets_index_set_grain_group_data(
+	          grain_offsets_index,
+	          0,
+	          vmdk_test_grain_offsets_index_grain_table_data,
+	          16,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_grain_offsets_index_get_grain_at_offset(
+	          grain_offsets_index,
+	          0,
+	          &grain_group_index,
+	          &sector_number,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "sector_number",
+	 sector_number,
+	 (uint32_t) 0x00000080UL );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_grain_offsets_index_get_grain_at_offset(
+	          grain_offsets_index,
+	          65536,
+	          &grain_group_index,
+	          &sector_number,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "sector_number",
+	 sector_number,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_grain_offsets_index_get_grain_at_offset(
+	          grain_offsets_index,
+	          ( 2 * 65536 ) + 512,
+	          &grain_group_index,
+	          &sector_number,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "sector_number",
+	 sector_number,
+	 (uint32_t) 0x00000100UL );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test retrieving a grain of a sparse grain group
+	 */
+	result = libvmdk_grain_offsets_index_read_grain_group(
+	          grain_offsets_index,
+	          NULL,
+	          0,
+	          1,
+	          0,
+	          LIBVMDK_RANGE_FLAG_IS_SPARSE,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_grain_offsets_index_get_grain_at_offset(
+	          grain_offsets_index,
+	          4 * 65536,
+	          &grain_group_index,
+	          &sector_number,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "grain_group_index",
+	 grain_group_index,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "sector_number",
+	 sector_number,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_grain_offsets_index_get_grain_at_offset(
+	          NULL,
+	          0,
+	          &grain_group_index,
+	          &sector_number,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_offsets_index_get_grain_at_offset(
+	          grain_offsets_index,
+	          -1,
+	          &grain_group_index,
+	          &sector_number,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_offsets_index_get_grain_at_offset(
+	          grain_offsets_index,
+	          8 * 65536,
+	          &grain_group_index,
+	          &sector_number,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_offsets_index_get_grain_at_offset(
+	          grain_offsets_index,
+	          0,
+	          NULL,
+	          &sector_number,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_offsets_index_get_grain_at_offset(
+	          grain_offsets_index,
+	          0,
+	          &grain_group_index,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_grain_offsets_index_free(
+	          &grain_offsets_index,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "grain_offsets_index",
+	 grain_offsets_index );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( grain_offsets_index != NULL )
+	{
+		libvmdk_grain_offsets_index_free(
+		 &grain_offsets_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_grain_offsets_index_initialize",
+	 vmdk_test_grain_offsets_index_initialize );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_grain_offsets_index_free",
+	 vmdk_test_grain_offsets_index_free );
+
+	/* TODO: add tests for libvmdk_grain_offsets_index_read_grain_group */
+
+	VMDK_TEST_RUN(
+	 "libvmdk_grain_offsets_index_set_grain_group_data",
+	 vmdk_test_grain_offsets_index_set_grain_group_data );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_grain_offsets_index_get_grain_at_offset",
+	 vmdk_test_grain_offsets_index_get_grain_at_offset );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+}
+
@@ -338,6 +338,295 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvmdk_grain_table_reset_grain_cursor function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_grain_table_reset_grain_cursor(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	libvmdk_grain_cursor_t grain_cursor;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	grain_cursor.extent_index            = 1;
+	grain_cursor.grain_groups_list_index = 2;
+	grain_cursor.grains_list_index       = 3;
+
+	result = libvmdk_grain_table_reset_grain_cursor(
+	          &grain_cursor,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "grain_cursor.extent_index",
+	 grain_cursor.extent_index,
+	 -1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "grain_cursor.grain_groups_list_index",
+	 grain_cursor.grain_groups_list_index,
+	 -1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "grain_cursor.grains_list_index",
+	 grain_cursor.grains_list_index,
+	 -1 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_grain_table_reset_grain_cursor(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_grain_table_resolve_grain_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_grain_table_resolve_grain_at_offset(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	libvmdk_grain_cursor_t grain_cursor;
+	libvmdk_grain_table_t *grain_table = NULL;
+	libvmdk_io_handle_t *io_handle     = NULL;
+	int result                         = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->grain_size = 65536;
+
+	result = libvmdk_grain_table_initialize(
+	          &grain_table,
+	          io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "grain_table",
+	 grain_table );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_grain_table_reset_grain_cursor(
+	          &grain_cursor,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_grain_table_resolve_grain_at_offset(
+	          NULL,
+	          &grain_cursor,
+	          0,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_table_resolve_grain_at_offset(
+	          grain_table,
+	          NULL,
+	          0,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_table_resolve_grain_at_offset(
+	          grain_table,
+	          &grain_cursor,
+	          0,
+	          NULL,
+	          NULL,
+	          -1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test resolve grain at offset with missing extent table
+	 */
+	result = libvmdk_grain_table_resolve_grain_at_offset(
+	          grain_table,
+	          &grain_cursor,
+	          1,
+	          NULL,
+	          NULL,
+	          65536,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "grain_cursor.extent_index",
+	 grain_cursor.extent_index,
+	 -1 );
+
+	/* Clean up
+	 */
+	result = libvmdk_grain_table_free(
+	          &grain_table,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "grain_table",
+	 grain_table );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( grain_table != NULL )
+	{
+		libvmdk_grain_table_free(
+		 &grain_table,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libvmdk_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
 
 /* The main program
@@ -369,6 +658,16 @@ int main(
 
 	/* TODO: add tests for libvmdk_grain_table_get_grain_data_at_offset */
 
+	VMDK_TEST_RUN(
+	 "libvmdk_grain_table_reset_grain_cursor",
+	 vmdk_test_grain_table_reset_grain_cursor );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_grain_table_resolve_grain_at_offset",
+	 vmdk_test_grain_table_resolve_grain_at_offset );
+
+	/* TODO: add tests for libvmdk_grain_table_get_grain_data_at_grain_cursor */
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
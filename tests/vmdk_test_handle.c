@@ -20,7 +20,9 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -65,6 +67,56 @@ int libvmdk_handle_open_file_io_handle(
 #define VMDK_TEST_HANDLE_VERBOSE
  */
 
+#define VMDK_TEST_HANDLE_GRAIN_SIZE			8192
+#define VMDK_TEST_HANDLE_NUMBER_OF_GRAINS		8
+#define VMDK_TEST_HANDLE_NUMBER_OF_GRAIN_TABLE_ENTRIES	4
+
+const char *vmdk_test_handle_monolithic_sparse_descriptor = \
+	"# Disk DescriptorFile\n"
+	"version=1\n"
+	"CID=12345678\n"
+	"parentCID=ffffffff\n"
+	"createType=\"monolithicSparse\"\n"
+	"\n"
+	"# Extent description\n"
+	"RW 128 SPARSE \"test.vmdk\"\n"
+	"\n"
+	"# The Disk Data Base\n"
+	"#DDB\n"
+	"\n"
+	"ddb.virtualHWVersion = \"4\"\n";
+
+const char *vmdk_test_handle_stream_optimized_descriptor = \
+	"# Disk DescriptorFile\n"
+	"version=1\n"
+	"CID=12345678\n"
+	"parentCID=ffffffff\n"
+	"createType=\"streamOptimized\"\n"
+	"\n"
+	"# Extent description\n"
+	"RW 128 SPARSE \"test.vmdk\"\n"
+	"\n"
+	"# The Disk Data Base\n"
+	"#DDB\n"
+	"\n"
+	"ddb.virtualHWVersion = \"4\"\n";
+
+const char *vmdk_test_handle_two_gb_max_extent_sparse_descriptor = \
+	"# Disk DescriptorFile\n"
+	"version=1\n"
+	"CID=12345678\n"
+	"parentCID=ffffffff\n"
+	"createType=\"twoGbMaxExtentSparse\"\n"
+	"\n"
+	"# Extent description\n"
+	"RW 128 SPARSE \"test-s001.vmdk\"\n"
+	"RW 128 SPARSE \"test-s002.vmdk\"\n"
+	"\n"
+	"# The Disk Data Base\n"
+	"#DDB\n"
+	"\n"
+	"ddb.virtualHWVersion = \"4\"\n";
+
 /* Creates and opens a source handle
  * Returns 1 if successful or -1 on error
  */
@@ -240,257 +292,5078 @@ int vmdk_test_handle_close_source(
 	return( result );
 }
 
-/* Tests the libvmdk_handle_initialize function
- * Returns 1 if successful or 0 if not
+/* Fills the data of a grain of the test images
+ * Every sector of a grain contains a different byte value
  */
-int vmdk_test_handle_initialize(
-     void )
+void vmdk_test_handle_fill_grain_data(
+      uint8_t *data,
+      uint64_t grain_index )
 {
-	libcerror_error_t *error        = NULL;
-	libvmdk_handle_t *handle        = NULL;
-	int result                      = 0;
+	size_t data_offset = 0;
 
-#if defined( HAVE_VMDK_TEST_MEMORY )
-	int number_of_malloc_fail_tests = 1;
-	int number_of_memset_fail_tests = 1;
-	int test_number                 = 0;
-#endif
+	for( data_offset = 0;
+	     data_offset < VMDK_TEST_HANDLE_GRAIN_SIZE;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( 1 + ( grain_index * 16 ) + ( data_offset / 512 ) );
+	}
+}
 
-	/* Test regular cases
-	 */
-	result = libvmdk_handle_initialize(
-	          &handle,
-	          &error );
+/* Creates the data of a VMDK sparse extent file in memory
+ * The extent file contains 8 grains of 8 KiB in 2 grain tables of 4 entries, where the
+ * grain sector numbers define the location of the grains and 0 represents a sparse grain
+ * Compressed grains are stored as deflate stored blocks and take up 17 sectors
+ * Returns 1 if successful or -1 on error
+ */
+int vmdk_test_handle_create_sparse_extent_data(
+     uint8_t **extent_data,
+     size_t *extent_data_size,
+     const char *descriptor,
+     const uint32_t *grain_sector_numbers,
+     uint64_t first_grain_index,
+     uint32_t flags,
+     libcerror_error_t **error )
+{
+	uint8_t *grain_data          = NULL;
+	uint8_t *safe_extent_data    = NULL;
+	static char *function        = "vmdk_test_handle_create_sparse_extent_data";
+	size_t descriptor_length     = 0;
+	size_t grain_data_offset     = 0;
+	uint32_t adler32_lower_word  = 1;
+	uint32_t adler32_upper_word  = 0;
+	uint32_t grain_sector_number = 0;
+	uint32_t number_of_sectors   = 16;
+	int grain_index              = 0;
+
+	if( extent_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent data.",
+		 function );
 
-	VMDK_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
+		return( -1 );
+	}
+	if( extent_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent data size.",
+		 function );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
-	 "handle",
-	 handle );
+		return( -1 );
+	}
+	if( grain_sector_numbers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain sector numbers.",
+		 function );
 
-	VMDK_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+		return( -1 );
+	}
+	if( descriptor != NULL )
+	{
+		descriptor_length = narrow_string_length(
+		                     descriptor );
 
-	result = libvmdk_handle_free(
-	          &handle,
-	          &error );
+		if( descriptor_length > 1024 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid descriptor length value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	for( grain_index = 0;
+	     grain_index < VMDK_TEST_HANDLE_NUMBER_OF_GRAINS;
+	     grain_index++ )
+	{
+		grain_sector_number = grain_sector_numbers[ grain_index ];
 
-	VMDK_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
+		if( grain_sector_number == 0 )
+		{
+			continue;
+		}
+		if( grain_sector_number < 16 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid grain: %d sector number value out of bounds.",
+			 function,
+			 grain_index );
+
+			return( -1 );
+		}
+		if( ( flags & LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION ) != 0 )
+		{
+			grain_sector_number += 17;
+		}
+		else
+		{
+			grain_sector_number += 16;
+		}
+		if( grain_sector_number > number_of_sectors )
+		{
+			number_of_sectors = grain_sector_number;
+		}
+	}
+	safe_extent_data = (uint8_t *) memory_allocate(
+	                                (size_t) number_of_sectors * 512 );
 
-	VMDK_TEST_ASSERT_IS_NULL(
-	 "handle",
-	 handle );
+	if( safe_extent_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create extent data.",
+		 function );
 
-	VMDK_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+		goto on_error;
+	}
+	if( memory_set(
+	     safe_extent_data,
+	     0,
+	     (size_t) number_of_sectors * 512 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear extent data.",
+		 function );
 
-	/* Test error cases
+		goto on_error;
+	}
+	/* The file header
 	 */
-	result = libvmdk_handle_initialize(
-	          NULL,
-	          &error );
+	safe_extent_data[ 0 ] = (uint8_t) 'K';
+	safe_extent_data[ 1 ] = (uint8_t) 'D';
+	safe_extent_data[ 2 ] = (uint8_t) 'M';
+	safe_extent_data[ 3 ] = (uint8_t) 'V';
 
-	VMDK_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+	if( ( flags & LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION ) != 0 )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 &( safe_extent_data[ 4 ] ),
+		 3 );
+	}
+	else
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 &( safe_extent_data[ 4 ] ),
+		 1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( safe_extent_data[ 8 ] ),
+	 flags | LIBVMDK_FLAG_NEW_LINE_DETECION_VALID );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+	byte_stream_copy_from_uint64_little_endian(
+	 &( safe_extent_data[ 12 ] ),
+	 (uint64_t) VMDK_TEST_HANDLE_NUMBER_OF_GRAINS * 16 );
 
-	libcerror_error_free(
-	 &error );
+	byte_stream_copy_from_uint64_little_endian(
+	 &( safe_extent_data[ 20 ] ),
+	 (uint64_t) 16 );
 
-	handle = (libvmdk_handle_t *) 0x12345678UL;
+	if( descriptor != NULL )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 &( safe_extent_data[ 28 ] ),
+		 (uint64_t) 1 );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( safe_extent_data[ 36 ] ),
+		 (uint64_t) 2 );
+
+		if( memory_copy(
+		     &( safe_extent_data[ 512 ] ),
+		     descriptor,
+		     descriptor_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy descriptor.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( safe_extent_data[ 44 ] ),
+	 VMDK_TEST_HANDLE_NUMBER_OF_GRAIN_TABLE_ENTRIES );
 
-	result = libvmdk_handle_initialize(
-	          &handle,
-	          &error );
+	byte_stream_copy_from_uint64_little_endian(
+	 &( safe_extent_data[ 48 ] ),
+	 (uint64_t) 3 );
 
-	VMDK_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+	byte_stream_copy_from_uint64_little_endian(
+	 &( safe_extent_data[ 56 ] ),
+	 (uint64_t) 3 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+	byte_stream_copy_from_uint64_little_endian(
+	 &( safe_extent_data[ 64 ] ),
+	 (uint64_t) 16 );
 
-	libcerror_error_free(
-	 &error );
+	safe_extent_data[ 73 ] = (uint8_t) '\n';
+	safe_extent_data[ 74 ] = (uint8_t) ' ';
+	safe_extent_data[ 75 ] = (uint8_t) '\r';
+	safe_extent_data[ 76 ] = (uint8_t) '\n';
 
-	handle = NULL;
+	if( ( flags & LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION ) != 0 )
+	{
+		byte_stream_copy_from_uint16_little_endian(
+		 &( safe_extent_data[ 77 ] ),
+		 LIBVMDK_COMPRESSION_METHOD_DEFLATE );
+	}
+	/* The grain directory in sector 3 and the grain tables in sectors 4 and 5
+	 */
+	byte_stream_copy_from_uint32_little_endian(
+	 &( safe_extent_data[ 3 * 512 ] ),
+	 4 );
 
-#if defined( HAVE_VMDK_TEST_MEMORY )
+	byte_stream_copy_from_uint32_little_endian(
+	 &( safe_extent_data[ ( 3 * 512 ) + 4 ] ),
+	 5 );
 
-	for( test_number = 0;
-	     test_number < number_of_malloc_fail_tests;
-	     test_number++ )
+	for( grain_index = 0;
+	     grain_index < VMDK_TEST_HANDLE_NUMBER_OF_GRAINS;
+	     grain_index++ )
 	{
-		/* Test libvmdk_handle_initialize with malloc failing
-		 */
-		vmdk_test_malloc_attempts_before_fail = test_number;
+		grain_sector_number = grain_sector_numbers[ grain_index ];
 
-		result = libvmdk_handle_initialize(
-		          &handle,
-		          &error );
+		byte_stream_copy_from_uint32_little_endian(
+		 &( safe_extent_data[ ( ( 4 + ( grain_index / VMDK_TEST_HANDLE_NUMBER_OF_GRAIN_TABLE_ENTRIES ) ) * 512 ) + ( ( grain_index % VMDK_TEST_HANDLE_NUMBER_OF_GRAIN_TABLE_ENTRIES ) * 4 ) ] ),
+		 grain_sector_number );
 
-		if( vmdk_test_malloc_attempts_before_fail != -1 )
+		if( grain_sector_number == 0 )
 		{
-			vmdk_test_malloc_attempts_before_fail = -1;
-
-			if( handle != NULL )
-			{
-				libvmdk_handle_free(
-				 &handle,
-				 NULL );
-			}
+			continue;
 		}
-		else
-		{
-			VMDK_TEST_ASSERT_EQUAL_INT(
-			 "result",
-			 result,
-			 -1 );
-
-			VMDK_TEST_ASSERT_IS_NULL(
-			 "handle",
-			 handle );
+		grain_data = &( safe_extent_data[ grain_sector_number * 512 ] );
 
-			VMDK_TEST_ASSERT_IS_NOT_NULL(
-			 "error",
-			 error );
+		if( ( flags & LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION ) == 0 )
+		{
+			vmdk_test_handle_fill_grain_data(
+			 grain_data,
+			 first_grain_index + grain_index );
 
-			libcerror_error_free(
-			 &error );
+			continue;
 		}
-	}
-	for( test_number = 0;
-	     test_number < number_of_memset_fail_tests;
-	     test_number++ )
-	{
-		/* Test libvmdk_handle_initialize with memset failing
+		/* The compressed grain data header contains the sector number of the grain
+		 * and the size of the zlib compressed data that follows it
 		 */
-		vmdk_test_memset_attempts_before_fail = test_number;
+		byte_stream_copy_from_uint64_little_endian(
+		 grain_data,
+		 (uint64_t) grain_index * 16 );
 
-		result = libvmdk_handle_initialize(
-		          &handle,
-		          &error );
+		byte_stream_copy_from_uint32_little_endian(
+		 &( grain_data[ 8 ] ),
+		 2 + 5 + VMDK_TEST_HANDLE_GRAIN_SIZE + 4 );
 
-		if( vmdk_test_memset_attempts_before_fail != -1 )
-		{
-			vmdk_test_memset_attempts_before_fail = -1;
+		grain_data[ 12 ] = 0x78;
+		grain_data[ 13 ] = 0x01;
+		grain_data[ 14 ] = 0x01;
 
-			if( handle != NULL )
-			{
-				libvmdk_handle_free(
-				 &handle,
-				 NULL );
-			}
-		}
-		else
-		{
-			VMDK_TEST_ASSERT_EQUAL_INT(
-			 "result",
-			 result,
-			 -1 );
+		byte_stream_copy_from_uint16_little_endian(
+		 &( grain_data[ 15 ] ),
+		 VMDK_TEST_HANDLE_GRAIN_SIZE );
 
-			VMDK_TEST_ASSERT_IS_NULL(
-			 "handle",
-			 handle );
+		byte_stream_copy_from_uint16_little_endian(
+		 &( grain_data[ 17 ] ),
+		 ~VMDK_TEST_HANDLE_GRAIN_SIZE & 0xffff );
 
-			VMDK_TEST_ASSERT_IS_NOT_NULL(
-			 "error",
-			 error );
+		vmdk_test_handle_fill_grain_data(
+		 &( grain_data[ 19 ] ),
+		 first_grain_index + grain_index );
 
-			libcerror_error_free(
-			 &error );
+		adler32_lower_word = 1;
+		adler32_upper_word = 0;
+
+		for( grain_data_offset = 0;
+		     grain_data_offset < VMDK_TEST_HANDLE_GRAIN_SIZE;
+		     grain_data_offset++ )
+		{
+			adler32_lower_word = ( adler32_lower_word + grain_data[ 19 + grain_data_offset ] ) % 65521;
+			adler32_upper_word = ( adler32_upper_word + adler32_lower_word ) % 65521;
 		}
+		byte_stream_copy_from_uint32_big_endian(
+		 &( grain_data[ 19 + VMDK_TEST_HANDLE_GRAIN_SIZE ] ),
+		 ( adler32_upper_word << 16 ) | adler32_lower_word );
 	}
-#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+	*extent_data      = safe_extent_data;
+	*extent_data_size = (size_t) number_of_sectors * 512;
 
 	return( 1 );
 
 on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	if( handle != NULL )
+	if( safe_extent_data != NULL )
 	{
-		libvmdk_handle_free(
-		 &handle,
-		 NULL );
+		memory_free(
+		 safe_extent_data );
 	}
-	return( 0 );
+	return( -1 );
 }
 
-/* Tests the libvmdk_handle_free function
- * Returns 1 if successful or 0 if not
+/* Creates and opens a handle of a VMDK image in memory
+ * The descriptor is read from the descriptor data, where the extent data files
+ * are added to the file IO pool in the order of the extents
+ * Returns 1 if successful or -1 on error
  */
-int vmdk_test_handle_free(
-     void )
+int vmdk_test_handle_open_memory_image(
+     libvmdk_handle_t **handle,
+     libbfio_pool_t **file_io_pool,
+     uint8_t *descriptor_data,
+     size_t descriptor_data_size,
+     uint8_t **extent_data,
+     size_t *extent_data_size,
+     int number_of_extents,
+     libcerror_error_t **error )
 {
-	libcerror_error_t *error = NULL;
-	int result               = 0;
-
-	/* Test error cases
-	 */
-	result = libvmdk_handle_free(
-	          NULL,
-	          &error );
-
-	VMDK_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
-
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
-
-	libcerror_error_free(
-	 &error );
-
-	return( 1 );
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "vmdk_test_handle_open_memory_image";
+	int entry_index                  = 0;
+	int extent_index                 = 0;
 
-on_error:
-	if( error != NULL )
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_initialize(
+	     handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( vmdk_test_open_file_io_handle(
+	     &file_io_handle,
+	     descriptor_data,
+	     descriptor_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open descriptor file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_open_file_io_handle(
+	     *handle,
+	     file_io_handle,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( vmdk_test_close_file_io_handle(
+	     &file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close descriptor file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_initialize(
+	     file_io_pool,
+	     0,
+	     LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( vmdk_test_open_file_io_handle(
+		     &file_io_handle,
+		     extent_data[ extent_index ],
+		     extent_data_size[ extent_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open extent: %d file IO handle.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( libbfio_pool_append_handle(
+		     *file_io_pool,
+		     &entry_index,
+		     file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append extent: %d file IO handle to pool.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		file_io_handle = NULL;
+	}
+	if( libvmdk_handle_open_extent_data_files_file_io_pool(
+	     *handle,
+	     *file_io_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( *file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 file_io_pool,
+		 NULL );
+	}
+	if( *handle != NULL )
+	{
+		libvmdk_handle_free(
+		 handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes and frees a handle of a VMDK image in memory
+ * Returns 1 if successful or -1 on error
+ */
+int vmdk_test_handle_close_memory_image(
+     libvmdk_handle_t **handle,
+     libbfio_pool_t **file_io_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "vmdk_test_handle_close_memory_image";
+	int result            = 1;
+
+	if( vmdk_test_handle_close_source(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		result = -1;
+	}
+	if( libbfio_pool_free(
+	     file_io_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO pool.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Tests the libvmdk_handle_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libvmdk_handle_t *handle        = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_initialize(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_free(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_initialize(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	handle = (libvmdk_handle_t *) 0x12345678UL;
+
+	result = libvmdk_handle_initialize(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	handle = NULL;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_handle_initialize with malloc failing
+		 */
+		vmdk_test_malloc_attempts_before_fail = test_number;
+
+		result = libvmdk_handle_initialize(
+		          &handle,
+		          &error );
+
+		if( vmdk_test_malloc_attempts_before_fail != -1 )
+		{
+			vmdk_test_malloc_attempts_before_fail = -1;
+
+			if( handle != NULL )
+			{
+				libvmdk_handle_free(
+				 &handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "handle",
+			 handle );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_handle_initialize with memset failing
+		 */
+		vmdk_test_memset_attempts_before_fail = test_number;
+
+		result = libvmdk_handle_initialize(
+		          &handle,
+		          &error );
+
+		if( vmdk_test_memset_attempts_before_fail != -1 )
+		{
+			vmdk_test_memset_attempts_before_fail = -1;
+
+			if( handle != NULL )
+			{
+				libvmdk_handle_free(
+				 &handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "handle",
+			 handle );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_free(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_open function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_open(
+     const system_character_t *source )
+{
+	char narrow_source[ 256 ];
+
+	libcerror_error_t *error = NULL;
+	libvmdk_handle_t *handle = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = vmdk_test_get_narrow_source(
+	          source,
+	          narrow_source,
+	          256,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_initialize(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open
+	 */
+	result = libvmdk_handle_open(
+	          handle,
+	          narrow_source,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_open(
+	          NULL,
+	          narrow_source,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_open(
+	          handle,
+	          NULL,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_open(
+	          handle,
+	          narrow_source,
+	          -1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test open when already opened
+	 */
+	result = libvmdk_handle_open(
+	          handle,
+	          narrow_source,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_handle_free(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Tests the libvmdk_handle_open_wide function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_open_wide(
+     const system_character_t *source )
+{
+	wchar_t wide_source[ 256 ];
+
+	libcerror_error_t *error = NULL;
+	libvmdk_handle_t *handle = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = vmdk_test_get_wide_source(
+	          source,
+	          wide_source,
+	          256,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_initialize(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open
+	 */
+	result = libvmdk_handle_open_wide(
+	          handle,
+	          wide_source,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_open_wide(
+	          NULL,
+	          wide_source,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_open_wide(
+	          handle,
+	          NULL,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_open_wide(
+	          handle,
+	          wide_source,
+	          -1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test open when already opened
+	 */
+	result = libvmdk_handle_open_wide(
+	          handle,
+	          wide_source,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_handle_free(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Tests the libvmdk_handle_open_file_io_handle function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_open_file_io_handle(
+     const system_character_t *source )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libvmdk_handle_t *handle         = NULL;
+	size_t string_length             = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libbfio_file_initialize(
+	          &file_io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        VMDK_TEST_ASSERT_IS_NOT_NULL(
+         "file_io_handle",
+         file_io_handle );
+
+        VMDK_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	string_length = system_string_length(
+	                 source );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfio_file_set_name_wide(
+	          file_io_handle,
+	          source,
+	          string_length,
+	          &error );
+#else
+	result = libbfio_file_set_name(
+	          file_io_handle,
+	          source,
+	          string_length,
+	          &error );
+#endif
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        VMDK_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libvmdk_handle_initialize(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open
+	 */
+	result = libvmdk_handle_open_file_io_handle(
+	          handle,
+	          file_io_handle,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_open_file_io_handle(
+	          NULL,
+	          file_io_handle,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_open_file_io_handle(
+	          handle,
+	          NULL,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_open_file_io_handle(
+	          handle,
+	          file_io_handle,
+	          -1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test open when already opened
+	 */
+	result = libvmdk_handle_open_file_io_handle(
+	          handle,
+	          file_io_handle,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_handle_free(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+         "file_io_handle",
+         file_io_handle );
+
+        VMDK_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_close function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_close(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_close(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_open and libvmdk_handle_close functions
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_open_close(
+     const system_character_t *source )
+{
+	libcerror_error_t *error = NULL;
+	libvmdk_handle_t *handle = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_handle_initialize(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open and close
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_open_wide(
+	          handle,
+	          source,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+#else
+	result = libvmdk_handle_open(
+	          handle,
+	          source,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+#endif
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_close(
+	          handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open and close a second time to validate clean up on close
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_open_wide(
+	          handle,
+	          source,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+#else
+	result = libvmdk_handle_open(
+	          handle,
+	          source,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+#endif
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_close(
+	          handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libvmdk_handle_free(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_signal_abort function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_signal_abort(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_signal_abort(
+	          handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_signal_abort(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_read_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_read_buffer(
+     libvmdk_handle_t *handle )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	ssize_t read_count       = 0;
+	off64_t offset           = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libvmdk_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reset offset to 0
+	 */
+	offset = libvmdk_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( media_size > 16 )
+	{
+		read_count = libvmdk_handle_read_buffer(
+		              handle,
+		              buffer,
+		              16,
+		              &error );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Set offset to media_size - 8
+		 */
+		offset = libvmdk_handle_seek_offset(
+		          handle,
+		          -8,
+		          SEEK_END,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 offset,
+		 (int64_t) media_size - 8 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read buffer on media_size boundary
+		 */
+		read_count = libvmdk_handle_read_buffer(
+		              handle,
+		              buffer,
+		              16,
+		              &error );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 8 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read buffer beyond media_size boundary
+		 */
+		read_count = libvmdk_handle_read_buffer(
+		              handle,
+		              buffer,
+		              16,
+		              &error );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 0 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Reset offset to 0
+		 */
+		offset = libvmdk_handle_seek_offset(
+		          handle,
+		          0,
+		          SEEK_SET,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 offset,
+		 (int64_t) 0 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	read_count = libvmdk_handle_read_buffer(
+	              NULL,
+	              buffer,
+	              16,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvmdk_handle_read_buffer(
+	              handle,
+	              NULL,
+	              16,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvmdk_handle_read_buffer(
+	              handle,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_read_buffer_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_read_buffer_at_offset(
+     libvmdk_handle_t *handle )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	ssize_t read_count       = 0;
+	off64_t current_offset   = 0;
+	off64_t offset           = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libvmdk_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_get_offset(
+	          handle,
+	          &current_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( media_size > 16 )
+	{
+		read_count = libvmdk_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              0,
+		              &error );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read buffer on media_size boundary
+		 */
+		read_count = libvmdk_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              media_size - 8,
+		              &error );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 8 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read buffer beyond media_size boundary
+		 */
+		read_count = libvmdk_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              media_size + 8,
+		              &error );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 0 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Check if the current offset was not changed
+		 */
+		result = libvmdk_handle_get_offset(
+		          handle,
+		          &offset,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 (int64_t) offset,
+		 (int64_t) current_offset );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              NULL,
+	              buffer,
+	              16,
+	              0,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              NULL,
+	              16,
+	              0,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              0,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              16,
+	              -1,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_read_buffers_at_offsets function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_read_buffers_at_offsets(
+     libvmdk_handle_t *handle )
+{
+	uint8_t buffer1[ 16 ];
+	uint8_t buffer2[ 16 ];
+	uint8_t buffer3[ 16 ];
+	uint8_t expected_buffer[ 16 ];
+
+	uint8_t *buffers[ 3 ]    = { buffer1, buffer2, buffer3 };
+	size_t buffer_sizes[ 3 ] = { 16, 16, 16 };
+	off64_t offsets[ 3 ]     = { 0, 0, 0 };
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	ssize_t read_count       = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libvmdk_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( media_size > 64 )
+	{
+		offsets[ 0 ] = 32;
+		offsets[ 1 ] = 0;
+		offsets[ 2 ] = (off64_t) media_size - 8;
+
+		read_count = libvmdk_handle_read_buffers_at_offsets(
+		              handle,
+		              buffers,
+		              buffer_sizes,
+		              offsets,
+		              3,
+		              &error );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 40 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Check if the data matches that of a single read
+		 */
+		read_count = libvmdk_handle_read_buffer_at_offset(
+		              handle,
+		              expected_buffer,
+		              16,
+		              32,
+		              &error );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer1,
+		          expected_buffer,
+		          16 );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		read_count = libvmdk_handle_read_buffer_at_offset(
+		              handle,
+		              expected_buffer,
+		              16,
+		              0,
+		              &error );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer2,
+		          expected_buffer,
+		          16 );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	read_count = libvmdk_handle_read_buffers_at_offsets(
+	              NULL,
+	              buffers,
+	              buffer_sizes,
+	              offsets,
+	              3,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvmdk_handle_read_buffers_at_offsets(
+	              handle,
+	              NULL,
+	              buffer_sizes,
+	              offsets,
+	              3,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvmdk_handle_read_buffers_at_offsets(
+	              handle,
+	              buffers,
+	              NULL,
+	              offsets,
+	              3,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvmdk_handle_read_buffers_at_offsets(
+	              handle,
+	              buffers,
+	              buffer_sizes,
+	              NULL,
+	              3,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvmdk_handle_read_buffers_at_offsets(
+	              handle,
+	              buffers,
+	              buffer_sizes,
+	              offsets,
+	              0,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offsets[ 0 ] = -1;
+
+	read_count = libvmdk_handle_read_buffers_at_offsets(
+	              handle,
+	              buffers,
+	              buffer_sizes,
+	              offsets,
+	              3,
+	              &error );
+
+	offsets[ 0 ] = 0;
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the sequential and random whole grain reads of the libvmdk_handle_read_buffer_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_read_buffer_at_offset_whole_grains(
+     void )
+{
+	uint64_t statistics[ LIBVMDK_NUMBER_OF_STATISTICS ];
+	uint32_t grain_sector_numbers[ VMDK_TEST_HANDLE_NUMBER_OF_GRAINS ] = {
+		16, 32, 48, 64, 80, 96, 112, 128 };
+	uint32_t compressed_grain_sector_numbers[ VMDK_TEST_HANDLE_NUMBER_OF_GRAINS ] = {
+		16, 33, 50, 67, 84, 101, 118, 135 };
+	uint8_t buffer[ VMDK_TEST_HANDLE_GRAIN_SIZE ];
+	uint8_t expected_data[ VMDK_TEST_HANDLE_GRAIN_SIZE ];
+
+	libbfio_pool_t *file_io_pool = NULL;
+	libcerror_error_t *error     = NULL;
+	libvmdk_handle_t *handle     = NULL;
+	uint8_t *extent_data         = NULL;
+	size_t extent_data_size      = 0;
+	ssize_t read_count           = 0;
+	int result                   = 0;
+
+	/* Initialize test
+	 */
+	result = vmdk_test_handle_create_sparse_extent_data(
+	          &extent_data,
+	          &extent_data_size,
+	          vmdk_test_handle_monolithic_sparse_descriptor,
+	          grain_sector_numbers,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_handle_open_memory_image(
+	          &handle,
+	          &file_io_pool,
+	          extent_data,
+	          extent_data_size,
+	          &extent_data,
+	          &extent_data_size,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a whole grain of a sequential read bypasses the grains cache
+	 */
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              VMDK_TEST_HANDLE_GRAIN_SIZE,
+	              0,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) VMDK_TEST_HANDLE_GRAIN_SIZE );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	vmdk_test_handle_fill_grain_data(
+	 expected_data,
+	 0 );
+
+	result = memory_compare(
+	          buffer,
+	          expected_data,
+	          VMDK_TEST_HANDLE_GRAIN_SIZE );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libvmdk_handle_get_statistics(
+	          handle,
+	          statistics,
+	          LIBVMDK_NUMBER_OF_STATISTICS,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics[ LIBVMDK_STATISTIC_GRAIN_CACHE_MISSES ]",
+	 statistics[ LIBVMDK_STATISTIC_GRAIN_CACHE_MISSES ],
+	 (uint64_t) 0 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics[ LIBVMDK_STATISTIC_GRAIN_CACHE_HITS ]",
+	 statistics[ LIBVMDK_STATISTIC_GRAIN_CACHE_HITS ],
+	 (uint64_t) 0 );
+
+	/* The grain was not added to the grains cache
+	 */
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              512,
+	              0,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_get_statistics(
+	          handle,
+	          statistics,
+	          LIBVMDK_NUMBER_OF_STATISTICS,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics[ LIBVMDK_STATISTIC_GRAIN_CACHE_MISSES ]",
+	 statistics[ LIBVMDK_STATISTIC_GRAIN_CACHE_MISSES ],
+	 (uint64_t) 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics[ LIBVMDK_STATISTIC_GRAIN_CACHE_HITS ]",
+	 statistics[ LIBVMDK_STATISTIC_GRAIN_CACHE_HITS ],
+	 (uint64_t) 0 );
+
+	/* Test that a whole grain of a random read fills the grains cache
+	 */
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              VMDK_TEST_HANDLE_GRAIN_SIZE,
+	              5 * VMDK_TEST_HANDLE_GRAIN_SIZE,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) VMDK_TEST_HANDLE_GRAIN_SIZE );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	vmdk_test_handle_fill_grain_data(
+	 expected_data,
+	 5 );
+
+	result = memory_compare(
+	          buffer,
+	          expected_data,
+	          VMDK_TEST_HANDLE_GRAIN_SIZE );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              512,
+	              ( 5 * VMDK_TEST_HANDLE_GRAIN_SIZE ) + 512,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_get_statistics(
+	          handle,
+	          statistics,
+	          LIBVMDK_NUMBER_OF_STATISTICS,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics[ LIBVMDK_STATISTIC_GRAIN_CACHE_MISSES ]",
+	 statistics[ LIBVMDK_STATISTIC_GRAIN_CACHE_MISSES ],
+	 (uint64_t) 2 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics[ LIBVMDK_STATISTIC_GRAIN_CACHE_HITS ]",
+	 statistics[ LIBVMDK_STATISTIC_GRAIN_CACHE_HITS ],
+	 (uint64_t) 1 );
+
+	result = vmdk_test_handle_close_memory_image(
+	          &handle,
+	          &file_io_pool,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 extent_data );
+
+	extent_data = NULL;
+
+	/* Test that a compressed whole grain of a sequential read is decompressed into the buffer
+	 */
+	result = vmdk_test_handle_create_sparse_extent_data(
+	          &extent_data,
+	          &extent_data_size,
+	          vmdk_test_handle_stream_optimized_descriptor,
+	          compressed_grain_sector_numbers,
+	          0,
+	          LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_handle_open_memory_image(
+	          &handle,
+	          &file_io_pool,
+	          extent_data,
+	          extent_data_size,
+	          &extent_data,
+	          &extent_data_size,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              VMDK_TEST_HANDLE_GRAIN_SIZE,
+	              0,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) VMDK_TEST_HANDLE_GRAIN_SIZE );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	vmdk_test_handle_fill_grain_data(
+	 expected_data,
+	 0 );
+
+	result = memory_compare(
+	          buffer,
+	          expected_data,
+	          VMDK_TEST_HANDLE_GRAIN_SIZE );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libvmdk_handle_get_statistics(
+	          handle,
+	          statistics,
+	          LIBVMDK_NUMBER_OF_STATISTICS,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics[ LIBVMDK_STATISTIC_GRAINS_DECOMPRESSED ]",
+	 statistics[ LIBVMDK_STATISTIC_GRAINS_DECOMPRESSED ],
+	 (uint64_t) 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics[ LIBVMDK_STATISTIC_GRAIN_CACHE_MISSES ]",
+	 statistics[ LIBVMDK_STATISTIC_GRAIN_CACHE_MISSES ],
+	 (uint64_t) 0 );
+
+	/* Clean up
+	 */
+	result = vmdk_test_handle_close_memory_image(
+	          &handle,
+	          &file_io_pool,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 extent_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		vmdk_test_handle_close_memory_image(
+		 &handle,
+		 &file_io_pool,
+		 NULL );
+	}
+	if( extent_data != NULL )
+	{
+		memory_free(
+		 extent_data );
+	}
+	return( 0 );
+}
+
+/* Tests that reads at a specific offset reset a signalled abort
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_read_buffer_at_offset_abort(
+     void )
+{
+	uint32_t grain_sector_numbers[ VMDK_TEST_HANDLE_NUMBER_OF_GRAINS ] = {
+		16, 32, 48, 64, 80, 96, 112, 128 };
+	uint8_t first_buffer[ 2 * VMDK_TEST_HANDLE_GRAIN_SIZE ];
+	uint8_t second_buffer[ 2 * VMDK_TEST_HANDLE_GRAIN_SIZE ];
+	uint8_t *buffers[ 2 ];
+	size_t buffer_sizes[ 2 ];
+	off64_t offsets[ 2 ];
+
+	libbfio_pool_t *file_io_pool = NULL;
+	libcerror_error_t *error     = NULL;
+	libvmdk_handle_t *handle     = NULL;
+	uint8_t *extent_data         = NULL;
+	size_t extent_data_size      = 0;
+	ssize_t read_count           = 0;
+	int result                   = 0;
+
+	/* Initialize test
+	 */
+	result = vmdk_test_handle_create_sparse_extent_data(
+	          &extent_data,
+	          &extent_data_size,
+	          vmdk_test_handle_monolithic_sparse_descriptor,
+	          grain_sector_numbers,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_handle_open_memory_image(
+	          &handle,
+	          &file_io_pool,
+	          extent_data,
+	          extent_data_size,
+	          &extent_data,
+	          &extent_data_size,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that an abort signalled before a read at a specific offset does not abort it
+	 */
+	result = libvmdk_handle_signal_abort(
+	          handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              first_buffer,
+	              2 * VMDK_TEST_HANDLE_GRAIN_SIZE,
+	              4096,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) ( 2 * VMDK_TEST_HANDLE_GRAIN_SIZE ) );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_signal_abort(
+	          handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	buffers[ 0 ]      = first_buffer;
+	buffer_sizes[ 0 ] = 2 * VMDK_TEST_HANDLE_GRAIN_SIZE;
+	offsets[ 0 ]      = 0;
+
+	buffers[ 1 ]      = second_buffer;
+	buffer_sizes[ 1 ] = 2 * VMDK_TEST_HANDLE_GRAIN_SIZE;
+	offsets[ 1 ]      = 4 * VMDK_TEST_HANDLE_GRAIN_SIZE;
+
+	read_count = libvmdk_handle_read_buffers_at_offsets(
+	              handle,
+	              buffers,
+	              buffer_sizes,
+	              offsets,
+	              2,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) ( 4 * VMDK_TEST_HANDLE_GRAIN_SIZE ) );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = vmdk_test_handle_close_memory_image(
+	          &handle,
+	          &file_io_pool,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 extent_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		vmdk_test_handle_close_memory_image(
+		 &handle,
+		 &file_io_pool,
+		 NULL );
+	}
+	if( extent_data != NULL )
+	{
+		memory_free(
+		 extent_data );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_read_buffers_at_offsets function with read ranges that share a grain
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_read_buffers_at_offsets_shared_grain(
+     void )
+{
+	uint64_t statistics[ LIBVMDK_NUMBER_OF_STATISTICS ];
+	uint32_t grain_sector_numbers[ VMDK_TEST_HANDLE_NUMBER_OF_GRAINS ] = {
+		16, 32, 48, 64, 80, 96, 112, 128 };
+	uint8_t expected_data[ VMDK_TEST_HANDLE_GRAIN_SIZE ];
+	uint8_t first_buffer[ 2 * VMDK_TEST_HANDLE_GRAIN_SIZE ];
+	uint8_t second_buffer[ 512 ];
+	uint8_t *buffers[ 2 ];
+	size_t buffer_sizes[ 2 ];
+	off64_t offsets[ 2 ];
+
+	libbfio_pool_t *file_io_pool = NULL;
+	libcerror_error_t *error     = NULL;
+	libvmdk_handle_t *handle     = NULL;
+	uint8_t *extent_data         = NULL;
+	size_t extent_data_size      = 0;
+	ssize_t read_count           = 0;
+	int result                   = 0;
+
+	/* Initialize test
+	 */
+	result = vmdk_test_handle_create_sparse_extent_data(
+	          &extent_data,
+	          &extent_data_size,
+	          vmdk_test_handle_monolithic_sparse_descriptor,
+	          grain_sector_numbers,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_handle_open_memory_image(
+	          &handle,
+	          &file_io_pool,
+	          extent_data,
+	          extent_data_size,
+	          &extent_data,
+	          &extent_data_size,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that 2 read ranges in the same grain look up the grain once
+	 */
+	buffers[ 0 ]      = first_buffer;
+	buffer_sizes[ 0 ] = 512;
+	offsets[ 0 ]      = ( 3 * VMDK_TEST_HANDLE_GRAIN_SIZE ) + 4096;
+
+	buffers[ 1 ]      = second_buffer;
+	buffer_sizes[ 1 ] = 512;
+	offsets[ 1 ]      = ( 3 * VMDK_TEST_HANDLE_GRAIN_SIZE ) + 1024;
+
+	read_count = libvmdk_handle_read_buffers_at_offsets(
+	              handle,
+	              buffers,
+	              buffer_sizes,
+	              offsets,
+	              2,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 1024 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	vmdk_test_handle_fill_grain_data(
+	 expected_data,
+	 3 );
+
+	result = memory_compare(
+	          first_buffer,
+	          &( expected_data[ 4096 ] ),
+	          512 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = memory_compare(
+	          second_buffer,
+	          &( expected_data[ 1024 ] ),
+	          512 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libvmdk_handle_get_statistics(
+	          handle,
+	          statistics,
+	          LIBVMDK_NUMBER_OF_STATISTICS,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics[ LIBVMDK_STATISTIC_GRAIN_CACHE_MISSES ]",
+	 statistics[ LIBVMDK_STATISTIC_GRAIN_CACHE_MISSES ],
+	 (uint64_t) 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics[ LIBVMDK_STATISTIC_GRAIN_CACHE_HITS ]",
+	 statistics[ LIBVMDK_STATISTIC_GRAIN_CACHE_HITS ],
+	 (uint64_t) 0 );
+
+	/* Test a read range that starts in a grain of a preceding read range
+	 */
+	buffers[ 0 ]      = first_buffer;
+	buffer_sizes[ 0 ] = 2 * VMDK_TEST_HANDLE_GRAIN_SIZE;
+	offsets[ 0 ]      = 4 * VMDK_TEST_HANDLE_GRAIN_SIZE;
+
+	buffers[ 1 ]      = second_buffer;
+	buffer_sizes[ 1 ] = 512;
+	offsets[ 1 ]      = ( 5 * VMDK_TEST_HANDLE_GRAIN_SIZE ) + 100;
+
+	read_count = libvmdk_handle_read_buffers_at_offsets(
+	              handle,
+	              buffers,
+	              buffer_sizes,
+	              offsets,
+	              2,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) ( ( 2 * VMDK_TEST_HANDLE_GRAIN_SIZE ) + 512 ) );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	vmdk_test_handle_fill_grain_data(
+	 expected_data,
+	 4 );
+
+	result = memory_compare(
+	          first_buffer,
+	          expected_data,
+	          VMDK_TEST_HANDLE_GRAIN_SIZE );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	vmdk_test_handle_fill_grain_data(
+	 expected_data,
+	 5 );
+
+	result = memory_compare(
+	          &( first_buffer[ VMDK_TEST_HANDLE_GRAIN_SIZE ] ),
+	          expected_data,
+	          VMDK_TEST_HANDLE_GRAIN_SIZE );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = memory_compare(
+	          second_buffer,
+	          &( expected_data[ 100 ] ),
+	          512 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error case where a read range starts at the end of the media data
+	 */
+	buffers[ 1 ]      = second_buffer;
+	buffer_sizes[ 1 ] = 512;
+	offsets[ 1 ]      = VMDK_TEST_HANDLE_NUMBER_OF_GRAINS * VMDK_TEST_HANDLE_GRAIN_SIZE;
+
+	read_count = libvmdk_handle_read_buffers_at_offsets(
+	              handle,
+	              buffers,
+	              buffer_sizes,
+	              offsets,
+	              2,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = vmdk_test_handle_close_memory_image(
+	          &handle,
+	          &file_io_pool,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 extent_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		vmdk_test_handle_close_memory_image(
+		 &handle,
+		 &file_io_pool,
+		 NULL );
+	}
+	if( extent_data != NULL )
+	{
+		memory_free(
+		 extent_data );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+/* Reads grains directly and checks the data that was read
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_internal_handle_read_grain_data_direct(
+     libvmdk_handle_t *handle,
+     uint64_t grain_index,
+     int number_of_grains,
+     ssize_t expected_read_count )
+{
+	uint8_t buffer[ VMDK_TEST_HANDLE_NUMBER_OF_GRAINS * VMDK_TEST_HANDLE_GRAIN_SIZE ];
+	uint8_t expected_data[ VMDK_TEST_HANDLE_GRAIN_SIZE ];
+
+	libcerror_error_t *error = NULL;
+	libvmdk_grain_cursor_t grain_cursor;
+	ssize_t read_count       = 0;
+	size_t buffer_offset     = 0;
+	int result               = 0;
+
+	result = libvmdk_grain_table_reset_grain_cursor(
+	          &grain_cursor,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libvmdk_internal_handle_read_grain_data_direct_from_file_io_pool(
+	              (libvmdk_internal_handle_t *) handle,
+	              ( (libvmdk_internal_handle_t *) handle )->extent_data_file_io_pool,
+	              &grain_cursor,
+	              grain_index,
+	              (off64_t) ( grain_index * VMDK_TEST_HANDLE_GRAIN_SIZE ),
+	              buffer,
+	              (size_t) number_of_grains * VMDK_TEST_HANDLE_GRAIN_SIZE,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 expected_read_count );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( buffer_offset = 0;
+	     buffer_offset < (size_t) read_count;
+	     buffer_offset += VMDK_TEST_HANDLE_GRAIN_SIZE )
+	{
+		vmdk_test_handle_fill_grain_data(
+		 expected_data,
+		 grain_index + ( buffer_offset / VMDK_TEST_HANDLE_GRAIN_SIZE ) );
+
+		result = memory_compare(
+		          &( buffer[ buffer_offset ] ),
+		          expected_data,
+		          VMDK_TEST_HANDLE_GRAIN_SIZE );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_internal_handle_read_grain_data_direct_from_file_io_pool function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_internal_handle_read_grain_data_direct_from_file_io_pool(
+     void )
+{
+	uint64_t statistics[ LIBVMDK_NUMBER_OF_STATISTICS ];
+	uint64_t previous_statistics[ LIBVMDK_NUMBER_OF_STATISTICS ];
+	uint32_t contiguous_grain_sector_numbers[ VMDK_TEST_HANDLE_NUMBER_OF_GRAINS ] = {
+		16, 32, 48, 64, 80, 96, 112, 128 };
+	uint32_t sparse_grain_sector_numbers[ VMDK_TEST_HANDLE_NUMBER_OF_GRAINS ] = {
+		16, 32, 0, 48, 64, 80, 96, 112 };
+	uint32_t non_adjacent_grain_sector_numbers[ VMDK_TEST_HANDLE_NUMBER_OF_GRAINS ] = {
+		16, 32, 64, 80, 96, 112, 128, 144 };
+	uint32_t second_extent_grain_sector_numbers[ VMDK_TEST_HANDLE_NUMBER_OF_GRAINS ] = {
+		144, 160, 176, 192, 208, 224, 240, 256 };
+	uint8_t buffer[ 1 ];
+	uint8_t *extent_data[ 2 ]     = { NULL, NULL };
+	size_t extent_data_size[ 2 ]  = { 0, 0 };
+
+	libbfio_pool_t *file_io_pool  = NULL;
+	libcerror_error_t *error      = NULL;
+	libvmdk_extent_file_t *extent_file = NULL;
+	libvmdk_handle_t *handle      = NULL;
+	ssize_t read_count            = 0;
+	int extent_index              = 0;
+	int result                    = 0;
+	int test_number               = 0;
+
+	/* Test that contiguous grains are read as one run, that a run
+	 * is broken by a sparse grain and by a non-adjacent grain offset
+	 */
+	for( test_number = 0;
+	     test_number < 3;
+	     test_number++ )
+	{
+		switch( test_number )
+		{
+			case 0:
+				result = vmdk_test_handle_create_sparse_extent_data(
+				          &( extent_data[ 0 ] ),
+				          &( extent_data_size[ 0 ] ),
+				          vmdk_test_handle_monolithic_sparse_descriptor,
+				          contiguous_grain_sector_numbers,
+				          0,
+				          0,
+				          &error );
+				break;
+
+			case 1:
+				result = vmdk_test_handle_create_sparse_extent_data(
+				          &( extent_data[ 0 ] ),
+				          &( extent_data_size[ 0 ] ),
+				          vmdk_test_handle_monolithic_sparse_descriptor,
+				          sparse_grain_sector_numbers,
+				          0,
+				          0,
+				          &error );
+				break;
+
+			default:
+				result = vmdk_test_handle_create_sparse_extent_data(
+				          &( extent_data[ 0 ] ),
+				          &( extent_data_size[ 0 ] ),
+				          vmdk_test_handle_monolithic_sparse_descriptor,
+				          non_adjacent_grain_sector_numbers,
+				          0,
+				          0,
+				          &error );
+				break;
+		}
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = vmdk_test_handle_open_memory_image(
+		          &handle,
+		          &file_io_pool,
+		          extent_data[ 0 ],
+		          extent_data_size[ 0 ],
+		          extent_data,
+		          extent_data_size,
+		          1,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read the grain table before the grains are read directly
+		 */
+		read_count = libvmdk_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              1,
+		              0,
+		              &error );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvmdk_handle_get_statistics(
+		          handle,
+		          previous_statistics,
+		          LIBVMDK_NUMBER_OF_STATISTICS,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( test_number == 0 )
+		{
+			result = vmdk_test_internal_handle_read_grain_data_direct(
+			          handle,
+			          0,
+			          3,
+			          (ssize_t) ( 3 * VMDK_TEST_HANDLE_GRAIN_SIZE ) );
+		}
+		else
+		{
+			result = vmdk_test_internal_handle_read_grain_data_direct(
+			          handle,
+			          0,
+			          3,
+			          (ssize_t) ( 2 * VMDK_TEST_HANDLE_GRAIN_SIZE ) );
+		}
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libvmdk_handle_get_statistics(
+		          handle,
+		          statistics,
+		          LIBVMDK_NUMBER_OF_STATISTICS,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VMDK_TEST_ASSERT_EQUAL_UINT64(
+		 "statistics[ LIBVMDK_STATISTIC_READS ]",
+		 statistics[ LIBVMDK_STATISTIC_READS ],
+		 previous_statistics[ LIBVMDK_STATISTIC_READS ] + 1 );
+
+		VMDK_TEST_ASSERT_EQUAL_UINT64(
+		 "statistics[ LIBVMDK_STATISTIC_SEEKS ]",
+		 statistics[ LIBVMDK_STATISTIC_SEEKS ],
+		 previous_statistics[ LIBVMDK_STATISTIC_SEEKS ] + 1 );
+
+		result = vmdk_test_handle_close_memory_image(
+		          &handle,
+		          &file_io_pool,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		memory_free(
+		 extent_data[ 0 ] );
+
+		extent_data[ 0 ] = NULL;
+	}
+	/* Test that a run is broken by a compressed grain
+	 * The grain compression flag of the extent file is set after the first grain table was read
+	 * since grain compression applies to all the grains of an extent file
+	 */
+	result = vmdk_test_handle_create_sparse_extent_data(
+	          &( extent_data[ 0 ] ),
+	          &( extent_data_size[ 0 ] ),
+	          vmdk_test_handle_monolithic_sparse_descriptor,
+	          contiguous_grain_sector_numbers,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_handle_open_memory_image(
+	          &handle,
+	          &file_io_pool,
+	          extent_data[ 0 ],
+	          extent_data_size[ 0 ],
+	          extent_data,
+	          extent_data_size,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              1,
+	              0,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_get_extent_file_by_index(
+	          ( (libvmdk_internal_handle_t *) handle )->extent_table,
+	          0,
+	          ( (libvmdk_internal_handle_t *) handle )->extent_data_file_io_pool,
+	          &extent_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "extent_file",
+	 extent_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	extent_file->flags |= LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION;
+
+	result = vmdk_test_internal_handle_read_grain_data_direct(
+	          handle,
+	          0,
+	          VMDK_TEST_HANDLE_NUMBER_OF_GRAINS,
+	          (ssize_t) ( VMDK_TEST_HANDLE_NUMBER_OF_GRAIN_TABLE_ENTRIES * VMDK_TEST_HANDLE_GRAIN_SIZE ) );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = vmdk_test_handle_close_memory_image(
+	          &handle,
+	          &file_io_pool,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 extent_data[ 0 ] );
+
+	extent_data[ 0 ] = NULL;
+
+	/* Test that a run is broken by a change of extent file
+	 * The first grain of the second extent file is stored at the offset directly after
+	 * the last grain of the first extent file
+	 */
+	result = vmdk_test_handle_create_sparse_extent_data(
+	          &( extent_data[ 0 ] ),
+	          &( extent_data_size[ 0 ] ),
+	          NULL,
+	          contiguous_grain_sector_numbers,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_handle_create_sparse_extent_data(
+	          &( extent_data[ 1 ] ),
+	          &( extent_data_size[ 1 ] ),
+	          NULL,
+	          second_extent_grain_sector_numbers,
+	          VMDK_TEST_HANDLE_NUMBER_OF_GRAINS,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_handle_open_memory_image(
+	          &handle,
+	          &file_io_pool,
+	          (uint8_t *) vmdk_test_handle_two_gb_max_extent_sparse_descriptor,
+	          narrow_string_length(
+	           vmdk_test_handle_two_gb_max_extent_sparse_descriptor ),
+	          extent_data,
+	          extent_data_size,
+	          2,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_internal_handle_read_grain_data_direct(
+	          handle,
+	          VMDK_TEST_HANDLE_NUMBER_OF_GRAINS - 1,
+	          2,
+	          (ssize_t) VMDK_TEST_HANDLE_GRAIN_SIZE );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = vmdk_test_internal_handle_read_grain_data_direct(
+	          handle,
+	          VMDK_TEST_HANDLE_NUMBER_OF_GRAINS,
+	          2,
+	          (ssize_t) ( 2 * VMDK_TEST_HANDLE_GRAIN_SIZE ) );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Clean up
+	 */
+	result = vmdk_test_handle_close_memory_image(
+	          &handle,
+	          &file_io_pool,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( extent_index = 0;
+	     extent_index < 2;
+	     extent_index++ )
+	{
+		memory_free(
+		 extent_data[ extent_index ] );
+
+		extent_data[ extent_index ] = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		vmdk_test_handle_close_memory_image(
+		 &handle,
+		 &file_io_pool,
+		 NULL );
+	}
+	for( extent_index = 0;
+	     extent_index < 2;
+	     extent_index++ )
+	{
+		if( extent_data[ extent_index ] != NULL )
+		{
+			memory_free(
+			 extent_data[ extent_index ] );
+		}
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+/* Tests the libvmdk_handle_seek_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_seek_offset(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	off64_t offset           = 0;
+
+	/* Test regular cases
+	 */
+	offset = libvmdk_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_END,
+	          &error );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	size = (size64_t) offset;
+
+	offset = libvmdk_handle_seek_offset(
+	          handle,
+	          1024,
+	          SEEK_SET,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 1024 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libvmdk_handle_seek_offset(
+	          handle,
+	          -512,
+	          SEEK_CUR,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 512 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libvmdk_handle_seek_offset(
+	          handle,
+	          (off64_t) ( size + 512 ),
+	          SEEK_SET,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) ( size + 512 ) );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reset offset to 0
+	 */
+	offset = libvmdk_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	offset = libvmdk_handle_seek_offset(
+	          NULL,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libvmdk_handle_seek_offset(
+	          handle,
+	          -1,
+	          SEEK_SET,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libvmdk_handle_seek_offset(
+	          handle,
+	          -1,
+	          SEEK_CUR,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	offset = libvmdk_handle_seek_offset(
+	          handle,
+	          (off64_t) ( -1 * ( size + 1 ) ),
+	          SEEK_END,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_get_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_get_offset(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	off64_t offset           = 0;
+	int offset_is_set        = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_get_offset(
+	          handle,
+	          &offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_get_offset(
+	          NULL,
+	          &offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( offset_is_set != 0 )
+	{
+		result = libvmdk_handle_get_offset(
+		          handle,
+		          NULL,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_get_number_of_decompression_threads function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_get_number_of_decompression_threads(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int number_of_threads    = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_get_number_of_decompression_threads(
+	          handle,
+	          &number_of_threads,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "number_of_threads",
+	 number_of_threads,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_get_number_of_decompression_threads(
+	          NULL,
+	          &number_of_threads,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_get_number_of_decompression_threads(
+	          handle,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_set_number_of_decompression_threads function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_set_number_of_decompression_threads(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	uint8_t *buffer          = NULL;
+	uint8_t *expected_buffer = NULL;
+	size64_t media_size      = 0;
+	size_t read_size         = 1024 * 1024;
+	ssize_t read_count       = 0;
+	int number_of_threads    = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libvmdk_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( media_size < (size64_t) read_size )
+	{
+		read_size = (size_t) media_size;
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * ( read_size + 1 ) );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	expected_buffer = (uint8_t *) memory_allocate(
+	                               sizeof( uint8_t ) * ( read_size + 1 ) );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "expected_buffer",
+	 expected_buffer );
+
+	/* Test regular cases
+	 */
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              expected_buffer,
+	              read_size,
+	              0,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_set_number_of_decompression_threads(
+	          handle,
+	          4,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_get_number_of_decompression_threads(
+	          handle,
+	          &number_of_threads,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "number_of_threads",
+	 number_of_threads,
+	 4 );
+
+	/* Check if the data matches that of a read without decompression threads
+	 */
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              read_size,
+	              0,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          expected_buffer,
+	          read_size );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libvmdk_handle_set_number_of_decompression_threads(
+	          handle,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	memory_free(
+	 expected_buffer );
+
+	expected_buffer = NULL;
+
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_set_number_of_decompression_threads(
+	          NULL,
+	          4,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_set_number_of_decompression_threads(
+	          handle,
+	          -1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( expected_buffer != NULL )
+	{
+		memory_free(
+		 expected_buffer );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_get_use_grain_offsets_index function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_get_use_grain_offsets_index(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error        = NULL;
+	uint8_t use_grain_offsets_index = 0;
+	int result                      = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_get_use_grain_offsets_index(
+	          handle,
+	          &use_grain_offsets_index,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "use_grain_offsets_index",
+	 use_grain_offsets_index,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_get_use_grain_offsets_index(
+	          NULL,
+	          &use_grain_offsets_index,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_get_use_grain_offsets_index(
+	          handle,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_set_use_grain_offsets_index function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_set_use_grain_offsets_index(
+     const system_character_t *source,
+     libbfio_handle_t *file_io_handle,
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error        = NULL;
+	libvmdk_handle_t *index_handle  = NULL;
+	uint8_t *buffer                 = NULL;
+	uint8_t *expected_buffer        = NULL;
+	size64_t media_size             = 0;
+	size_t read_size                = 1024 * 1024;
+	size_t string_length            = 0;
+	ssize_t read_count              = 0;
+	uint8_t use_grain_offsets_index = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( media_size < (size64_t) read_size )
+	{
+		read_size = (size_t) media_size;
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * ( read_size + 1 ) );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	expected_buffer = (uint8_t *) memory_allocate(
+	                               sizeof( uint8_t ) * ( read_size + 1 ) );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "expected_buffer",
+	 expected_buffer );
+
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              expected_buffer,
+	              read_size,
+	              0,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_initialize(
+	          &index_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "index_handle",
+	 index_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_set_use_grain_offsets_index(
+	          index_handle,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_get_use_grain_offsets_index(
+	          index_handle,
+	          &use_grain_offsets_index,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "use_grain_offsets_index",
+	 use_grain_offsets_index,
+	 1 );
+
+	result = libvmdk_handle_open_file_io_handle(
+	          index_handle,
+	          file_io_handle,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	string_length = system_string_length(
+	                 source );
+
+	while( string_length > 0 )
+	{
+		if( source[ string_length - 1 ] == '/' )
+		{
+			break;
+		}
+		string_length--;
+	}
+	result = libvmdk_handle_set_extent_data_files_path(
+	          index_handle,
+	          source,
+	          string_length,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_open_extent_data_files(
+	          index_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Check if the data matches that of a read without the grain offsets index
+	 */
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              index_handle,
+	              buffer,
+	              read_size,
+	              0,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          expected_buffer,
+	          read_size );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_set_use_grain_offsets_index(
+	          NULL,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test setting the value after the extent data files were opened
+	 */
+	result = libvmdk_handle_set_use_grain_offsets_index(
+	          index_handle,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_handle_close(
+	          index_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_free(
+	          &index_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "index_handle",
+	 index_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 expected_buffer );
+
+	expected_buffer = NULL;
+
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( index_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &index_handle,
+		 NULL );
+	}
+	if( expected_buffer != NULL )
+	{
+		memory_free(
+		 expected_buffer );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_get_use_lazy_loading function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_get_use_lazy_loading(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	uint8_t use_lazy_loading = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_get_use_lazy_loading(
+	          handle,
+	          &use_lazy_loading,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "use_lazy_loading",
+	 use_lazy_loading,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_get_use_lazy_loading(
+	          NULL,
+	          &use_lazy_loading,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_get_use_lazy_loading(
+	          handle,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_set_use_lazy_loading function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_set_use_lazy_loading(
+     const system_character_t *source,
+     libbfio_handle_t *file_io_handle,
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error      = NULL;
+	libvmdk_handle_t *lazy_handle = NULL;
+	uint8_t *buffer               = NULL;
+	uint8_t *expected_buffer      = NULL;
+	size64_t media_size           = 0;
+	size_t read_size              = 1024 * 1024;
+	size_t string_length          = 0;
+	ssize_t read_count            = 0;
+	uint8_t use_lazy_loading      = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( media_size < (size64_t) read_size )
+	{
+		read_size = (size_t) media_size;
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * ( read_size + 1 ) );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	expected_buffer = (uint8_t *) memory_allocate(
+	                               sizeof( uint8_t ) * ( read_size + 1 ) );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "expected_buffer",
+	 expected_buffer );
+
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              expected_buffer,
+	              read_size,
+	              0,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_initialize(
+	          &lazy_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "lazy_handle",
+	 lazy_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_set_use_lazy_loading(
+	          lazy_handle,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_get_use_lazy_loading(
+	          lazy_handle,
+	          &use_lazy_loading,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "use_lazy_loading",
+	 use_lazy_loading,
+	 1 );
+
+	result = libvmdk_handle_open_file_io_handle(
+	          lazy_handle,
+	          file_io_handle,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	string_length = system_string_length(
+	                 source );
+
+	while( string_length > 0 )
+	{
+		if( source[ string_length - 1 ] == '/' )
+		{
+			break;
+		}
+		string_length--;
+	}
+	result = libvmdk_handle_set_extent_data_files_path(
+	          lazy_handle,
+	          source,
+	          string_length,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_open_extent_data_files(
+	          lazy_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Check if the data matches that of a read without lazy loading
+	 */
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              lazy_handle,
+	              buffer,
+	              read_size,
+	              0,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          expected_buffer,
+	          read_size );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test verifying the extent data files which reads the grain directories
+	 * that were not read when opening
+	 */
+	result = libvmdk_handle_verify_extent_data_files(
+	          lazy_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_verify_extent_data_files(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_set_use_lazy_loading(
+	          NULL,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test setting the value after the extent data files were opened
+	 */
+	result = libvmdk_handle_set_use_lazy_loading(
+	          lazy_handle,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_handle_close(
+	          lazy_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_free(
+	          &lazy_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "lazy_handle",
+	 lazy_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 expected_buffer );
+
+	expected_buffer = NULL;
+
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
 	{
 		libcerror_error_free(
 		 &error );
 	}
+	if( lazy_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &lazy_handle,
+		 NULL );
+	}
+	if( expected_buffer != NULL )
+	{
+		memory_free(
+		 expected_buffer );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
 	return( 0 );
 }
 
-/* Tests the libvmdk_handle_open function
+/* Tests the libvmdk_handle_get_number_of_open_threads function
  * Returns 1 if successful or 0 if not
  */
-int vmdk_test_handle_open(
-     const system_character_t *source )
+int vmdk_test_handle_get_number_of_open_threads(
+     libvmdk_handle_t *handle )
 {
-	char narrow_source[ 256 ];
-
 	libcerror_error_t *error = NULL;
-	libvmdk_handle_t *handle = NULL;
+	int number_of_threads    = 0;
 	int result               = 0;
 
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_get_number_of_open_threads(
+	          handle,
+	          &number_of_threads,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "number_of_threads",
+	 number_of_threads,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_get_number_of_open_threads(
+	          NULL,
+	          &number_of_threads,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_get_number_of_open_threads(
+	          handle,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_set_number_of_open_threads function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_set_number_of_open_threads(
+     const system_character_t *source,
+     libbfio_handle_t *file_io_handle,
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error         = NULL;
+	libvmdk_handle_t *threads_handle = NULL;
+	uint8_t *buffer                  = NULL;
+	uint8_t *expected_buffer         = NULL;
+	size64_t media_size              = 0;
+	size_t read_size                 = 1024 * 1024;
+	size_t string_length             = 0;
+	ssize_t read_count               = 0;
+	int number_of_threads            = 0;
+	int result                       = 0;
+
 	/* Initialize test
 	 */
-	result = vmdk_test_get_narrow_source(
-	          source,
-	          narrow_source,
-	          256,
+	result = libvmdk_handle_get_media_size(
+	          handle,
+	          &media_size,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -502,8 +5375,42 @@ int vmdk_test_handle_open(
 	 "error",
 	 error );
 
+	if( media_size < (size64_t) read_size )
+	{
+		read_size = (size_t) media_size;
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * ( read_size + 1 ) );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	expected_buffer = (uint8_t *) memory_allocate(
+	                               sizeof( uint8_t ) * ( read_size + 1 ) );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "expected_buffer",
+	 expected_buffer );
+
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              expected_buffer,
+	              read_size,
+	              0,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	result = libvmdk_handle_initialize(
-	          &handle,
+	          &threads_handle,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -512,19 +5419,18 @@ int vmdk_test_handle_open(
 	 1 );
 
 	VMDK_TEST_ASSERT_IS_NOT_NULL(
-	 "handle",
-	 handle );
+	 "threads_handle",
+	 threads_handle );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test open
+	/* Test regular cases
 	 */
-	result = libvmdk_handle_open(
-	          handle,
-	          narrow_source,
-	          LIBVMDK_OPEN_READ,
+	result = libvmdk_handle_set_number_of_open_threads(
+	          threads_handle,
+	          4,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -536,48 +5442,112 @@ int vmdk_test_handle_open(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libvmdk_handle_open(
-	          NULL,
-	          narrow_source,
-	          LIBVMDK_OPEN_READ,
+	result = libvmdk_handle_get_number_of_open_threads(
+	          threads_handle,
+	          &number_of_threads,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "number_of_threads",
+	 number_of_threads,
+	 4 );
 
-	result = libvmdk_handle_open(
-	          handle,
-	          NULL,
+	result = libvmdk_handle_open_file_io_handle(
+	          threads_handle,
+	          file_io_handle,
 	          LIBVMDK_OPEN_READ,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	string_length = system_string_length(
+	                 source );
 
-	result = libvmdk_handle_open(
-	          handle,
-	          narrow_source,
-	          -1,
+	while( string_length > 0 )
+	{
+		if( source[ string_length - 1 ] == '/' )
+		{
+			break;
+		}
+		string_length--;
+	}
+	result = libvmdk_handle_set_extent_data_files_path(
+	          threads_handle,
+	          source,
+	          string_length,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_open_extent_data_files(
+	          threads_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Check if the data matches that of a handle opened without open threads
+	 */
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              threads_handle,
+	              buffer,
+	              read_size,
+	              0,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          expected_buffer,
+	          read_size );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_set_number_of_open_threads(
+	          NULL,
+	          4,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -592,12 +5562,9 @@ int vmdk_test_handle_open(
 	libcerror_error_free(
 	 &error );
 
-	/* Test open when already opened
-	 */
-	result = libvmdk_handle_open(
-	          handle,
-	          narrow_source,
-	          LIBVMDK_OPEN_READ,
+	result = libvmdk_handle_set_number_of_open_threads(
+	          threads_handle,
+	          -1,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -614,8 +5581,21 @@ int vmdk_test_handle_open(
 
 	/* Clean up
 	 */
+	result = libvmdk_handle_close(
+	          threads_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	result = libvmdk_handle_free(
-	          &handle,
+	          &threads_handle,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -624,13 +5604,23 @@ int vmdk_test_handle_open(
 	 1 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
-	 "handle",
-	 handle );
+	 "threads_handle",
+	 threads_handle );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
+	memory_free(
+	 expected_buffer );
+
+	expected_buffer = NULL;
+
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
 	return( 1 );
 
 on_error:
@@ -639,35 +5629,40 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( handle != NULL )
+	if( threads_handle != NULL )
 	{
 		libvmdk_handle_free(
-		 &handle,
+		 &threads_handle,
 		 NULL );
 	}
+	if( expected_buffer != NULL )
+	{
+		memory_free(
+		 expected_buffer );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
 	return( 0 );
 }
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
-
-/* Tests the libvmdk_handle_open_wide function
+/* Tests the libvmdk_handle_get_maximum_number_of_readahead_grains function
  * Returns 1 if successful or 0 if not
  */
-int vmdk_test_handle_open_wide(
-     const system_character_t *source )
+int vmdk_test_handle_get_maximum_number_of_readahead_grains(
+     libvmdk_handle_t *handle )
 {
-	wchar_t wide_source[ 256 ];
-
 	libcerror_error_t *error = NULL;
-	libvmdk_handle_t *handle = NULL;
+	int number_of_grains     = 0;
 	int result               = 0;
 
-	/* Initialize test
+	/* Test regular cases
 	 */
-	result = vmdk_test_get_wide_source(
-	          source,
-	          wide_source,
-	          256,
+	result = libvmdk_handle_get_maximum_number_of_readahead_grains(
+	          handle,
+	          &number_of_grains,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -679,46 +5674,33 @@ int vmdk_test_handle_open_wide(
 	 "error",
 	 error );
 
-	result = libvmdk_handle_initialize(
-	          &handle,
-	          &error );
-
 	VMDK_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
-
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
-	 "handle",
-	 handle );
-
-	VMDK_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+	 "number_of_grains",
+	 number_of_grains,
+	 0 );
 
-	/* Test open
+	/* Test error cases
 	 */
-	result = libvmdk_handle_open_wide(
-	          handle,
-	          wide_source,
-	          LIBVMDK_OPEN_READ,
+	result = libvmdk_handle_get_maximum_number_of_readahead_grains(
+	          NULL,
+	          &number_of_grains,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-	VMDK_TEST_ASSERT_IS_NULL(
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libvmdk_handle_open_wide(
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_get_maximum_number_of_readahead_grains(
+	          handle,
 	          NULL,
-	          wide_source,
-	          LIBVMDK_OPEN_READ,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -733,66 +5715,124 @@ int vmdk_test_handle_open_wide(
 	libcerror_error_free(
 	 &error );
 
-	result = libvmdk_handle_open_wide(
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_set_maximum_number_of_readahead_grains function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_set_maximum_number_of_readahead_grains(
+     const system_character_t *source,
+     libbfio_handle_t *file_io_handle,
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error           = NULL;
+	libvmdk_handle_t *readahead_handle = NULL;
+	uint8_t *buffer                    = NULL;
+	uint8_t *expected_buffer           = NULL;
+	size64_t media_size                = 0;
+	size_t buffer_offset               = 0;
+	size_t chunk_size                  = 0;
+	size_t read_size                   = 1024 * 1024;
+	size_t string_length               = 0;
+	ssize_t read_count                 = 0;
+	int number_of_grains               = 0;
+	int result                         = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_handle_get_media_size(
 	          handle,
-	          NULL,
-	          LIBVMDK_OPEN_READ,
+	          &media_size,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	if( media_size < (size64_t) read_size )
+	{
+		read_size = (size_t) media_size;
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * ( read_size + 1 ) );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	expected_buffer = (uint8_t *) memory_allocate(
+	                               sizeof( uint8_t ) * ( read_size + 1 ) );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "expected_buffer",
+	 expected_buffer );
+
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              expected_buffer,
+	              read_size,
+	              0,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	result = libvmdk_handle_open_wide(
-	          handle,
-	          wide_source,
-	          -1,
+	result = libvmdk_handle_initialize(
+	          &readahead_handle,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "readahead_handle",
+	 readahead_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	/* Test open when already opened
+	/* Test regular cases
 	 */
-	result = libvmdk_handle_open_wide(
-	          handle,
-	          wide_source,
-	          LIBVMDK_OPEN_READ,
+	result = libvmdk_handle_set_maximum_number_of_readahead_grains(
+	          readahead_handle,
+	          16,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	/* Clean up
-	 */
-	result = libvmdk_handle_free(
-	          &handle,
+	result = libvmdk_handle_get_maximum_number_of_readahead_grains(
+	          readahead_handle,
+	          &number_of_grains,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -800,49 +5840,19 @@ int vmdk_test_handle_open_wide(
 	 result,
 	 1 );
 
-	VMDK_TEST_ASSERT_IS_NULL(
-	 "handle",
-	 handle );
-
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	return( 1 );
-
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	if( handle != NULL )
-	{
-		libvmdk_handle_free(
-		 &handle,
-		 NULL );
-	}
-	return( 0 );
-}
-
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
-
-/* Tests the libvmdk_handle_open_file_io_handle function
- * Returns 1 if successful or 0 if not
- */
-int vmdk_test_handle_open_file_io_handle(
-     const system_character_t *source )
-{
-	libbfio_handle_t *file_io_handle = NULL;
-	libcerror_error_t *error         = NULL;
-	libvmdk_handle_t *handle         = NULL;
-	size_t string_length             = 0;
-	int result                       = 0;
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "number_of_grains",
+	 number_of_grains,
+	 16 );
 
-	/* Initialize test
-	 */
-	result = libbfio_file_initialize(
-	          &file_io_handle,
+	result = libvmdk_handle_open_file_io_handle(
+	          readahead_handle,
+	          file_io_handle,
+	          LIBVMDK_OPEN_READ,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -850,41 +5860,38 @@ int vmdk_test_handle_open_file_io_handle(
 	 result,
 	 1 );
 
-        VMDK_TEST_ASSERT_IS_NOT_NULL(
-         "file_io_handle",
-         file_io_handle );
-
-        VMDK_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	string_length = system_string_length(
 	                 source );
 
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libbfio_file_set_name_wide(
-	          file_io_handle,
-	          source,
-	          string_length,
-	          &error );
-#else
-	result = libbfio_file_set_name(
-	          file_io_handle,
+	while( string_length > 0 )
+	{
+		if( source[ string_length - 1 ] == '/' )
+		{
+			break;
+		}
+		string_length--;
+	}
+	result = libvmdk_handle_set_extent_data_files_path(
+	          readahead_handle,
 	          source,
 	          string_length,
 	          &error );
-#endif
+
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 1 );
 
-        VMDK_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	result = libvmdk_handle_initialize(
-	          &handle,
+	result = libvmdk_handle_open_extent_data_files(
+	          readahead_handle,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -892,37 +5899,54 @@ int vmdk_test_handle_open_file_io_handle(
 	 result,
 	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
-	 "handle",
-	 handle );
-
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test open
+	/* Check if the data of sequential reads matches that of a handle opened without readahead
 	 */
-	result = libvmdk_handle_open_file_io_handle(
-	          handle,
-	          file_io_handle,
-	          LIBVMDK_OPEN_READ,
-	          &error );
+	while( buffer_offset < read_size )
+	{
+		chunk_size = read_size - buffer_offset;
+
+		if( chunk_size > 4096 )
+		{
+			chunk_size = 4096;
+		}
+		read_count = libvmdk_handle_read_buffer_at_offset(
+		              readahead_handle,
+		              &( buffer[ buffer_offset ] ),
+		              chunk_size,
+		              (off64_t) buffer_offset,
+		              &error );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) chunk_size );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		buffer_offset += chunk_size;
+	}
+
+	result = memory_compare(
+	          buffer,
+	          expected_buffer,
+	          read_size );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
-
-	VMDK_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+	 0 );
 
 	/* Test error cases
 	 */
-	result = libvmdk_handle_open_file_io_handle(
+	result = libvmdk_handle_set_maximum_number_of_readahead_grains(
 	          NULL,
-	          file_io_handle,
-	          LIBVMDK_OPEN_READ,
+	          4,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -937,10 +5961,9 @@ int vmdk_test_handle_open_file_io_handle(
 	libcerror_error_free(
 	 &error );
 
-	result = libvmdk_handle_open_file_io_handle(
-	          handle,
-	          NULL,
-	          LIBVMDK_OPEN_READ,
+	result = libvmdk_handle_set_maximum_number_of_readahead_grains(
+	          readahead_handle,
+	          -1,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -955,10 +5978,9 @@ int vmdk_test_handle_open_file_io_handle(
 	libcerror_error_free(
 	 &error );
 
-	result = libvmdk_handle_open_file_io_handle(
+	result = libvmdk_handle_set_maximum_number_of_readahead_grains(
 	          handle,
-	          file_io_handle,
-	          -1,
+	          1024 + 1,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -973,12 +5995,11 @@ int vmdk_test_handle_open_file_io_handle(
 	libcerror_error_free(
 	 &error );
 
-	/* Test open when already opened
+	/* The value cannot be changed after the handle is opened
 	 */
-	result = libvmdk_handle_open_file_io_handle(
-	          handle,
-	          file_io_handle,
-	          LIBVMDK_OPEN_READ,
+	result = libvmdk_handle_set_maximum_number_of_readahead_grains(
+	          readahead_handle,
+	          16,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -995,25 +6016,21 @@ int vmdk_test_handle_open_file_io_handle(
 
 	/* Clean up
 	 */
-	result = libvmdk_handle_free(
-	          &handle,
+	result = libvmdk_handle_close(
+	          readahead_handle,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
-
-	VMDK_TEST_ASSERT_IS_NULL(
-	 "handle",
-	 handle );
+	 0 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	result = libbfio_handle_free(
-	          &file_io_handle,
+	result = libvmdk_handle_free(
+	          &readahead_handle,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -1022,12 +6039,22 @@ int vmdk_test_handle_open_file_io_handle(
 	 1 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
-         "file_io_handle",
-         file_io_handle );
+	 "readahead_handle",
+	 readahead_handle );
 
-        VMDK_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 expected_buffer );
+
+	expected_buffer = NULL;
+
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
 
 	return( 1 );
 
@@ -1037,33 +6064,77 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( handle != NULL )
+	if( readahead_handle != NULL )
 	{
 		libvmdk_handle_free(
-		 &handle,
+		 &readahead_handle,
 		 NULL );
 	}
-	if( file_io_handle != NULL )
+	if( expected_buffer != NULL )
 	{
-		libbfio_handle_free(
-		 &file_io_handle,
-		 NULL );
+		memory_free(
+		 expected_buffer );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
 	}
 	return( 0 );
 }
 
-/* Tests the libvmdk_handle_close function
+/* Tests the libvmdk_handle_get_maximum_cache_size function
  * Returns 1 if successful or 0 if not
  */
-int vmdk_test_handle_close(
-     void )
+int vmdk_test_handle_get_maximum_cache_size(
+     libvmdk_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+	libcerror_error_t *error    = NULL;
+	size64_t maximum_cache_size = 0;
+	int result                  = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_get_maximum_cache_size(
+	          handle,
+	          &maximum_cache_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "maximum_cache_size",
+	 (uint64_t) maximum_cache_size,
+	 (uint64_t) 0 );
 
 	/* Test error cases
 	 */
-	result = libvmdk_handle_close(
+	result = libvmdk_handle_get_maximum_cache_size(
+	          NULL,
+	          &maximum_cache_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_get_maximum_cache_size(
+	          handle,
 	          NULL,
 	          &error );
 
@@ -1090,20 +6161,26 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libvmdk_handle_open and libvmdk_handle_close functions
+/* Tests the libvmdk_handle_set_maximum_cache_size function
  * Returns 1 if successful or 0 if not
  */
-int vmdk_test_handle_open_close(
-     const system_character_t *source )
+int vmdk_test_handle_set_maximum_cache_size(
+     libvmdk_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	libvmdk_handle_t *handle = NULL;
-	int result               = 0;
+	libcerror_error_t *error    = NULL;
+	uint8_t *buffer             = NULL;
+	uint8_t *expected_buffer    = NULL;
+	size64_t maximum_cache_size = 0;
+	size64_t media_size         = 0;
+	size_t read_size            = 256 * 1024;
+	ssize_t read_count          = 0;
+	int result                  = 0;
 
 	/* Initialize test
 	 */
-	result = libvmdk_handle_initialize(
-	          &handle,
+	result = libvmdk_handle_get_media_size(
+	          handle,
+	          &media_size,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -1111,29 +6188,50 @@ int vmdk_test_handle_open_close(
 	 result,
 	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
-	 "handle",
-	 handle );
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( media_size < (size64_t) read_size )
+	{
+		read_size = (size_t) media_size;
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * ( read_size + 1 ) );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	expected_buffer = (uint8_t *) memory_allocate(
+	                               sizeof( uint8_t ) * ( read_size + 1 ) );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "expected_buffer",
+	 expected_buffer );
+
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              expected_buffer,
+	              read_size,
+	              0,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test open and close
+	/* Test regular cases
 	 */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libvmdk_handle_open_wide(
-	          handle,
-	          source,
-	          LIBVMDK_OPEN_READ,
-	          &error );
-#else
-	result = libvmdk_handle_open(
+	result = libvmdk_handle_set_maximum_cache_size(
 	          handle,
-	          source,
-	          LIBVMDK_OPEN_READ,
+	          1024 * 1024,
 	          &error );
-#endif
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
@@ -1144,76 +6242,98 @@ int vmdk_test_handle_open_close(
 	 "error",
 	 error );
 
-	result = libvmdk_handle_close(
+	result = libvmdk_handle_get_maximum_cache_size(
 	          handle,
+	          &maximum_cache_size,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 0 );
+	 1 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test open and close a second time to validate clean up on close
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "maximum_cache_size",
+	 (uint64_t) maximum_cache_size,
+	 (uint64_t) 1024 * 1024 );
+
+	/* Check if the data read with the resized caches matches
 	 */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libvmdk_handle_open_wide(
-	          handle,
-	          source,
-	          LIBVMDK_OPEN_READ,
-	          &error );
-#else
-	result = libvmdk_handle_open(
-	          handle,
-	          source,
-	          LIBVMDK_OPEN_READ,
-	          &error );
-#endif
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              read_size,
+	              0,
+	              &error );
 
-	VMDK_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	result = libvmdk_handle_close(
+	result = memory_compare(
+	          buffer,
+	          expected_buffer,
+	          read_size );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Clean up
+	 */
+	result = libvmdk_handle_set_maximum_cache_size(
 	          handle,
+	          0,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 0 );
+	 1 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Clean up
+	/* Test error cases
 	 */
-	result = libvmdk_handle_free(
-	          &handle,
+	result = libvmdk_handle_set_maximum_cache_size(
+	          NULL,
+	          1024 * 1024,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
-
-	VMDK_TEST_ASSERT_IS_NULL(
-	 "handle",
-	 handle );
+	 -1 );
 
-	VMDK_TEST_ASSERT_IS_NULL(
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
+	libcerror_error_free(
+	 &error );
+
+	memory_free(
+	 expected_buffer );
+
+	expected_buffer = NULL;
+
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
 	return( 1 );
 
 on_error:
@@ -1222,28 +6342,36 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( handle != NULL )
+	if( expected_buffer != NULL )
 	{
-		libvmdk_handle_free(
-		 &handle,
-		 NULL );
+		memory_free(
+		 expected_buffer );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
 	}
 	return( 0 );
 }
 
-/* Tests the libvmdk_handle_signal_abort function
+/* Tests the libvmdk_handle_get_cache_sizes function
  * Returns 1 if successful or 0 if not
  */
-int vmdk_test_handle_signal_abort(
+int vmdk_test_handle_get_cache_sizes(
      libvmdk_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+	libcerror_error_t *error         = NULL;
+	size64_t grain_groups_cache_size = 0;
+	size64_t grains_cache_size       = 0;
+	int result                       = 0;
 
 	/* Test regular cases
 	 */
-	result = libvmdk_handle_signal_abort(
+	result = libvmdk_handle_get_cache_sizes(
 	          handle,
+	          &grain_groups_cache_size,
+	          &grains_cache_size,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -1257,7 +6385,45 @@ int vmdk_test_handle_signal_abort(
 
 	/* Test error cases
 	 */
-	result = libvmdk_handle_signal_abort(
+	result = libvmdk_handle_get_cache_sizes(
+	          NULL,
+	          &grain_groups_cache_size,
+	          &grains_cache_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_get_cache_sizes(
+	          handle,
+	          NULL,
+	          &grains_cache_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_get_cache_sizes(
+	          handle,
+	          &grain_groups_cache_size,
 	          NULL,
 	          &error );
 
@@ -1284,25 +6450,25 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libvmdk_handle_read_buffer function
+/* Tests the libvmdk_handle_get_statistics function
  * Returns 1 if successful or 0 if not
  */
-int vmdk_test_handle_read_buffer(
+int vmdk_test_handle_get_statistics(
      libvmdk_handle_t *handle )
 {
-	uint8_t buffer[ 16 ];
+	uint64_t statistics[ LIBVMDK_NUMBER_OF_STATISTICS + 1 ];
 
 	libcerror_error_t *error = NULL;
-	size64_t media_size      = 0;
-	ssize_t read_count       = 0;
-	off64_t offset           = 0;
 	int result               = 0;
 
-	/* Determine size
+	/* Test regular cases
 	 */
-	result = libvmdk_handle_get_media_size(
+	statistics[ LIBVMDK_NUMBER_OF_STATISTICS ] = 1;
+
+	result = libvmdk_handle_get_statistics(
 	          handle,
-	          &media_size,
+	          statistics,
+	          LIBVMDK_NUMBER_OF_STATISTICS + 1,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -1314,122 +6480,38 @@ int vmdk_test_handle_read_buffer(
 	 "error",
 	 error );
 
-	/* Reset offset to 0
-	 */
-	offset = libvmdk_handle_seek_offset(
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics[ LIBVMDK_NUMBER_OF_STATISTICS ]",
+	 statistics[ LIBVMDK_NUMBER_OF_STATISTICS ],
+	 (uint64_t) 0 );
+
+	result = libvmdk_handle_get_statistics(
 	          handle,
-	          0,
-	          SEEK_SET,
+	          statistics,
+	          1,
 	          &error );
 
-	VMDK_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test regular cases
-	 */
-	if( media_size > 16 )
-	{
-		read_count = libvmdk_handle_read_buffer(
-		              handle,
-		              buffer,
-		              16,
-		              &error );
-
-		VMDK_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 16 );
-
-		VMDK_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-
-		/* Set offset to media_size - 8
-		 */
-		offset = libvmdk_handle_seek_offset(
-		          handle,
-		          -8,
-		          SEEK_END,
-		          &error );
-
-		VMDK_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 offset,
-		 (int64_t) media_size - 8 );
-
-		VMDK_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-
-		/* Read buffer on media_size boundary
-		 */
-		read_count = libvmdk_handle_read_buffer(
-		              handle,
-		              buffer,
-		              16,
-		              &error );
-
-		VMDK_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 8 );
-
-		VMDK_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-
-		/* Read buffer beyond media_size boundary
-		 */
-		read_count = libvmdk_handle_read_buffer(
-		              handle,
-		              buffer,
-		              16,
-		              &error );
-
-		VMDK_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 0 );
-
-		VMDK_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-
-		/* Reset offset to 0
-		 */
-		offset = libvmdk_handle_seek_offset(
-		          handle,
-		          0,
-		          SEEK_SET,
-		          &error );
-
-		VMDK_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 offset,
-		 (int64_t) 0 );
-
-		VMDK_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-	}
 	/* Test error cases
 	 */
-	read_count = libvmdk_handle_read_buffer(
-	              NULL,
-	              buffer,
-	              16,
-	              &error );
+	result = libvmdk_handle_get_statistics(
+	          NULL,
+	          statistics,
+	          LIBVMDK_NUMBER_OF_STATISTICS,
+	          &error );
 
-	VMDK_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	VMDK_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1438,16 +6520,16 @@ int vmdk_test_handle_read_buffer(
 	libcerror_error_free(
 	 &error );
 
-	read_count = libvmdk_handle_read_buffer(
-	              handle,
-	              NULL,
-	              16,
-	              &error );
+	result = libvmdk_handle_get_statistics(
+	          handle,
+	          NULL,
+	          LIBVMDK_NUMBER_OF_STATISTICS,
+	          &error );
 
-	VMDK_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	VMDK_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1456,16 +6538,16 @@ int vmdk_test_handle_read_buffer(
 	libcerror_error_free(
 	 &error );
 
-	read_count = libvmdk_handle_read_buffer(
-	              handle,
-	              buffer,
-	              (size_t) SSIZE_MAX + 1,
-	              &error );
+	result = libvmdk_handle_get_statistics(
+	          handle,
+	          statistics,
+	          0,
+	          &error );
 
-	VMDK_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	VMDK_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1485,24 +6567,35 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libvmdk_handle_read_buffer_at_offset function
+/* Tests the grain cache statistics of the libvmdk_handle_read_buffer_at_offset function
  * Returns 1 if successful or 0 if not
  */
-int vmdk_test_handle_read_buffer_at_offset(
-     libvmdk_handle_t *handle )
+int vmdk_test_handle_read_buffer_at_offset_grain_cache(
+     void )
 {
-	uint8_t buffer[ 16 ];
+	uint64_t statistics[ LIBVMDK_NUMBER_OF_STATISTICS ];
+	uint32_t grain_sector_numbers[ VMDK_TEST_HANDLE_NUMBER_OF_GRAINS ] = {
+		16, 32, 48, 64, 80, 96, 112, 128 };
+	uint8_t buffer[ 512 ];
+	uint8_t expected_data[ VMDK_TEST_HANDLE_GRAIN_SIZE ];
 
-	libcerror_error_t *error = NULL;
-	size64_t media_size      = 0;
-	ssize_t read_count       = 0;
-	int result               = 0;
+	libbfio_pool_t *file_io_pool = NULL;
+	libcerror_error_t *error     = NULL;
+	libvmdk_handle_t *handle     = NULL;
+	uint8_t *extent_data         = NULL;
+	size_t extent_data_size      = 0;
+	ssize_t read_count           = 0;
+	int result                   = 0;
 
-	/* Determine size
+	/* Initialize test
 	 */
-	result = libvmdk_handle_get_media_size(
-	          handle,
-	          &media_size,
+	result = vmdk_test_handle_create_sparse_extent_data(
+	          &extent_data,
+	          &extent_data_size,
+	          vmdk_test_handle_monolithic_sparse_descriptor,
+	          grain_sector_numbers,
+	          0,
+	          0,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -1514,139 +6607,127 @@ int vmdk_test_handle_read_buffer_at_offset(
 	 "error",
 	 error );
 
-	/* Test regular cases
-	 */
-	if( media_size > 16 )
-	{
-		read_count = libvmdk_handle_read_buffer_at_offset(
-		              handle,
-		              buffer,
-		              16,
-		              0,
-		              &error );
-
-		VMDK_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 16 );
-
-		VMDK_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-
-		/* Read buffer on media_size boundary
-		 */
-		read_count = libvmdk_handle_read_buffer_at_offset(
-		              handle,
-		              buffer,
-		              16,
-		              media_size - 8,
-		              &error );
-
-		VMDK_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 8 );
+	result = vmdk_test_handle_open_memory_image(
+	          &handle,
+	          &file_io_pool,
+	          extent_data,
+	          extent_data_size,
+	          &extent_data,
+	          &extent_data_size,
+	          1,
+	          &error );
 
-		VMDK_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		/* Read buffer beyond media_size boundary
-		 */
-		read_count = libvmdk_handle_read_buffer_at_offset(
-		              handle,
-		              buffer,
-		              16,
-		              media_size + 8,
-		              &error );
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		VMDK_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 0 );
+	vmdk_test_handle_fill_grain_data(
+	 expected_data,
+	 2 );
 
-		VMDK_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-	}
-	/* Test error cases
+	/* Test that the first read of a grain is counted as a miss
+	 * and the second read of the same grain as a hit
 	 */
 	read_count = libvmdk_handle_read_buffer_at_offset(
-	              NULL,
+	              handle,
 	              buffer,
-	              16,
-	              0,
+	              512,
+	              ( 2 * VMDK_TEST_HANDLE_GRAIN_SIZE ) + 1024,
 	              &error );
 
 	VMDK_TEST_ASSERT_EQUAL_SSIZE(
 	 "read_count",
 	 read_count,
-	 (ssize_t) -1 );
+	 (ssize_t) 512 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	result = memory_compare(
+	          buffer,
+	          &( expected_data[ 1024 ] ),
+	          512 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
 	read_count = libvmdk_handle_read_buffer_at_offset(
 	              handle,
-	              NULL,
-	              16,
-	              0,
+	              buffer,
+	              512,
+	              ( 2 * VMDK_TEST_HANDLE_GRAIN_SIZE ) + 4096,
 	              &error );
 
 	VMDK_TEST_ASSERT_EQUAL_SSIZE(
 	 "read_count",
 	 read_count,
-	 (ssize_t) -1 );
+	 (ssize_t) 512 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	result = memory_compare(
+	          buffer,
+	          &( expected_data[ 4096 ] ),
+	          512 );
 
-	read_count = libvmdk_handle_read_buffer_at_offset(
-	              handle,
-	              buffer,
-	              (size_t) SSIZE_MAX + 1,
-	              0,
-	              &error );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
-	VMDK_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	result = libvmdk_handle_get_statistics(
+	          handle,
+	          statistics,
+	          LIBVMDK_NUMBER_OF_STATISTICS,
+	          &error );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics[ LIBVMDK_STATISTIC_GRAIN_CACHE_MISSES ]",
+	 statistics[ LIBVMDK_STATISTIC_GRAIN_CACHE_MISSES ],
+	 (uint64_t) 1 );
 
-	read_count = libvmdk_handle_read_buffer_at_offset(
-	              handle,
-	              buffer,
-	              16,
-	              -1,
-	              &error );
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics[ LIBVMDK_STATISTIC_GRAIN_CACHE_HITS ]",
+	 statistics[ LIBVMDK_STATISTIC_GRAIN_CACHE_HITS ],
+	 (uint64_t) 1 );
 
-	VMDK_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	/* Clean up
+	 */
+	result = vmdk_test_handle_close_memory_image(
+	          &handle,
+	          &file_io_pool,
+	          &error );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	memory_free(
+	 extent_data );
 
 	return( 1 );
 
@@ -1656,95 +6737,185 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( handle != NULL )
+	{
+		vmdk_test_handle_close_memory_image(
+		 &handle,
+		 &file_io_pool,
+		 NULL );
+	}
+	if( extent_data != NULL )
+	{
+		memory_free(
+		 extent_data );
+	}
 	return( 0 );
 }
 
-/* Tests the libvmdk_handle_seek_offset function
+/* Trace callback function that counts the trace events
+ */
+void vmdk_test_handle_trace_callback(
+     int trace_event VMDK_TEST_ATTRIBUTE_UNUSED,
+     uint64_t start_timestamp VMDK_TEST_ATTRIBUTE_UNUSED,
+     uint64_t duration VMDK_TEST_ATTRIBUTE_UNUSED,
+     void *callback_data )
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( trace_event )
+	VMDK_TEST_UNREFERENCED_PARAMETER( start_timestamp )
+	VMDK_TEST_UNREFERENCED_PARAMETER( duration )
+
+	if( callback_data != NULL )
+	{
+		*( (int *) callback_data ) += 1;
+	}
+}
+
+/* Tests the libvmdk_handle_set_trace_callback function
  * Returns 1 if successful or 0 if not
  */
-int vmdk_test_handle_seek_offset(
+int vmdk_test_handle_set_trace_callback(
      libvmdk_handle_t *handle )
 {
+	uint8_t buffer[ 512 ];
+
 	libcerror_error_t *error = NULL;
-	size64_t size            = 0;
-	off64_t offset           = 0;
+	ssize_t read_count       = 0;
+	int number_of_events     = 0;
+	int result               = 0;
 
 	/* Test regular cases
 	 */
-	offset = libvmdk_handle_seek_offset(
+	result = libvmdk_handle_set_trace_callback(
 	          handle,
-	          0,
-	          SEEK_END,
+	          &vmdk_test_handle_trace_callback,
+	          (void *) &number_of_events,
 	          &error );
 
-	VMDK_TEST_ASSERT_NOT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	size = (size64_t) offset;
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              512,
+	              0,
+	              &error );
 
-	offset = libvmdk_handle_seek_offset(
+	VMDK_TEST_ASSERT_NOT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_set_trace_callback(
 	          handle,
-	          1024,
-	          SEEK_SET,
+	          NULL,
+	          NULL,
 	          &error );
 
-	VMDK_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 1024 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_set_trace_callback(
+	          NULL,
+	          &vmdk_test_handle_trace_callback,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	VMDK_TEST_ASSERT_IS_NULL(
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	offset = libvmdk_handle_seek_offset(
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_set_use_latency_histograms function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_set_use_latency_histograms(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error       = NULL;
+	uint8_t use_latency_histograms = 0;
+	int result                     = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_set_use_latency_histograms(
 	          handle,
-	          -512,
-	          SEEK_CUR,
+	          1,
 	          &error );
 
-	VMDK_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 512 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	offset = libvmdk_handle_seek_offset(
+	result = libvmdk_handle_get_use_latency_histograms(
 	          handle,
-	          (off64_t) ( size + 512 ),
-	          SEEK_SET,
+	          &use_latency_histograms,
 	          &error );
 
-	VMDK_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) ( size + 512 ) );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Reset offset to 0
-	 */
-	offset = libvmdk_handle_seek_offset(
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "use_latency_histograms",
+	 use_latency_histograms,
+	 1 );
+
+	result = libvmdk_handle_set_use_latency_histograms(
 	          handle,
 	          0,
-	          SEEK_SET,
 	          &error );
 
-	VMDK_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -1752,16 +6923,15 @@ int vmdk_test_handle_seek_offset(
 
 	/* Test error cases
 	 */
-	offset = libvmdk_handle_seek_offset(
+	result = libvmdk_handle_set_use_latency_histograms(
 	          NULL,
-	          0,
-	          SEEK_SET,
+	          1,
 	          &error );
 
-	VMDK_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	VMDK_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1770,16 +6940,15 @@ int vmdk_test_handle_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	offset = libvmdk_handle_seek_offset(
-	          handle,
-	          -1,
-	          SEEK_SET,
+	result = libvmdk_handle_get_use_latency_histograms(
+	          NULL,
+	          &use_latency_histograms,
 	          &error );
 
-	VMDK_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	VMDK_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1788,31 +6957,15 @@ int vmdk_test_handle_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	offset = libvmdk_handle_seek_offset(
-	          handle,
-	          -1,
-	          SEEK_CUR,
-	          &error );
-
-	VMDK_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
-
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
-
-	offset = libvmdk_handle_seek_offset(
+	result = libvmdk_handle_get_use_latency_histograms(
 	          handle,
-	          (off64_t) ( -1 * ( size + 1 ) ),
-	          SEEK_END,
+	          NULL,
 	          &error );
 
-	VMDK_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	VMDK_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1832,40 +6985,49 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libvmdk_handle_get_offset function
+/* Tests the libvmdk_handle_get_latency_histogram function
  * Returns 1 if successful or 0 if not
  */
-int vmdk_test_handle_get_offset(
+int vmdk_test_handle_get_latency_histogram(
      libvmdk_handle_t *handle )
 {
+	uint64_t buckets[ LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS + 1 ];
+
 	libcerror_error_t *error = NULL;
-	off64_t offset           = 0;
-	int offset_is_set        = 0;
 	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libvmdk_handle_get_offset(
+	buckets[ LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS ] = 1;
+
+	result = libvmdk_handle_get_latency_histogram(
 	          handle,
-	          &offset,
+	          LIBVMDK_TRACE_EVENT_GRAIN_READ,
+	          buckets,
+	          LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS + 1,
 	          &error );
 
-	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	offset_is_set = result;
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "buckets[ LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS ]",
+	 buckets[ LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS ],
+	 (uint64_t) 0 );
 
 	/* Test error cases
 	 */
-	result = libvmdk_handle_get_offset(
+	result = libvmdk_handle_get_latency_histogram(
 	          NULL,
-	          &offset,
+	          LIBVMDK_TRACE_EVENT_GRAIN_READ,
+	          buckets,
+	          LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -1880,25 +7042,63 @@ int vmdk_test_handle_get_offset(
 	libcerror_error_free(
 	 &error );
 
-	if( offset_is_set != 0 )
-	{
-		result = libvmdk_handle_get_offset(
-		          handle,
-		          NULL,
-		          &error );
+	result = libvmdk_handle_get_latency_histogram(
+	          handle,
+	          -1,
+	          buckets,
+	          LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS,
+	          &error );
 
-		VMDK_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		VMDK_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_get_latency_histogram(
+	          handle,
+	          LIBVMDK_TRACE_EVENT_GRAIN_READ,
+	          NULL,
+	          LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_get_latency_histogram(
+	          handle,
+	          LIBVMDK_TRACE_EVENT_GRAIN_READ,
+	          buckets,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
 
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -2749,6 +7949,30 @@ int main(
 	 "libvmdk_handle_free",
 	 vmdk_test_handle_free );
 
+	VMDK_TEST_RUN(
+	 "libvmdk_handle_read_buffer_at_offset_grain_cache",
+	 vmdk_test_handle_read_buffer_at_offset_grain_cache );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_handle_read_buffer_at_offset_whole_grains",
+	 vmdk_test_handle_read_buffer_at_offset_whole_grains );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_handle_read_buffer_at_offset_abort",
+	 vmdk_test_handle_read_buffer_at_offset_abort );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_handle_read_buffers_at_offsets_shared_grain",
+	 vmdk_test_handle_read_buffers_at_offsets_shared_grain );
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_internal_handle_read_grain_data_direct_from_file_io_pool",
+	 vmdk_test_internal_handle_read_grain_data_direct_from_file_io_pool );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
 #if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
 	if( source != NULL )
 	{
@@ -2893,6 +8117,11 @@ int main(
 		 vmdk_test_handle_read_buffer_at_offset,
 		 handle );
 
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_read_buffers_at_offsets",
+		 vmdk_test_handle_read_buffers_at_offsets,
+		 handle );
+
 		/* TODO: add tests for libvmdk_handle_write_buffer */
 
 		/* TODO: add tests for libvmdk_handle_write_buffer_at_offset */
@@ -2907,6 +8136,99 @@ int main(
 		 vmdk_test_handle_get_offset,
 		 handle );
 
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_get_number_of_decompression_threads",
+		 vmdk_test_handle_get_number_of_decompression_threads,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_set_number_of_decompression_threads",
+		 vmdk_test_handle_set_number_of_decompression_threads,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_get_use_grain_offsets_index",
+		 vmdk_test_handle_get_use_grain_offsets_index,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_set_use_grain_offsets_index",
+		 vmdk_test_handle_set_use_grain_offsets_index,
+		 source,
+		 file_io_handle,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_get_use_lazy_loading",
+		 vmdk_test_handle_get_use_lazy_loading,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_set_use_lazy_loading",
+		 vmdk_test_handle_set_use_lazy_loading,
+		 source,
+		 file_io_handle,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_get_number_of_open_threads",
+		 vmdk_test_handle_get_number_of_open_threads,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_set_number_of_open_threads",
+		 vmdk_test_handle_set_number_of_open_threads,
+		 source,
+		 file_io_handle,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_get_maximum_number_of_readahead_grains",
+		 vmdk_test_handle_get_maximum_number_of_readahead_grains,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_set_maximum_number_of_readahead_grains",
+		 vmdk_test_handle_set_maximum_number_of_readahead_grains,
+		 source,
+		 file_io_handle,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_get_maximum_cache_size",
+		 vmdk_test_handle_get_maximum_cache_size,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_set_maximum_cache_size",
+		 vmdk_test_handle_set_maximum_cache_size,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_get_cache_sizes",
+		 vmdk_test_handle_get_cache_sizes,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_get_statistics",
+		 vmdk_test_handle_get_statistics,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_set_trace_callback",
+		 vmdk_test_handle_set_trace_callback,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_set_use_latency_histograms",
+		 vmdk_test_handle_set_use_latency_histograms,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_get_latency_histogram",
+		 vmdk_test_handle_get_latency_histogram,
+		 handle );
+
 		/* TODO: add tests for libvmdk_handle_set_maximum_number_of_open_handles */
 
 		/* TODO: add tests for libvmdk_handle_set_parent_handle */
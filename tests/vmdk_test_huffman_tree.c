@@ -855,6 +855,30 @@ int vmdk_test_huffman_tree_get_symbol_from_bit_stream(
 	libcerror_error_free(
 	 &error );
 
+	/* Test error case where the bit stream is stored front-to-back
+	 */
+	bit_stream->storage_type = LIBVMDK_BIT_STREAM_STORAGE_TYPE_BYTE_FRONT_TO_BACK;
+
+	result = libvmdk_huffman_tree_get_symbol_from_bit_stream(
+	          huffman_tree,
+	          bit_stream,
+	          &symbol,
+	          &error );
+
+	bit_stream->storage_type = LIBVMDK_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT;
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
 /* TODO add byte stream seek function */
         bit_stream->byte_stream_offset = 2627;
         bit_stream->bit_buffer_size    = 0;
@@ -0,0 +1,827 @@
+/*
+ * Library metadata_index type test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_memory.h"
+#include "vmdk_test_unused.h"
+
+#include "../libvmdk/libvmdk_metadata_index.h"
+
+uint8_t vmdk_test_metadata_index_file_header_data[ 64 ] = {
+	0x56, 0x4d, 0x44, 0x4b, 0x4d, 0x49, 0x44, 0x58, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+	0x78, 0x56, 0x34, 0x12, 0xff, 0xff, 0xff, 0xff, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+/* Tests the libvmdk_metadata_index_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_metadata_index_initialize(
+     void )
+{
+	libcerror_error_t *error                 = NULL;
+	libvmdk_metadata_index_t *metadata_index = NULL;
+	int result                               = 0;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+	int number_of_malloc_fail_tests          = 1;
+	int number_of_memset_fail_tests          = 1;
+	int test_number                          = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvmdk_metadata_index_initialize(
+	          &metadata_index,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "metadata_index",
+	 metadata_index );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_metadata_index_free(
+	          &metadata_index,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "metadata_index",
+	 metadata_index );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_metadata_index_initialize(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	metadata_index = (libvmdk_metadata_index_t *) 0x12345678UL;
+
+	result = libvmdk_metadata_index_initialize(
+	          &metadata_index,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	metadata_index = NULL;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_metadata_index_initialize with malloc failing
+		 */
+		vmdk_test_malloc_attempts_before_fail = test_number;
+
+		result = libvmdk_metadata_index_initialize(
+		          &metadata_index,
+		          &error );
+
+		if( vmdk_test_malloc_attempts_before_fail != -1 )
+		{
+			vmdk_test_malloc_attempts_before_fail = -1;
+
+			if( metadata_index != NULL )
+			{
+				libvmdk_metadata_index_free(
+				 &metadata_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "metadata_index",
+			 metadata_index );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_metadata_index_initialize with memset failing
+		 */
+		vmdk_test_memset_attempts_before_fail = test_number;
+
+		result = libvmdk_metadata_index_initialize(
+		          &metadata_index,
+		          &error );
+
+		if( vmdk_test_memset_attempts_before_fail != -1 )
+		{
+			vmdk_test_memset_attempts_before_fail = -1;
+
+			if( metadata_index != NULL )
+			{
+				libvmdk_metadata_index_free(
+				 &metadata_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "metadata_index",
+			 metadata_index );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( metadata_index != NULL )
+	{
+		libvmdk_metadata_index_free(
+		 &metadata_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_metadata_index_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_metadata_index_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_metadata_index_free(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_metadata_index_set_filename function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_metadata_index_set_filename(
+     void )
+{
+	libcerror_error_t *error                 = NULL;
+	libvmdk_metadata_index_t *metadata_index = NULL;
+	int result                               = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_metadata_index_initialize(
+	          &metadata_index,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "metadata_index",
+	 metadata_index );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_metadata_index_set_filename(
+	          metadata_index,
+	          "test.vmdkidx",
+	          12,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "metadata_index->filename",
+	 metadata_index->filename );
+
+	VMDK_TEST_ASSERT_EQUAL_SIZE(
+	 "metadata_index->filename_size",
+	 metadata_index->filename_size,
+	 (size_t) 13 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_metadata_index_set_filename(
+	          NULL,
+	          "test.vmdkidx",
+	          12,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_metadata_index_set_filename(
+	          metadata_index,
+	          NULL,
+	          12,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_metadata_index_set_filename(
+	          metadata_index,
+	          "test.vmdkidx",
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_metadata_index_free(
+	          &metadata_index,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "metadata_index",
+	 metadata_index );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( metadata_index != NULL )
+	{
+		libvmdk_metadata_index_free(
+		 &metadata_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_metadata_index_read_file_header_data function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_metadata_index_read_file_header_data(
+     void )
+{
+	uint8_t file_header_data[ 64 ];
+
+	libcerror_error_t *error                 = NULL;
+	libvmdk_metadata_index_t *metadata_index = NULL;
+	uint32_t data_checksum                   = 0;
+	int result                               = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_metadata_index_initialize(
+	          &metadata_index,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "metadata_index",
+	 metadata_index );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_metadata_index_read_file_header_data(
+	          metadata_index,
+	          vmdk_test_metadata_index_file_header_data,
+	          64,
+	          0x12345678UL,
+	          0xffffffffUL,
+	          1,
+	          &data_checksum,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "metadata_index->number_of_extents",
+	 metadata_index->number_of_extents,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_SIZE(
+	 "metadata_index->data_size",
+	 metadata_index->data_size,
+	 (size_t) 64 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "data_checksum",
+	 data_checksum,
+	 1 );
+
+	/* Test with a mismatch in content identifier
+	 */
+	result = libvmdk_metadata_index_read_file_header_data(
+	          metadata_index,
+	          vmdk_test_metadata_index_file_header_data,
+	          64,
+	          0x87654321UL,
+	          0xffffffffUL,
+	          1,
+	          &data_checksum,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with a mismatch in number of extents
+	 */
+	result = libvmdk_metadata_index_read_file_header_data(
+	          metadata_index,
+	          vmdk_test_metadata_index_file_header_data,
+	          64,
+	          0x12345678UL,
+	          0xffffffffUL,
+	          2,
+	          &data_checksum,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with an invalid signature
+	 */
+	memory_copy(
+	 file_header_data,
+	 vmdk_test_metadata_index_file_header_data,
+	 64 );
+
+	file_header_data[ 0 ] = 0xff;
+
+	result = libvmdk_metadata_index_read_file_header_data(
+	          metadata_index,
+	          file_header_data,
+	          64,
+	          0x12345678UL,
+	          0xffffffffUL,
+	          1,
+	          &data_checksum,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with an unsupported format version
+	 */
+	memory_copy(
+	 file_header_data,
+	 vmdk_test_metadata_index_file_header_data,
+	 64 );
+
+	file_header_data[ 8 ] = 0x02;
+
+	result = libvmdk_metadata_index_read_file_header_data(
+	          metadata_index,
+	          file_header_data,
+	          64,
+	          0x12345678UL,
+	          0xffffffffUL,
+	          1,
+	          &data_checksum,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with a data size that is too small for the extent records
+	 */
+	memory_copy(
+	 file_header_data,
+	 vmdk_test_metadata_index_file_header_data,
+	 64 );
+
+	file_header_data[ 24 ] = 0x10;
+
+	result = libvmdk_metadata_index_read_file_header_data(
+	          metadata_index,
+	          file_header_data,
+	          64,
+	          0x12345678UL,
+	          0xffffffffUL,
+	          1,
+	          &data_checksum,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_metadata_index_read_file_header_data(
+	          NULL,
+	          vmdk_test_metadata_index_file_header_data,
+	          64,
+	          0x12345678UL,
+	          0xffffffffUL,
+	          1,
+	          &data_checksum,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_metadata_index_read_file_header_data(
+	          metadata_index,
+	          NULL,
+	          64,
+	          0x12345678UL,
+	          0xffffffffUL,
+	          1,
+	          &data_checksum,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_metadata_index_read_file_header_data(
+	          metadata_index,
+	          vmdk_test_metadata_index_file_header_data,
+	          (size_t) SSIZE_MAX + 1,
+	          0x12345678UL,
+	          0xffffffffUL,
+	          1,
+	          &data_checksum,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_metadata_index_read_file_header_data(
+	          metadata_index,
+	          vmdk_test_metadata_index_file_header_data,
+	          0,
+	          0x12345678UL,
+	          0xffffffffUL,
+	          1,
+	          &data_checksum,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_metadata_index_read_file_header_data(
+	          metadata_index,
+	          vmdk_test_metadata_index_file_header_data,
+	          64,
+	          0x12345678UL,
+	          0xffffffffUL,
+	          1,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_metadata_index_free(
+	          &metadata_index,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "metadata_index",
+	 metadata_index );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( metadata_index != NULL )
+	{
+		libvmdk_metadata_index_free(
+		 &metadata_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_metadata_index_initialize",
+	 vmdk_test_metadata_index_initialize );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_metadata_index_free",
+	 vmdk_test_metadata_index_free );
+
+	/* TODO: add tests for libvmdk_metadata_index_clear_data */
+
+	VMDK_TEST_RUN(
+	 "libvmdk_metadata_index_set_filename",
+	 vmdk_test_metadata_index_set_filename );
+
+	/* TODO: add tests for libvmdk_metadata_index_set_filename_wide */
+
+	/* TODO: add tests for libvmdk_metadata_index_open_file */
+
+	VMDK_TEST_RUN(
+	 "libvmdk_metadata_index_read_file_header_data",
+	 vmdk_test_metadata_index_read_file_header_data );
+
+	/* TODO: add tests for libvmdk_metadata_index_read_file */
+
+	/* TODO: add tests for libvmdk_metadata_index_get_grain_offsets_index */
+
+	/* TODO: add tests for libvmdk_metadata_index_write_file */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+}
+
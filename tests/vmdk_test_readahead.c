@@ -0,0 +1,721 @@
+/*
+ * Library readahead type test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_memory.h"
+#include "vmdk_test_unused.h"
+
+#include "../libvmdk/libvmdk_definitions.h"
+#include "../libvmdk/libvmdk_readahead.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) && defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+
+/* Reads the (grain) data of a specific test grain
+ * The data of every grain is filled with the lower 8 bits of its index, except for grain 5 that is sparse
+ * Returns 1 if successful, 0 if the grain is sparse or -1 on error
+ */
+int vmdk_test_readahead_read_grain(
+     intptr_t *data VMDK_TEST_ATTRIBUTE_UNUSED,
+     uint64_t grain_index,
+     uint8_t *grain_data,
+     size_t grain_data_size,
+     libcerror_error_t **error VMDK_TEST_ATTRIBUTE_UNUSED )
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( data )
+	VMDK_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( grain_index == 5 )
+	{
+		return( 0 );
+	}
+	if( memory_set(
+	     grain_data,
+	     (uint8_t) grain_index,
+	     grain_data_size ) == NULL )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests the libvmdk_readahead_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_readahead_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libvmdk_readahead_t *readahead  = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 4;
+	int number_of_memset_fail_tests = 3;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvmdk_readahead_initialize(
+	          &readahead,
+	          512,
+	          16,
+	          4,
+	          &vmdk_test_readahead_read_grain,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "readahead",
+	 readahead );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "readahead->number_of_slots",
+	 readahead->number_of_slots,
+	 5 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "readahead->window_size",
+	 readahead->window_size,
+	 LIBVMDK_READAHEAD_MINIMUM_WINDOW_SIZE );
+
+	result = libvmdk_readahead_free(
+	          &readahead,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "readahead",
+	 readahead );
+
+	/* Test error cases
+	 */
+	result = libvmdk_readahead_initialize(
+	          NULL,
+	          512,
+	          16,
+	          4,
+	          &vmdk_test_readahead_read_grain,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	readahead = (libvmdk_readahead_t *) 0x12345678UL;
+
+	result = libvmdk_readahead_initialize(
+	          &readahead,
+	          512,
+	          16,
+	          4,
+	          &vmdk_test_readahead_read_grain,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	readahead = NULL;
+
+	result = libvmdk_readahead_initialize(
+	          &readahead,
+	          0,
+	          16,
+	          4,
+	          &vmdk_test_readahead_read_grain,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_readahead_initialize(
+	          &readahead,
+	          512,
+	          0,
+	          4,
+	          &vmdk_test_readahead_read_grain,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_readahead_initialize(
+	          &readahead,
+	          512,
+	          16,
+	          0,
+	          &vmdk_test_readahead_read_grain,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_readahead_initialize(
+	          &readahead,
+	          512,
+	          16,
+	          LIBVMDK_MAXIMUM_NUMBER_OF_READAHEAD_GRAINS + 1,
+	          &vmdk_test_readahead_read_grain,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_readahead_initialize(
+	          &readahead,
+	          512,
+	          16,
+	          4,
+	          NULL,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_readahead_initialize with malloc failing
+		 */
+		vmdk_test_malloc_attempts_before_fail = test_number;
+
+		result = libvmdk_readahead_initialize(
+		          &readahead,
+		          512,
+		          16,
+		          4,
+		          &vmdk_test_readahead_read_grain,
+		          NULL,
+		          &error );
+
+		if( vmdk_test_malloc_attempts_before_fail != -1 )
+		{
+			vmdk_test_malloc_attempts_before_fail = -1;
+
+			if( readahead != NULL )
+			{
+				libvmdk_readahead_free(
+				 &readahead,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "readahead",
+			 readahead );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_readahead_initialize with memset failing
+		 */
+		vmdk_test_memset_attempts_before_fail = test_number;
+
+		result = libvmdk_readahead_initialize(
+		          &readahead,
+		          512,
+		          16,
+		          4,
+		          &vmdk_test_readahead_read_grain,
+		          NULL,
+		          &error );
+
+		if( vmdk_test_memset_attempts_before_fail != -1 )
+		{
+			vmdk_test_memset_attempts_before_fail = -1;
+
+			if( readahead != NULL )
+			{
+				libvmdk_readahead_free(
+				 &readahead,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "readahead",
+			 readahead );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( readahead != NULL )
+	{
+		libvmdk_readahead_free(
+		 &readahead,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_readahead_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_readahead_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_readahead_free(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_readahead_read_grain_data function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_readahead_read_grain_data(
+     void )
+{
+	uint8_t buffer[ 512 ];
+
+	libcerror_error_t *error       = NULL;
+	libvmdk_readahead_t *readahead = NULL;
+	size_t buffer_index            = 0;
+	uint64_t grain_index           = 0;
+	int pass_index                 = 0;
+	int result                     = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_readahead_initialize(
+	          &readahead,
+	          512,
+	          16,
+	          4,
+	          &vmdk_test_readahead_read_grain,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "readahead",
+	 readahead );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The grains are read sequentially twice, the second pass starts with a non-sequential read
+	 */
+	for( pass_index = 0;
+	     pass_index < 2;
+	     pass_index++ )
+	{
+		for( grain_index = 0;
+		     grain_index < 16;
+		     grain_index++ )
+		{
+			result = libvmdk_readahead_read_grain_data(
+			          readahead,
+			          grain_index,
+			          256,
+			          buffer,
+			          256,
+			          &error );
+
+			VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			/* The sparse grain is never read ahead
+			 */
+			if( grain_index == 5 )
+			{
+				VMDK_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 0 );
+			}
+			if( result == 1 )
+			{
+				for( buffer_index = 0;
+				     buffer_index < 256;
+				     buffer_index++ )
+				{
+					VMDK_TEST_ASSERT_EQUAL_UINT8(
+					 "buffer[ buffer_index ]",
+					 buffer[ buffer_index ],
+					 (uint8_t) grain_index );
+				}
+			}
+			VMDK_TEST_ASSERT_EQUAL_UINT64(
+			 "readahead->last_grain_index",
+			 readahead->last_grain_index,
+			 grain_index );
+
+			VMDK_TEST_ASSERT_LESS_THAN_UINT64(
+			 "readahead->end_grain_index",
+			 readahead->end_grain_index,
+			 (uint64_t) 17 );
+		}
+	}
+	/* Grains beyond the grains that can be read ahead are not read ahead
+	 */
+	result = libvmdk_readahead_read_grain_data(
+	          readahead,
+	          16,
+	          0,
+	          buffer,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_readahead_read_grain_data(
+	          NULL,
+	          0,
+	          0,
+	          buffer,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_readahead_read_grain_data(
+	          readahead,
+	          0,
+	          512,
+	          buffer,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_readahead_read_grain_data(
+	          readahead,
+	          0,
+	          0,
+	          NULL,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_readahead_read_grain_data(
+	          readahead,
+	          0,
+	          256,
+	          buffer,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_readahead_free(
+	          &readahead,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "readahead",
+	 readahead );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( readahead != NULL )
+	{
+		libvmdk_readahead_free(
+		 &readahead,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) && defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) && defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_readahead_initialize",
+	 vmdk_test_readahead_initialize );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_readahead_free",
+	 vmdk_test_readahead_free );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_readahead_read_grain_data",
+	 vmdk_test_readahead_read_grain_data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) && defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) && defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) && defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+}
+
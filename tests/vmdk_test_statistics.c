@@ -0,0 +1,709 @@
+/*
+ * Library statistics type test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_memory.h"
+#include "vmdk_test_unused.h"
+
+#include "../libvmdk/libvmdk_definitions.h"
+#include "../libvmdk/libvmdk_statistics.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+/* Tests the libvmdk_statistics_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_statistics_initialize(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libvmdk_statistics_t *statistics = NULL;
+	int result                       = 0;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+	int number_of_malloc_fail_tests  = 2;
+	int number_of_memset_fail_tests  = 1;
+	int test_number                  = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvmdk_statistics_initialize(
+	          &statistics,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "statistics",
+	 statistics );
+
+	result = libvmdk_statistics_free(
+	          &statistics,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "statistics",
+	 statistics );
+
+	/* Test error cases
+	 */
+	result = libvmdk_statistics_initialize(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	statistics = (libvmdk_statistics_t *) 0x12345678UL;
+
+	result = libvmdk_statistics_initialize(
+	          &statistics,
+	          &error );
+
+	statistics = NULL;
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_statistics_initialize with malloc failing
+		 */
+		vmdk_test_malloc_attempts_before_fail = test_number;
+
+		result = libvmdk_statistics_initialize(
+		          &statistics,
+		          &error );
+
+		if( vmdk_test_malloc_attempts_before_fail != -1 )
+		{
+			vmdk_test_malloc_attempts_before_fail = -1;
+
+			if( statistics != NULL )
+			{
+				libvmdk_statistics_free(
+				 &statistics,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "statistics",
+			 statistics );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_statistics_initialize with memset failing
+		 */
+		vmdk_test_memset_attempts_before_fail = test_number;
+
+		result = libvmdk_statistics_initialize(
+		          &statistics,
+		          &error );
+
+		if( vmdk_test_memset_attempts_before_fail != -1 )
+		{
+			vmdk_test_memset_attempts_before_fail = -1;
+
+			if( statistics != NULL )
+			{
+				libvmdk_statistics_free(
+				 &statistics,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "statistics",
+			 statistics );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( statistics != NULL )
+	{
+		libvmdk_statistics_free(
+		 &statistics,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_statistics_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_statistics_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_statistics_free(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_statistics_add function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_statistics_add(
+     void )
+{
+	uint64_t values[ LIBVMDK_NUMBER_OF_STATISTICS + 1 ];
+
+	libcerror_error_t *error         = NULL;
+	libvmdk_statistics_t *statistics = NULL;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_statistics_initialize(
+	          &statistics,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_statistics_add(
+	          statistics,
+	          LIBVMDK_STATISTIC_BYTES_READ,
+	          4096,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_statistics_add(
+	          statistics,
+	          LIBVMDK_STATISTIC_BYTES_READ,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_statistics_add(
+	          statistics,
+	          LIBVMDK_STATISTIC_READS,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	values[ LIBVMDK_NUMBER_OF_STATISTICS ] = 1;
+
+	result = libvmdk_statistics_get_values(
+	          statistics,
+	          values,
+	          LIBVMDK_NUMBER_OF_STATISTICS + 1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVMDK_STATISTIC_BYTES_READ ]",
+	 values[ LIBVMDK_STATISTIC_BYTES_READ ],
+	 (uint64_t) 4608 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVMDK_STATISTIC_READS ]",
+	 values[ LIBVMDK_STATISTIC_READS ],
+	 (uint64_t) 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVMDK_STATISTIC_SEEKS ]",
+	 values[ LIBVMDK_STATISTIC_SEEKS ],
+	 (uint64_t) 0 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVMDK_NUMBER_OF_STATISTICS ]",
+	 values[ LIBVMDK_NUMBER_OF_STATISTICS ],
+	 (uint64_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_statistics_add(
+	          NULL,
+	          LIBVMDK_STATISTIC_READS,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_statistics_add(
+	          statistics,
+	          -1,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_statistics_add(
+	          statistics,
+	          LIBVMDK_NUMBER_OF_STATISTICS,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_statistics_free(
+	          &statistics,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "statistics",
+	 statistics );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( statistics != NULL )
+	{
+		libvmdk_statistics_free(
+		 &statistics,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_statistics_clear function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_statistics_clear(
+     void )
+{
+	uint64_t values[ LIBVMDK_NUMBER_OF_STATISTICS ];
+
+	libcerror_error_t *error         = NULL;
+	libvmdk_statistics_t *statistics = NULL;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_statistics_initialize(
+	          &statistics,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_statistics_add(
+	          statistics,
+	          LIBVMDK_STATISTIC_SEEKS,
+	          3,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_statistics_clear(
+	          statistics,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_statistics_get_values(
+	          statistics,
+	          values,
+	          LIBVMDK_NUMBER_OF_STATISTICS,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVMDK_STATISTIC_SEEKS ]",
+	 values[ LIBVMDK_STATISTIC_SEEKS ],
+	 (uint64_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_statistics_clear(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_statistics_get_values(
+	          NULL,
+	          values,
+	          LIBVMDK_NUMBER_OF_STATISTICS,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_statistics_get_values(
+	          statistics,
+	          NULL,
+	          LIBVMDK_NUMBER_OF_STATISTICS,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_statistics_get_values(
+	          statistics,
+	          values,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_statistics_free(
+	          &statistics,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "statistics",
+	 statistics );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( statistics != NULL )
+	{
+		libvmdk_statistics_free(
+		 &statistics,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_statistics_initialize",
+	 vmdk_test_statistics_initialize );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_statistics_free",
+	 vmdk_test_statistics_free );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_statistics_add",
+	 vmdk_test_statistics_add );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_statistics_clear",
+	 vmdk_test_statistics_clear );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,957 @@
+/*
+ * Library stream_reader type test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vmdk_test_functions.h"
+#include "vmdk_test_libbfio.h"
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_memory.h"
+#include "vmdk_test_unused.h"
+
+#include "../libvmdk/libvmdk_stream_reader.h"
+
+/* The start of the file header of a streamOptimized extent file with 32 sectors,
+ * a grain of 16 sectors and 1 sector of metadata
+ */
+uint8_t vmdk_test_stream_reader_file_header_data[ 79 ] = {
+	0x4b, 0x44, 0x4d, 0x56, 0x03, 0x00, 0x00, 0x00, 0x01, 0x00, 0x03, 0x00, 0x20, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0a, 0x20, 0x0d, 0x0a, 0x01, 0x00 };
+
+/* A grain marker of the grain at sector 16 containing 8192 bytes of 0-byte values
+ */
+uint8_t vmdk_test_stream_reader_grain_marker_data[ 43 ] = {
+	0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x00, 0x78, 0xda, 0xed, 0xc1,
+	0x01, 0x0d, 0x00, 0x00, 0x00, 0xc2, 0xa0, 0xf7, 0x4f, 0x6d, 0x0e, 0x37, 0xa0, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x80, 0x77, 0x03, 0x20, 0x00, 0x00, 0x01 };
+
+/* A grain table marker of 1 sector
+ */
+uint8_t vmdk_test_stream_reader_grain_table_marker_data[ 16 ] = {
+	0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00 };
+
+/* Builds a stream that consists of the file header, a grain, a grain table and an end of stream marker
+ * Returns 1 if successful or -1 on error
+ */
+int vmdk_test_stream_reader_get_stream_data(
+     uint8_t *data,
+     size_t data_size )
+{
+	if( ( data == NULL )
+	 || ( data_size != 2560 ) )
+	{
+		return( -1 );
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     data_size ) == NULL )
+	{
+		return( -1 );
+	}
+	if( memory_copy(
+	     data,
+	     vmdk_test_stream_reader_file_header_data,
+	     79 ) == NULL )
+	{
+		return( -1 );
+	}
+	if( memory_copy(
+	     &( data[ 512 ] ),
+	     vmdk_test_stream_reader_grain_marker_data,
+	     43 ) == NULL )
+	{
+		return( -1 );
+	}
+	if( memory_copy(
+	     &( data[ 1024 ] ),
+	     vmdk_test_stream_reader_grain_table_marker_data,
+	     16 ) == NULL )
+	{
+		return( -1 );
+	}
+	/* The grain table data is stored in data[ 1536 ] to data[ 2047 ]
+	 * and the end of stream marker in data[ 2048 ] to data[ 2559 ]
+	 */
+	return( 1 );
+}
+
+/* Tests the libvmdk_stream_reader_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_stream_reader_initialize(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libvmdk_stream_reader_t *stream_reader  = NULL;
+	int result                              = 0;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+	int number_of_malloc_fail_tests         = 2;
+	int number_of_memset_fail_tests         = 1;
+	int test_number                         = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvmdk_stream_reader_initialize(
+	          &stream_reader,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "stream_reader",
+	 stream_reader );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_stream_reader_free(
+	          &stream_reader,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "stream_reader",
+	 stream_reader );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_stream_reader_initialize(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	stream_reader = (libvmdk_stream_reader_t *) 0x12345678UL;
+
+	result = libvmdk_stream_reader_initialize(
+	          &stream_reader,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	stream_reader = NULL;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_stream_reader_initialize with malloc failing
+		 */
+		vmdk_test_malloc_attempts_before_fail = test_number;
+
+		result = libvmdk_stream_reader_initialize(
+		          &stream_reader,
+		          &error );
+
+		if( vmdk_test_malloc_attempts_before_fail != -1 )
+		{
+			vmdk_test_malloc_attempts_before_fail = -1;
+
+			if( stream_reader != NULL )
+			{
+				libvmdk_stream_reader_free(
+				 &stream_reader,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "stream_reader",
+			 stream_reader );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_stream_reader_initialize with memset failing
+		 */
+		vmdk_test_memset_attempts_before_fail = test_number;
+
+		result = libvmdk_stream_reader_initialize(
+		          &stream_reader,
+		          &error );
+
+		if( vmdk_test_memset_attempts_before_fail != -1 )
+		{
+			vmdk_test_memset_attempts_before_fail = -1;
+
+			if( stream_reader != NULL )
+			{
+				libvmdk_stream_reader_free(
+				 &stream_reader,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "stream_reader",
+			 stream_reader );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream_reader != NULL )
+	{
+		libvmdk_stream_reader_free(
+		 &stream_reader,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_stream_reader_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_stream_reader_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_stream_reader_free(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+/* Tests the libvmdk_stream_reader_read_marker_data function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_stream_reader_read_marker_data(
+     void )
+{
+	libcerror_error_t *error      = NULL;
+	uint64_t marker_value         = 0;
+	uint32_t compressed_data_size = 0;
+	uint32_t marker_type          = 0;
+	int result                    = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_stream_reader_read_marker_data(
+	          vmdk_test_stream_reader_grain_marker_data,
+	          43,
+	          &marker_value,
+	          &compressed_data_size,
+	          &marker_type,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "marker_value",
+	 marker_value,
+	 (uint64_t) 16 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "compressed_data_size",
+	 compressed_data_size,
+	 (uint32_t) 31 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_stream_reader_read_marker_data(
+	          vmdk_test_stream_reader_grain_table_marker_data,
+	          16,
+	          &marker_value,
+	          &compressed_data_size,
+	          &marker_type,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "marker_value",
+	 marker_value,
+	 (uint64_t) 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "compressed_data_size",
+	 compressed_data_size,
+	 (uint32_t) 0 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "marker_type",
+	 marker_type,
+	 (uint32_t) 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_stream_reader_read_marker_data(
+	          NULL,
+	          16,
+	          &marker_value,
+	          &compressed_data_size,
+	          &marker_type,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_stream_reader_read_marker_data(
+	          vmdk_test_stream_reader_grain_table_marker_data,
+	          8,
+	          &marker_value,
+	          &compressed_data_size,
+	          &marker_type,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_stream_reader_read_marker_data(
+	          vmdk_test_stream_reader_grain_table_marker_data,
+	          16,
+	          NULL,
+	          &compressed_data_size,
+	          &marker_type,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_stream_reader_read_marker_data(
+	          vmdk_test_stream_reader_grain_table_marker_data,
+	          16,
+	          &marker_value,
+	          NULL,
+	          &marker_type,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_stream_reader_read_marker_data(
+	          vmdk_test_stream_reader_grain_table_marker_data,
+	          16,
+	          &marker_value,
+	          &compressed_data_size,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+/* Tests the libvmdk_stream_reader_read_grain function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_stream_reader_read_grain(
+     void )
+{
+	uint8_t buffer[ 8192 ];
+	uint8_t stream_data[ 2560 ];
+
+	libbfio_handle_t *file_io_handle       = NULL;
+	libcerror_error_t *error               = NULL;
+	libvmdk_stream_reader_t *stream_reader = NULL;
+	size64_t grain_size                    = 0;
+	size64_t media_size                    = 0;
+	ssize_t read_count                     = 0;
+	off64_t offset                         = 0;
+	size_t buffer_index                    = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	result = vmdk_test_stream_reader_get_stream_data(
+	          stream_data,
+	          2560 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = vmdk_test_open_file_io_handle(
+	          &file_io_handle,
+	          stream_data,
+	          2560,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_stream_reader_initialize(
+	          &stream_reader,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "stream_reader",
+	 stream_reader );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_stream_reader_open_file_io_handle(
+	          stream_reader,
+	          file_io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_stream_reader_get_grain_size(
+	          stream_reader,
+	          &grain_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "grain_size",
+	 (uint64_t) grain_size,
+	 (uint64_t) 8192 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_stream_reader_get_media_size(
+	          stream_reader,
+	          &media_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "media_size",
+	 (uint64_t) media_size,
+	 (uint64_t) 16384 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = ( memory_set(
+	            buffer,
+	            0xff,
+	            8192 ) != NULL );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	read_count = libvmdk_stream_reader_read_grain(
+	              stream_reader,
+	              buffer,
+	              8192,
+	              &offset,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 8192 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 8192 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( buffer_index = 0;
+	     buffer_index < 8192;
+	     buffer_index++ )
+	{
+		if( buffer[ buffer_index ] != 0 )
+		{
+			break;
+		}
+	}
+	VMDK_TEST_ASSERT_EQUAL_SIZE(
+	 "buffer_index",
+	 buffer_index,
+	 (size_t) 8192 );
+
+	/* The grain table is skipped and the end of stream marker is read
+	 */
+	read_count = libvmdk_stream_reader_read_grain(
+	              stream_reader,
+	              buffer,
+	              8192,
+	              &offset,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libvmdk_stream_reader_read_grain(
+	              stream_reader,
+	              buffer,
+	              8192,
+	              &offset,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	read_count = libvmdk_stream_reader_read_grain(
+	              NULL,
+	              buffer,
+	              8192,
+	              &offset,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvmdk_stream_reader_read_grain(
+	              stream_reader,
+	              NULL,
+	              8192,
+	              &offset,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvmdk_stream_reader_read_grain(
+	              stream_reader,
+	              buffer,
+	              512,
+	              &offset,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvmdk_stream_reader_read_grain(
+	              stream_reader,
+	              buffer,
+	              8192,
+	              NULL,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_stream_reader_close(
+	          stream_reader,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test libvmdk_stream_reader_open_file_io_handle with a truncated stream
+	 */
+	result = vmdk_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = vmdk_test_open_file_io_handle(
+	          &file_io_handle,
+	          stream_data,
+	          256,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvmdk_stream_reader_open_file_io_handle(
+	          stream_reader,
+	          file_io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_stream_reader_free(
+	          &stream_reader,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream_reader != NULL )
+	{
+		libvmdk_stream_reader_free(
+		 &stream_reader,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_stream_reader_initialize",
+	 vmdk_test_stream_reader_initialize );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_stream_reader_free",
+	 vmdk_test_stream_reader_free );
+
+	/* TODO: add tests for libvmdk_stream_reader_open_file_io_handle */
+
+	/* TODO: add tests for libvmdk_stream_reader_close */
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_stream_reader_read_marker_data",
+	 vmdk_test_stream_reader_read_marker_data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+	VMDK_TEST_RUN(
+	 "libvmdk_stream_reader_read_grain",
+	 vmdk_test_stream_reader_read_grain );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1295 @@
+/*
+ * Library trace type test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_memory.h"
+#include "vmdk_test_unused.h"
+
+#include "../libvmdk/libvmdk_definitions.h"
+#include "../libvmdk/libvmdk_trace.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+/* Trace callback function that counts the trace events
+ */
+void vmdk_test_trace_callback(
+     int trace_event,
+     uint64_t start_timestamp VMDK_TEST_ATTRIBUTE_UNUSED,
+     uint64_t duration VMDK_TEST_ATTRIBUTE_UNUSED,
+     void *callback_data )
+{
+	int *number_of_events = NULL;
+
+	VMDK_TEST_UNREFERENCED_PARAMETER( start_timestamp )
+	VMDK_TEST_UNREFERENCED_PARAMETER( duration )
+
+	if( ( callback_data != NULL )
+	 && ( trace_event >= 0 )
+	 && ( trace_event < LIBVMDK_NUMBER_OF_TRACE_EVENTS ) )
+	{
+		number_of_events = (int *) callback_data;
+
+		number_of_events[ trace_event ] += 1;
+	}
+}
+
+/* Tests the libvmdk_trace_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_trace_initialize(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libvmdk_trace_t *trace           = NULL;
+	int result                       = 0;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+	int number_of_malloc_fail_tests  = 2;
+	int number_of_memset_fail_tests  = 1;
+	int test_number                  = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvmdk_trace_initialize(
+	          &trace,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "trace",
+	 trace );
+
+	result = libvmdk_trace_free(
+	          &trace,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "trace",
+	 trace );
+
+	/* Test error cases
+	 */
+	result = libvmdk_trace_initialize(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	trace = (libvmdk_trace_t *) 0x12345678UL;
+
+	result = libvmdk_trace_initialize(
+	          &trace,
+	          &error );
+
+	trace = NULL;
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_trace_initialize with malloc failing
+		 */
+		vmdk_test_malloc_attempts_before_fail = test_number;
+
+		result = libvmdk_trace_initialize(
+		          &trace,
+		          &error );
+
+		if( vmdk_test_malloc_attempts_before_fail != -1 )
+		{
+			vmdk_test_malloc_attempts_before_fail = -1;
+
+			if( trace != NULL )
+			{
+				libvmdk_trace_free(
+				 &trace,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "trace",
+			 trace );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_trace_initialize with memset failing
+		 */
+		vmdk_test_memset_attempts_before_fail = test_number;
+
+		result = libvmdk_trace_initialize(
+		          &trace,
+		          &error );
+
+		if( vmdk_test_memset_attempts_before_fail != -1 )
+		{
+			vmdk_test_memset_attempts_before_fail = -1;
+
+			if( trace != NULL )
+			{
+				libvmdk_trace_free(
+				 &trace,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "trace",
+			 trace );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( trace != NULL )
+	{
+		libvmdk_trace_free(
+		 &trace,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_trace_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_trace_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_trace_free(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_trace_set_callback function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_trace_set_callback(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	libvmdk_trace_t *trace   = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_trace_initialize(
+	          &trace,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "trace->is_enabled",
+	 trace->is_enabled,
+	 0 );
+
+	result = libvmdk_trace_set_callback(
+	          trace,
+	          &vmdk_test_trace_callback,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "trace->is_enabled",
+	 trace->is_enabled,
+	 1 );
+
+	result = libvmdk_trace_set_callback(
+	          trace,
+	          NULL,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "trace->is_enabled",
+	 trace->is_enabled,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_trace_set_callback(
+	          NULL,
+	          &vmdk_test_trace_callback,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_trace_free(
+	          &trace,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "trace",
+	 trace );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( trace != NULL )
+	{
+		libvmdk_trace_free(
+		 &trace,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_trace_set_use_latency_histograms function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_trace_set_use_latency_histograms(
+     void )
+{
+	libcerror_error_t *error       = NULL;
+	libvmdk_trace_t *trace         = NULL;
+	uint8_t use_latency_histograms = 0;
+	int result                     = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_trace_initialize(
+	          &trace,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_trace_set_use_latency_histograms(
+	          trace,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "trace->is_enabled",
+	 trace->is_enabled,
+	 1 );
+
+	result = libvmdk_trace_get_use_latency_histograms(
+	          trace,
+	          &use_latency_histograms,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "use_latency_histograms",
+	 use_latency_histograms,
+	 1 );
+
+	result = libvmdk_trace_set_use_latency_histograms(
+	          trace,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "trace->is_enabled",
+	 trace->is_enabled,
+	 0 );
+
+	result = libvmdk_trace_get_use_latency_histograms(
+	          trace,
+	          &use_latency_histograms,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "use_latency_histograms",
+	 use_latency_histograms,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_trace_set_use_latency_histograms(
+	          NULL,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_trace_get_use_latency_histograms(
+	          NULL,
+	          &use_latency_histograms,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_trace_get_use_latency_histograms(
+	          trace,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_trace_free(
+	          &trace,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "trace",
+	 trace );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( trace != NULL )
+	{
+		libvmdk_trace_free(
+		 &trace,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_trace_get_timestamp function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_trace_get_timestamp(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	uint64_t timestamp       = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_trace_get_timestamp(
+	          &timestamp,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_trace_get_timestamp(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_trace_get_latency_histogram_bucket_index function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_trace_get_latency_histogram_bucket_index(
+     void )
+{
+	int bucket_index = 0;
+
+	/* Test regular cases
+	 */
+	bucket_index = libvmdk_trace_get_latency_histogram_bucket_index(
+	                0 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "bucket_index",
+	 bucket_index,
+	 0 );
+
+	bucket_index = libvmdk_trace_get_latency_histogram_bucket_index(
+	                1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "bucket_index",
+	 bucket_index,
+	 0 );
+
+	bucket_index = libvmdk_trace_get_latency_histogram_bucket_index(
+	                2 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "bucket_index",
+	 bucket_index,
+	 1 );
+
+	bucket_index = libvmdk_trace_get_latency_histogram_bucket_index(
+	                3 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "bucket_index",
+	 bucket_index,
+	 1 );
+
+	bucket_index = libvmdk_trace_get_latency_histogram_bucket_index(
+	                1024 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "bucket_index",
+	 bucket_index,
+	 10 );
+
+	bucket_index = libvmdk_trace_get_latency_histogram_bucket_index(
+	                2047 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "bucket_index",
+	 bucket_index,
+	 10 );
+
+	bucket_index = libvmdk_trace_get_latency_histogram_bucket_index(
+	                (uint64_t) 0xffffffffffffffffULL );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "bucket_index",
+	 bucket_index,
+	 LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS - 1 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libvmdk_trace_start_event function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_trace_start_event(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	libvmdk_trace_t *trace   = NULL;
+	uint64_t start_timestamp = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_trace_initialize(
+	          &trace,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "trace",
+	 trace );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_trace_start_event(
+	          trace,
+	          &start_timestamp );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libvmdk_trace_set_use_latency_histograms(
+	          trace,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_trace_start_event(
+	          trace,
+	          &start_timestamp );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_trace_start_event(
+	          NULL,
+	          &start_timestamp );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libvmdk_trace_start_event(
+	          trace,
+	          NULL );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Clean up
+	 */
+	result = libvmdk_trace_free(
+	          &trace,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "trace",
+	 trace );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( trace != NULL )
+	{
+		libvmdk_trace_free(
+		 &trace,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_trace_record_event function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_trace_record_event(
+     void )
+{
+	uint64_t buckets[ LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS + 1 ];
+	int number_of_events[ LIBVMDK_NUMBER_OF_TRACE_EVENTS ];
+
+	libcerror_error_t *error = NULL;
+	libvmdk_trace_t *trace   = NULL;
+	uint64_t bucket_total    = 0;
+	int bucket_index         = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_trace_initialize(
+	          &trace,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_trace_set_callback(
+	          trace,
+	          &vmdk_test_trace_callback,
+	          (void *) number_of_events,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_trace_set_use_latency_histograms(
+	          trace,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	number_of_events[ LIBVMDK_TRACE_EVENT_GRAIN_READ ]        = 0;
+	number_of_events[ LIBVMDK_TRACE_EVENT_GRAIN_TABLE_READ ] = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_trace_record_event(
+	          trace,
+	          LIBVMDK_TRACE_EVENT_GRAIN_READ,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_trace_record_event(
+	          trace,
+	          LIBVMDK_TRACE_EVENT_GRAIN_READ,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "number_of_events[ LIBVMDK_TRACE_EVENT_GRAIN_READ ]",
+	 number_of_events[ LIBVMDK_TRACE_EVENT_GRAIN_READ ],
+	 2 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "number_of_events[ LIBVMDK_TRACE_EVENT_GRAIN_TABLE_READ ]",
+	 number_of_events[ LIBVMDK_TRACE_EVENT_GRAIN_TABLE_READ ],
+	 0 );
+
+	buckets[ LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS ] = 1;
+
+	result = libvmdk_trace_get_latency_histogram(
+	          trace,
+	          LIBVMDK_TRACE_EVENT_GRAIN_READ,
+	          buckets,
+	          LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS + 1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	bucket_total = 0;
+
+	for( bucket_index = 0;
+	     bucket_index < LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS;
+	     bucket_index++ )
+	{
+		bucket_total += buckets[ bucket_index ];
+	}
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "bucket_total",
+	 bucket_total,
+	 (uint64_t) 2 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "buckets[ LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS ]",
+	 buckets[ LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS ],
+	 (uint64_t) 0 );
+
+	result = libvmdk_trace_clear_latency_histograms(
+	          trace,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_trace_get_latency_histogram(
+	          trace,
+	          LIBVMDK_TRACE_EVENT_GRAIN_READ,
+	          buckets,
+	          LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	bucket_total = 0;
+
+	for( bucket_index = 0;
+	     bucket_index < LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS;
+	     bucket_index++ )
+	{
+		bucket_total += buckets[ bucket_index ];
+	}
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "bucket_total",
+	 bucket_total,
+	 (uint64_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_trace_record_event(
+	          NULL,
+	          LIBVMDK_TRACE_EVENT_GRAIN_READ,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_trace_record_event(
+	          trace,
+	          -1,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_trace_record_event(
+	          trace,
+	          LIBVMDK_NUMBER_OF_TRACE_EVENTS,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_trace_get_latency_histogram(
+	          NULL,
+	          LIBVMDK_TRACE_EVENT_GRAIN_READ,
+	          buckets,
+	          LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_trace_get_latency_histogram(
+	          trace,
+	          LIBVMDK_NUMBER_OF_TRACE_EVENTS,
+	          buckets,
+	          LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_trace_get_latency_histogram(
+	          trace,
+	          LIBVMDK_TRACE_EVENT_GRAIN_READ,
+	          NULL,
+	          LIBVMDK_NUMBER_OF_LATENCY_HISTOGRAM_BUCKETS,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_trace_get_latency_histogram(
+	          trace,
+	          LIBVMDK_TRACE_EVENT_GRAIN_READ,
+	          buckets,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_trace_clear_latency_histograms(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_trace_free(
+	          &trace,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "trace",
+	 trace );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( trace != NULL )
+	{
+		libvmdk_trace_free(
+		 &trace,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_trace_initialize",
+	 vmdk_test_trace_initialize );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_trace_free",
+	 vmdk_test_trace_free );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_trace_set_callback",
+	 vmdk_test_trace_set_callback );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_trace_set_use_latency_histograms",
+	 vmdk_test_trace_set_use_latency_histograms );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_trace_get_timestamp",
+	 vmdk_test_trace_get_timestamp );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_trace_get_latency_histogram_bucket_index",
+	 vmdk_test_trace_get_latency_histogram_bucket_index );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_trace_start_event",
+	 vmdk_test_trace_start_event );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_trace_record_event",
+	 vmdk_test_trace_record_event );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+}
+
@@ -35,6 +35,8 @@
 
 #define INFO_HANDLE_NOTIFY_STREAM		stdout
 
+#define INFO_HANDLE_STATISTICS_BUFFER_SIZE	1024 * 1024
+
 /* Creates an info handle
  * Make sure the value info_handle is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -190,6 +192,8 @@ int info_handle_signal_abort(
 
 		return( -1 );
 	}
+	info_handle->abort = 1;
+
 	if( info_handle->input_handle != NULL )
 	{
 		if( libvmdk_handle_signal_abort(
@@ -937,3 +941,159 @@ on_error:
 	return( -1 );
 }
 
+/* Reads the media data and prints the statistics of reading it
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_statistics_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	uint64_t statistics[ LIBVMDK_NUMBER_OF_STATISTICS ];
+
+	static char *statistic_descriptions[ LIBVMDK_NUMBER_OF_STATISTICS ] = {
+		"Bytes read\t\t\t",
+		"Sparse grains read\t\t",
+		"Grains decompressed\t\t",
+		"Compressed bytes decompressed\t",
+		"Grain tables read\t\t",
+		"Grain cache hits\t\t",
+		"Grain cache misses\t\t",
+		"Grain table cache hits\t\t",
+		"Grain table cache misses\t",
+		"Seeks\t\t\t\t",
+		"Reads\t\t\t\t" };
+
+	uint8_t *buffer       = NULL;
+	static char *function = "info_handle_statistics_fprint";
+	size64_t media_size   = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+	off64_t media_offset  = 0;
+	int statistic_index   = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_get_media_size(
+	     info_handle->input_handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * INFO_HANDLE_STATISTICS_BUFFER_SIZE );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	while( (size64_t) media_offset < media_size )
+	{
+		if( info_handle->abort != 0 )
+		{
+			break;
+		}
+		read_size = INFO_HANDLE_STATISTICS_BUFFER_SIZE;
+
+		if( (size64_t) read_size > ( media_size - media_offset ) )
+		{
+			read_size = (size_t) ( media_size - media_offset );
+		}
+		read_count = libvmdk_handle_read_buffer_at_offset(
+		              info_handle->input_handle,
+		              buffer,
+		              read_size,
+		              media_offset,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read media data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 media_offset,
+			 media_offset );
+
+			goto on_error;
+		}
+		else if( read_count == 0 )
+		{
+			break;
+		}
+		media_offset += (off64_t) read_count;
+	}
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	if( libvmdk_handle_get_statistics(
+	     info_handle->input_handle,
+	     statistics,
+	     LIBVMDK_NUMBER_OF_STATISTICS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve statistics.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "Statistics:\n" );
+
+	for( statistic_index = 0;
+	     statistic_index < LIBVMDK_NUMBER_OF_STATISTICS;
+	     statistic_index++ )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "\t%s: %" PRIu64 "\n",
+		 statistic_descriptions[ statistic_index ],
+		 statistics[ statistic_index ] );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
@@ -45,6 +45,10 @@ struct info_handle
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
 };
 
 int info_handle_initialize(
@@ -73,6 +77,10 @@ int info_handle_file_fprint(
      info_handle_t *info_handle,
      libcerror_error_t **error );
 
+int info_handle_statistics_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -64,11 +64,12 @@ void usage_fprint(
 	fprintf( stream, "Use vmdkinfo to determine information about a VMware Virtual Disk (VMDK)\n"
 	                 "image file.\n\n" );
 
-	fprintf( stream, "Usage: vmdkinfo [ -hvV ] source\n\n" );
+	fprintf( stream, "Usage: vmdkinfo [ -hsvV ] source\n\n" );
 
 	fprintf( stream, "\tsource: the source file(s)\n\n" );
 
 	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-s:     read the media data and print the statistics of reading it\n" );
 	fprintf( stream, "\t-v:     verbose output to stderr\n" );
 	fprintf( stream, "\t-V:     print version\n" );
 }
@@ -130,6 +131,7 @@ int main( int argc, char * const argv[] )
 	char *program                                = "vmdkinfo";
 	system_integer_t option                      = 0;
 	int number_of_source_filenames               = 0;
+	int print_statistics                         = 0;
 	int verbose                                  = 0;
 
 	libcnotify_stream_set(
@@ -165,7 +167,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = vmdktools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "hvV" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "hsvV" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -187,6 +189,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 's':
+				print_statistics = 1;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -253,6 +260,44 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( print_statistics != 0 )
+	{
+		if( vmdktools_signal_attach(
+		     vmdkinfo_signal_handler,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to attach signal handler.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+		if( info_handle_statistics_fprint(
+		     vmdkinfo_info_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to print statistics.\n" );
+
+			goto on_error;
+		}
+		if( vmdktools_signal_detach(
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to detach signal handler.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
 	if( info_handle_close(
 	     vmdkinfo_info_handle,
 	     &error ) != 0 )